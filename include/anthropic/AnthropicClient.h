@@ -53,12 +53,13 @@ class AnthropicClient : public LLMClient {
      */
 
     /**
-     * Send a Messages API request directly
+     * Send a Messages API request directly; throws llmcpp::OperationCancelled when cancelled
      */
-    MessagesResponse sendMessagesRequest(const MessagesRequest& request);
+    MessagesResponse sendMessagesRequest(const MessagesRequest& request,
+                                         const llmcpp::CancellationToken& cancel = {});
 
     /**
-     * Synchronous request (blocking)
+     * Synchronous request (blocking); honours request.cancellation
      */
     LLMResponse sendRequest(const LLMRequest& request);
 
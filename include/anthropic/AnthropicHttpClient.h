@@ -3,6 +3,7 @@
 #include <string>
 
 #include "anthropic/AnthropicTypes.h"
+#include "core/CancellationToken.h"
 
 namespace Anthropic {
 
@@ -16,8 +17,12 @@ class AnthropicHttpClient {
 
     /**
      * Send a Messages API request
+     *
+     * Cancelling `cancel` aborts the socket read and throws llmcpp::OperationCancelled.
+     * Cancellable requests use a connection of their own.
      */
-    MessagesResponse sendMessagesRequest(const MessagesRequest& request);
+    MessagesResponse sendMessagesRequest(const MessagesRequest& request,
+                                         const llmcpp::CancellationToken& cancel = {});
 
    private:
     class HttpClientImpl;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "anthropic/AnthropicTypes.h"
+#include "core/ToolCallStream.h"
+#include "core/ToolRunner.h"
+
+namespace Anthropic {
+
+class AnthropicClient;
+
+/**
+ * @brief llmcpp::ToolSession over the Messages API
+ *
+ * The Messages API is stateless, so the session keeps the conversation: each assistant
+ * turn (text and tool_use blocks) is appended to the request, followed by a user message
+ * carrying one tool_result block per call, and the whole history is resent.
+ */
+class MessagesToolSession : public llmcpp::ToolSession {
+   public:
+    using Sender = std::function<MessagesResponse(const MessagesRequest&)>;
+
+    MessagesToolSession(AnthropicClient& client, MessagesRequest request);
+    MessagesToolSession(Sender send, MessagesRequest request);
+
+    llmcpp::ToolTurn start(const std::vector<llmcpp::ToolDefinition>& tools) override;
+    llmcpp::ToolTurn submit(const std::vector<llmcpp::ToolCallResult>& results) override;
+
+    // The conversation so far, including the last assistant turn
+    const MessagesRequest& request() const { return request_; }
+    const MessagesResponse& lastResponse() const { return last_; }
+
+   private:
+    llmcpp::ToolTurn send();
+
+    Sender send_;
+    MessagesRequest request_;
+    MessagesResponse last_;
+};
+
+/**
+ * @brief Map a Messages API stream event onto `assembler`
+ *
+ * Handles content_block_start (tool_use), content_block_delta (input_json_delta) and
+ * content_block_stop. Returns true for tool_use events.
+ */
+bool applyMessagesStreamEvent(llmcpp::ToolCallAssembler& assembler, const json& event);
+
+}  // namespace Anthropic
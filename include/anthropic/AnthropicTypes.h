@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/LLMTypes.h"
+#include "core/PromptCache.h"
 
 using json = nlohmann::json;
 
@@ -128,6 +129,36 @@ inline std::string toString(MessageRole role) {
     }
 }
 
+/**
+ * Prompt cache breakpoint: the prompt up to and including the marked block is cached
+ */
+struct CacheControl {
+    std::string type = "ephemeral";
+    std::optional<std::string> ttl;  // "5m" (default) or "1h"
+
+    json toJson() const {
+        json j = {{"type", type}};
+        if (ttl.has_value()) {
+            j["ttl"] = ttl.value();
+        }
+        return j;
+    }
+
+    // Accepts the API object or just its type, e.g. "ephemeral"
+    static CacheControl fromJson(const json& j) {
+        CacheControl control;
+        if (j.is_string()) {
+            control.type = j.get<std::string>();
+        } else if (j.is_object()) {
+            control.type = j.value("type", control.type);
+            if (j.contains("ttl") && j["ttl"].is_string()) {
+                control.ttl = j["ttl"].get<std::string>();
+            }
+        }
+        return control;
+    }
+};
+
 /**
  * Anthropic message content (supports text, tool_use, and tool_result)
  */
@@ -145,19 +176,24 @@ struct MessageContent {
     json content;
     bool isError = false;
 
+    std::optional<CacheControl> cacheControl;  // Cache breakpoint after this block
+
     json toJson() const {
-        if (type == "text") {
-            return json{{"type", type}, {"text", text}};
-        } else if (type == "tool_use") {
-            return json{{"type", type}, {"id", id}, {"name", name}, {"input", input}};
+        json j;
+        if (type == "tool_use") {
+            j = {{"type", type}, {"id", id}, {"name", name}, {"input", input}};
         } else if (type == "tool_result") {
-            json j = {{"type", type}, {"tool_use_id", toolUseId}, {"content", content}};
+            j = {{"type", type}, {"tool_use_id", toolUseId}, {"content", content}};
             if (isError) {
                 j["is_error"] = true;
             }
-            return j;
+        } else {
+            j = {{"type", type}, {"text", text}};
+        }
+        if (cacheControl.has_value()) {
+            j["cache_control"] = cacheControl->toJson();
         }
-        return json{{"type", type}, {"text", text}};
+        return j;
     }
 
     // Convenience constructors
@@ -217,6 +253,27 @@ struct AnthropicConfig {
 
     AnthropicConfig() = default;
     explicit AnthropicConfig(const std::string& key) : apiKey(key) {}
+
+    json toJson() const {
+        return json{{"api_key", apiKey},
+                    {"base_url", baseUrl},
+                    {"anthropic_version", anthropicVersion},
+                    {"default_model", toString(defaultModel)},
+                    {"timeout_seconds", timeoutSeconds}};
+    }
+
+    static AnthropicConfig fromJson(const json& j) {
+        AnthropicConfig config;
+        if (j.contains("api_key")) config.apiKey = j["api_key"].get<std::string>();
+        else if (j.contains("apiKey")) config.apiKey = j["apiKey"].get<std::string>();
+        if (j.contains("base_url")) config.baseUrl = j["base_url"].get<std::string>();
+        if (j.contains("anthropic_version"))
+            config.anthropicVersion = j["anthropic_version"].get<std::string>();
+        if (j.contains("default_model"))
+            config.defaultModel = modelFromString(j["default_model"].get<std::string>());
+        if (j.contains("timeout_seconds")) config.timeoutSeconds = j["timeout_seconds"].get<int>();
+        return config;
+    }
 };
 
 /**
@@ -226,9 +283,14 @@ struct Tool {
     std::string name;
     std::string description;
     json inputSchema;
+    std::optional<CacheControl> cacheControl;  // Set on the last tool to cache all of them
 
     json toJson() const {
-        return json{{"name", name}, {"description", description}, {"input_schema", inputSchema}};
+        json j = {{"name", name}, {"description", description}, {"input_schema", inputSchema}};
+        if (cacheControl.has_value()) {
+            j["cache_control"] = cacheControl->toJson();
+        }
+        return j;
     }
 };
 
@@ -277,6 +339,7 @@ struct MessagesRequest {
     std::optional<double> temperature;
     std::optional<double> topP;
     std::optional<std::string> system;
+    std::vector<MessageContent> systemBlocks;  // Sent instead of `system`; blocks can be cached
     std::vector<std::string> stopSequences;
     std::vector<Tool> tools;                // Tool definitions for function calling
     std::optional<std::string> toolChoice;  // "auto", "any", or specific tool name
@@ -299,7 +362,9 @@ struct MessagesRequest {
         if (topP.has_value()) {
             j["top_p"] = topP.value();
         }
-        if (system.has_value()) {
+        if (!systemBlocks.empty()) {
+            j["system"] = systemJson();
+        } else if (system.has_value()) {
             j["system"] = system.value();
         }
         if (!stopSequences.empty()) {
@@ -318,13 +383,51 @@ struct MessagesRequest {
         return j;
     }
 
+    /**
+     * Canonical tools, system and messages up to the last cache breakpoint
+     *
+     * This is the part of the prompt a cache hit covers; it follows the API's render order
+     * (tools, system, messages). Without breakpoints only tools and system are included.
+     */
+    llmcpp::PromptPrefix staticPrefix() const {
+        json toolsJson = json::array();
+        for (const auto& tool : tools) {
+            toolsJson.push_back(tool.toJson());
+        }
+        json messagesJson = json::array();
+        size_t cachedMessages = 0;
+        for (size_t i = 0; i < messages.size(); ++i) {
+            const auto& blocks = messages[i].content;
+            if (std::any_of(blocks.begin(), blocks.end(),
+                            [](const MessageContent& c) { return c.cacheControl.has_value(); })) {
+                cachedMessages = i + 1;
+            }
+        }
+        for (size_t i = 0; i < cachedMessages; ++i) {
+            messagesJson.push_back(messages[i].toJson());
+        }
+        json systemValue = !systemBlocks.empty() ? systemJson() : json(system.value_or(""));
+        return llmcpp::PromptPrefix::of(json::array({toolsJson, systemValue, messagesJson}));
+    }
+
     /**
      * Convert from common LLMRequest to Anthropic MessagesRequest
+     *
+     * With `extensions["cache_control"]` ("ephemeral" or a CacheControl object) the prompt
+     * is sent as a cached system block ahead of the context, so repeated calls with the same
+     * prompt and different context share a cached prefix. Otherwise the prompt is the final
+     * user message.
      */
     static MessagesRequest fromLLMRequest(const LLMRequest& request) {
         MessagesRequest req;
         req.model = request.config.model;
 
+        std::optional<CacheControl> cacheControl;
+        const auto& extensions = request.config.extensions;
+        if (extensions.contains("cache_control") && !extensions["cache_control"].is_null()) {
+            cacheControl = CacheControl::fromJson(extensions["cache_control"]);
+        }
+
         // Add context messages first (chronological order)
         for (const auto& contextMsg : request.context) {
             Message msg;
@@ -343,8 +446,17 @@ struct MessagesRequest {
             }
         }
 
-        // Add main prompt as the final user message
-        if (!request.prompt.empty()) {
+        if (cacheControl.has_value() && !request.prompt.empty()) {
+            auto block = MessageContent::createText(request.prompt);
+            block.cacheControl = cacheControl;
+            if (req.messages.empty()) {
+                // Nothing follows the prompt, so it stays the user message
+                req.messages.push_back(Message{MessageRole::USER, {std::move(block)}});
+            } else {
+                req.systemBlocks.push_back(std::move(block));
+            }
+        } else if (!request.prompt.empty()) {
+            // Add main prompt as the final user message
             Message userMsg;
             userMsg.role = MessageRole::USER;
             userMsg.content.push_back({.type = "text", .text = request.prompt});
@@ -356,21 +468,42 @@ struct MessagesRequest {
             req.maxTokens = request.config.maxTokens.value();
         }
         if (request.config.temperature.has_value()) {
-            req.temperature = request.config.temperature.value();
+            req.temperature = llmcpp::canonicalFloat(request.config.temperature.value());
         }
 
         return req;
     }
+
+   private:
+    json systemJson() const {
+        json blocks = json::array();
+        for (const auto& block : systemBlocks) {
+            blocks.push_back(block.toJson());
+        }
+        return blocks;
+    }
 };
 
 /**
  * Anthropic usage information
  */
 struct Usage {
-    int inputTokens = 0;
+    int inputTokens = 0;  // Uncached input after the last cache breakpoint
     int outputTokens = 0;
+    int cacheReadInputTokens = 0;      // Input served from the prompt cache
+    int cacheCreationInputTokens = 0;  // Input written to the prompt cache
 
     int totalTokens() const { return inputTokens + outputTokens; }
+
+    // LLMUsage counts every prompt token as input, cached or not
+    LLMUsage toLLMUsage() const {
+        LLMUsage usage;
+        usage.inputTokens = inputTokens + cacheReadInputTokens + cacheCreationInputTokens;
+        usage.outputTokens = outputTokens;
+        usage.cachedInputTokens = cacheReadInputTokens;
+        usage.cacheCreationInputTokens = cacheCreationInputTokens;
+        return usage;
+    }
 };
 
 /**
@@ -386,6 +519,32 @@ struct MessagesResponse {
     std::optional<std::string> stopSequence;
     Usage usage;
 
+    /**
+     * All tool_use blocks, in order (toLLMResponse only surfaces the first one's input)
+     */
+    std::vector<ToolUse> getToolUses() const {
+        std::vector<ToolUse> uses;
+        for (const auto& c : content) {
+            if (c.type == "tool_use") {
+                uses.push_back(ToolUse{c.type, c.id, c.name, c.input});
+            }
+        }
+        return uses;
+    }
+
+    /**
+     * Concatenated text blocks
+     */
+    std::string getText() const {
+        std::string text;
+        for (const auto& c : content) {
+            if (c.type == "text") {
+                text += c.text;
+            }
+        }
+        return text;
+    }
+
     /**
      * Convert to common LLMResponse
      */
@@ -416,8 +575,7 @@ struct MessagesResponse {
             }
         }
 
-        response.usage.inputTokens = usage.inputTokens;
-        response.usage.outputTokens = usage.outputTokens;
+        response.usage = usage.toLLMUsage();
 
         if (!response.success) {
             response.errorMessage = "No content in response";
@@ -486,6 +644,13 @@ struct MessagesResponse {
             if (usageJson.contains("output_tokens")) {
                 response.usage.outputTokens = usageJson["output_tokens"];
             }
+            // Cache counters may be absent or null when no breakpoint was set
+            auto count = [&usageJson](const char* key) {
+                auto it = usageJson.find(key);
+                return it != usageJson.end() && it->is_number_integer() ? it->get<int>() : 0;
+            };
+            response.usage.cacheReadInputTokens = count("cache_read_input_tokens");
+            response.usage.cacheCreationInputTokens = count("cache_creation_input_tokens");
         }
 
         return response;
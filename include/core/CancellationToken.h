@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+#include <stdexcept>
+#include <stop_token>
+
+namespace llmcpp {
+
+/**
+ * @brief Cooperative cancellation for requests, streams and polling loops
+ *
+ * Whoever may lose interest in a result (e.g. the handler of a client connection) keeps a
+ * CancellationSource and passes its token to async and streaming calls, or sets it on
+ * LLMRequest::cancellation. request_stop() then aborts the socket read of the in-flight HTTP
+ * request, ends a stream at its next chunk, wakes polling loops and cancels background Responses
+ * API jobs on the server. Provider APIs report it by throwing OperationCancelled; LLMClient
+ * calls return an unsuccessful LLMResponse.
+ *
+ * These are the C++20 stop types: a default-constructed token is never cancelled, and
+ * std::stop_callback runs a function when cancellation is requested.
+ *
+ * Example usage:
+ * @code
+ * llmcpp::CancellationSource source;
+ * request.cancellation = source.get_token();
+ * auto future = client.sendRequestAsync(request);
+ * // ... the caller disconnected
+ * source.request_stop();
+ * @endcode
+ */
+using CancellationToken = std::stop_token;
+using CancellationSource = std::stop_source;
+
+class OperationCancelled : public std::runtime_error {
+   public:
+    OperationCancelled() : std::runtime_error("Operation cancelled") {}
+};
+
+// Throws OperationCancelled once cancellation has been requested
+void throwIfCancelled(const CancellationToken& token);
+
+// Sleeps for `duration` or until cancellation; returns false when cancelled
+bool sleepFor(const CancellationToken& token, std::chrono::milliseconds duration);
+
+}  // namespace llmcpp
@@ -2,14 +2,17 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "LLMClient.h"
+#include "providers/ClientFactory.h"
 
 /**
  * @brief Factory class for creating LLM clients
  *
  * This factory provides a unified interface for creating different types of LLM clients
  * based on provider names. It supports various providers like OpenAI, Anthropic, etc.
+ * Instance-style front end for llmcpp::ClientFactory; both share one provider registry.
  */
 class ClientFactory {
    public:
@@ -32,7 +35,26 @@ class ClientFactory {
      * @return std::unique_ptr<LLMClient> Pointer to the created client, nullptr if provider not
      * supported
      */
-    std::unique_ptr<LLMClient> createClient(const std::string& provider, const std::string& apiKey);
+    std::unique_ptr<LLMClient> createClient(const std::string& provider,
+                                            const std::string& apiKey) {
+        return llmcpp::ClientFactory::createClient(provider, apiKey);
+    }
+
+    std::unique_ptr<LLMClient> createClient(const std::string& provider, const char* apiKey) {
+        return llmcpp::ClientFactory::createClient(provider, std::string(apiKey));
+    }
+
+    /**
+     * @brief Create a new LLM client from a full provider config
+     *
+     * @param provider The provider name (e.g., "openai", "anthropic")
+     * @param config Provider settings, e.g. {"api_key", ...}, {"timeout_seconds", 60}
+     * @return std::unique_ptr<LLMClient> Pointer to the created client, nullptr if provider not
+     * supported
+     */
+    std::unique_ptr<LLMClient> createClient(const std::string& provider, const json& config) {
+        return llmcpp::ClientFactory::createClient(provider, config);
+    }
 
     /**
      * @brief Check if a provider is supported
@@ -40,12 +62,16 @@ class ClientFactory {
      * @param provider The provider name to check
      * @return true if the provider is supported, false otherwise
      */
-    bool isProviderSupported(const std::string& provider) const;
+    bool isProviderSupported(const std::string& provider) const {
+        return llmcpp::ClientFactory::isProviderSupported(provider);
+    }
 
     /**
      * @brief Get list of all supported providers
      *
      * @return std::vector<std::string> List of supported provider names
      */
-    std::vector<std::string> getSupportedProviders() const;
+    std::vector<std::string> getSupportedProviders() const {
+        return llmcpp::ClientFactory::getSupportedProviders();
+    }
 };
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "LLMClient.h"
 
@@ -13,11 +16,16 @@
  * This manager provides centralized client lifecycle management, connection pooling,
  * and thread-safe access to multiple LLM clients.
  * Uses shared_ptr for safe memory management and shared ownership.
+ *
+ * The client map is published as an immutable snapshot. Writers copy the map, modify the
+ * copy and publish it under a lock. Each thread caches the last snapshot it saw of each
+ * manager and reuses it while that manager's generation counter is unchanged, so lookups take
+ * no lock between writes, even when a thread alternates between managers.
  */
 class ClientManager {
    public:
     ClientManager() = default;
-    ~ClientManager() = default;
+    ~ClientManager();
 
     // Disable copy and move semantics (singleton-like behavior)
     ClientManager(const ClientManager&) = delete;
@@ -45,6 +53,11 @@ class ClientManager {
     /**
      * @brief Remove a client from the manager
      *
+     * The manager and the calling thread release the client at once. Another thread that has
+     * looked up in this manager keeps it alive until that thread's next lookup here, as does
+     * any shared_ptr returned by getClient(). clear() and destruction behave the same way;
+     * after destruction, other threads let go on their next lookup in any manager.
+     *
      * @param name The name of the client to remove
      * @return true if removed successfully, false if not found
      */
@@ -99,6 +112,18 @@ class ClientManager {
     }
 
    private:
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::shared_ptr<LLMClient>> clients_;
+    using ClientMap = std::unordered_map<std::string, std::shared_ptr<LLMClient>>;
+
+    static uint64_t nextId();
+
+    // The calling thread's snapshot; valid until its next snapshot() call
+    const ClientMap& snapshot() const;
+    // Returns the replaced map
+    std::shared_ptr<const ClientMap> publish(std::shared_ptr<const ClientMap> clients);
+
+    const uint64_t id_ = nextId();  // Tags thread-local snapshots; never reused, unlike `this`
+    std::shared_ptr<const bool> alive_ = std::make_shared<const bool>(true);  // Snapshot owner
+    mutable std::mutex mutex_;      // Guards clients_ and serializes writers
+    std::shared_ptr<const ClientMap> clients_ = std::make_shared<const ClientMap>();
+    std::atomic<uint64_t> generation_{0};
 };
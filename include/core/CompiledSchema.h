@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "core/LLMTypes.h"
+
+namespace llmcpp {
+
+/**
+ * @brief A single schema violation
+ */
+struct SchemaValidationError {
+    std::string path;     // JSON Pointer to the offending value ("" is the document root)
+    std::string keyword;  // Schema keyword that failed, e.g. "type", "required", "enum"
+    std::string message;
+};
+
+/**
+ * @brief Outcome of validating one instance
+ */
+struct SchemaValidationResult {
+    std::vector<SchemaValidationError> errors;
+
+    bool valid() const { return errors.empty(); }
+    explicit operator bool() const { return valid(); }
+
+    // "/items/0/name: expected string; : missing required property \"id\""
+    std::string toString() const;
+};
+
+/**
+ * @brief JSON Schema precompiled into a flat node table for repeated validation
+ *
+ * Compilation resolves types into bitmasks, indexes properties and required keys,
+ * builds hash sets for `enum` and compiles `pattern` regexes once. Validation is then
+ * a single pass over the instance, and error paths are only materialized on failure.
+ *
+ * Supported keywords: type, enum, const, properties, required, additionalProperties,
+ * patternProperties, minProperties, maxProperties, items, minItems, maxItems,
+ * uniqueItems, minLength, maxLength, pattern, minimum, maximum, exclusiveMinimum,
+ * exclusiveMaximum, multipleOf, anyOf, oneOf, allOf, not, if/then/else and local
+ * `$ref` ("#/..."). Annotations such as `format`, `description` and `default` are ignored.
+ *
+ * Example usage:
+ * @code
+ * auto schema = llmcpp::CompiledSchema::cached(JsonSchemaBuilder::object()
+ *     .property("name", JsonSchemaBuilder::string())
+ *     .required({"name"})
+ *     .build());
+ * auto result = schema->validate(response.result);
+ * if (!result) std::cerr << result.toString() << std::endl;
+ * @endcode
+ */
+class CompiledSchema {
+   public:
+    ~CompiledSchema();
+
+    CompiledSchema(const CompiledSchema&) = delete;
+    CompiledSchema& operator=(const CompiledSchema&) = delete;
+
+    /**
+     * @brief Compile a schema; throws std::invalid_argument on malformed schemas
+     */
+    static std::shared_ptr<const CompiledSchema> compile(const nlohmann::json& schema);
+
+    /**
+     * @brief Compile once and reuse: results are cached by a hash of the canonical schema text
+     */
+    static std::shared_ptr<const CompiledSchema> cached(const nlohmann::json& schema);
+    static std::shared_ptr<const CompiledSchema> cached(const std::string& schemaText);
+
+    static size_t cacheSize();
+    static void clearCache();
+
+    /**
+     * @brief Validate and collect up to `maxErrors` errors
+     */
+    SchemaValidationResult validate(const nlohmann::json& instance, size_t maxErrors = 32) const;
+
+    /**
+     * @brief Validate and stop at the first error
+     */
+    bool isValid(const nlohmann::json& instance) const;
+
+    uint64_t hash() const { return hash_; }
+    size_t nodeCount() const;
+
+   private:
+    struct Node;
+    struct Compiler;
+    struct Context;
+
+    CompiledSchema();
+
+    bool validateNode(uint32_t index, const nlohmann::json& value, Context& ctx) const;
+    bool validateObject(const Node& node, const nlohmann::json& value, Context& ctx) const;
+    bool validateArray(const Node& node, const nlohmann::json& value, Context& ctx) const;
+
+    std::vector<Node> nodes_;
+    uint64_t hash_ = 0;
+};
+
+/**
+ * @brief Validate `response.result` against the request schema when `config.validateOutput` is set
+ *
+ * A failed validation turns the response into an error (success = false) with the
+ * violations in `errorMessage`; `result` is left untouched for inspection.
+ */
+void validateStructuredOutput(const LLMRequestConfig& config, LLMResponse& response);
+
+}  // namespace llmcpp
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "core/LLMTypes.h"
+#include "core/Tokenizer.h"
+
+namespace llmcpp {
+
+/**
+ * @brief Fits LLMRequest::context into a model's context window before the request is sent
+ *
+ * The budget is the model's context window minus the tokens reserved for the reply. When a
+ * request is over budget the oldest context messages are evicted first; the newest message
+ * is kept and, if it alone is too large, cut down to its tail. Prompt, schema and tools are
+ * never touched: a request whose fixed part does not fit is reported with `fits == false`
+ * so the client can fail without uploading it.
+ *
+ * Token counting is pluggable. The default estimate (4 bytes per token) needs no vocabulary;
+ * pass a BpeTokenizer for exact counts.
+ *
+ * Configure the manager before attaching it to a client; fit() is const and thread-safe.
+ *
+ * Example usage:
+ * @code
+ * auto manager = std::make_shared<llmcpp::ContextWindowManager>(tokenizer);
+ * manager->setSummarizer([](const LLMContext& evicted, size_t maxTokens) {
+ *     return LLMContext{{{"role", "user"}, {"content", summarize(evicted, maxTokens)}}};
+ * });
+ * client.setContextWindowManager(manager);
+ * @endcode
+ */
+class ContextWindowManager {
+   public:
+    struct ModelLimits {
+        size_t contextWindow = 0;    // Input plus output tokens
+        size_t maxOutputTokens = 0;  // Largest reply the model can produce
+    };
+
+    /**
+     * @brief Replacement for evicted messages, oldest first
+     *
+     * Receives the evicted messages in order and the tokens available for the replacement;
+     * returns the messages to put at the front of the context (typically one summary turn)
+     * or an empty context to drop them.
+     */
+    using Summarizer = std::function<LLMContext(const LLMContext& evicted, size_t maxTokens)>;
+
+    struct FitResult {
+        std::optional<size_t> budget;  // Unset when the model's window is unknown: no check
+        size_t tokensBefore = 0;
+        size_t tokensAfter = 0;
+        size_t evictedMessages = 0;
+        bool truncated = false;   // The newest message was cut to its tail
+        bool summarized = false;  // Evicted messages were replaced by the summarizer's output
+        bool fits = true;
+
+        bool changed() const { return evictedMessages > 0 || truncated; }
+    };
+
+    explicit ContextWindowManager(TextTokenCounter countText = estimateTokens);
+    explicit ContextWindowManager(std::shared_ptr<const BpeTokenizer> tokenizer);
+
+    // About 4 bytes per token, rounded up; close for English prose and JSON
+    static size_t estimateTokens(std::string_view text);
+
+    // Limits of a model in the catalog (core/ModelCatalog.h), including dated snapshots
+    static std::optional<ModelLimits> modelLimits(std::string_view model);
+
+    // Use `tokens` as the window instead of the model table (0 restores the table)
+    void setContextWindow(size_t tokens) { contextWindow_ = tokens; }
+
+    // Reply reservation when the request sets no maxTokens; capped at the model's max output
+    void setReservedOutputTokens(size_t tokens) { reservedOutputTokens_ = tokens; }
+
+    // Summarize evicted messages; eviction keeps at least `reserveTokens` free for the summary
+    void setSummarizer(Summarizer summarizer, size_t reserveTokens = 512);
+
+    // Tokens available for the request's input; nullopt when the model's window is unknown
+    std::optional<size_t> budgetFor(const LLMRequest& request, std::string_view model = {}) const;
+
+    size_t countTokens(const LLMRequest& request) const;
+
+    /**
+     * @brief Evict, truncate or summarize `request.context` in place until it fits
+     * @param model Model the request will be sent to; defaults to request.config.model
+     */
+    FitResult fit(LLMRequest& request, std::string_view model = {}) const;
+
+    /**
+     * @brief Fitted copy of `request`, or nullopt when it already fits as is
+     *
+     * Counts without copying in the common case where the request is under budget.
+     * @param result Receives the outcome when non-null
+     * @throws std::length_error if the request cannot be made to fit
+     */
+    std::optional<LLMRequest> fitted(const LLMRequest& request, std::string_view model = {},
+                                     FitResult* result = nullptr) const;
+
+   private:
+    bool truncateToTail(json& message, size_t maxTokens) const;
+
+    TextTokenCounter countText_;
+    size_t contextWindow_ = 0;
+    size_t reservedOutputTokens_ = 4096;
+    Summarizer summarizer_;
+    size_t summaryReserveTokens_ = 0;
+};
+
+}  // namespace llmcpp
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/LLMTypes.h"
+#include "core/ModelCatalog.h"
+#include "core/Tokenizer.h"
+
+namespace llmcpp {
+
+/**
+ * @brief A request's estimated cost, held against its tenant's budget while it is in flight
+ *
+ * Returned by CostMeter::admit() for budgeted tenants. The hold is released on destruction,
+ * so a request that fails or is cancelled gives its estimate back; after a response, record
+ * the actual cost first and then release(). Move-only; must not outlive its CostMeter.
+ */
+class BudgetReservation {
+   public:
+    BudgetReservation() = default;
+    BudgetReservation(BudgetReservation&& other) noexcept;
+    BudgetReservation& operator=(BudgetReservation&& other) noexcept;
+    ~BudgetReservation() { release(); }
+
+    void release();
+
+    double usd() const;
+
+   private:
+    friend class CostMeter;
+    BudgetReservation(std::atomic<uint64_t>* pending, uint64_t nanos)
+        : pending_(pending), nanos_(nanos) {}
+
+    std::atomic<uint64_t>* pending_ = nullptr;
+    uint64_t nanos_ = 0;
+};
+
+/**
+ * @brief Prices LLMUsage and enforces per-tenant spend budgets before requests are sent
+ *
+ * record() converts a response's usage into USD with the model catalog's list prices (or
+ * overrides from setPrice) and adds it to lock-free counters keyed by tenant, tag and model.
+ * Each series is sharded across cache lines so concurrent clients do not contend on one
+ * counter; totals are summed when read.
+ *
+ * admit() estimates a request's cost from its token count before it is sent and checks it
+ * against the tenant's budget: hard budgets reject the request, soft budgets switch it to a
+ * cheaper model. Admitted estimates are reserved until the request settles, so concurrent
+ * requests cannot overrun a hard budget between them. Spend accumulates until reset(), so
+ * call reset() at each billing period.
+ *
+ * Configure prices and budgets before sharing the meter; record() and admit() are thread-safe.
+ *
+ * Example usage:
+ * @code
+ * auto meter = std::make_shared<llmcpp::CostMeter>();
+ * meter->setBudget("acme", {25.0, llmcpp::CostMeter::BudgetMode::Soft, "gpt-4.1-mini"});
+ * client.setCostMeter(meter);
+ *
+ * config.tenant = "acme";
+ * config.costTag = "search";
+ * @endcode
+ */
+class CostMeter {
+   public:
+    struct Totals {
+        uint64_t requests = 0;
+        uint64_t inputTokens = 0;  // Including cached and cache-write tokens
+        uint64_t cachedInputTokens = 0;
+        uint64_t cacheCreationInputTokens = 0;
+        uint64_t outputTokens = 0;  // Including reasoning tokens
+        uint64_t reasoningTokens = 0;
+        double costUsd = 0.0;
+    };
+
+    struct Series {
+        std::string tenant;
+        std::string tag;
+        std::string model;
+        Totals totals;
+    };
+
+    enum class BudgetMode {
+        Hard,  // Reject requests that would exceed the limit
+        Soft,  // Send them to downgradeModel instead (or let them through when it is empty)
+    };
+
+    struct Budget {
+        double limitUsd = 0.0;
+        BudgetMode mode = BudgetMode::Hard;
+        std::string downgradeModel;
+    };
+
+    enum class Decision { Allow, Downgrade, Reject };
+
+    struct Admission {
+        Decision decision = Decision::Allow;
+        std::string model;  // Model to send the request to
+        double estimatedCostUsd = 0.0;
+        double spentUsd = 0.0;
+        double pendingUsd = 0.0;         // Reserved by other requests still in flight
+        std::optional<double> limitUsd;  // Unset when the tenant has no budget
+        BudgetReservation reservation;   // Holds estimatedCostUsd unless rejected
+    };
+
+    /**
+     * @param countText Token counter for estimates; defaults to 4 bytes per token
+     * @param maxSeries Distinct tenant/tag/model series tracked; usage beyond that is
+     *                  aggregated into one overflow series. Spend of tenants with a
+     *                  budget is always counted on its own, so their budgets still hold.
+     */
+    explicit CostMeter(TextTokenCounter countText = {}, size_t maxSeries = 1024);
+    ~CostMeter();
+
+    CostMeter(const CostMeter&) = delete;
+    CostMeter& operator=(const CostMeter&) = delete;
+
+    // USD for `usage` at `pricing`; reasoning tokens are part of outputTokens
+    static double cost(const LLMUsage& usage, const ModelPricing& pricing);
+
+    // USD for `usage` on `model`, or nullopt when the model has no price
+    std::optional<double> cost(const LLMUsage& usage, std::string_view model) const;
+
+    // Negotiated or custom-model prices; take precedence over the catalog
+    void setPrice(std::string model, const ModelPricing& pricing);
+
+    void setBudget(std::string tenant, Budget budget);
+
+    // Reply length assumed by estimates when the request sets no maxTokens
+    void setExpectedOutputTokens(size_t tokens) { expectedOutputTokens_ = tokens; }
+
+    /**
+     * @brief Add one response's usage; returns its cost in USD (0 for unpriced models)
+     *
+     * Lock-free: relaxed atomic adds on the calling thread's shard of the series.
+     */
+    double record(const LLMUsage& usage, std::string_view model, std::string_view tenant = {},
+                  std::string_view tag = {});
+
+    /**
+     * @brief Budget decision for `request` before it is sent
+     *
+     * Tenant and tag come from request.config.tenant and costTag. Unless the request is
+     * rejected, its estimate stays reserved until `Admission::reservation` is released.
+     * @param model Model the request will be sent to; defaults to request.config.model
+     */
+    Admission admit(const LLMRequest& request, std::string_view model = {}) const;
+
+    // Estimated USD for sending `request` to `model` (0 for unpriced models)
+    double estimate(const LLMRequest& request, std::string_view model) const;
+
+    Totals tenantTotals(std::string_view tenant) const;
+    Totals totals() const;
+
+    // Every series with its totals; the overflow series has tenant, tag and model "*"
+    std::vector<Series> snapshot() const;
+
+    // Zero all counters, e.g. at the start of a billing period; reservations stay held
+    void reset();
+
+   private:
+    struct Entry;
+    class Table;
+
+    // Budgeted tenants get their own counters so the series limit never hides their spend
+    struct BudgetState {
+        Budget budget;
+        std::unique_ptr<Entry> spend;
+        mutable std::atomic<uint64_t> pendingNanos{0};  // Estimates of admitted requests
+    };
+
+    const ModelPricing* pricing(std::string_view model) const;
+    Entry* budgetedSpend(std::string_view tenant) const;
+
+    TextTokenCounter countText_;
+    std::unique_ptr<Table> series_;
+    std::unique_ptr<Table> tenants_;
+    std::unordered_map<std::string, ModelPricing> prices_;
+    std::unordered_map<std::string, BudgetState> budgets_;
+    size_t expectedOutputTokens_ = 1024;
+};
+
+}  // namespace llmcpp
@@ -6,6 +6,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "core/SchemaInterner.h"
+
 using json = nlohmann::json;
 
 /**
@@ -52,12 +54,15 @@ class JsonSchemaBuilder {
     JsonSchemaBuilder& maxItems(int max);
     JsonSchemaBuilder& uniqueItems(bool unique = true);
     JsonSchemaBuilder& items(const JsonSchemaBuilder& itemSchema);
+    JsonSchemaBuilder& items(JsonSchemaBuilder&& itemSchema);
 
     // Object constraints
     JsonSchemaBuilder& property(const std::string& name, const JsonSchemaBuilder& propSchema);
+    JsonSchemaBuilder& property(const std::string& name, JsonSchemaBuilder&& propSchema);
     JsonSchemaBuilder& required(const std::vector<std::string>& requiredProps);
     JsonSchemaBuilder& additionalProperties(bool allowed);
     JsonSchemaBuilder& additionalProperties(const JsonSchemaBuilder& schema);
+    JsonSchemaBuilder& additionalProperties(JsonSchemaBuilder&& schema);
     JsonSchemaBuilder& minProperties(int min);
     JsonSchemaBuilder& maxProperties(int max);
 
@@ -83,8 +88,12 @@ class JsonSchemaBuilder {
     JsonSchemaBuilder& examples(const std::vector<json>& examples);
     JsonSchemaBuilder& constValue(const json& value);
 
-    // Build the final schema
-    json build() const;
+    // Build the final schema; temporaries hand over their tree instead of copying it
+    json build() const&;
+    json build() &&;
+
+    // Build and intern: identical schemas share one immutable, pre-serialized copy
+    llmcpp::SchemaRef intern() const;
 
     // Utility methods
     static JsonSchemaBuilder object();
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace llmcpp {
+
+/**
+ * @brief Bulk JSON structure scanner for salvaging JSON from free-form model output
+ *
+ * Classifies 64-byte blocks at a time in the style of simdjson's stage 1: quote, backslash
+ * and bracket bitmasks come from vector compares, escaped characters from the odd-length
+ * backslash run trick, and string interiors from a prefix XOR over unescaped quotes. Only
+ * the surviving bracket bits are visited one at a time.
+ *
+ * Results match a character-by-character scan that tracks string and escape state. Blocks
+ * where that state cannot be derived in bulk (a backslash outside any string) are rescanned
+ * one character at a time, which is also how Isa::Scalar scans every block.
+ */
+class JsonStructuralScanner {
+   public:
+    enum class Isa { Scalar, SSE2, AVX2 };
+
+    struct Range {
+        size_t begin;
+        size_t end;  // One past the closing brace
+
+        bool operator==(const Range& other) const {
+            return begin == other.begin && end == other.end;
+        }
+    };
+
+    // Widest classifier supported by this CPU
+    static Isa bestIsa();
+    static const char* isaName(Isa isa);
+
+    /**
+     * @brief Index one past the bracket that closes text[start] ('[' or '{')
+     * @return std::string_view::npos if the text ends first
+     */
+    static size_t matchingBracketEnd(std::string_view text, size_t start, Isa isa = bestIsa());
+
+    /**
+     * @brief Outermost balanced {...} objects in `text`, in order
+     *
+     * Quotes between objects are prose and do not start strings. An unclosed brace keeps
+     * the balanced objects nested in it, so a truncated array yields its complete elements.
+     */
+    static std::vector<Range> balancedObjects(std::string_view text, Isa isa = bestIsa());
+};
+
+}  // namespace llmcpp
@@ -1,9 +1,18 @@
 #pragma once
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "LLMTypes.h"
 
+namespace llmcpp {
+class BudgetReservation;
+class ContextWindowManager;
+class CostMeter;
+class Span;
+}  // namespace llmcpp
+
 /**
  * Abstract base class for any LLM client (OpenAI, Anthropic, local models, etc)
  */
@@ -40,4 +49,51 @@ class LLMClient {
      * Get the client name/type
      */
     virtual std::string getClientName() const = 0;
+
+    /**
+     * Fit each request's context to the model's window before it is converted and sent.
+     * Set before the client is shared between threads; nullptr (the default) disables it.
+     */
+    void setContextWindowManager(std::shared_ptr<const llmcpp::ContextWindowManager> manager) {
+        hooks_.contextWindow = std::move(manager);
+    }
+    const std::shared_ptr<const llmcpp::ContextWindowManager>& getContextWindowManager() const {
+        return hooks_.contextWindow;
+    }
+
+    /**
+     * Price each response's usage and check the tenant's budget before each request is sent.
+     * Set before the client is shared between threads; nullptr (the default) disables it.
+     */
+    void setCostMeter(std::shared_ptr<llmcpp::CostMeter> meter) {
+        hooks_.costMeter = std::move(meter);
+    }
+    const std::shared_ptr<llmcpp::CostMeter>& getCostMeter() const { return hooks_.costMeter; }
+
+   protected:
+    /**
+     * Per-request steps shared by every provider; cheap to copy into worker threads
+     */
+    struct RequestHooks {
+        std::shared_ptr<const llmcpp::ContextWindowManager> contextWindow;
+        std::shared_ptr<llmcpp::CostMeter> costMeter;
+
+        /**
+         * Budget admission, then context fitting, for a request about to be sent to `model`.
+         * Returns the adjusted request, or nullopt to send `request` unchanged. The admitted
+         * estimate is held in `reservation` until recordCost(), or until it is destroyed if
+         * the request fails first.
+         * @throws std::runtime_error if the budget rejects the request
+         * @throws std::length_error if the request cannot fit the model's window
+         */
+        std::optional<LLMRequest> prepare(const LLMRequest& request, const std::string& model,
+                                          llmcpp::Span& span,
+                                          llmcpp::BudgetReservation& reservation) const;
+
+        // Charge `usage` for `sent` to the cost meter, if one is set, and settle `reservation`
+        void recordCost(const LLMRequest& sent, const std::string& model, const LLMUsage& usage,
+                        llmcpp::Span& span, llmcpp::BudgetReservation& reservation) const;
+    };
+
+    RequestHooks hooks_;
 };
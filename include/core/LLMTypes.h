@@ -7,6 +7,10 @@
 #include <variant>
 #include <vector>
 
+#include "core/CancellationToken.h"
+#include "core/SchemaInterner.h"
+#include "core/Tracing.h"
+
 using json = nlohmann::json;
 
 // Context type using standard C++ vectors of generic objects
@@ -14,14 +18,23 @@ using LLMContext = std::vector<json>;
 
 // Core LLM types (provider-agnostic)
 struct LLMUsage {
-    int inputTokens = 0;
+    int inputTokens = 0;   // All prompt tokens, including the cached ones below
     int outputTokens = 0;
+    int cachedInputTokens = 0;         // Prompt tokens read from the provider's prefix cache
+    int cacheCreationInputTokens = 0;  // Prompt tokens written to the cache (Anthropic)
+    int reasoningTokens = 0;           // Output tokens spent on reasoning, part of outputTokens
 
     int totalTokens() const { return inputTokens + outputTokens; }
 
+    // Share of the prompt served from the prefix cache, 0 when nothing was sent
+    double cacheHitRate() const {
+        return inputTokens > 0 ? static_cast<double>(cachedInputTokens) / inputTokens : 0.0;
+    }
+
     std::string toString() const {
         return "LLMUsage { inputTokens: " + std::to_string(inputTokens) +
                ", outputTokens: " + std::to_string(outputTokens) +
+               ", cachedInputTokens: " + std::to_string(cachedInputTokens) +
                ", totalTokens: " + std::to_string(totalTokens()) + " }";
     }
 };
@@ -52,6 +65,8 @@ struct LLMRequestConfig {
     // Schema configuration (for structured outputs)
     std::string jsonSchema;            // String representation of schema
     std::optional<json> schemaObject;  // Structured schema as JSON
+    llmcpp::SchemaRef internedSchema;  // Shared pre-serialized schema (takes precedence)
+    bool validateOutput = false;       // Validate structured results against the schema
 
     // Generation parameters (optional, provider-specific support)
     std::optional<float> temperature;                       // Sampling temperature
@@ -60,14 +75,24 @@ struct LLMRequestConfig {
     std::optional<int> topK;                                // Top-k sampling parameter
     std::optional<std::vector<std::string>> stopSequences;  // Stop sequences
 
+    // Cost accounting (see llmcpp::CostMeter)
+    std::string tenant;   // Budget and spend series the request is charged to
+    std::string costTag;  // Free-form breakdown within the tenant (feature, endpoint, ...)
+
     // Provider-specific extensions (type-erased)
     // Providers can store any additional config here (tools, system prompts, etc.)
     json extensions = json::object();
 
     std::string getModelString() const { return model; }
 
+    bool hasSchema() const {
+        return internedSchema || schemaObject.has_value() || !jsonSchema.empty();
+    }
+
     std::string toString() const {
-        std::string schemaStr = schemaObject.has_value() ? schemaObject->dump() : jsonSchema;
+        std::string schemaStr = internedSchema           ? internedSchema->canonical()
+                                : schemaObject.has_value() ? schemaObject->dump()
+                                                           : jsonSchema;
         std::string tempStr = temperature.has_value() ? std::to_string(*temperature) : "not set";
         std::string extensionsStr = extensions.empty() ? "none" : extensions.dump();
         return "LLMRequestConfig { client: " + client + ", model: " + getModelString() +
@@ -101,6 +126,8 @@ struct LLMRequest {
     std::string prompt;  // The main task/prompt (what to do) - maps to instructions
     LLMContext context;  // Context data (vector of generic objects) - maps to inputValues
     std::string previousResponseId;  // For conversation continuity
+    std::optional<llmcpp::TraceContext> traceContext;  // Inbound W3C trace context (optional)
+    llmcpp::CancellationToken cancellation;  // Aborts the request when stop is requested
 
     // Utility methods
     std::string instructions() const { return prompt; }  // For OpenAI mapping
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+
+/**
+ * Compile-time minimum log level (0 = trace ... 4 = error, 5 = off).
+ * Statements below this level compile to nothing, arguments included.
+ * Set via the LLMCPP_LOG_MIN_LEVEL CMake cache variable.
+ */
+#ifndef LLMCPP_LOG_MIN_LEVEL
+#define LLMCPP_LOG_MIN_LEVEL 0
+#endif
+
+namespace llmcpp {
+
+enum class LogLevel { Trace = 0, Debug = 1, Info = 2, Warn = 3, Error = 4, Off = 5 };
+
+std::string toString(LogLevel level);
+
+/**
+ * @brief A single structured log event
+ */
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    uint64_t timestampUnixNano = 0;
+    std::string component;
+    std::string message;
+    nlohmann::json fields;  // Optional structured key/value pairs (null when absent)
+
+    // One JSON object per record, suitable for log shippers
+    nlohmann::json toJson() const;
+};
+
+/**
+ * @brief Destination for formatted log records
+ *
+ * Sinks are only ever called from the logger's background thread, so they
+ * don't need to be thread-safe themselves.
+ */
+class LogSink {
+   public:
+    virtual ~LogSink() = default;
+    virtual void write(const LogRecord& record) = 0;
+    virtual void flush() {}
+};
+
+/**
+ * @brief Writes human-readable lines to stderr
+ */
+class StderrLogSink : public LogSink {
+   public:
+    void write(const LogRecord& record) override;
+    void flush() override;
+};
+
+/**
+ * @brief Writes one JSON object per line to stderr
+ */
+class JsonStderrLogSink : public LogSink {
+   public:
+    void write(const LogRecord& record) override;
+    void flush() override;
+};
+
+/**
+ * @brief Asynchronous leveled logger
+ *
+ * Producers push records into a bounded lock-free ring buffer and return
+ * immediately; a background thread drains it into the sink. When the buffer
+ * is full new records are dropped (and counted) rather than blocking the
+ * request path.
+ *
+ * Example usage:
+ * @code
+ * llmcpp::Logger::instance().setLevel(llmcpp::LogLevel::Debug);
+ * LLMCPP_LOG_DEBUG("openai", "request sent", {{"model", "gpt-4o"}});
+ * @endcode
+ */
+class Logger {
+   public:
+    static Logger& instance();
+
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Cheap runtime check used by the logging macros before building a record
+    static bool shouldLog(LogLevel level) {
+        return static_cast<int>(level) >= runtimeLevel_.load(std::memory_order_relaxed);
+    }
+
+    void setLevel(LogLevel level);
+    LogLevel getLevel() const;
+
+    // Replace the sink (nullptr discards all records)
+    void setSink(std::shared_ptr<LogSink> sink);
+
+    void log(LogLevel level, std::string component, std::string message);
+    void log(LogLevel level, std::string component, std::string message, nlohmann::json fields);
+
+    // Block until every record enqueued before the call has reached the sink
+    void flush();
+
+    // Number of records dropped because the ring buffer was full
+    uint64_t droppedCount() const;
+
+   private:
+    Logger();
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+
+    // Records below Warn are opt-in so the library is quiet by default
+    static inline std::atomic<int> runtimeLevel_{static_cast<int>(LogLevel::Warn)};
+};
+
+}  // namespace llmcpp
+
+#define LLMCPP_LOG(level, ...)                                    \
+    do {                                                          \
+        if (::llmcpp::Logger::shouldLog(level)) {                 \
+            ::llmcpp::Logger::instance().log(level, __VA_ARGS__); \
+        }                                                         \
+    } while (0)
+
+#define LLMCPP_LOG_DISABLED(...) \
+    do {                         \
+    } while (0)
+
+#if LLMCPP_LOG_MIN_LEVEL <= 0
+#define LLMCPP_LOG_TRACE(...) LLMCPP_LOG(::llmcpp::LogLevel::Trace, __VA_ARGS__)
+#else
+#define LLMCPP_LOG_TRACE(...) LLMCPP_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LLMCPP_LOG_MIN_LEVEL <= 1
+#define LLMCPP_LOG_DEBUG(...) LLMCPP_LOG(::llmcpp::LogLevel::Debug, __VA_ARGS__)
+#else
+#define LLMCPP_LOG_DEBUG(...) LLMCPP_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LLMCPP_LOG_MIN_LEVEL <= 2
+#define LLMCPP_LOG_INFO(...) LLMCPP_LOG(::llmcpp::LogLevel::Info, __VA_ARGS__)
+#else
+#define LLMCPP_LOG_INFO(...) LLMCPP_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LLMCPP_LOG_MIN_LEVEL <= 3
+#define LLMCPP_LOG_WARN(...) LLMCPP_LOG(::llmcpp::LogLevel::Warn, __VA_ARGS__)
+#else
+#define LLMCPP_LOG_WARN(...) LLMCPP_LOG_DISABLED(__VA_ARGS__)
+#endif
+
+#if LLMCPP_LOG_MIN_LEVEL <= 4
+#define LLMCPP_LOG_ERROR(...) LLMCPP_LOG(::llmcpp::LogLevel::Error, __VA_ARGS__)
+#else
+#define LLMCPP_LOG_ERROR(...) LLMCPP_LOG_DISABLED(__VA_ARGS__)
+#endif
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace llmcpp {
+
+enum class ModelProvider : uint8_t { OpenAI, Anthropic };
+
+/**
+ * @brief Capability bits of a catalog entry
+ */
+enum class ModelFeature : uint16_t {
+    None = 0,
+    ResponsesApi = 1 << 0,        // OpenAI Responses API; preferred when available
+    ChatCompletionsApi = 1 << 1,  // OpenAI Chat Completions API
+    MessagesApi = 1 << 2,         // Anthropic Messages API
+    Reasoning = 1 << 3,           // Reasoning / extended thinking; output includes reasoning tokens
+    Sampling = 1 << 4,            // Accepts temperature and top_p
+    Tools = 1 << 5,
+    StructuredOutputs = 1 << 6,
+    Mcp = 1 << 7,         // Remote MCP servers as tools
+    Background = 1 << 8,  // Responses API background mode
+};
+
+constexpr ModelFeature operator|(ModelFeature a, ModelFeature b) {
+    return static_cast<ModelFeature>(static_cast<uint16_t>(a) | static_cast<uint16_t>(b));
+}
+
+/**
+ * @brief List prices in USD per million tokens
+ *
+ * Reasoning tokens are billed as output. A zero cached-input or cache-write price means the
+ * model has no discount or surcharge and those tokens are billed at the input price.
+ */
+struct ModelPricing {
+    double input = 0.0;
+    double cachedInput = 0.0;
+    double cacheWrite = 0.0;
+    double output = 0.0;
+};
+
+struct ModelInfo {
+    std::string_view name;
+    ModelProvider provider;
+    uint32_t contextWindow;    // Input plus output tokens; 0 when not published
+    uint32_t maxOutputTokens;  // Largest reply; 0 when not published
+    ModelPricing pricing;
+    ModelFeature features;
+
+    constexpr bool supports(ModelFeature feature) const {
+        return (static_cast<uint16_t>(features) & static_cast<uint16_t>(feature)) ==
+               static_cast<uint16_t>(feature);
+    }
+};
+
+namespace detail {
+
+using enum ModelFeature;
+using enum ModelProvider;
+
+inline constexpr ModelFeature kGpt = ResponsesApi | ChatCompletionsApi | Sampling | Tools |
+                                     StructuredOutputs | Mcp;
+inline constexpr ModelFeature kGptReasoning = ResponsesApi | ChatCompletionsApi | Reasoning |
+                                              Tools | StructuredOutputs | Mcp | Background;
+inline constexpr ModelFeature kGptLegacy = ChatCompletionsApi | Sampling | Tools;
+inline constexpr ModelFeature kClaude = MessagesApi | Sampling | Tools;
+inline constexpr ModelFeature kClaudeThinking = kClaude | Reasoning;
+
+// Base model names; dated snapshots and "-latest" aliases resolve to these (see resolveModel)
+inline constexpr ModelInfo kModels[] = {
+    // OpenAI
+    {"gpt-5", OpenAI, 400000, 128000, {1.25, 0.125, 0, 10.00}, kGptReasoning},
+    {"gpt-5-mini", OpenAI, 400000, 128000, {0.25, 0.025, 0, 2.00}, kGptReasoning},
+    {"gpt-5-nano", OpenAI, 400000, 128000, {0.05, 0.005, 0, 0.40}, kGptReasoning},
+    {"gpt-4.1", OpenAI, 1047576, 32768, {2.00, 0.50, 0, 8.00}, kGpt},
+    {"gpt-4.1-mini", OpenAI, 1047576, 32768, {0.40, 0.10, 0, 1.60}, kGpt},
+    {"gpt-4.1-nano", OpenAI, 1047576, 32768, {0.10, 0.025, 0, 0.40}, kGpt},
+    {"gpt-4o", OpenAI, 128000, 16384, {2.50, 1.25, 0, 10.00}, kGpt},
+    {"gpt-4o-mini", OpenAI, 128000, 16384, {0.15, 0.075, 0, 0.60}, kGpt},
+    {"gpt-4.5-preview", OpenAI, 128000, 16384, {75.00, 37.50, 0, 150.00},
+     ChatCompletionsApi | Sampling | Tools | StructuredOutputs},
+    {"gpt-4-turbo", OpenAI, 128000, 4096, {10.00, 0, 0, 30.00}, kGptLegacy},
+    {"gpt-4", OpenAI, 8192, 8192, {30.00, 0, 0, 60.00}, kGptLegacy},
+    {"gpt-3.5-turbo", OpenAI, 16385, 4096, {0.50, 0, 0, 1.50}, kGptLegacy},
+    {"o1", OpenAI, 200000, 100000, {15.00, 7.50, 0, 60.00}, kGptReasoning},
+    {"o1-mini", OpenAI, 128000, 65536, {1.10, 0.55, 0, 4.40},
+     ChatCompletionsApi | Reasoning | StructuredOutputs},
+    {"o1-preview", OpenAI, 128000, 32768, {15.00, 7.50, 0, 60.00},
+     ChatCompletionsApi | Reasoning | StructuredOutputs},
+    {"o1-pro", OpenAI, 200000, 100000, {150.00, 0, 0, 600.00},
+     ResponsesApi | Reasoning | Tools | StructuredOutputs | Background},
+    {"o3", OpenAI, 200000, 100000, {2.00, 0.50, 0, 8.00}, kGptReasoning},
+    {"o3-mini", OpenAI, 200000, 100000, {1.10, 0.55, 0, 4.40}, kGptReasoning},
+    {"o4-mini", OpenAI, 200000, 100000, {1.10, 0.275, 0, 4.40}, kGptReasoning},
+    {"o4-mini-deep-research", OpenAI, 200000, 100000, {2.00, 0.50, 0, 8.00},
+     ResponsesApi | Reasoning | Tools | Mcp | Background},
+    {"gpt-image-1", OpenAI, 0, 0, {5.00, 1.25, 0, 40.00}, ResponsesApi},
+    {"computer-use-preview", OpenAI, 8192, 1024, {3.00, 0, 0, 12.00},
+     ResponsesApi | Sampling | Tools},
+
+    // Anthropic: cache reads are 0.1x and cache writes 1.25x the input price
+    {"claude-opus-4-1", Anthropic, 200000, 32000, {15.00, 1.50, 18.75, 75.00}, kClaudeThinking},
+    {"claude-opus-4", Anthropic, 200000, 32000, {15.00, 1.50, 18.75, 75.00}, kClaudeThinking},
+    {"claude-sonnet-4", Anthropic, 200000, 64000, {3.00, 0.30, 3.75, 15.00}, kClaudeThinking},
+    {"claude-3-7-sonnet", Anthropic, 200000, 64000, {3.00, 0.30, 3.75, 15.00}, kClaudeThinking},
+    {"claude-3-5-sonnet", Anthropic, 200000, 8192, {3.00, 0.30, 3.75, 15.00}, kClaude},
+    {"claude-3-5-haiku", Anthropic, 200000, 8192, {0.80, 0.08, 1.00, 4.00}, kClaude},
+    {"claude-3-opus", Anthropic, 200000, 4096, {15.00, 1.50, 18.75, 75.00}, kClaude},
+    {"claude-3-haiku", Anthropic, 200000, 4096, {0.25, 0.03, 0.30, 1.25}, kClaude},
+};
+
+inline constexpr size_t kModelSlots = std::bit_ceil(std::size(kModels) * 4);
+inline constexpr uint8_t kEmptySlot = 0xFF;
+static_assert(std::size(kModels) < kEmptySlot);
+
+constexpr uint64_t modelNameHash(std::string_view name, uint64_t seed) {
+    uint64_t hash = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return hash ^ (hash >> 32);
+}
+
+struct ModelIndex {
+    uint64_t seed = 0;
+    std::array<uint8_t, kModelSlots> slots{};
+};
+
+// Smallest seed under which every name gets its own slot: one probe per lookup
+consteval ModelIndex buildModelIndex() {
+    for (uint64_t seed = 0;; ++seed) {
+        ModelIndex index{seed, {}};
+        index.slots.fill(kEmptySlot);
+        bool collision = false;
+        for (size_t i = 0; i < std::size(kModels) && !collision; ++i) {
+            auto& slot = index.slots[modelNameHash(kModels[i].name, seed) & (kModelSlots - 1)];
+            collision = slot != kEmptySlot;
+            slot = static_cast<uint8_t>(i);
+        }
+        if (!collision) {
+            return index;
+        }
+    }
+}
+
+inline constexpr ModelIndex kModelIndex = buildModelIndex();
+
+constexpr bool isDigits(std::string_view text) {
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+    return !text.empty();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Catalog entry for an exact base model name, or nullptr
+ *
+ * Perfect-hash lookup: one hash and at most one string compare.
+ */
+constexpr const ModelInfo* findModel(std::string_view name) {
+    const auto& index = detail::kModelIndex;
+    const uint8_t slot =
+        index.slots[detail::modelNameHash(name, index.seed) & (detail::kModelSlots - 1)];
+    if (slot == detail::kEmptySlot || detail::kModels[slot].name != name) {
+        return nullptr;
+    }
+    return &detail::kModels[slot];
+}
+
+/**
+ * @brief Catalog entry for a model name as sent to the API, or nullptr
+ *
+ * Accepts base names and their dated snapshots or aliases: "gpt-4o-2024-08-06",
+ * "claude-sonnet-4-20250514" and "claude-3-5-haiku-latest" resolve to their base entries.
+ */
+constexpr const ModelInfo* resolveModel(std::string_view name) {
+    if (const auto* info = findModel(name)) {
+        return info;
+    }
+    constexpr std::string_view latest = "-latest";
+    if (name.ends_with(latest)) {
+        return findModel(name.substr(0, name.size() - latest.size()));
+    }
+    // -YYYYMMDD (Anthropic) or -YYYY-MM-DD (OpenAI)
+    if (name.size() > 9 && name[name.size() - 9] == '-' &&
+        detail::isDigits(name.substr(name.size() - 8))) {
+        return findModel(name.substr(0, name.size() - 9));
+    }
+    if (name.size() > 11 && name[name.size() - 11] == '-' && name[name.size() - 6] == '-' &&
+        name[name.size() - 3] == '-' && detail::isDigits(name.substr(name.size() - 10, 4)) &&
+        detail::isDigits(name.substr(name.size() - 5, 2)) &&
+        detail::isDigits(name.substr(name.size() - 2))) {
+        return findModel(name.substr(0, name.size() - 11));
+    }
+    return nullptr;
+}
+
+// True when `name` resolves to a catalog entry with every bit of `feature`
+constexpr bool modelSupports(std::string_view name, ModelFeature feature) {
+    const auto* info = resolveModel(name);
+    return info && info->supports(feature);
+}
+
+// Every catalog entry, in table order
+constexpr std::span<const ModelInfo> modelCatalog() { return detail::kModels; }
+
+// Base names of `provider`'s models with `feature` (all of them for ModelFeature::None)
+std::vector<std::string> modelNames(ModelProvider provider,
+                                    ModelFeature feature = ModelFeature::None);
+
+}  // namespace llmcpp
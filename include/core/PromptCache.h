@@ -0,0 +1,39 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "core/SchemaInterner.h"
+
+namespace llmcpp {
+
+/**
+ * @brief Shortest decimal that round-trips `value`, widened to double
+ *
+ * Widening a float directly keeps its binary error, so 0.7f would be sent as
+ * 0.699999988079071. Request builders store sampling parameters through this instead,
+ * and the body carries the value the caller wrote.
+ */
+double canonicalFloat(float value);
+
+/**
+ * @brief Canonical bytes of the static leading part of a request
+ *
+ * Provider prompt caches only match an exact prefix. The parts that do not change between
+ * calls (tools, instructions, output schema) are serialized in the order the provider
+ * renders them, with sorted keys, no whitespace and canonical numbers. Requests with equal
+ * hashes can share a cache entry, so the hash is a useful grouping key when comparing
+ * `LLMUsage::cachedInputTokens` across calls.
+ */
+struct PromptPrefix {
+    std::string bytes;
+    SchemaHash128 hash;
+
+    bool operator==(const PromptPrefix& other) const { return hash == other.hash; }
+    bool operator!=(const PromptPrefix& other) const { return !(*this == other); }
+
+    // `parts` is a JSON array holding the prefix parts in render order
+    static PromptPrefix of(const nlohmann::json& parts);
+};
+
+}  // namespace llmcpp
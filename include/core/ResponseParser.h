@@ -73,10 +73,16 @@ class ResponseParser {
      */
     static std::vector<ParsedResult> parseMarkdownFencedJson(const std::string& text);
 
+    /**
+     * @brief Parse <function_calls><invoke name="..."><parameter name="..."> blocks
+     * @param xmlText Text containing one or more function_calls blocks
+     * @return One result per invoke element that has parameters
+     */
+    static std::vector<ParsedResult> parseXmlFunctionCalls(const std::string& xmlText);
+
    private:
     // Helper methods for XML parsing
     static std::string extractXmlContent(const std::string& text);
-    static std::vector<ParsedResult> parseXmlFunctionCalls(const std::string& xmlText);
     static std::vector<ParsedResult> parseDirectFunctionTags(const std::string& text,
                                                              const std::string& functionName);
     static std::string extractParameterValue(const std::string& xmlText,
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+
+namespace llmcpp {
+
+/**
+ * @brief 128-bit content hash of a canonical schema
+ */
+struct SchemaHash128 {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const SchemaHash128& other) const {
+        return low == other.low && high == other.high;
+    }
+    bool operator!=(const SchemaHash128& other) const { return !(*this == other); }
+
+    std::string toHex() const;
+
+    struct Hasher {
+        size_t operator()(const SchemaHash128& h) const { return static_cast<size_t>(h.low); }
+    };
+
+    // MurmurHash3 x64_128 of `bytes`
+    static SchemaHash128 of(std::string_view bytes);
+};
+
+/**
+ * @brief Immutable schema shared by every request that uses it
+ *
+ * Holds the schema value, its canonical serialization (sorted keys, no whitespace)
+ * and the hash of that serialization. Request builders reference it instead of
+ * copying the schema, and serializers splice `canonical()` into the request body.
+ */
+class InternedSchema {
+   public:
+    const nlohmann::json& value() const { return value_; }
+    const std::string& canonical() const { return canonical_; }
+    const SchemaHash128& hash() const { return hash_; }
+
+   private:
+    friend class SchemaInterner;
+    InternedSchema(nlohmann::json value, std::string canonical, SchemaHash128 hash)
+        : value_(std::move(value)), canonical_(std::move(canonical)), hash_(hash) {}
+
+    nlohmann::json value_;
+    std::string canonical_;
+    SchemaHash128 hash_;
+};
+
+using SchemaRef = std::shared_ptr<const InternedSchema>;
+
+/**
+ * @brief Process-wide interning table for schemas
+ *
+ * Identical schemas (after canonicalization) resolve to the same InternedSchema.
+ * Entries are held weakly: a schema is dropped once no request or config refers to it.
+ *
+ * Example usage:
+ * @code
+ * static const auto schema = llmcpp::SchemaInterner::intern(builder.build());
+ * config.internedSchema = schema;  // No per-request copy or re-serialization
+ * @endcode
+ */
+class SchemaInterner {
+   public:
+    static SchemaRef intern(const nlohmann::json& schema);
+    static SchemaRef intern(nlohmann::json&& schema);
+
+    // Parse and intern schema text; throws nlohmann::json::parse_error on invalid JSON
+    static SchemaRef internText(std::string_view schemaText);
+
+    // Number of live interned schemas
+    static size_t size();
+
+   private:
+    static SchemaRef internCanonical(nlohmann::json&& schema, std::string&& canonical);
+};
+
+}  // namespace llmcpp
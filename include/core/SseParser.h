@@ -0,0 +1,41 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace llmcpp {
+
+/**
+ * @brief Incremental parser for text/event-stream bodies
+ *
+ * Accepts the body in arbitrary chunks and emits one Event per blank-line-terminated
+ * frame. Multiple data: lines are joined with '\n', comments (": ...") and unknown
+ * fields are ignored, and CRLF line endings are accepted.
+ */
+class SseParser {
+   public:
+    struct Event {
+        std::string event;  // "event:" field; empty when the frame has none
+        std::string data;
+    };
+    using EventCallback = std::function<void(const Event&)>;
+
+    explicit SseParser(EventCallback onEvent);
+
+    void feed(std::string_view chunk);
+
+    // Emit a trailing frame that ended without a blank line
+    void finish();
+
+   private:
+    void processLine(std::string_view line);
+    void dispatch();
+
+    EventCallback onEvent_;
+    std::string line_;  // Partial line carried across chunks
+    Event current_;
+    bool hasData_ = false;
+};
+
+}  // namespace llmcpp
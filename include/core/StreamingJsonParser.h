@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/LLMTypes.h"
+
+namespace llmcpp {
+
+/**
+ * @brief A completed element of the streamed container
+ */
+struct StreamedValue {
+    std::string key;   // Field name when the container is an object
+    size_t index = 0;  // Position in the container (array index or field ordinal)
+    nlohmann::json value;
+};
+
+/**
+ * @brief Incremental parser that emits the elements of a JSON container as they complete
+ *
+ * Fed arbitrary chunks of a streamed structured output, it tracks string, escape and
+ * nesting state across chunk boundaries and only buffers the element in progress. Each
+ * element of the container at `containerPath` (a JSON Pointer; "" is the root) is emitted
+ * as soon as it is complete: array elements in order, or object fields with their keys.
+ * Text before the root value (prose, a ```json fence) and after it is ignored.
+ *
+ * Example usage:
+ * @code
+ * llmcpp::StreamingJsonParser parser("/items", [](llmcpp::StreamedValue item) {
+ *     startWork(std::move(item.value));  // Runs while the rest of the list streams in
+ * });
+ * client.sendStreamingRequest(request, onDone, parser.streamCallback());
+ * @endcode
+ */
+class StreamingJsonParser {
+   public:
+    using ValueCallback = std::function<void(StreamedValue)>;
+
+    explicit StreamingJsonParser(ValueCallback onValue);
+    StreamingJsonParser(std::string_view containerPath, ValueCallback onValue);
+
+    // Consume the next chunk; a no-op once the root value has closed or an error occurred
+    void feed(std::string_view chunk);
+
+    // LLMStreamCallback that feeds this parser; the parser must outlive the stream
+    LLMStreamCallback streamCallback();
+
+    // Forget all state so the parser can be reused for another stream
+    void reset();
+
+    bool complete() const { return done_; }  // Root value closed
+    bool failed() const { return !error_.empty(); }
+    const std::string& error() const { return error_; }
+    size_t emitted() const { return emitted_; }
+
+   private:
+    struct Frame {
+        bool isObject = false;
+        bool expectKey = false;  // Objects: next string is a member name
+        size_t index = 0;        // Elements (arrays) or members (objects) seen so far
+        std::string key;         // Objects: current member name
+    };
+
+    void consume(char c);
+    void beginElement();
+    void emitElement();
+    bool framesMatchPath() const;
+    void fail(std::string message);
+
+    std::vector<std::string> path_;
+    ValueCallback onValue_;
+
+    std::vector<Frame> frames_;
+    size_t targetDepth_ = 0;  // frames_.size() inside the target container; 0 if not open
+    bool inString_ = false;
+    bool escape_ = false;
+    bool readingKey_ = false;
+    bool capturing_ = false;
+    bool done_ = false;
+    std::string key_;      // Raw member name being read, quotes included
+    std::string element_;  // Raw text of the element in progress
+    StreamedValue pending_;
+    size_t emitted_ = 0;
+    std::string error_;
+};
+
+}  // namespace llmcpp
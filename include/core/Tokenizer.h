@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/LLMTypes.h"
+
+namespace llmcpp {
+
+/**
+ * @brief Byte-pair rank table: token bytes -> rank (which is also the token id)
+ *
+ * Open addressing over a single byte arena, looked up by string_view so merge candidates
+ * are never copied into temporary strings.
+ */
+class BpeRanks {
+   public:
+    using Rank = uint32_t;
+    static constexpr Rank npos = UINT32_MAX;
+
+    void reserve(size_t count);
+    // Later inserts of the same bytes replace the rank
+    void insert(std::string_view bytes, Rank rank);
+    Rank find(std::string_view bytes) const;
+    size_t size() const { return size_; }
+
+   private:
+    struct Slot {
+        uint64_t hash = 0;
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        Rank rank = npos;
+    };
+
+    size_t probe(std::string_view bytes, uint64_t hash) const;
+    void grow();
+
+    std::string arena_;
+    std::vector<Slot> slots_;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Local BPE tokenizer compatible with OpenAI's cl100k_base and o200k_base
+ *
+ * Loads a tiktoken vocabulary file (one "base64(token) rank" pair per line) and counts
+ * tokens before a request is sent, for TPM budgeting, context truncation and model choice.
+ * The pretokenizer follows each encoding's split pattern with hand-written scanners instead
+ * of std::regex; merges pop the lowest-ranked adjacent pair from a heap.
+ *
+ * ASCII text is split exactly as tiktoken splits it. Outside ASCII, letters, digits and
+ * whitespace are classified from compact code point tables (Latin, Greek and Cyrillic case,
+ * common digit blocks, Unicode spaces, punctuation and symbol blocks); rare scripts may
+ * split differently, so counts there are close rather than exact. Special tokens such as
+ * <|endoftext|> are encoded as ordinary text.
+ *
+ * Example usage:
+ * @code
+ * auto tokenizer = llmcpp::BpeTokenizer::fromTiktokenFile("o200k_base.tiktoken",
+ *                                                         llmcpp::BpeTokenizer::Encoding::O200kBase);
+ * size_t n = tokenizer.countTokens(request);
+ * @endcode
+ */
+class BpeTokenizer {
+   public:
+    using Rank = BpeRanks::Rank;
+
+    enum class Encoding { Cl100kBase, O200kBase };
+
+    // Framing tokens OpenAI adds around every chat message and before the reply
+    static constexpr size_t kTokensPerMessage = 3;
+    static constexpr size_t kReplyPrimingTokens = 3;
+
+    BpeTokenizer(Encoding encoding, BpeRanks ranks);
+
+    /**
+     * @brief Load a tiktoken vocabulary
+     * @throws std::runtime_error if the file cannot be read or a line is malformed
+     */
+    static BpeTokenizer fromTiktokenFile(const std::string& path, Encoding encoding);
+    static BpeTokenizer fromTiktoken(std::istream& in, Encoding encoding);
+
+    // o200k_base for gpt-4o, gpt-4.1, gpt-5 and the o-series, cl100k_base otherwise
+    static Encoding encodingForModel(std::string_view model);
+    static const char* encodingName(Encoding encoding);
+
+    Encoding encoding() const { return encoding_; }
+    size_t vocabularySize() const { return ranks_.size(); }
+
+    // Pretokenizer pieces, in order; BPE never merges across them
+    std::vector<std::string_view> pretokenize(std::string_view text) const;
+
+    std::vector<Rank> encode(std::string_view text) const;
+    size_t countTokens(std::string_view text) const;
+
+    /**
+     * @brief Input tokens of a request: prompt, context, tools and schema
+     *
+     * The prompt and each context entry count as one chat message each (role and content
+     * plus kTokensPerMessage), followed by kReplyPrimingTokens. Context objects without a
+     * string or text-part content, tools and the schema are counted from their compact JSON,
+     * which tracks but does not equal the provider's internal rendering of them.
+     */
+    size_t countTokens(const LLMRequest& request) const;
+
+   private:
+    template <typename Emit>
+    void bytePairMerge(std::string_view piece, Emit&& emit) const;
+
+    Encoding encoding_;
+    BpeRanks ranks_;
+    std::array<Rank, 256> byteRanks_;  // Parts that never merge are single bytes
+    std::vector<Rank> pairRanks_;      // Every first merge is a two-byte lookup
+};
+
+// Tokens in a piece of text; BpeTokenizer::countTokens or an estimate
+using TextTokenCounter = std::function<size_t(std::string_view)>;
+
+// Tokens of one LLMContext entry as a chat message: framing, role and content
+size_t countMessageTokens(const nlohmann::json& entry, const TextTokenCounter& countText);
+
+// Tokens of everything in a request except its context: prompt, schema, tools, reply priming
+size_t countFixedRequestTokens(const LLMRequest& request, const TextTokenCounter& countText);
+
+}  // namespace llmcpp
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/LLMTypes.h"
+#include "core/SseParser.h"
+#include "core/ToolRunner.h"
+
+namespace llmcpp {
+
+/**
+ * @brief Assembles streamed tool-call arguments and emits each call once its block closes
+ *
+ * Providers stream a tool call as a start event (id and name), argument JSON deltas and a
+ * stop event, all tagged with the position of the call in the response. Buffers are kept
+ * per position, so interleaved calls assemble independently. Provider event mappings:
+ * OpenAI::applyResponsesStreamEvent and Anthropic::applyMessagesStreamEvent.
+ */
+class ToolCallAssembler {
+   public:
+    using CallCallback = std::function<void(ToolCall)>;
+
+    explicit ToolCallAssembler(CallCallback onCall);
+
+    void begin(size_t index, std::string id, std::string name);
+    void append(size_t index, std::string_view delta);
+
+    /**
+     * @brief Close the call at `index` and emit it
+     *
+     * `arguments` replaces the buffered deltas when the provider repeats the full text at the
+     * end. Empty arguments become {}; text that does not parse is passed on as a string so
+     * the runner can report it. Indexes with no open call (e.g. text blocks) are ignored.
+     * @return true if a call was emitted
+     */
+    bool finish(size_t index, std::optional<std::string_view> arguments = std::nullopt);
+
+    size_t open() const { return open_.size(); }
+    size_t emitted() const { return emitted_; }
+
+   private:
+    struct Pending {
+        std::string id;
+        std::string name;
+        std::string arguments;
+    };
+
+    CallCallback onCall_;
+    std::map<size_t, Pending> open_;
+    size_t emitted_ = 0;
+};
+
+/**
+ * @brief Dispatches streamed tool calls to a ToolRunner while the response is still streaming
+ *
+ * Each call starts on its own thread as soon as its arguments are complete, so tool latency
+ * overlaps with generation of the remaining calls and text. Feed it provider events
+ * directly, or hand streamCallback() to a transport that delivers the raw SSE body.
+ *
+ * The dispatcher is wired up by hand. ToolRunner::run and the provider clients do not use it,
+ * because the clients do not pass stream events to callers. Post the streaming request
+ * yourself and pass results() to the session's submit().
+ *
+ * Example usage:
+ * @code
+ * llmcpp::StreamingToolDispatcher dispatcher(runner, OpenAI::applyResponsesStreamEvent);
+ * httpClient.postStreaming(url, body, dispatcher.streamCallback()).get();
+ * auto results = dispatcher.results();  // Waits for calls still running
+ * @endcode
+ */
+class StreamingToolDispatcher {
+   public:
+    // Applies one provider event to the assembler; returns true if it was tool-related
+    using EventHandler = std::function<bool(ToolCallAssembler&, const nlohmann::json& event)>;
+
+    // `runner` must outlive the dispatcher
+    StreamingToolDispatcher(const ToolRunner& runner, EventHandler applyEvent);
+
+    void onEvent(const nlohmann::json& event);
+
+    // LLMStreamCallback that parses an SSE body and feeds each event's data to onEvent()
+    LLMStreamCallback streamCallback();
+
+    // Calls dispatched so far
+    size_t dispatched() const;
+
+    // Wait for every dispatched call; results are in dispatch order
+    std::vector<ToolCallResult> results();
+
+   private:
+    const ToolRunner& runner_;
+    EventHandler applyEvent_;
+    ToolCallAssembler assembler_;
+    SseParser sse_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::future<ToolCallResult>> pending_;
+    std::vector<ToolCallResult> finished_;
+};
+
+}  // namespace llmcpp
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/LLMTypes.h"
+#include "core/TypedSchema.h"
+
+namespace llmcpp {
+
+/**
+ * @brief A tool as advertised to the model
+ */
+struct ToolDefinition {
+    std::string name;
+    std::string description;
+    nlohmann::json parameters;  // JSON Schema of the arguments object
+};
+
+/**
+ * @brief A tool invocation requested by the model
+ */
+struct ToolCall {
+    std::string id;  // Provider call id (OpenAI call_id, Anthropic tool_use id)
+    std::string name;
+    nlohmann::json arguments;
+};
+
+/**
+ * @brief Outcome of one tool call, in the shape providers expect back
+ */
+struct ToolCallResult {
+    std::string id;
+    std::string name;
+    nlohmann::json output;  // Handler return value, or the error message
+    bool isError = false;
+    double durationMs = 0.0;
+
+    // Output as tool-result text: strings verbatim, anything else serialized
+    std::string outputText() const {
+        return output.is_string() ? output.get<std::string>() : output.dump();
+    }
+};
+
+/**
+ * @brief One model turn as seen by the tool loop
+ */
+struct ToolTurn {
+    std::vector<ToolCall> calls;  // Empty once the model gives its final answer
+    std::string text;
+    LLMUsage usage;
+    std::string responseId;
+};
+
+/**
+ * @brief Provider side of a tool loop: sends turns and carries the conversation state
+ *
+ * Implementations translate to the provider's wire format, e.g. OpenAI::ResponsesToolSession
+ * (function_call / function_call_output) and Anthropic::MessagesToolSession
+ * (tool_use / tool_result). Both methods throw on transport or API errors.
+ */
+class ToolSession {
+   public:
+    virtual ~ToolSession() = default;
+
+    // Send the initial request with `tools` attached
+    virtual ToolTurn start(const std::vector<ToolDefinition>& tools) = 0;
+
+    // Send the results of the previous turn's calls and return the next turn
+    virtual ToolTurn submit(const std::vector<ToolCallResult>& results) = 0;
+};
+
+/**
+ * @brief Provider-neutral function-calling loop with parallel tool execution
+ *
+ * Registered callables are advertised to the model; each turn's calls run concurrently on
+ * worker threads, their results are submitted back, and the loop repeats until the model
+ * answers without calling tools, `maxSteps` turns have been taken, or the deadline passes.
+ * Handler exceptions, unknown tools and non-object arguments become error results the
+ * model can react to instead of aborting the loop.
+ *
+ * Example usage:
+ * @code
+ * struct WeatherArgs { std::string city; };
+ * LLMCPP_SCHEMA(WeatherArgs, city)
+ *
+ * llmcpp::ToolRunner runner;
+ * runner.addTool<WeatherArgs>("get_weather", "Current weather for a city",
+ *                             [](const WeatherArgs& args) { return lookupWeather(args.city); });
+ *
+ * OpenAI::ResponsesToolSession session(client, request);
+ * auto result = runner.run(session);
+ * if (result.success) std::cout << result.text;
+ * @endcode
+ */
+class ToolRunner {
+   public:
+    using Handler = std::function<nlohmann::json(const nlohmann::json& arguments)>;
+
+    struct Options {
+        int maxSteps = 10;                     // Model turns, the final answer included
+        std::chrono::milliseconds timeout{0};  // Whole loop; 0 disables the deadline
+        size_t maxParallel = 8;                // Concurrent tool calls within a turn
+    };
+
+    struct Result {
+        bool success = false;
+        std::string text;  // Final answer (or the last turn's text on failure)
+        std::string errorMessage;
+        int steps = 0;
+        std::vector<ToolCallResult> toolResults;  // Every executed call, in turn order
+        LLMUsage usage;                           // Summed over all turns
+        std::string responseId;                   // Last response
+    };
+
+    ToolRunner() = default;
+    explicit ToolRunner(Options options) : options_(options) {}
+
+    // Register a tool; throws std::invalid_argument on a duplicate name or null handler
+    ToolRunner& addTool(ToolDefinition definition, Handler handler);
+
+    // Register a tool whose arguments are an LLMCPP_SCHEMA type; the schema is derived from it
+    template <typename Args, typename Fn>
+    ToolRunner& addTool(std::string name, std::string description, Fn fn) {
+        return addTool(ToolDefinition{std::move(name), std::move(description), schemaFor<Args>()},
+                       [fn = std::move(fn)](const nlohmann::json& arguments) -> nlohmann::json {
+                           return fn(parseStructured<Args>(arguments));
+                       });
+    }
+
+    std::vector<ToolDefinition> definitions() const;
+    bool hasTool(std::string_view name) const;
+    Options& options() { return options_; }
+    const Options& options() const { return options_; }
+
+    /**
+     * @brief Run one turn's calls concurrently; results are in call order
+     *
+     * Calls still running at `deadline` are reported as timed-out errors. Their threads
+     * finish in the background and their results are discarded.
+     */
+    std::vector<ToolCallResult> execute(
+        const std::vector<ToolCall>& calls,
+        std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt) const;
+
+    // Run a single call on its own thread, e.g. as soon as a streamed call is complete
+    std::future<ToolCallResult> dispatch(const ToolCall& call) const;
+
+    // Drive `session` until a final answer, the step limit or the deadline
+    Result run(ToolSession& session) const;
+
+   private:
+    struct Tool {
+        ToolDefinition definition;
+        std::shared_ptr<const Handler> handler;  // Shared with worker threads
+    };
+
+    // Handler for `call`, or null with `result` filled in as an error
+    std::shared_ptr<const Handler> resolve(const ToolCall& call, ToolCallResult& result) const;
+
+    std::vector<Tool> tools_;
+    std::unordered_map<std::string, size_t> byName_;
+    Options options_;
+};
+
+}  // namespace llmcpp
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace llmcpp {
+
+/**
+ * @brief W3C trace context identifying a span in a distributed trace
+ *
+ * Callers pass an inbound context (e.g. parsed from an incoming `traceparent`
+ * header) on LLMRequest::traceContext so client spans join their trace.
+ */
+struct TraceContext {
+    std::string traceId;  // 32 lowercase hex characters
+    std::string spanId;   // 16 lowercase hex characters
+    bool sampled = true;
+
+    bool isValid() const;
+
+    /**
+     * @brief Parse a W3C `traceparent` header ("00-<trace-id>-<span-id>-<flags>")
+     * @return The context, or std::nullopt if the header is malformed
+     */
+    static std::optional<TraceContext> fromTraceparent(const std::string& header);
+
+    std::string toTraceparent() const;
+};
+
+/**
+ * @brief Finished span as handed to exporters
+ */
+struct SpanData {
+    enum class Kind { Internal, Client };
+    enum class StatusCode { Unset, Ok, Error };
+
+    std::string name;
+    std::string traceId;
+    std::string spanId;
+    std::string parentSpanId;
+    bool sampled = true;  // Inherited from the parent; unsampled spans are never exported
+    Kind kind = Kind::Internal;
+    uint64_t startTimeUnixNano = 0;
+    uint64_t endTimeUnixNano = 0;
+    StatusCode status = StatusCode::Unset;
+    std::string statusMessage;
+    nlohmann::json attributes = nlohmann::json::object();
+
+    double durationMs() const {
+        return static_cast<double>(endTimeUnixNano - startTimeUnixNano) / 1e6;
+    }
+};
+
+/**
+ * @brief Pluggable sink for finished spans
+ *
+ * exportSpan() is called synchronously on the thread that ends the span,
+ * so implementations must be thread-safe and cheap.
+ */
+class SpanExporter {
+   public:
+    virtual ~SpanExporter() = default;
+    virtual void exportSpan(const SpanData& span) = 0;
+    virtual void flush() {}
+};
+
+/**
+ * @brief Collects spans in memory (useful for tests and ad-hoc inspection)
+ */
+class InMemorySpanExporter : public SpanExporter {
+   public:
+    void exportSpan(const SpanData& span) override;
+
+    std::vector<SpanData> getSpans() const;
+    void clear();
+
+   private:
+    mutable std::mutex mutex_;
+    std::vector<SpanData> spans_;
+};
+
+/**
+ * @brief Writes spans as OTLP/JSON, one ExportTraceServiceRequest per line
+ *
+ * The output matches the OpenTelemetry file exporter format and can be
+ * replayed into any OTLP/HTTP JSON collector.
+ */
+class OtlpJsonFileExporter : public SpanExporter {
+   public:
+    explicit OtlpJsonFileExporter(const std::string& path,
+                                  const std::string& serviceName = "llmcpp");
+
+    void exportSpan(const SpanData& span) override;
+    void flush() override;
+
+    // Convert a span to an OTLP/JSON ExportTraceServiceRequest
+    static nlohmann::json toOtlpJson(const SpanData& span, const std::string& serviceName);
+
+   private:
+    std::mutex mutex_;
+    std::ofstream out_;
+    std::string serviceName_;
+};
+
+/**
+ * @brief Global tracer configuration
+ *
+ * Tracing is disabled until an exporter is installed; spans created while
+ * disabled are no-ops and cost a single atomic load.
+ */
+class Tracer {
+   public:
+    static void setExporter(std::shared_ptr<SpanExporter> exporter);
+    static std::shared_ptr<SpanExporter> getExporter();
+    static bool isEnabled();
+};
+
+/**
+ * @brief RAII span; becomes the current span of its thread until ended
+ *
+ * Spans created without an explicit parent are children of the thread's
+ * current span, which yields the client -> attempt -> HTTP -> parse tree
+ * without threading contexts through every call.
+ *
+ * Example usage:
+ * @code
+ * llmcpp::Span span("llm.client.request", llmcpp::SpanData::Kind::Client);
+ * span.setAttribute("llm.model", "gpt-4o");
+ * @endcode
+ */
+class Span {
+   public:
+    explicit Span(std::string name, SpanData::Kind kind = SpanData::Kind::Internal);
+    Span(std::string name, const std::optional<TraceContext>& parent,
+         SpanData::Kind kind = SpanData::Kind::Internal);
+    ~Span();
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+    Span(Span&&) = delete;
+    Span& operator=(Span&&) = delete;
+
+    bool isRecording() const { return data_ != nullptr; }
+    TraceContext context() const;
+
+    void setAttribute(const std::string& key, const nlohmann::json& value);
+    void setStatus(SpanData::StatusCode code, const std::string& message = "");
+    void recordError(const std::string& message);
+
+    // End the span and export it (idempotent; also called by the destructor)
+    void end();
+
+    // Innermost active span on the calling thread, nullptr if none
+    static Span* current();
+
+   private:
+    std::unique_ptr<SpanData> data_;
+    std::shared_ptr<SpanExporter> exporter_;
+    std::chrono::steady_clock::time_point start_;
+    Span* previous_ = nullptr;
+};
+
+}  // namespace llmcpp
@@ -0,0 +1,480 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/LLMTypes.h"
+
+/**
+ * @brief Typed structured outputs: derive a strict JSON Schema and a parser from a C++ struct
+ *
+ * Declare the fields once, next to the struct (at namespace scope, in the struct's namespace):
+ * @code
+ * struct Person {
+ *     std::string name;
+ *     int age = 0;
+ *     std::optional<std::string> email;
+ *     std::vector<std::string> tags;
+ * };
+ * LLMCPP_SCHEMA(Person, name, age, email, tags)
+ *
+ * LLMRequestConfig config;
+ * llmcpp::applySchema<Person>(config);           // Strict schema, interned once per type
+ * auto response = client.sendRequest(LLMRequest(config, "Extract the person"));
+ * Person p = llmcpp::parseStructured<Person>(response);
+ *
+ * // Or straight from the model's output text, without building a json DOM
+ * Person q = llmcpp::parseStructured<Person>(std::string_view(outputText));
+ * @endcode
+ *
+ * Supported field types: bool, integers, floating point, std::string, std::vector<T>,
+ * std::optional<T> and other LLMCPP_SCHEMA types. The generated schema follows the
+ * strict-mode rules: every field is listed in `required`, `additionalProperties` is false,
+ * and std::optional fields are nullable instead of omitted.
+ */
+
+namespace llmcpp {
+
+/**
+ * @brief Thrown when output text or JSON does not match the typed schema
+ */
+class TypedParseError : public std::runtime_error {
+   public:
+    TypedParseError(const std::string& message, size_t offset)
+        : std::runtime_error(message), offset_(offset) {}
+
+    // Byte offset into the parsed text (0 when converting from a json value)
+    size_t offset() const { return offset_; }
+
+   private:
+    size_t offset_;
+};
+
+/**
+ * @brief Minimal pull reader over JSON text used by the typed parser
+ *
+ * Reads values in place from the input buffer; nothing is materialized except the
+ * leaf values written into the target struct.
+ */
+class JsonReader {
+   public:
+    explicit JsonReader(std::string_view text) : text_(text) {}
+
+    void skipWhitespace();
+    bool atEnd();
+    char peek();
+    bool consume(char c);  // Skips whitespace, then consumes `c` if it is next
+    void expect(char c);
+
+    bool readBool();
+    bool readNull();  // Consumes `null` if it is next
+    int64_t readInt64();
+    uint64_t readUInt64();
+    double readDouble();
+    void readString(std::string& out);
+
+    // Object key; a view into the input when unescaped, otherwise decoded into `scratch`
+    std::string_view readKey(std::string& scratch);
+
+    void skipValue();
+
+    [[noreturn]] void fail(const std::string& message) const;
+    size_t offset() const { return pos_; }
+
+   private:
+    std::string_view numberToken();
+    void appendEscape(std::string& out);
+    void skipString();
+
+    std::string_view text_;
+    size_t pos_ = 0;
+    int depth_ = 0;
+};
+
+namespace detail {
+
+template <typename Owner, typename Member>
+struct FieldDescriptor {
+    const char* name;
+    Member Owner::*member;
+};
+
+template <typename Owner, typename Member>
+constexpr FieldDescriptor<Owner, Member> field(const char* name, Member Owner::*member) {
+    return {name, member};
+}
+
+// LLMCPP_SCHEMA defines llmcppSchemaFields(const T*) next to T; found through ADL
+template <typename T, typename = void>
+struct IsReflected : std::false_type {};
+template <typename T>
+struct IsReflected<T, std::void_t<decltype(llmcppSchemaFields(static_cast<const T*>(nullptr)))>>
+    : std::true_type {};
+
+template <typename T>
+struct IsOptional : std::false_type {};
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+struct IsVector : std::false_type {};
+template <typename T, typename A>
+struct IsVector<std::vector<T, A>> : std::true_type {};
+
+template <typename T>
+constexpr auto fieldsOf() {
+    return llmcppSchemaFields(static_cast<const T*>(nullptr));
+}
+
+template <typename Tuple, typename Fn, size_t... I>
+void forEachField(const Tuple& fields, Fn&& fn, std::index_sequence<I...>) {
+    (fn(std::integral_constant<size_t, I>{}, std::get<I>(fields)), ...);
+}
+
+template <typename Tuple, typename Fn>
+void forEachField(const Tuple& fields, Fn&& fn) {
+    forEachField(fields, std::forward<Fn>(fn),
+                 std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+}
+
+template <typename T>
+inline constexpr bool kUnsupported = false;
+
+template <typename T>
+nlohmann::json schemaOf() {
+    using json = nlohmann::json;
+    if constexpr (std::is_same_v<T, bool>) {
+        return {{"type", "boolean"}};
+    } else if constexpr (std::is_integral_v<T>) {
+        return {{"type", "integer"}};
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return {{"type", "number"}};
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return {{"type", "string"}};
+    } else if constexpr (IsOptional<T>::value) {
+        json schema = schemaOf<typename T::value_type>();
+        schema["type"] = json::array({schema["type"], "null"});
+        return schema;
+    } else if constexpr (IsVector<T>::value) {
+        return {{"type", "array"}, {"items", schemaOf<typename T::value_type>()}};
+    } else if constexpr (IsReflected<T>::value) {
+        json properties = json::object();
+        json required = json::array();
+        forEachField(fieldsOf<T>(), [&](auto, const auto& f) {
+            using Member = std::remove_reference_t<decltype(std::declval<T&>().*(f.member))>;
+            properties[f.name] = schemaOf<Member>();
+            required.push_back(f.name);
+        });
+        return {{"type", "object"},
+                {"properties", properties},
+                {"required", required},
+                {"additionalProperties", false}};
+    } else {
+        static_assert(kUnsupported<T>, "Type has no LLMCPP_SCHEMA declaration");
+    }
+}
+
+template <typename T>
+void readValue(JsonReader& reader, T& out) {
+    if constexpr (std::is_same_v<T, bool>) {
+        out = reader.readBool();
+    } else if constexpr (std::is_integral_v<T>) {
+        if constexpr (std::is_signed_v<T>) {
+            int64_t v = reader.readInt64();
+            if (v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max()) {
+                reader.fail("integer out of range");
+            }
+            out = static_cast<T>(v);
+        } else {
+            uint64_t v = reader.readUInt64();
+            if (v > std::numeric_limits<T>::max()) {
+                reader.fail("integer out of range");
+            }
+            out = static_cast<T>(v);
+        }
+    } else if constexpr (std::is_floating_point_v<T>) {
+        out = static_cast<T>(reader.readDouble());
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        reader.readString(out);
+    } else if constexpr (IsOptional<T>::value) {
+        if (reader.readNull()) {
+            out.reset();
+        } else {
+            readValue(reader, out.emplace());
+        }
+    } else if constexpr (IsVector<T>::value) {
+        out.clear();
+        reader.expect('[');
+        if (reader.consume(']')) {
+            return;
+        }
+        do {
+            readValue(reader, out.emplace_back());
+        } while (reader.consume(','));
+        reader.expect(']');
+    } else if constexpr (IsReflected<T>::value) {
+        constexpr auto fields = fieldsOf<T>();
+        constexpr size_t count = std::tuple_size_v<decltype(fields)>;
+        static_assert(count <= 32, "LLMCPP_SCHEMA supports at most 32 fields");
+        uint64_t seen = 0;
+        std::string scratch;
+
+        reader.expect('{');
+        if (!reader.consume('}')) {
+            do {
+                std::string_view key = reader.readKey(scratch);
+                reader.expect(':');
+                bool matched = false;
+                forEachField(fields, [&](auto index, const auto& f) {
+                    if (!matched && key == f.name) {
+                        readValue(reader, out.*(f.member));
+                        seen |= uint64_t{1} << decltype(index)::value;
+                        matched = true;
+                    }
+                });
+                if (!matched) {
+                    reader.skipValue();
+                }
+            } while (reader.consume(','));
+            reader.expect('}');
+        }
+
+        forEachField(fields, [&](auto index, const auto& f) {
+            using Member = std::remove_reference_t<decltype(out.*(f.member))>;
+            if (!(seen & (uint64_t{1} << decltype(index)::value))) {
+                if constexpr (IsOptional<Member>::value) {
+                    (out.*(f.member)).reset();
+                } else {
+                    reader.fail(std::string("missing field \"") + f.name + "\"");
+                }
+            }
+        });
+    } else {
+        static_assert(kUnsupported<T>, "Type has no LLMCPP_SCHEMA declaration");
+    }
+}
+
+template <typename T>
+void fromJsonValue(const nlohmann::json& value, T& out, const std::string& path) {
+    auto mismatch = [&](const char* expected) {
+        throw TypedParseError("expected " + std::string(expected) + " at \"" + path + "\", got " +
+                                  value.type_name(),
+                              0);
+    };
+    if constexpr (std::is_same_v<T, bool>) {
+        if (!value.is_boolean()) mismatch("boolean");
+        out = value.get<bool>();
+    } else if constexpr (std::is_integral_v<T>) {
+        if (!value.is_number_integer()) mismatch("integer");
+        using Limits = std::numeric_limits<T>;
+        bool inRange = false;
+        if (value.is_number_unsigned()) {
+            inRange = value.get<uint64_t>() <= static_cast<uint64_t>(Limits::max());
+        } else {
+            const auto v = value.get<int64_t>();
+            inRange = v >= static_cast<int64_t>(Limits::min()) &&
+                      (v < 0 || static_cast<uint64_t>(v) <= static_cast<uint64_t>(Limits::max()));
+        }
+        if (!inRange) {
+            throw TypedParseError("integer out of range at \"" + path + "\"", 0);
+        }
+        out = value.get<T>();
+    } else if constexpr (std::is_floating_point_v<T>) {
+        if (!value.is_number()) mismatch("number");
+        out = value.get<T>();
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        if (!value.is_string()) mismatch("string");
+        out = value.get_ref<const std::string&>();
+    } else if constexpr (IsOptional<T>::value) {
+        if (value.is_null()) {
+            out.reset();
+        } else {
+            fromJsonValue(value, out.emplace(), path);
+        }
+    } else if constexpr (IsVector<T>::value) {
+        if (!value.is_array()) mismatch("array");
+        out.clear();
+        out.reserve(value.size());
+        for (size_t i = 0; i < value.size(); ++i) {
+            fromJsonValue(value[i], out.emplace_back(), path + "/" + std::to_string(i));
+        }
+    } else if constexpr (IsReflected<T>::value) {
+        if (!value.is_object()) mismatch("object");
+        forEachField(fieldsOf<T>(), [&](auto, const auto& f) {
+            using Member = std::remove_reference_t<decltype(out.*(f.member))>;
+            auto it = value.find(f.name);
+            if (it != value.end()) {
+                fromJsonValue(*it, out.*(f.member), path + "/" + f.name);
+            } else if constexpr (IsOptional<Member>::value) {
+                (out.*(f.member)).reset();
+            } else {
+                throw TypedParseError(
+                    std::string("missing field \"") + f.name + "\" at \"" + path + "\"", 0);
+            }
+        });
+    } else {
+        static_assert(kUnsupported<T>, "Type has no LLMCPP_SCHEMA declaration");
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Strict JSON Schema for T, built on first use and shared afterwards
+ */
+template <typename T>
+const nlohmann::json& schemaFor() {
+    static const nlohmann::json schema = detail::schemaOf<T>();
+    return schema;
+}
+
+/**
+ * @brief T's schema interned once, for requests that reference it without copying
+ */
+template <typename T>
+const SchemaRef& internedSchemaFor() {
+    static const SchemaRef schema = SchemaInterner::intern(schemaFor<T>());
+    return schema;
+}
+
+/**
+ * @brief Name declared in LLMCPP_SCHEMA, usable as the structured-output function name
+ */
+template <typename T>
+const char* schemaName() {
+    return llmcppSchemaName(static_cast<const T*>(nullptr));
+}
+
+/**
+ * @brief Point a request config at T's interned schema and name
+ */
+template <typename T>
+void applySchema(LLMRequestConfig& config) {
+    config.internedSchema = internedSchemaFor<T>();
+    config.functionName = schemaName<T>();
+}
+
+/**
+ * @brief Parse model output text directly into T, without an intermediate json DOM
+ *
+ * Throws TypedParseError on malformed JSON, type mismatches or missing non-optional fields.
+ * Unknown keys are skipped.
+ */
+template <typename T>
+T parseStructured(std::string_view text) {
+    T out{};
+    JsonReader reader(text);
+    detail::readValue(reader, out);
+    if (!reader.atEnd()) {
+        reader.fail("unexpected trailing characters");
+    }
+    return out;
+}
+
+/**
+ * @brief Convert an already-parsed json value into T
+ */
+template <typename T>
+T parseStructured(const nlohmann::json& value) {
+    T out{};
+    detail::fromJsonValue(value, out, "");
+    return out;
+}
+
+/**
+ * @brief Convert a structured LLMResponse into T; throws std::runtime_error on failed responses
+ */
+template <typename T>
+T parseStructured(const LLMResponse& response) {
+    if (!response.success) {
+        throw std::runtime_error("Cannot parse failed response: " + response.errorMessage);
+    }
+    return parseStructured<T>(response.result);
+}
+
+/**
+ * @brief Non-throwing variant of parseStructured(text); fills `error` on failure
+ */
+template <typename T>
+std::optional<T> tryParseStructured(std::string_view text, std::string* error = nullptr) {
+    try {
+        return parseStructured<T>(text);
+    } catch (const TypedParseError& e) {
+        if (error) {
+            *error = e.what();
+        }
+        return std::nullopt;
+    }
+}
+
+}  // namespace llmcpp
+
+// Preprocessor plumbing for LLMCPP_SCHEMA (up to 32 fields)
+
+#define LLMCPP_PP_EXPAND(x) x
+#define LLMCPP_PP_NARG(...) \
+    LLMCPP_PP_EXPAND(LLMCPP_PP_ARG_N(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, \
+                                     21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, \
+                                     6, 5, 4, 3, 2, 1))
+#define LLMCPP_PP_ARG_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, \
+                        _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30,  \
+                        _31, _32, N, ...)                                                      \
+    N
+#define LLMCPP_PP_CONCAT_(a, b) a##b
+#define LLMCPP_PP_CONCAT(a, b) LLMCPP_PP_CONCAT_(a, b)
+
+#define LLMCPP_SCHEMA_FIELD(Type, name) ::llmcpp::detail::field(#name, &Type::name)
+
+#define LLMCPP_PP_FE_1(T, x) LLMCPP_SCHEMA_FIELD(T, x)
+#define LLMCPP_PP_FE_2(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_1(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_3(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_2(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_4(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_3(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_5(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_4(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_6(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_5(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_7(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_6(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_8(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_7(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_9(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_8(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_10(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_9(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_11(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_10(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_12(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_11(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_13(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_12(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_14(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_13(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_15(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_14(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_16(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_15(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_17(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_16(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_18(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_17(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_19(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_18(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_20(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_19(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_21(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_20(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_22(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_21(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_23(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_22(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_24(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_23(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_25(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_24(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_26(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_25(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_27(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_26(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_28(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_27(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_29(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_28(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_30(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_29(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_31(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_30(T, __VA_ARGS__))
+#define LLMCPP_PP_FE_32(T, x, ...) LLMCPP_SCHEMA_FIELD(T, x), LLMCPP_PP_EXPAND(LLMCPP_PP_FE_31(T, __VA_ARGS__))
+
+/**
+ * @brief Declare the fields of a struct for typed schemas and parsing
+ *
+ * Must appear at namespace scope in the namespace that declares `Type`.
+ */
+#define LLMCPP_SCHEMA(Type, ...)                                                                 \
+    [[maybe_unused]] inline constexpr auto llmcppSchemaFields(const Type*) {                     \
+        return std::make_tuple(LLMCPP_PP_EXPAND(                                                 \
+            LLMCPP_PP_CONCAT(LLMCPP_PP_FE_, LLMCPP_PP_NARG(__VA_ARGS__))(Type, __VA_ARGS__))); \
+    }                                                                                            \
+    [[maybe_unused]] inline constexpr const char* llmcppSchemaName(const Type*) { return #Type; }
@@ -9,22 +9,44 @@
  */
 
 // Core functionality
+#include "core/CancellationToken.h"
 #include "core/ClientManager.h"
+#include "core/CompiledSchema.h"
+#include "core/ContextWindowManager.h"
+#include "core/CostMeter.h"
 #include "core/JsonSchemaBuilder.h"
 #include "core/LLMClient.h"
 #include "core/LLMTypes.h"
+#include "core/Logger.h"
+#include "core/ModelCatalog.h"
+#include "core/PromptCache.h"
 #include "core/ResponseParser.h"
+#include "core/SchemaInterner.h"
+#include "core/StreamingJsonParser.h"
+#include "core/SseParser.h"
+#include "core/Tokenizer.h"
+#include "core/ToolCallStream.h"
+#include "core/ToolRunner.h"
+#include "core/Tracing.h"
+#include "core/TypedSchema.h"
 
 // OpenAI provider
 #include "openai/OpenAIClient.h"
 #include "openai/OpenAISchemaBuilder.h"
+#include "openai/OpenAIStrictSchema.h"
+#include "openai/OpenAIToolSession.h"
 #include "openai/OpenAITypes.h"
 
 // Anthropic provider
 #include "anthropic/AnthropicClient.h"
 #include "anthropic/AnthropicSchemaBuilder.h"
+#include "anthropic/AnthropicToolSession.h"
 #include "anthropic/AnthropicTypes.h"
 
+// OpenAI-compatible self-hosted servers (llama.cpp, vLLM, ...)
+#include "local/LocalClient.h"
+#include "local/LocalTypes.h"
+
 // Version information
 #include "llmcpp_version.h"
 
@@ -0,0 +1,56 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/LLMClient.h"
+#include "local/LocalTypes.h"
+
+namespace Local {
+
+/**
+ * Client for self-hosted OpenAI-compatible servers (llama.cpp server, vLLM, Ollama, ...)
+ *
+ * Talks Chat Completions or legacy Completions over plain HTTP or HTTPS through the shared
+ * OpenAIHttpClient transport, so connection reuse, tracing and header handling match the
+ * OpenAI client. Streaming responses are parsed as they arrive and text deltas are passed
+ * to the chunk callback.
+ */
+class LocalClient : public LLMClient {
+   public:
+    explicit LocalClient(const LocalConfig& config = LocalConfig());
+    explicit LocalClient(const std::string& baseUrl);
+
+    ~LocalClient() override;
+
+    LocalClient(LocalClient&& other) noexcept;
+    LocalClient& operator=(LocalClient&& other) noexcept;
+
+    LocalClient(const LocalClient&) = delete;
+    LocalClient& operator=(const LocalClient&) = delete;
+
+    /**
+     * LLMClient interface implementation
+     */
+    void sendRequest(const LLMRequest& request, LLMResponseCallback callback) override;
+    void sendStreamingRequest(const LLMRequest& request, LLMResponseCallback onDone,
+                              LLMStreamCallback onChunk) override;
+    // Model ids reported by GET /models; empty if the server is unreachable
+    std::vector<std::string> getAvailableModels() const override;
+    bool supportsStreaming() const override;
+    std::string getClientName() const override;
+
+    /**
+     * Synchronous requests (blocking)
+     */
+    LLMResponse sendRequest(const LLMRequest& request);
+    LLMResponse sendStreamingRequest(const LLMRequest& request, LLMStreamCallback onChunk);
+
+    const LocalConfig& getConfig() const;
+
+   private:
+    class ClientImpl;
+    std::unique_ptr<ClientImpl> pImpl;
+};
+
+}  // namespace Local
@@ -0,0 +1,93 @@
+#pragma once
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+
+#include "core/LLMTypes.h"
+#include "core/SseParser.h"
+#include "openai/OpenAITypes.h"
+
+using json = nlohmann::json;
+
+namespace Local {
+
+/**
+ * OpenAI-compatible endpoint used for generation
+ */
+enum class Endpoint {
+    ChatCompletions,  // POST /chat/completions (messages)
+    Completions       // POST /completions (raw prompt)
+};
+
+std::string toString(Endpoint endpoint);
+Endpoint endpointFromString(const std::string& name);
+
+/**
+ * Configuration for a self-hosted OpenAI-compatible server (llama.cpp, vLLM, ...)
+ */
+struct LocalConfig {
+    std::string baseUrl = "http://localhost:8000/v1";
+    std::string apiKey;        // Optional; sent as a Bearer token when set
+    std::string defaultModel;  // Used when the request has no model
+    Endpoint endpoint = Endpoint::ChatCompletions;
+    std::map<std::string, std::string> headers;
+    int timeoutSeconds = 60;
+    int maxRetries = 0;  // Local servers fail fast; retries rarely help
+
+    LocalConfig() = default;
+    explicit LocalConfig(const std::string& url) : baseUrl(url) {}
+
+    json toJson() const;
+    static LocalConfig fromJson(const json& j);
+};
+
+/**
+ * Build the JSON body for `config.endpoint`
+ *
+ * Chat bodies use the OpenAI Chat Completions mapping (OpenAI::ChatCompletionRequest), with
+ * `config.defaultModel` for requests without a model and `top_k` as a local extension.
+ * Completions bodies join the context messages and the prompt into one prompt string.
+ * Streaming bodies ask for a final usage chunk (`stream_options.include_usage`).
+ */
+json buildRequestBody(const LLMRequest& request, const LocalConfig& config, bool stream);
+
+/**
+ * Convert a non-streaming chat or completions response
+ *
+ * Same result shape as OpenAI::ChatCompletionResponse::toLLMResponse; structured output that
+ * is not valid JSON is reported as a failed response.
+ */
+LLMResponse parseResponse(json body, bool expectStructuredOutput);
+
+/**
+ * Accumulates an SSE chat or completions stream into an LLMResponse
+ *
+ * Feed raw response bytes; text deltas of choice 0 are forwarded to `onText` as they arrive.
+ */
+class StreamAccumulator {
+   public:
+    explicit StreamAccumulator(LLMStreamCallback onText = nullptr);
+
+    // The SSE parser calls back into this object
+    StreamAccumulator(const StreamAccumulator&) = delete;
+    StreamAccumulator& operator=(const StreamAccumulator&) = delete;
+
+    void feed(std::string_view bytes);
+
+    // True once the server sent `data: [DONE]`
+    bool done() const { return done_; }
+
+    LLMResponse finish(bool expectStructuredOutput);
+
+   private:
+    void onEvent(const llmcpp::SseParser::Event& event);
+
+    LLMStreamCallback onText_;
+    llmcpp::SseParser sse_;
+    OpenAI::ChatCompletionResponse response_;
+    std::string error_;
+    bool done_ = false;
+};
+
+}  // namespace Local
@@ -1,13 +1,22 @@
 #pragma once
 #include <functional>
+#include <future>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "core/CancellationToken.h"
 #include "openai/OpenAITypes.h"
 
 class OpenAIHttpClient;
 
 /**
  * Internal API handler for OpenAI Chat Completions API
+ *
+ * Also the API spoken by most OpenAI-compatible gateways. Errors (HTTP failures, API error
+ * bodies, invalid requests) are thrown as exceptions; the asynchronous variants deliver them
+ * through the returned future and do not invoke the callback. A cancelled CancellationToken
+ * aborts the request or stream with llmcpp::OperationCancelled.
  */
 class OpenAIChatCompletionsApi {
    public:
@@ -16,22 +25,42 @@ class OpenAIChatCompletionsApi {
     /**
      * Synchronous chat completion
      */
-    OpenAI::ChatCompletionResponse sendChatCompletion(const OpenAI::ChatCompletionRequest& request);
+    OpenAI::ChatCompletionResponse sendChatCompletion(const OpenAI::ChatCompletionRequest& request,
+                                                      const llmcpp::CancellationToken& cancel = {});
 
     /**
      * Asynchronous chat completion
      */
     std::future<OpenAI::ChatCompletionResponse> sendChatCompletionAsync(
         const OpenAI::ChatCompletionRequest& request,
-        std::function<void(const OpenAI::ChatCompletionResponse&)> callback = nullptr);
+        std::function<void(const OpenAI::ChatCompletionResponse&)> callback = nullptr,
+        llmcpp::CancellationToken cancel = {});
 
     /**
      * Streaming chat completion
+     *
+     * `streamCallback` receives the content deltas of the first choice as they arrive; the
+     * future holds the assembled response with every choice, tool calls and usage.
      */
     std::future<OpenAI::ChatCompletionResponse> sendChatCompletionStreaming(
         const OpenAI::ChatCompletionRequest& request,
         std::function<void(const std::string&)> streamCallback,
-        std::function<void(const OpenAI::ChatCompletionResponse&)> finalCallback = nullptr);
+        std::function<void(const OpenAI::ChatCompletionResponse&)> finalCallback = nullptr,
+        llmcpp::CancellationToken cancel = {});
+
+    // Blocking form of sendChatCompletionStreaming, run on the caller's thread
+    OpenAI::ChatCompletionResponse streamChatCompletion(
+        const OpenAI::ChatCompletionRequest& request,
+        const std::function<void(const std::string&)>& streamCallback,
+        const llmcpp::CancellationToken& cancel = {});
+
+    /**
+     * Streaming helpers (`data:` payloads of the SSE body)
+     */
+    // Content delta of the first choice in a chunk; empty for other chunks
+    static std::string parseStreamingChunk(const std::string& chunk);
+    // True for the `[DONE]` sentinel that ends the stream
+    static bool isStreamingComplete(const std::string& chunk);
 
    private:
     std::shared_ptr<OpenAIHttpClient> httpClient_;
@@ -42,19 +71,10 @@ class OpenAIChatCompletionsApi {
     json buildRequestJson(const OpenAI::ChatCompletionRequest& request) const;
     OpenAI::ChatCompletionResponse parseResponse(const json& response) const;
 
-    /**
-     * Streaming helpers
-     */
-    void processStreamingResponse(
-        const std::string& streamData, std::function<void(const std::string&)> streamCallback,
-        std::function<void(const OpenAI::ChatCompletionResponse&)> finalCallback);
-    std::string parseStreamingChunk(const std::string& chunk) const;
-    bool isStreamingComplete(const std::string& chunk) const;
-
     /**
      * Validation
      */
     void validateRequest(const OpenAI::ChatCompletionRequest& request) const;
-    void validateTools(const std::vector<json>& tools) const;
+    void validateTools(const std::vector<OpenAI::ToolVariant>& tools) const;
     void validateMessages(const std::vector<OpenAI::ChatMessage>& messages) const;
 };
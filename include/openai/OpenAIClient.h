@@ -1,7 +1,9 @@
 #pragma once
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -51,6 +53,10 @@ class OpenAIClient : public LLMClient {
 
     /**
      * Synchronous methods (convenience)
+     *
+     * Set request.cancellation to make these calls cancellable; a cancelled request returns an
+     * unsuccessful response and, when it was a background Responses API job, is cancelled on
+     * the server as well.
      */
     LLMResponse sendRequest(const LLMRequest& request);
     std::future<LLMResponse> sendRequestAsync(const LLMRequest& request,
@@ -87,10 +93,12 @@ class OpenAIClient : public LLMClient {
      */
 
     // Responses API (Modern Structured Output - Primary API)
-    OpenAI::ResponsesResponse sendResponsesRequest(const OpenAI::ResponsesRequest& request);
+    OpenAI::ResponsesResponse sendResponsesRequest(const OpenAI::ResponsesRequest& request,
+                                                   const llmcpp::CancellationToken& cancel = {});
     std::future<OpenAI::ResponsesResponse> sendResponsesRequestAsync(
         const OpenAI::ResponsesRequest& request,
-        std::function<void(const OpenAI::ResponsesResponse&)> callback = nullptr);
+        std::function<void(const OpenAI::ResponsesResponse&)> callback = nullptr,
+        llmcpp::CancellationToken cancel = {});
     std::future<OpenAI::ResponsesResponse> sendResponsesStreaming(
         const OpenAI::ResponsesRequest& request,
         std::function<void(const std::string&)> streamCallback,
@@ -102,14 +110,17 @@ class OpenAIClient : public LLMClient {
     OpenAI::ResponsesResponse deleteResponse(const std::string& responseId);
 
     // Chat Completions API (Traditional Conversational)
-    OpenAI::ChatCompletionResponse sendChatCompletion(const OpenAI::ChatCompletionRequest& request);
+    OpenAI::ChatCompletionResponse sendChatCompletion(const OpenAI::ChatCompletionRequest& request,
+                                                      const llmcpp::CancellationToken& cancel = {});
     std::future<OpenAI::ChatCompletionResponse> sendChatCompletionAsync(
         const OpenAI::ChatCompletionRequest& request,
-        std::function<void(const OpenAI::ChatCompletionResponse&)> callback = nullptr);
+        std::function<void(const OpenAI::ChatCompletionResponse&)> callback = nullptr,
+        llmcpp::CancellationToken cancel = {});
     std::future<OpenAI::ChatCompletionResponse> sendChatCompletionStreaming(
         const OpenAI::ChatCompletionRequest& request,
         std::function<void(const std::string&)> streamCallback,
-        std::function<void(const OpenAI::ChatCompletionResponse&)> finalCallback = nullptr);
+        std::function<void(const OpenAI::ChatCompletionResponse&)> finalCallback = nullptr,
+        llmcpp::CancellationToken cancel = {});
 
     // Configuration
     void setConfig(const OpenAI::OpenAIConfig& config);
@@ -151,7 +162,11 @@ class OpenAIClient : public LLMClient {
     /**
      * Internal routing methods
      */
-    LLMResponse routeRequest(const LLMRequest& request);
+    // With `streamCallback`, Chat Completions requests stream text deltas to it
+    LLMResponse routeRequest(
+        const LLMRequest& request,
+        std::optional<std::chrono::steady_clock::time_point> enqueuedAt = std::nullopt,
+        LLMStreamCallback streamCallback = nullptr);
     std::future<LLMResponse> routeRequestAsync(const LLMRequest& request,
                                                LLMResponseCallback callback);
     std::future<LLMResponse> routeStreamingRequest(const LLMRequest& request,
@@ -162,6 +177,7 @@ class OpenAIClient : public LLMClient {
      * Helper methods
      */
     void initializeApiHandlers();
+    OpenAI::ApiType resolveApiType(const LLMRequest& request) const;  // Honours the preference
     void logDeprecationWarning(const std::string& model, const std::string& api) const;
     bool shouldUseResponsesApi(const LLMRequest& request) const;
     bool shouldUseChatCompletionsApi(const LLMRequest& request) const;
@@ -5,10 +5,14 @@
 #include <string>
 #include <unordered_map>
 
+#include "core/CancellationToken.h"
 #include "openai/OpenAITypes.h"
 
 /**
  * HTTP client wrapper for OpenAI API calls
+ *
+ * Also used for OpenAI-compatible servers (see Local::LocalClient): plain http:// base URLs
+ * are supported and the Authorization header is omitted when no API key is configured.
  */
 class OpenAIHttpClient {
    public:
@@ -23,27 +27,43 @@ class OpenAIHttpClient {
         std::string body;
         std::string errorMessage;
         bool success;
+        bool cancelled;  // Aborted through a CancellationToken; never retried
 
-        HttpResponse() : statusCode(0), success(false) {}
+        HttpResponse() : statusCode(0), success(false), cancelled(false) {}
     };
 
     /**
      * Synchronous HTTP requests
+     *
+     * Cancelling `cancel` aborts the socket read and any retry backoff and returns a response
+     * with `cancelled` set. Cancellable requests use a connection of their own.
      */
-    HttpResponse post(const std::string& endpoint, const json& requestBody);
-    HttpResponse get(const std::string& endpoint);
+    HttpResponse post(const std::string& endpoint, const json& requestBody,
+                      const llmcpp::CancellationToken& cancel = {});
+    // Post an already-serialized JSON body (e.g. with interned schema bytes spliced in)
+    HttpResponse postSerialized(const std::string& endpoint, const std::string& body,
+                                const llmcpp::CancellationToken& cancel = {});
+    HttpResponse get(const std::string& endpoint, const llmcpp::CancellationToken& cancel = {});
 
     /**
      * Asynchronous HTTP requests
      */
-    std::future<HttpResponse> postAsync(const std::string& endpoint, const json& requestBody);
-    std::future<HttpResponse> getAsync(const std::string& endpoint);
+    std::future<HttpResponse> postAsync(const std::string& endpoint, const json& requestBody,
+                                        llmcpp::CancellationToken cancel = {});
+    std::future<HttpResponse> getAsync(const std::string& endpoint,
+                                       llmcpp::CancellationToken cancel = {});
 
     /**
      * Streaming HTTP requests
+     *
+     * The callback receives the raw response body (e.g. SSE frames) chunk by chunk as it
+     * arrives; the returned HttpResponse has an empty body on success. Error responses are
+     * not passed to the callback. Streaming requests are not retried. Cancelling `cancel` ends
+     * the stream before the next chunk is delivered.
      */
     std::future<HttpResponse> postStreaming(const std::string& endpoint, const json& requestBody,
-                                            std::function<void(const std::string&)> streamCallback);
+                                            std::function<void(const std::string&)> streamCallback,
+                                            llmcpp::CancellationToken cancel = {});
 
     /**
      * Configuration
@@ -95,8 +115,10 @@ class OpenAIHttpClient {
     /**
      * Retry logic
      */
-    HttpResponse executeWithRetry(std::function<HttpResponse()> requestFunc);
-    void waitForRetry(int attemptNumber) const;
+    HttpResponse executeWithRetry(std::function<HttpResponse()> requestFunc,
+                                  const llmcpp::CancellationToken& cancel = {});
+    // False when cancelled during the backoff
+    bool waitForRetry(int attemptNumber, const llmcpp::CancellationToken& cancel) const;
 
     /**
      * Streaming helpers
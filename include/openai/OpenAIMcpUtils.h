@@ -39,6 +39,10 @@ struct McpToolCall {
 };
 
 /// Utility functions for parsing MCP tool outputs from OpenAI responses
+///
+/// Each function scans the response output once. The overloads taking a ResponseOutputIndex
+/// (from response.outputIndex()) answer from that index instead, so several queries against
+/// one response share a single pass.
 namespace McpUtils {
 
 /**
@@ -47,6 +51,8 @@ namespace McpUtils {
  * @return Vector of McpToolCall structs with details about each tool invocation
  */
 std::vector<McpToolCall> extractMcpCalls(const ResponsesResponse& response);
+std::vector<McpToolCall> extractMcpCalls(const ResponsesResponse& response,
+                                         const ResponseOutputIndex& index);
 
 /**
  * Check if a specific MCP tool was called in the response
@@ -55,6 +61,8 @@ std::vector<McpToolCall> extractMcpCalls(const ResponsesResponse& response);
  * @return true if the tool was called at least once
  */
 bool wasToolCalled(const ResponsesResponse& response, const std::string& toolName);
+bool wasToolCalled(const ResponsesResponse& response, const ResponseOutputIndex& index,
+                   const std::string& toolName);
 
 /**
  * Get the output from a specific MCP tool call
@@ -63,6 +71,8 @@ bool wasToolCalled(const ResponsesResponse& response, const std::string& toolNam
  * @return The output JSON if found, std::nullopt otherwise
  */
 std::optional<json> getToolOutput(const ResponsesResponse& response, const std::string& toolName);
+std::optional<json> getToolOutput(const ResponsesResponse& response,
+                                  const ResponseOutputIndex& index, const std::string& toolName);
 
 /**
  * Get all outputs from a specific MCP tool (if called multiple times)
@@ -71,6 +81,9 @@ std::optional<json> getToolOutput(const ResponsesResponse& response, const std::
  * @return Vector of output JSON objects
  */
 std::vector<json> getAllToolOutputs(const ResponsesResponse& response, const std::string& toolName);
+std::vector<json> getAllToolOutputs(const ResponsesResponse& response,
+                                    const ResponseOutputIndex& index,
+                                    const std::string& toolName);
 
 /**
  * Check if any MCP tools were listed in the response
@@ -78,6 +91,7 @@ std::vector<json> getAllToolOutputs(const ResponsesResponse& response, const std
  * @return true if mcp_list_tools output item was found
  */
 bool wereMcpToolsListed(const ResponsesResponse& response);
+bool wereMcpToolsListed(const ResponsesResponse& response, const ResponseOutputIndex& index);
 
 /**
  * Get the list of available MCP tools from mcp_list_tools output
@@ -85,6 +99,8 @@ bool wereMcpToolsListed(const ResponsesResponse& response);
  * @return Vector of tool names that are available
  */
 std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response);
+std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response,
+                                              const ResponseOutputIndex& index);
 
 /**
  * Check if all expected tools were called
@@ -94,6 +110,8 @@ std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response)
  */
 bool wereAllToolsCalled(const ResponsesResponse& response,
                         const std::vector<std::string>& expectedTools);
+bool wereAllToolsCalled(const ResponsesResponse& response, const ResponseOutputIndex& index,
+                        const std::vector<std::string>& expectedTools);
 
 /**
  * Get summary statistics about MCP tool usage
@@ -101,6 +119,7 @@ bool wereAllToolsCalled(const ResponsesResponse& response,
  * @return JSON object with statistics (total_calls, successful_calls, failed_calls, tools_used)
  */
 json getMcpUsageStats(const ResponsesResponse& response);
+json getMcpUsageStats(const ResponsesResponse& response, const ResponseOutputIndex& index);
 
 }  // namespace McpUtils
 }  // namespace OpenAI
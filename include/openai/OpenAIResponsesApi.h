@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 
+#include "core/CancellationToken.h"
 #include "openai/OpenAITypes.h"
 
 // Forward declarations
@@ -19,6 +20,9 @@ class OpenAIHttpClient;
  * - Streaming with partial results
  * - Model Context Protocol (MCP) integration
  * - Multimodal inputs (text, images, files)
+ *
+ * Methods taking a CancellationToken throw llmcpp::OperationCancelled once it is cancelled;
+ * createAsync() reports it as a response with status Cancelled instead.
  */
 class OpenAIResponsesApi {
    public:
@@ -30,12 +34,14 @@ class OpenAIResponsesApi {
      */
 
     // Create a new response (synchronous)
-    ResponsesResponse create(const ResponsesRequest& request);
+    ResponsesResponse create(const ResponsesRequest& request,
+                             const llmcpp::CancellationToken& cancel = {});
 
     // Create a new response (asynchronous)
     std::future<ResponsesResponse> createAsync(
         const ResponsesRequest& request,
-        std::function<void(const OpenAI::ResponsesResponse&)> callback = nullptr);
+        std::function<void(const OpenAI::ResponsesResponse&)> callback = nullptr,
+        llmcpp::CancellationToken cancel = {});
 
     // Create with streaming support
     std::future<ResponsesResponse> createStreaming(
@@ -47,9 +53,10 @@ class OpenAIResponsesApi {
      */
 
     // Retrieve an existing response by ID
-    ResponsesResponse retrieve(const std::string& responseId);
+    ResponsesResponse retrieve(const std::string& responseId,
+                               const llmcpp::CancellationToken& cancel = {});
 
-    // Cancel an in-progress background response
+    // Cancel an in-progress background response on the server; returns it with its new status
     ResponsesResponse cancel(const std::string& responseId);
 
     // Delete a stored response
@@ -66,9 +73,11 @@ class OpenAIResponsesApi {
     // Check if a response is still processing
     bool isProcessing(const std::string& responseId);
 
-    // Wait for a background response to complete
+    // Wait for a background response to complete. Cancelling `cancel` stops polling and
+    // cancels the response on the server before OperationCancelled is thrown.
     ResponsesResponse waitForCompletion(const std::string& responseId, int timeoutSeconds = 300,
-                                        int pollIntervalSeconds = 2);
+                                        int pollIntervalSeconds = 2,
+                                        const llmcpp::CancellationToken& cancel = {});
 
     /**
      * Streaming helpers
@@ -83,7 +92,7 @@ class OpenAIResponsesApi {
      * Conversation management
      */
 
-    // Create a follow-up response in a conversation
+    // Create a follow-up response in a conversation (looks up the model with retrieve())
     ResponsesResponse continueConversation(
         const std::string& previousResponseId, const OpenAI::ResponsesInput& newInput,
         const std::optional<std::vector<OpenAI::ToolVariant>>& tools = std::nullopt);
@@ -101,7 +110,8 @@ class OpenAIResponsesApi {
     ResponsesResponse approveMcpRequest(const std::string& responseId,
                                         const std::string& approvalRequestId, bool approve = true);
 
-    // Submit function call outputs
+    // Submit function call outputs. Looks up the model with retrieve(); to skip that round
+    // trip, create() a request with previousResponseId and functionOutputs set instead.
     ResponsesResponse submitFunctionOutputs(const std::string& responseId,
                                             const std::vector<OpenAI::FunctionCallOutput>& outputs);
 
@@ -159,5 +169,6 @@ class OpenAIResponsesApi {
 
     // Polling helpers for background tasks
     ResponsesResponse pollForCompletion(const std::string& responseId, int maxAttempts,
-                                        int intervalSeconds);
+                                        int intervalSeconds,
+                                        const llmcpp::CancellationToken& cancel);
 };
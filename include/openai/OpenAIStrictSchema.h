@@ -0,0 +1,70 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+#include "core/SchemaInterner.h"
+
+using json = nlohmann::json;
+
+namespace OpenAI {
+
+/**
+ * @brief A finding from the strict-mode normalizer
+ *
+ * Warnings describe rewrites that were applied (e.g. an optional property made nullable);
+ * errors describe constructs that strict mode rejects and that cannot be rewritten.
+ */
+struct StrictSchemaIssue {
+    enum class Severity { Warning, Error };
+
+    Severity severity = Severity::Warning;
+    std::string path;  // JSON Pointer into the input schema
+    std::string keyword;
+    std::string message;
+};
+
+struct StrictSchemaOptions {
+    // Drop type-specific keywords strict mode does not support (minLength, uniqueItems, ...)
+    // instead of reporting them as errors
+    bool dropUnsupportedKeywords = true;
+    int maxDepth = 10;            // Object nesting limit
+    size_t maxProperties = 5000;  // Total object properties across the schema
+    size_t maxEnumValues = 1000;  // Total enum values across the schema
+};
+
+struct StrictSchemaResult {
+    json schema;  // Strict-compatible rewrite of the input
+    std::vector<StrictSchemaIssue> issues;
+
+    bool ok() const;
+    std::string errorSummary() const;  // "; "-joined error messages
+};
+
+/**
+ * @brief Rewrite a schema into the form OpenAI structured outputs accept with `strict: true`
+ *
+ * Every object gets `additionalProperties: false` and lists all of its properties in
+ * `required`; properties that were optional become nullable instead. Unsupported keywords
+ * and limits are reported so invalid schemas fail locally rather than with a 400.
+ *
+ * Example usage:
+ * @code
+ * auto result = OpenAI::normalizeStrictSchema(schema);
+ * if (!result.ok()) {
+ *     throw std::invalid_argument(result.errorSummary());
+ * }
+ * @endcode
+ */
+StrictSchemaResult normalizeStrictSchema(const json& schema, const StrictSchemaOptions& options = {});
+
+/**
+ * @brief Strict-normalized version of an interned schema, computed once per schema
+ *
+ * Throws std::invalid_argument when the schema cannot be made strict-compatible.
+ * Rewrites are logged at debug level the first time a schema is normalized.
+ */
+llmcpp::SchemaRef strictSchemaFor(const llmcpp::SchemaRef& schema);
+
+}  // namespace OpenAI
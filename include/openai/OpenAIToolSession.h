@@ -0,0 +1,51 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "core/ToolCallStream.h"
+#include "core/ToolRunner.h"
+#include "openai/OpenAITypes.h"
+
+class OpenAIClient;
+
+namespace OpenAI {
+
+/**
+ * @brief llmcpp::ToolSession over the Responses API
+ *
+ * Tools are sent as function tools. Each follow-up turn sends function_call_output items
+ * with previous_response_id, so only the new results travel, not the whole conversation;
+ * the request must therefore be stored (`store`, the default). Instructions and tools are
+ * resent every turn because stored responses do not carry them forward.
+ */
+class ResponsesToolSession : public llmcpp::ToolSession {
+   public:
+    using Sender = std::function<ResponsesResponse(const ResponsesRequest&)>;
+
+    // Throws std::invalid_argument if `request.store` is false
+    ResponsesToolSession(OpenAIClient& client, ResponsesRequest request);
+    ResponsesToolSession(Sender send, ResponsesRequest request);
+
+    llmcpp::ToolTurn start(const std::vector<llmcpp::ToolDefinition>& tools) override;
+    llmcpp::ToolTurn submit(const std::vector<llmcpp::ToolCallResult>& results) override;
+
+    const ResponsesResponse& lastResponse() const { return last_; }
+
+   private:
+    llmcpp::ToolTurn send(const ResponsesRequest& request);
+
+    Sender send_;
+    ResponsesRequest request_;
+    ResponsesResponse last_;
+};
+
+/**
+ * @brief Map a Responses API stream event onto `assembler`
+ *
+ * Handles response.output_item.added (function_call), response.function_call_arguments.delta
+ * and .done, and response.output_item.done. Returns true for function-call events.
+ */
+bool applyResponsesStreamEvent(llmcpp::ToolCallAssembler& assembler, const json& event);
+
+}  // namespace OpenAI
@@ -1,12 +1,19 @@
 #pragma once
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
 #include <nlohmann/json.hpp>
 #include <optional>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
 #include "core/LLMTypes.h"
+#include "core/ModelCatalog.h"
+#include "core/PromptCache.h"
 #include "utils/JsonUtils.h"
 
 using json = nlohmann::json;
@@ -64,21 +71,41 @@ class TextOutputConfig {
    public:
     TextOutputConfig() = default;
     TextOutputConfig(std::string name, json schema, bool strict = true)
+        : formatName(std::move(name)),
+          formatSchema(llmcpp::SchemaInterner::intern(std::move(schema))),
+          isStrict(strict) {}
+    TextOutputConfig(std::string name, llmcpp::SchemaRef schema, bool strict = true)
         : formatName(std::move(name)), formatSchema(std::move(schema)), isStrict(strict) {}
 
-    json toJson() const {
+    json toJson() const { return toJson(false); }
+
+    // With `schemaPlaceholder`, the schema is emitted as schemaPlaceholderToken() so the
+    // serializer can splice in the interned canonical bytes instead of copying the tree
+    json toJson(bool schemaPlaceholder) const {
         if (formatName.empty()) {
             return json{{"format", {{"type", "text"}}}};
         }
 
-        json formatObj = {{"type", "json_schema"},
-                          {"name", formatName},
-                          {"strict", isStrict},
-                          {"schema", formatSchema}};
+        json formatObj = {{"type", "json_schema"}, {"name", formatName}, {"strict", isStrict}};
+        if (!formatSchema) {
+            formatObj["schema"] = json::object();
+        } else if (schemaPlaceholder) {
+            formatObj["schema"] = schemaPlaceholderToken();
+        } else {
+            formatObj["schema"] = formatSchema->value();
+        }
 
         return json{{"format", formatObj}};
     }
 
+    const std::string& name() const { return formatName; }
+    const llmcpp::SchemaRef& schema() const { return formatSchema; }
+    bool strict() const { return isStrict; }
+
+    std::string schemaPlaceholderToken() const {
+        return formatSchema ? "@llmcpp-interned-schema:" + formatSchema->hash().toHex() : "";
+    }
+
     static TextOutputConfig fromJson(const json& j) {
         if (!j.contains("format")) {
             return TextOutputConfig{};
@@ -95,12 +122,13 @@ class TextOutputConfig {
             strict = !format["json_schema"]["additionalProperties"].get<bool>();
         }
 
-        return TextOutputConfig{format["name"].get<std::string>(), format["json_schema"], strict};
+        return TextOutputConfig{format["name"].get<std::string>(), json(format["json_schema"]),
+                                strict};
     }
 
    private:
     std::string formatName;
-    json formatSchema;
+    llmcpp::SchemaRef formatSchema;
     bool isStrict = true;
 };
 
@@ -234,30 +262,8 @@ inline Model modelFromString(const std::string& modelStr) {
  * Check if model supports structured outputs via Responses API
  */
 inline bool supportsStructuredOutputs(Model model) {
-    switch (model) {
-        case Model::GPT_5:
-        case Model::GPT_5_Mini:
-        case Model::GPT_5_Nano:
-        case Model::O3:
-        case Model::O3_Mini:
-        case Model::O1:
-        case Model::O1_Mini:
-        case Model::O1_Preview:
-        case Model::O1_Pro:
-        case Model::O4_Mini:
-        case Model::O4_Mini_Deep_Research:
-        case Model::GPT_4_1:
-        case Model::GPT_4_1_Mini:
-        case Model::GPT_4_1_Nano:
-        case Model::GPT_4o:
-        case Model::GPT_4o_Mini:
-        case Model::GPT_4_5:
-            return true;
-        case Model::GPT_3_5_Turbo:
-        case Model::Custom:
-            return false;
-    }
-    return false;
+    const auto* info = llmcpp::findModel(toString(model));
+    return info && info->supports(llmcpp::ModelFeature::StructuredOutputs);
 }
 
 // OpenAI-specific simple message structure for convenience
@@ -453,6 +459,22 @@ struct ResponsesInput {
     }
 };
 
+// Function call output for tool responses
+struct FunctionCallOutput {
+    std::string type = "function_call_output";
+    std::string callId;
+    std::string output;
+
+    json toJson() const { return json{{"type", type}, {"call_id", callId}, {"output", output}}; }
+
+    static FunctionCallOutput fromJson(const json& j) {
+        FunctionCallOutput output;
+        output.callId = j.at("call_id").get<std::string>();
+        output.output = j.at("output").get<std::string>();
+        return output;
+    }
+};
+
 // Responses API request structure
 struct ResponsesRequest {
     std::string model;
@@ -470,10 +492,73 @@ struct ResponsesRequest {
     std::string reasoningEffort = "medium";
     std::string metadata;
     std::optional<json> reasoning;
+    std::string previousResponseId;                  // Continue from a stored response
+    std::vector<FunctionCallOutput> functionOutputs;  // Tool results, sent after `input`
 
     static ResponsesRequest fromLLMRequest(const struct LLMRequest& request);
     static ResponsesRequest fromJson(const json& j);
-    json toJson() const;
+    json toJson() const { return toJson(false); }
+    json toJson(bool schemaPlaceholder) const;
+
+    // Canonical tools, instructions and output format: what OpenAI's prefix cache can reuse
+    llmcpp::PromptPrefix staticPrefix() const;
+
+    // Replace the schema placeholder in a dumped body with the interned canonical schema
+    std::string spliceSchema(std::string body) const;
+    // Same, but splice `schema` (e.g. its strict-normalized form) in place of text->schema()
+    std::string spliceSchema(std::string body, const llmcpp::SchemaRef& schema) const;
+};
+
+/**
+ * @brief Positions of Responses API output items by type, built in one pass over the output
+ *
+ * Extractors walk only the items of the type they need instead of rescanning the whole
+ * output and comparing "type" strings. mcp_call items are also grouped by tool name.
+ * Positions refer to the output as it was when the index was built.
+ */
+class ResponseOutputIndex {
+   public:
+    enum class ItemType : uint8_t {
+        Message,       // "message"
+        Text,          // "text" (legacy)
+        FunctionCall,  // "function_call"
+        Image,         // "image"
+        McpCall,       // "mcp_call"
+        McpListTools,  // "mcp_list_tools"
+        Other
+    };
+
+    explicit ResponseOutputIndex(const std::vector<json>& output);
+
+    static ItemType typeOf(const json& item);
+
+    // Calls fn(item) for each item of `type`: through `index` when given (it must have been
+    // built from `output`), otherwise by scanning `output`
+    template <typename Fn>
+    static void forEachItem(const std::vector<json>& output, const ResponseOutputIndex* index,
+                            ItemType type, Fn&& fn) {
+        if (index) {
+            for (size_t pos : index->items(type)) fn(output[pos]);
+            return;
+        }
+        for (const auto& item : output) {
+            if (typeOf(item) == type) fn(item);
+        }
+    }
+
+    // Positions into the indexed output, in output order
+    std::span<const size_t> items(ItemType type) const {
+        return byType_[static_cast<size_t>(type)];
+    }
+    // Positions of the mcp_call items naming `tool`
+    std::span<const size_t> mcpCalls(std::string_view tool) const;
+    // Distinct tools named by mcp_call items, in order of first call
+    const std::vector<std::string>& mcpToolsUsed() const { return toolsUsed_; }
+
+   private:
+    std::array<std::vector<size_t>, static_cast<size_t>(ItemType::Other) + 1> byType_;
+    std::map<std::string, std::vector<size_t>, std::less<>> callsByTool_;
+    std::vector<std::string> toolsUsed_;
 };
 
 // Responses API response structure
@@ -504,9 +589,16 @@ struct ResponsesResponse {
     std::vector<json> output;
 
     LLMResponse toLLMResponse(bool expectStructuredOutput = false) const;
+    // Each extractor scans `output` once. To run several against one response, build the index
+    // once with outputIndex() and pass it to the overloads here and in McpUtils; the index is a
+    // snapshot of `output` and must be rebuilt after `output` changes.
     std::string getOutputText() const;
+    std::string getOutputText(const ResponseOutputIndex& index) const;
     std::vector<FunctionCall> getFunctionCalls() const;
+    std::vector<FunctionCall> getFunctionCalls(const ResponseOutputIndex& index) const;
     std::vector<ImageGenerationCall> getImageGenerations() const;
+    std::vector<ImageGenerationCall> getImageGenerations(const ResponseOutputIndex& index) const;
+    ResponseOutputIndex outputIndex() const { return ResponseOutputIndex(output); }
     bool hasError() const;
     bool isCompleted() const { return status == ResponseStatus::Completed; }
     static ResponsesResponse fromJson(const json& j);
@@ -529,20 +621,26 @@ struct OpenAIConfig {
                   {"base_url", baseUrl},
                   {"timeout_seconds", timeoutSeconds},
                   {"max_retries", maxRetries},
+                  {"verify_ssl", verifySSL},
                   {"enable_deprecation_warnings", enableDeprecationWarnings}};
         if (!organization.empty()) j["organization"] = organization;
         if (!project.empty()) j["project"] = project;
+        if (!headers.empty()) j["headers"] = headers;
         return j;
     }
 
     static OpenAIConfig fromJson(const json& j) {
         OpenAIConfig config;
         if (j.contains("api_key")) config.apiKey = j["api_key"].get<std::string>();
+        else if (j.contains("apiKey")) config.apiKey = j["apiKey"].get<std::string>();
         if (j.contains("base_url")) config.baseUrl = j["base_url"].get<std::string>();
         if (j.contains("organization")) config.organization = j["organization"].get<std::string>();
         if (j.contains("project")) config.project = j["project"].get<std::string>();
         if (j.contains("timeout_seconds")) config.timeoutSeconds = j["timeout_seconds"].get<int>();
         if (j.contains("max_retries")) config.maxRetries = j["max_retries"].get<int>();
+        if (j.contains("verify_ssl")) config.verifySSL = j["verify_ssl"].get<bool>();
+        if (j.contains("headers"))
+            config.headers = j["headers"].get<std::map<std::string, std::string>>();
         if (j.contains("enable_deprecation_warnings"))
             config.enableDeprecationWarnings = j["enable_deprecation_warnings"].get<bool>();
         return config;
@@ -576,33 +674,30 @@ struct ChatMessage {
     }
 };
 
+/**
+ * Chat messages for request context
+ *
+ * Role/content entries, alone or in arrays, map to messages as they are; any other value is
+ * sent as a user message, strings verbatim and everything else as serialized JSON.
+ */
+std::vector<ChatMessage> chatMessagesFromContext(const LLMContext& context);
+
 // Chat Completion API structures
 struct ChatCompletionRequest {
     std::string model;
     std::vector<ChatMessage> messages;
     std::optional<float> temperature;
     std::optional<int> maxTokens;
+    std::optional<float> topP;
+    std::optional<int> n;  // Number of choices to generate
     std::optional<std::vector<std::string>> stop;
-    std::optional<bool> stream;
+    std::optional<bool> stream;  // Streaming bodies also ask for a final usage chunk
     std::optional<std::string> user;
-    std::optional<std::vector<ToolVariant>> tools;
+    std::optional<std::vector<ToolVariant>> tools;  // Function tools only
     std::optional<ToolChoiceMode> toolChoice;
-    std::optional<TextOutputConfig> text;
+    std::optional<TextOutputConfig> text;  // Sent as response_format
 
-    json toJson() const {
-        json j = {{"model", model}};
-        json msgs = json::array();
-        for (const auto& msg : messages) {
-            msgs.push_back(msg.toJson());
-        }
-        j["messages"] = msgs;
-        if (temperature.has_value()) j["temperature"] = temperature.value();
-        if (maxTokens.has_value()) j["max_tokens"] = maxTokens.value();
-        if (stop.has_value()) j["stop"] = stop.value();
-        if (stream.has_value()) j["stream"] = stream.value();
-        if (user.has_value()) j["user"] = user.value();
-        return j;
-    }
+    json toJson() const;
 
     static ChatCompletionRequest fromLLMRequest(const struct LLMRequest& request);
     struct LLMRequest toLLMRequest() const;
@@ -610,10 +705,11 @@ struct ChatCompletionRequest {
 };
 
 struct ChatCompletionChoice {
-    int index;
+    int index = 0;
     Message message;
     std::optional<std::string> finishReason;
     std::optional<json> logprobs;
+    std::optional<json> toolCalls;  // message.tool_calls
 
     static ChatCompletionChoice fromJson(const json& j);
 };
@@ -621,15 +717,34 @@ struct ChatCompletionChoice {
 struct ChatCompletionResponse {
     std::string id;
     std::string object;
-    int64_t created;
+    int64_t created = 0;
     std::string model;
-    std::vector<ChatCompletionChoice> choices;
+    std::vector<ChatCompletionChoice> choices;  // Ordered by index
     std::optional<std::string> systemFingerprint;
     LLMUsage usage;
 
     static ChatCompletionResponse fromJson(const json& j);
+
+    /**
+     * `result` holds {"text": ...} for the first choice, or its parsed JSON when
+     * `expectStructuredOutput`; tool calls are listed under "function_calls". With several
+     * text choices, `result["choices"]` holds the text of each.
+     */
+    LLMResponse toLLMResponse(bool expectStructuredOutput = false) const;
 };
 
+/**
+ * Merge one `chat.completion.chunk` stream event into `response`
+ *
+ * Content and tool-call argument deltas are appended per choice; the final usage chunk
+ * (stream_options.include_usage) fills in `usage`.
+ * @return The content delta of the first choice, empty if the chunk carried none
+ */
+std::string applyChatCompletionChunk(ChatCompletionResponse& response, const json& chunk);
+
+// LLMUsage from a Responses or Chat Completions `usage` object, including cached prompt tokens
+LLMUsage usageFromJson(const json& usage);
+
 // Tool definitions
 struct FunctionTool {
     std::string name;
@@ -779,22 +894,6 @@ inline ToolChoiceMode toolChoiceModeFromString(const std::string& str) {
     throw std::invalid_argument("Invalid tool choice mode: " + str);
 }
 
-// Function call output for tool responses
-struct FunctionCallOutput {
-    std::string type = "function_call_output";
-    std::string callId;
-    std::string output;
-
-    json toJson() const { return json{{"type", type}, {"call_id", callId}, {"output", output}}; }
-
-    static FunctionCallOutput fromJson(const json& j) {
-        FunctionCallOutput output;
-        output.callId = j.at("call_id").get<std::string>();
-        output.output = j.at("output").get<std::string>();
-        return output;
-    }
-};
-
 // MCP approval response
 struct McpApprovalResponse {
     std::string type = "mcp_approval_response";
@@ -876,14 +975,12 @@ bool supportsChatCompletions(const std::string& model);
 
 std::string getRecommendedApiForModel(const std::string& model);
 
-// Model lists for different APIs
-const std::vector<std::string> RESPONSES_MODELS = {
-    "gpt-5",        "gpt-5-mini",          "gpt-5-nano",  "gpt-4o", "gpt-4o-mini", "gpt-4.1",
-    "gpt-4.1-nano", "gpt-4.1-mini",        "gpt-image-1", "o1",     "o3-mini",     "o3",
-    "o4-mini",      "computer-use-preview"};
+// Model lists for different APIs, derived from the model catalog (see core/ModelCatalog.h)
+inline const std::vector<std::string> RESPONSES_MODELS =
+    llmcpp::modelNames(llmcpp::ModelProvider::OpenAI, llmcpp::ModelFeature::ResponsesApi);
 
-const std::vector<std::string> CHAT_COMPLETION_MODELS = {"gpt-4", "gpt-4-turbo", "gpt-4o",
-                                                         "gpt-4o-mini", "gpt-3.5-turbo"};
+inline const std::vector<std::string> CHAT_COMPLETION_MODELS =
+    llmcpp::modelNames(llmcpp::ModelProvider::OpenAI, llmcpp::ModelFeature::ChatCompletionsApi);
 
 /**
  * Implementation stubs for conversion methods
@@ -910,14 +1007,11 @@ const std::vector<std::string> CHAT_COMPLETION_MODELS = {"gpt-4", "gpt-4-turbo",
 // Implementation moved to .cpp file to avoid circular dependency
 
 inline bool supportsResponses(const std::string& model) {
-    return std::any_of(
-        RESPONSES_MODELS.begin(), RESPONSES_MODELS.end(),
-        [&model](const std::string& responsesModel) { return model == responsesModel; });
+    return llmcpp::modelSupports(model, llmcpp::ModelFeature::ResponsesApi);
 }
 
 inline bool supportsChatCompletions(const std::string& model) {
-    return std::any_of(CHAT_COMPLETION_MODELS.begin(), CHAT_COMPLETION_MODELS.end(),
-                       [&model](const std::string& chatModel) { return model == chatModel; });
+    return llmcpp::modelSupports(model, llmcpp::ModelFeature::ChatCompletionsApi);
 }
 
 inline std::string getRecommendedApiForModel(const std::string& model) {
@@ -1,7 +1,9 @@
 #pragma once
+#include <functional>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
 
 #include "core/LLMClient.h"
 
@@ -10,13 +12,67 @@ using json = nlohmann::json;
 namespace llmcpp {
 
 /**
- * Factory for creating LLM clients
+ * Factory for creating LLM clients from a registry of provider constructors
+ *
+ * Each provider registers a constructor that receives the full JSON config, so every setting
+ * the provider understands (base URL, timeouts, retries, headers, ...) can come from
+ * deployment config. "openai", "anthropic" and "local" (OpenAI-compatible self-hosted
+ * servers, see Local::LocalConfig) are registered by the library; other backends
+ * register themselves with ProviderRegistrar or registerProvider() without changes here.
+ *
+ * Example usage:
+ * @code
+ * auto client = llmcpp::ClientFactory::createClient(
+ *     "openai", json{{"api_key", key}, {"timeout_seconds", 120}, {"max_retries", 5}});
+ * @endcode
  */
 class ClientFactory {
    public:
+    using Constructor = std::function<std::unique_ptr<LLMClient>(const json& config)>;
+
+    /**
+     * Register `constructor` under `provider`, replacing any previous registration
+     */
+    static void registerProvider(const std::string& provider, Constructor constructor);
+    static bool unregisterProvider(const std::string& provider);
+
+    static bool isProviderSupported(const std::string& provider);
+    static std::vector<std::string> getSupportedProviders();  // Sorted
+
+    /**
+     * Construct a client for `provider` from `config`
+     *
+     * @return nullptr if no provider is registered under that name; configuration errors are
+     *         reported by the provider's constructor (e.g. std::invalid_argument for a
+     *         missing API key)
+     */
     static std::unique_ptr<LLMClient> createClient(const std::string& provider, const json& config);
+
+    // Shorthand for createClient(provider, {{"api_key", apiKey}})
     static std::unique_ptr<LLMClient> createClient(const std::string& provider,
                                                    const std::string& apiKey);
+    static std::unique_ptr<LLMClient> createClient(const std::string& provider,
+                                                   const char* apiKey) {
+        return createClient(provider, std::string(apiKey));
+    }
+};
+
+/**
+ * Registers a provider during static initialization
+ *
+ * Place the registrar in the translation unit that defines the client. With static linking,
+ * that object file must be referenced from elsewhere or the linker may drop it.
+ *
+ * @code
+ * static const llmcpp::ProviderRegistrar registerMock("mock", [](const json& config) {
+ *     return std::make_unique<MockClient>(config);
+ * });
+ * @endcode
+ */
+struct ProviderRegistrar {
+    ProviderRegistrar(const std::string& provider, ClientFactory::Constructor constructor) {
+        ClientFactory::registerProvider(provider, std::move(constructor));
+    }
 };
 
 }  // namespace llmcpp
@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+"""
+Performance baselines for llmcpp
+Runs the microbenchmarks and mock-server load tests, stores versioned JSON
+baselines and flags statistically significant regressions between runs.
+"""
+
+import json
+import platform
+import random
+import re
+import subprocess
+import sys
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+SCHEMA_VERSION = 1
+BASELINE_DIR = Path("tests/bench/baselines")
+
+# Mock-server scenarios driven through the real clients (no network access needed)
+LOADGEN_SCENARIOS = [
+    {"name": "openai-c8", "args": ["--provider", "openai", "--requests", "2000", "--concurrency", "8"]},
+    {"name": "anthropic-c8", "args": ["--provider", "anthropic", "--requests", "2000", "--concurrency", "8"]},
+]
+
+
+class PerfBaseline:
+    def __init__(self, build_dir: str = "build", threshold: float = 0.05,
+                 confidence: float = 0.95, resamples: int = 2000):
+        self.build_dir = Path(build_dir)
+        self.threshold = threshold
+        self.confidence = confidence
+        self.resamples = resamples
+
+    def get_current_version(self) -> str:
+        """Extract current version from CMakeLists.txt"""
+        content = Path("CMakeLists.txt").read_text()
+        match = re.search(r'project\(llmcpp VERSION ([0-9.]+)\)', content)
+        return match.group(1) if match else "unknown"
+
+    def git_commit(self) -> str:
+        result = subprocess.run(['git', 'rev-parse', '--short', 'HEAD'],
+                                capture_output=True, text=True, check=False)
+        return result.stdout.strip() if result.returncode == 0 else "unknown"
+
+    # Running
+
+    def run(self, skip_loadgen: bool = False) -> Dict:
+        """Run all benchmarks and return a baseline document"""
+        microbench = self.build_dir / "tests" / "llmcpp_microbench"
+        loadgen = self.build_dir / "tests" / "llmcpp_loadgen"
+        if not microbench.exists():
+            print(f"❌ {microbench} not found. Build with 'make tests' first.")
+            sys.exit(2)
+
+        micro_json = self.build_dir / "microbench.json"
+        print("🔬 Running microbenchmarks...")
+        subprocess.run([str(microbench), "--json", str(micro_json), "--quiet"], check=True)
+        micro = json.loads(micro_json.read_text())
+
+        loadgen_results = []
+        if not skip_loadgen and loadgen.exists():
+            for scenario in LOADGEN_SCENARIOS:
+                print(f"🚚 Running load scenario {scenario['name']}...")
+                output = subprocess.run([str(loadgen), "--json"] + scenario["args"],
+                                        capture_output=True, text=True, check=True).stdout
+                report = json.loads(output)
+                report["scenario"] = scenario["name"]
+                loadgen_results.append(report)
+
+        return {
+            "schema_version": SCHEMA_VERSION,
+            "version": self.get_current_version(),
+            "git_commit": self.git_commit(),
+            "created_at": datetime.now(timezone.utc).isoformat(timespec="seconds"),
+            "host": {
+                "system": platform.system(),
+                "machine": platform.machine(),
+                "processor": platform.processor(),
+            },
+            "microbench": micro,
+            "loadgen": loadgen_results,
+        }
+
+    # Statistics
+
+    def bootstrap_ratio(self, base: List[float], current: List[float],
+                        quantile: float = 0.5) -> Tuple[float, float, float]:
+        """Ratio current/base of a quantile with a bootstrap confidence interval"""
+        def stat(values: List[float]) -> float:
+            ordered = sorted(values)
+            return ordered[min(len(ordered) - 1, int(quantile * (len(ordered) - 1) + 0.5))]
+
+        rng = random.Random(0)  # Deterministic so the gate gives the same answer twice
+        point = stat(current) / stat(base)
+        ratios = []
+        for _ in range(self.resamples):
+            b = stat([rng.choice(base) for _ in base])
+            c = stat([rng.choice(current) for _ in current])
+            ratios.append(c / b if b > 0 else float("inf"))
+        ratios.sort()
+        alpha = (1.0 - self.confidence) / 2.0
+        low = ratios[int(alpha * (len(ratios) - 1))]
+        high = ratios[int((1.0 - alpha) * (len(ratios) - 1))]
+        return point, low, high
+
+    def classify(self, low: float, high: float) -> str:
+        if low > 1.0 + self.threshold:
+            return "regression"
+        if high < 1.0 - self.threshold:
+            return "improvement"
+        return "ok"
+
+    # Comparison
+
+    def compare(self, baseline: Dict, current: Dict) -> List[Dict]:
+        findings = []
+
+        if baseline.get("host") != current.get("host"):
+            print("⚠️  Baseline was recorded on a different host; timings may not be comparable")
+
+        base_micro = {(r["name"], r["param"]): r for r in baseline["microbench"]["results"]}
+        for result in current["microbench"]["results"]:
+            key = (result["name"], result["param"])
+            base = base_micro.get(key)
+            if base is None:
+                continue
+            label = f"{key[0]}/{key[1]}" if key[1] else key[0]
+
+            point, low, high = self.bootstrap_ratio(base["samples_ns"], result["samples_ns"])
+            findings.append({"case": label, "metric": "time", "ratio": point,
+                             "ci": [low, high], "status": self.classify(low, high)})
+
+            # Allocation counts are deterministic, so a plain threshold is enough
+            for metric in ("allocs_per_op", "alloc_bytes_per_op"):
+                if metric in base and metric in result:
+                    before, after = base[metric], result[metric]
+                    ratio = after / before if before > 0 else (1.0 if after == 0 else float("inf"))
+                    status = "ok"
+                    if after - before >= 1 and ratio > 1.0 + self.threshold:
+                        status = "regression"
+                    elif before - after >= 1 and ratio < 1.0 - self.threshold:
+                        status = "improvement"
+                    findings.append({"case": label, "metric": metric, "ratio": ratio,
+                                     "ci": None, "status": status})
+
+        base_load = {r["scenario"]: r for r in baseline.get("loadgen", [])}
+        for report in current.get("loadgen", []):
+            base = base_load.get(report["scenario"])
+            if base is None:
+                continue
+            for metric, quantile in (("latency_p50", 0.5), ("latency_p99", 0.99)):
+                point, low, high = self.bootstrap_ratio(
+                    base["latency_samples_ms"], report["latency_samples_ms"], quantile)
+                findings.append({"case": report["scenario"], "metric": metric, "ratio": point,
+                                 "ci": [low, high], "status": self.classify(low, high)})
+
+        return findings
+
+    def print_findings(self, findings: List[Dict]) -> None:
+        icons = {"ok": "  ", "regression": "❌", "improvement": "✅"}
+        for f in findings:
+            if f["status"] == "ok" and f["metric"] != "time":
+                continue
+            ci = f" [{f['ci'][0]:.3f}, {f['ci'][1]:.3f}]" if f["ci"] else ""
+            print(f"{icons[f['status']]} {f['case']:<55} {f['metric']:<18} x{f['ratio']:.3f}{ci}")
+
+        regressions = [f for f in findings if f["status"] == "regression"]
+        improvements = [f for f in findings if f["status"] == "improvement"]
+        print("")
+        print(f"📊 {len(findings)} comparisons: {len(regressions)} regressions, "
+              f"{len(improvements)} improvements "
+              f"(threshold {self.threshold:.0%}, {self.confidence:.0%} CI)")
+
+    def latest_baseline(self) -> Optional[Path]:
+        def version_key(path: Path):
+            return tuple(int(p) if p.isdigit() else 0 for p in path.stem.split("."))
+
+        baselines = sorted(BASELINE_DIR.glob("*.json"), key=version_key)
+        return baselines[-1] if baselines else None
+
+    def show_help(self) -> None:
+        """Show help message"""
+        print("""Usage: python scripts/perf-baseline.py <command> [options]
+
+Commands:
+  record [path]               - Run benchmarks and store a baseline
+                                (default: tests/bench/baselines/<version>.json)
+  run <path>                  - Run benchmarks and write the results to <path>
+  compare <baseline> <current> - Compare two result files; exit 1 on regression
+  gate                        - Run benchmarks and compare against the latest baseline
+  help                        - Show this help message
+
+Options:
+  --build-dir DIR    Build directory containing tests/llmcpp_microbench (default: build)
+  --threshold F      Relative change treated as significant (default: 0.05)
+  --confidence F     Bootstrap confidence level (default: 0.95)
+  --skip-loadgen     Only run the microbenchmarks
+
+Examples:
+  python scripts/perf-baseline.py record
+  python scripts/perf-baseline.py gate --threshold 0.10
+""")
+
+
+def main():
+    args = sys.argv[1:]
+    options = {"--build-dir": "build", "--threshold": "0.05", "--confidence": "0.95"}
+    skip_loadgen = False
+    positional = []
+    i = 0
+    while i < len(args):
+        if args[i] in options and i + 1 < len(args):
+            options[args[i]] = args[i + 1]
+            i += 2
+        elif args[i] == "--skip-loadgen":
+            skip_loadgen = True
+            i += 1
+        else:
+            positional.append(args[i])
+            i += 1
+
+    perf = PerfBaseline(options["--build-dir"], float(options["--threshold"]),
+                        float(options["--confidence"]))
+    command = positional[0] if positional else "help"
+
+    if command == "record":
+        path = Path(positional[1]) if len(positional) > 1 else \
+            BASELINE_DIR / f"{perf.get_current_version()}.json"
+        path.parent.mkdir(parents=True, exist_ok=True)
+        path.write_text(json.dumps(perf.run(skip_loadgen), indent=2) + "\n")
+        print(f"✅ Baseline written to {path}")
+    elif command == "run":
+        if len(positional) < 2:
+            print("❌ Usage: python scripts/perf-baseline.py run <path>")
+            sys.exit(1)
+        Path(positional[1]).write_text(json.dumps(perf.run(skip_loadgen), indent=2) + "\n")
+    elif command == "compare":
+        if len(positional) < 3:
+            print("❌ Usage: python scripts/perf-baseline.py compare <baseline> <current>")
+            sys.exit(1)
+        baseline = json.loads(Path(positional[1]).read_text())
+        current = json.loads(Path(positional[2]).read_text())
+        findings = perf.compare(baseline, current)
+        perf.print_findings(findings)
+        sys.exit(1 if any(f["status"] == "regression" for f in findings) else 0)
+    elif command == "gate":
+        baseline_path = perf.latest_baseline()
+        if baseline_path is None:
+            print(f"⚠️  No baseline in {BASELINE_DIR}; skipping performance gate")
+            sys.exit(0)
+        print(f"📏 Comparing against {baseline_path}")
+        findings = perf.compare(json.loads(baseline_path.read_text()), perf.run(skip_loadgen))
+        perf.print_findings(findings)
+        sys.exit(1 if any(f["status"] == "regression" for f in findings) else 0)
+    elif command in ["help", "-h", "--help"]:
+        perf.show_help()
+    else:
+        print(f"❌ Unknown command: {command}")
+        print("Use 'python scripts/perf-baseline.py help' for usage information")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -147,6 +147,25 @@ check_git_status() {
     fi
 }
 
+check_performance() {
+    if [ "${LLMCPP_SKIP_PERF_GATE:-0}" = "1" ]; then
+        print_warning "LLMCPP_SKIP_PERF_GATE=1, skipping performance gate"
+        return
+    fi
+
+    if [ ! -x "$PROJECT_DIR/build/tests/llmcpp_microbench" ]; then
+        print_warning "Benchmarks not built (run 'make tests'), skipping performance gate"
+        return
+    fi
+
+    print_info "Checking for performance regressions against the latest baseline..."
+    if ! python3 "$PROJECT_DIR/scripts/perf-baseline.py" gate --build-dir "$PROJECT_DIR/build"; then
+        print_error "Performance regressions detected. Fix them or set LLMCPP_SKIP_PERF_GATE=1."
+        exit 1
+    fi
+    print_success "No performance regressions"
+}
+
 main() {
     cd "$PROJECT_DIR"
     
@@ -161,6 +180,9 @@ main() {
     
     # Check git status
     check_git_status
+
+    # Hold the release back on benchmark regressions
+    check_performance
     
     # Get current version
     local current_version
@@ -1,10 +1,15 @@
 #include "anthropic/AnthropicClient.h"
 
+#include <chrono>
 #include <future>
+#include <optional>
 #include <stdexcept>
 #include <thread>
 
 #include "anthropic/AnthropicHttpClient.h"
+#include "core/CompiledSchema.h"
+#include "core/CostMeter.h"
+#include "core/Tracing.h"
 
 namespace Anthropic {
 
@@ -16,11 +21,13 @@ class AnthropicClient::ClientImpl {
     explicit ClientImpl(const AnthropicConfig& config)
         : config_(config), httpClient_(std::make_unique<AnthropicHttpClient>(config)) {}
 
-    void sendRequest(const LLMRequest& request, LLMResponseCallback callback) {
+    void sendRequest(const LLMRequest& request, LLMResponseCallback callback,
+                     RequestHooks hooks) {
         // Run the request in a separate thread to make it async
-        std::thread([this, request, callback]() {
+        auto enqueuedAt = std::chrono::steady_clock::now();
+        std::thread([this, request, callback, enqueuedAt, hooks]() {
             try {
-                auto response = sendRequestSync(request);
+                auto response = sendRequestSync(request, hooks, enqueuedAt);
                 callback(response);
             } catch (const std::exception& e) {
                 LLMResponse errorResponse;
@@ -32,41 +39,86 @@ class AnthropicClient::ClientImpl {
     }
 
     void sendStreamingRequest(const LLMRequest& request, LLMResponseCallback onDone,
-                              LLMStreamCallback onChunk) {
+                              LLMStreamCallback onChunk, RequestHooks hooks) {
         // Anthropic doesn't support streaming in this implementation yet
         // Fall back to regular request
         (void)onChunk;  // Suppress unused parameter warning
-        sendRequest(request, std::move(onDone));
+        sendRequest(request, std::move(onDone), std::move(hooks));
     }
 
-    LLMResponse sendRequestSync(const LLMRequest& request) {
+    LLMResponse sendRequestSync(
+        const LLMRequest& request, const RequestHooks& hooks,
+        std::optional<std::chrono::steady_clock::time_point> enqueuedAt = std::nullopt) {
+        llmcpp::Span span("llm.client.request", request.traceContext,
+                          llmcpp::SpanData::Kind::Client);
+        span.setAttribute("llm.system", "anthropic");
+        if (enqueuedAt) {
+            std::chrono::duration<double, std::milli> queued =
+                std::chrono::steady_clock::now() - *enqueuedAt;
+            span.setAttribute("llm.queue_time_ms", queued.count());
+        }
+
+        LLMResponse response;
         try {
+            llmcpp::throwIfCancelled(request.cancellation);
+
+            // Budget check and context fitting happen before conversion
+            const std::string model = request.config.model.empty()
+                                          ? toString(config_.defaultModel)
+                                          : request.config.model;
+            llmcpp::BudgetReservation reservation;  // Released on failure
+            auto prepared = hooks.prepare(request, model, span, reservation);
+            const LLMRequest& sent = prepared ? *prepared : request;
+
             // Convert LLMRequest to MessagesRequest
-            auto messagesRequest = MessagesRequest::fromLLMRequest(request);
+            auto messagesRequest = MessagesRequest::fromLLMRequest(sent);
 
             // Use default model if none specified
             if (messagesRequest.model.empty()) {
                 messagesRequest.model = toString(config_.defaultModel);
             }
+            span.setAttribute("llm.model", messagesRequest.model);
+            if (request.config.extensions.contains("cache_control")) {
+                span.setAttribute("llm.prompt.prefix_hash",
+                                  messagesRequest.staticPrefix().hash.toHex());
+            }
 
             // Send the request
-            auto messagesResponse = httpClient_->sendMessagesRequest(messagesRequest);
+            auto messagesResponse =
+                httpClient_->sendMessagesRequest(messagesRequest, request.cancellation);
 
             // Convert back to LLMResponse
             // Check if structured output is expected based on JSON schema
-            bool expectStructured =
-                !request.config.jsonSchema.empty() || request.config.schemaObject.has_value();
-            return messagesResponse.toLLMResponse(expectStructured);
+            bool expectStructured = request.config.hasSchema();
+            response = messagesResponse.toLLMResponse(expectStructured);
+            hooks.recordCost(sent, messagesRequest.model, response.usage, span, reservation);
+            llmcpp::validateStructuredOutput(request.config, response);
+        } catch (const llmcpp::OperationCancelled& e) {
+            response = LLMResponse{};
+            response.success = false;
+            response.errorMessage = e.what();
+            span.setAttribute("llm.cancelled", true);
         } catch (const std::exception& e) {
-            LLMResponse errorResponse;
-            errorResponse.success = false;
-            errorResponse.errorMessage = e.what();
-            return errorResponse;
+            response = LLMResponse{};
+            response.success = false;
+            response.errorMessage = e.what();
+        }
+
+        span.setAttribute("llm.response.id", response.responseId);
+        span.setAttribute("llm.usage.input_tokens", response.usage.inputTokens);
+        span.setAttribute("llm.usage.output_tokens", response.usage.outputTokens);
+        span.setAttribute("llm.usage.cached_input_tokens", response.usage.cachedInputTokens);
+        if (response.success) {
+            span.setStatus(llmcpp::SpanData::StatusCode::Ok);
+        } else {
+            span.recordError(response.errorMessage);
         }
+        return response;
     }
 
-    MessagesResponse sendMessagesRequest(const MessagesRequest& request) {
-        return httpClient_->sendMessagesRequest(request);
+    MessagesResponse sendMessagesRequest(const MessagesRequest& request,
+                                         const llmcpp::CancellationToken& cancel) {
+        return httpClient_->sendMessagesRequest(request, cancel);
     }
 
     std::vector<std::string> getAvailableModels() const { return Anthropic::getAvailableModels(); }
@@ -111,12 +163,12 @@ AnthropicClient::AnthropicClient(AnthropicClient&& other) noexcept = default;
 AnthropicClient& AnthropicClient::operator=(AnthropicClient&& other) noexcept = default;
 
 void AnthropicClient::sendRequest(const LLMRequest& request, LLMResponseCallback callback) {
-    pImpl->sendRequest(request, std::move(callback));
+    pImpl->sendRequest(request, std::move(callback), hooks_);
 }
 
 void AnthropicClient::sendStreamingRequest(const LLMRequest& request, LLMResponseCallback onDone,
                                            LLMStreamCallback onChunk) {
-    pImpl->sendStreamingRequest(request, std::move(onDone), std::move(onChunk));
+    pImpl->sendStreamingRequest(request, std::move(onDone), std::move(onChunk), hooks_);
 }
 
 std::vector<std::string> AnthropicClient::getAvailableModels() const {
@@ -127,12 +179,13 @@ bool AnthropicClient::supportsStreaming() const { return pImpl->supportsStreamin
 
 std::string AnthropicClient::getClientName() const { return pImpl->getClientName(); }
 
-MessagesResponse AnthropicClient::sendMessagesRequest(const MessagesRequest& request) {
-    return pImpl->sendMessagesRequest(request);
+MessagesResponse AnthropicClient::sendMessagesRequest(const MessagesRequest& request,
+                                                      const llmcpp::CancellationToken& cancel) {
+    return pImpl->sendMessagesRequest(request, cancel);
 }
 
 LLMResponse AnthropicClient::sendRequest(const LLMRequest& request) {
-    return pImpl->sendRequestSync(request);
+    return pImpl->sendRequestSync(request, hooks_);
 }
 
 const AnthropicConfig& AnthropicClient::getConfig() const { return pImpl->getConfig(); }
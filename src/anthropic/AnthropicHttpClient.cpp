@@ -5,6 +5,8 @@
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 
+#include "core/Tracing.h"
+
 using json = nlohmann::json;
 
 namespace Anthropic {
@@ -57,7 +59,8 @@ class AnthropicHttpClient::HttpClientImpl {
         }
     }
 
-    MessagesResponse sendMessagesRequest(const MessagesRequest& request) {
+    MessagesResponse sendMessagesRequest(const MessagesRequest& request,
+                                         const llmcpp::CancellationToken& cancel) {
         // Build headers
         httplib::Headers headers = buildHeaders();
 
@@ -65,23 +68,54 @@ class AnthropicHttpClient::HttpClientImpl {
         json requestJson = request.toJson();
         std::string requestBody = requestJson.dump();
 
+        // No client-side retries here, so the single attempt is always attempt 0
+        if (auto* clientSpan = llmcpp::Span::current()) {
+            clientSpan->setAttribute("llm.retry.count", 0);
+        }
+        llmcpp::Span attemptSpan("llm.retry.attempt");
+        attemptSpan.setAttribute("llm.retry.attempt", 0);
+
         // Make the API call
+        llmcpp::Span httpSpan("HTTP POST", llmcpp::SpanData::Kind::Client);
+        httpSpan.setAttribute("http.request.method", "POST");
+        httpSpan.setAttribute("server.address", host_);
+        httpSpan.setAttribute("url.path", "/v1/messages");
+        if (httpSpan.isRecording()) {
+            headers.emplace("traceparent", httpSpan.context().toTraceparent());
+        }
+
         httplib::Result result;
         if (useSSL_) {
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-            result = sslClient_->Post("/v1/messages", headers, requestBody, "application/json");
+            result = cancel.stop_possible()
+                         ? postCancellable(headers, requestBody, cancel)
+                         : sslClient_->Post("/v1/messages", headers, requestBody,
+                                            "application/json");
 #else
             throw std::runtime_error(
                 "SSL support not available (OpenSSL>=3 not found at build time)");
 #endif
         } else {
-            result = httpClient_->Post("/v1/messages", headers, requestBody, "application/json");
+            result = cancel.stop_possible()
+                         ? postCancellable(headers, requestBody, cancel)
+                         : httpClient_->Post("/v1/messages", headers, requestBody,
+                                             "application/json");
         }
 
+        if (cancel.stop_requested()) {
+            httpSpan.recordError("Request cancelled");
+            throw llmcpp::OperationCancelled();
+        }
         if (!result) {
+            httpSpan.recordError("Connection error");
             throw std::runtime_error("HTTP request failed: Connection error");
         }
 
+        httpSpan.setAttribute("http.status_code", result->status);
+        httpSpan.setAttribute("http.response.body.size", result->body.size());
+        attemptSpan.setAttribute("http.status_code", result->status);
+        httpSpan.end();
+
         if (result->status != 200) {
             std::string errorMsg = "HTTP " + std::to_string(result->status);
             if (!result->body.empty()) {
@@ -96,11 +130,14 @@ class AnthropicHttpClient::HttpClientImpl {
                     errorMsg += ": " + result->body;
                 }
             }
+            attemptSpan.recordError(errorMsg);
             throw std::runtime_error(errorMsg);
         }
 
         // Parse response
         try {
+            llmcpp::Span parseSpan("llm.response.parse");
+            parseSpan.setAttribute("llm.response.body_size", result->body.size());
             json responseJson = json::parse(result->body);
             return MessagesResponse::fromJson(responseJson);
         } catch (const json::exception& e) {
@@ -109,6 +146,27 @@ class AnthropicHttpClient::HttpClientImpl {
     }
 
    private:
+    // Cancellable requests get a connection of their own: stop() shuts down whatever socket a
+    // client has open, which on the shared client may carry another caller's request
+    httplib::Result postCancellable(const httplib::Headers& headers, const std::string& body,
+                                    const llmcpp::CancellationToken& cancel) const {
+        llmcpp::throwIfCancelled(cancel);
+        httplib::Client client((useSSL_ ? "https://" : "http://") + host_);
+        client.set_read_timeout(config_.timeoutSeconds, 0);
+        client.set_write_timeout(config_.timeoutSeconds, 0);
+
+        httplib::Request req;
+        req.method = "POST";
+        req.path = "/v1/messages";
+        req.headers = headers;
+        req.body = body;
+        req.set_header("Content-Type", "application/json");
+        req.progress = [&cancel](uint64_t, uint64_t) { return !cancel.stop_requested(); };
+
+        std::stop_callback abortRead(cancel, [&client]() { client.stop(); });
+        return client.send(req);
+    }
+
     httplib::Headers buildHeaders() const {
         httplib::Headers headers;
         headers.emplace("x-api-key", config_.apiKey);
@@ -133,8 +191,9 @@ AnthropicHttpClient::AnthropicHttpClient(const AnthropicConfig& config)
 
 AnthropicHttpClient::~AnthropicHttpClient() = default;
 
-MessagesResponse AnthropicHttpClient::sendMessagesRequest(const MessagesRequest& request) {
-    return pImpl->sendMessagesRequest(request);
+MessagesResponse AnthropicHttpClient::sendMessagesRequest(const MessagesRequest& request,
+                                                          const llmcpp::CancellationToken& cancel) {
+    return pImpl->sendMessagesRequest(request, cancel);
 }
 
 }  // namespace Anthropic
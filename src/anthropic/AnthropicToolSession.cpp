@@ -0,0 +1,90 @@
+#include "anthropic/AnthropicToolSession.h"
+
+#include <stdexcept>
+
+#include "anthropic/AnthropicClient.h"
+
+namespace Anthropic {
+
+MessagesToolSession::MessagesToolSession(AnthropicClient& client, MessagesRequest request)
+    : MessagesToolSession(
+          [&client](const MessagesRequest& r) { return client.sendMessagesRequest(r); },
+          std::move(request)) {}
+
+MessagesToolSession::MessagesToolSession(Sender send, MessagesRequest request)
+    : send_(std::move(send)), request_(std::move(request)) {}
+
+llmcpp::ToolTurn MessagesToolSession::start(const std::vector<llmcpp::ToolDefinition>& tools) {
+    for (const auto& definition : tools) {
+        request_.tools.push_back(Tool{.name = definition.name,
+                                      .description = definition.description,
+                                      .inputSchema = definition.parameters,
+                                      .cacheControl = std::nullopt});
+    }
+    return send();
+}
+
+llmcpp::ToolTurn MessagesToolSession::submit(
+    const std::vector<llmcpp::ToolCallResult>& results) {
+    Message message;
+    message.role = MessageRole::USER;
+    message.content.reserve(results.size());
+    for (const auto& result : results) {
+        message.content.push_back(
+            MessageContent::createToolResult(result.id, result.outputText(), result.isError));
+    }
+    request_.messages.push_back(std::move(message));
+    return send();
+}
+
+llmcpp::ToolTurn MessagesToolSession::send() {
+    last_ = send_(request_);
+    if (last_.content.empty()) {
+        throw std::runtime_error("Messages API turn returned no content");
+    }
+    request_.messages.push_back(Message{MessageRole::ASSISTANT, last_.content});
+
+    llmcpp::ToolTurn turn;
+    turn.text = last_.getText();
+    turn.usage = last_.usage.toLLMUsage();
+    turn.responseId = last_.id;
+    for (auto& use : last_.getToolUses()) {
+        turn.calls.push_back({std::move(use.id), std::move(use.name), std::move(use.input)});
+    }
+    return turn;
+}
+
+bool applyMessagesStreamEvent(llmcpp::ToolCallAssembler& assembler, const json& event) {
+    auto type = event.find("type");
+    if (type == event.end() || !type->is_string()) {
+        return false;
+    }
+    const auto& name = type->get_ref<const std::string&>();
+    const size_t index = event.value("index", size_t{0});
+
+    if (name == "content_block_start") {
+        auto block = event.find("content_block");
+        if (block == event.end() || !block->is_object() ||
+            block->value("type", std::string()) != "tool_use") {
+            return false;
+        }
+        assembler.begin(index, block->value("id", std::string()),
+                        block->value("name", std::string()));
+        return true;
+    }
+    if (name == "content_block_delta") {
+        auto delta = event.find("delta");
+        if (delta == event.end() || !delta->is_object() ||
+            delta->value("type", std::string()) != "input_json_delta") {
+            return false;
+        }
+        assembler.append(index, delta->value("partial_json", std::string()));
+        return true;
+    }
+    if (name == "content_block_stop") {
+        return assembler.finish(index);  // No-op for text blocks
+    }
+    return false;
+}
+
+}  // namespace Anthropic
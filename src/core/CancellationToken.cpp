@@ -0,0 +1,28 @@
+#include "core/CancellationToken.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace llmcpp {
+
+void throwIfCancelled(const CancellationToken& token) {
+    if (token.stop_requested()) {
+        throw OperationCancelled();
+    }
+}
+
+bool sleepFor(const CancellationToken& token, std::chrono::milliseconds duration) {
+    if (!token.stop_possible()) {
+        std::this_thread::sleep_for(duration);
+        return true;
+    }
+    // Nothing notifies the condition variable; only the stop request wakes it early
+    std::mutex mutex;
+    std::condition_variable_any wakeup;
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait_for(lock, token, duration, [] { return false; });
+    return !token.stop_requested();
+}
+
+}  // namespace llmcpp
@@ -0,0 +1,756 @@
+#include "core/CompiledSchema.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+using json = nlohmann::json;
+
+namespace llmcpp {
+
+namespace {
+
+// Type bits; "number" accepts integers too, so Integer values carry both bits
+enum TypeBit : uint8_t {
+    kNull = 1 << 0,
+    kBoolean = 1 << 1,
+    kInteger = 1 << 2,
+    kNumber = 1 << 3,
+    kString = 1 << 4,
+    kArray = 1 << 5,
+    kObject = 1 << 6,
+    kAnyType = 0x7f,
+};
+
+uint8_t typeBitFromName(const std::string& name) {
+    if (name == "null") return kNull;
+    if (name == "boolean") return kBoolean;
+    if (name == "integer") return kInteger;
+    if (name == "number") return kNumber;
+    if (name == "string") return kString;
+    if (name == "array") return kArray;
+    if (name == "object") return kObject;
+    throw std::invalid_argument("CompiledSchema: unknown type \"" + name + "\"");
+}
+
+uint8_t instanceTypeBits(const json& value) {
+    switch (value.type()) {
+        case json::value_t::null:
+            return kNull;
+        case json::value_t::boolean:
+            return kBoolean;
+        case json::value_t::number_integer:
+        case json::value_t::number_unsigned:
+            return kInteger | kNumber;
+        case json::value_t::number_float: {
+            double d = value.get<double>();
+            return std::isfinite(d) && std::floor(d) == d ? (kInteger | kNumber) : kNumber;
+        }
+        case json::value_t::string:
+            return kString;
+        case json::value_t::array:
+            return kArray;
+        case json::value_t::object:
+            return kObject;
+        default:
+            return 0;
+    }
+}
+
+std::string typeMaskToString(uint8_t mask) {
+    static const char* const names[] = {"null",   "boolean", "integer", "number",
+                                        "string", "array",   "object"};
+    std::string out;
+    for (int bit = 0; bit < 7; ++bit) {
+        if (mask & (1 << bit)) {
+            if (!out.empty()) out += " or ";
+            out += names[bit];
+        }
+    }
+    return out;
+}
+
+// Unicode code points in a UTF-8 string (what JSON Schema length keywords count)
+size_t utf8Length(const std::string& s) {
+    size_t n = 0;
+    for (unsigned char c : s) {
+        if ((c & 0xC0) != 0x80) ++n;
+    }
+    return n;
+}
+
+std::string escapePointerToken(const std::string& token) {
+    std::string out;
+    out.reserve(token.size());
+    for (char c : token) {
+        if (c == '~') {
+            out += "~0";
+        } else if (c == '/') {
+            out += "~1";
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+uint64_t fnv1a(const std::string& text) {
+    uint64_t h = 1469598103934665603ULL;
+    for (unsigned char c : text) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+}  // namespace
+
+// Node table
+
+struct CompiledSchema::Node {
+    bool alwaysFalse = false;
+    uint8_t typeMask = kAnyType;
+
+    // enum / const
+    bool hasEnum = false;
+    bool stringEnum = false;                    // All enum values are strings
+    std::unordered_set<std::string> enumKeys;   // Raw strings, or dump() for mixed enums
+    std::optional<json> constValue;
+
+    // Strings
+    std::optional<size_t> minLength;
+    std::optional<size_t> maxLength;
+    std::shared_ptr<std::regex> pattern;
+    std::string patternSource;
+
+    // Numbers
+    std::optional<double> minimum;
+    std::optional<double> maximum;
+    std::optional<double> exclusiveMinimum;
+    std::optional<double> exclusiveMaximum;
+    std::optional<double> multipleOf;
+
+    // Arrays
+    std::optional<uint32_t> items;
+    std::vector<uint32_t> tupleItems;  // Draft 7 array form of "items"
+    std::optional<size_t> minItems;
+    std::optional<size_t> maxItems;
+    bool uniqueItems = false;
+
+    // Objects
+    struct Property {
+        std::string name;
+        uint32_t node;
+        bool required;
+    };
+    std::vector<Property> properties;
+    std::unordered_map<std::string, uint32_t> propertyIndex;  // name -> index in properties
+    size_t requiredInProperties = 0;
+    std::vector<std::string> requiredElsewhere;  // Required names without a property schema
+    std::vector<std::pair<std::shared_ptr<std::regex>, uint32_t>> patternProperties;
+    bool additionalAllowed = true;
+    std::optional<uint32_t> additionalSchema;
+    std::optional<size_t> minProperties;
+    std::optional<size_t> maxProperties;
+
+    // Combinators
+    std::vector<uint32_t> allOf;
+    std::vector<uint32_t> anyOf;
+    std::vector<uint32_t> oneOf;
+    std::optional<uint32_t> notSchema;
+    std::optional<uint32_t> ifSchema;
+    std::optional<uint32_t> thenSchema;
+    std::optional<uint32_t> elseSchema;
+    std::optional<uint32_t> ref;
+};
+
+// Compiler
+
+struct CompiledSchema::Compiler {
+    const json& root;
+    std::vector<Node>& nodes;
+    std::unordered_map<std::string, uint32_t> byPointer;
+
+    static std::optional<size_t> count(const json& schema, const char* key) {
+        if (!schema.contains(key)) return std::nullopt;
+        const auto& v = schema[key];
+        if (!v.is_number() || v.get<double>() < 0) {
+            throw std::invalid_argument(std::string("CompiledSchema: \"") + key +
+                                        "\" must be a non-negative number");
+        }
+        return static_cast<size_t>(v.get<double>());
+    }
+
+    static std::optional<double> number(const json& schema, const char* key) {
+        if (!schema.contains(key) || !schema[key].is_number()) return std::nullopt;
+        return schema[key].get<double>();
+    }
+
+    static std::shared_ptr<std::regex> regex(const std::string& source) {
+        try {
+            return std::make_shared<std::regex>(source, std::regex::ECMAScript);
+        } catch (const std::regex_error& e) {
+            throw std::invalid_argument("CompiledSchema: invalid pattern \"" + source +
+                                        "\": " + e.what());
+        }
+    }
+
+    std::vector<uint32_t> list(const json& schema, const char* key, const std::string& pointer) {
+        std::vector<uint32_t> out;
+        if (!schema.contains(key)) return out;
+        const auto& arr = schema[key];
+        if (!arr.is_array() || arr.empty()) {
+            throw std::invalid_argument(std::string("CompiledSchema: \"") + key +
+                                        "\" must be a non-empty array");
+        }
+        for (size_t i = 0; i < arr.size(); ++i) {
+            out.push_back(compile(arr[i], pointer + "/" + key + "/" + std::to_string(i)));
+        }
+        return out;
+    }
+
+    uint32_t resolveRef(const std::string& ref) {
+        if (ref.empty() || ref[0] != '#') {
+            throw std::invalid_argument("CompiledSchema: only local $ref is supported: " + ref);
+        }
+        std::string pointer = ref.substr(1);
+        if (auto it = byPointer.find(pointer); it != byPointer.end()) {
+            return it->second;
+        }
+        try {
+            return compile(root.at(json::json_pointer(pointer)), pointer);
+        } catch (const json::exception&) {
+            throw std::invalid_argument("CompiledSchema: unresolvable $ref " + ref);
+        }
+    }
+
+    // Nodes are referenced by index because the table grows while children compile
+    uint32_t compile(const json& schema, const std::string& pointer) {
+        auto index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        byPointer.emplace(pointer, index);
+
+        Node node;
+        if (schema.is_boolean()) {
+            node.alwaysFalse = !schema.get<bool>();
+            nodes[index] = std::move(node);
+            return index;
+        }
+        if (!schema.is_object()) {
+            throw std::invalid_argument("CompiledSchema: schema at \"" + pointer +
+                                        "\" must be an object or boolean");
+        }
+
+        if (schema.contains("$ref")) {
+            node.ref = resolveRef(schema["$ref"].get<std::string>());
+        }
+
+        if (schema.contains("type")) {
+            const auto& type = schema["type"];
+            if (type.is_string()) {
+                node.typeMask = typeBitFromName(type.get<std::string>());
+            } else if (type.is_array()) {
+                node.typeMask = 0;
+                for (const auto& t : type) {
+                    node.typeMask |= typeBitFromName(t.get<std::string>());
+                }
+            } else {
+                throw std::invalid_argument("CompiledSchema: \"type\" must be a string or array");
+            }
+        }
+
+        if (schema.contains("enum")) {
+            const auto& values = schema["enum"];
+            if (!values.is_array()) {
+                throw std::invalid_argument("CompiledSchema: \"enum\" must be an array");
+            }
+            node.hasEnum = true;
+            node.stringEnum = std::all_of(values.begin(), values.end(),
+                                          [](const json& v) { return v.is_string(); });
+            for (const auto& v : values) {
+                node.enumKeys.insert(node.stringEnum ? v.get<std::string>() : v.dump());
+            }
+        }
+        if (schema.contains("const")) {
+            node.constValue = schema["const"];
+        }
+
+        node.minLength = count(schema, "minLength");
+        node.maxLength = count(schema, "maxLength");
+        if (schema.contains("pattern")) {
+            node.patternSource = schema["pattern"].get<std::string>();
+            node.pattern = regex(node.patternSource);
+        }
+
+        node.minimum = number(schema, "minimum");
+        node.maximum = number(schema, "maximum");
+        node.exclusiveMinimum = number(schema, "exclusiveMinimum");
+        node.exclusiveMaximum = number(schema, "exclusiveMaximum");
+        // Draft 4 boolean form: exclusiveMinimum/Maximum modify minimum/maximum
+        if (schema.value("exclusiveMinimum", json()).is_boolean() &&
+            schema["exclusiveMinimum"].get<bool>()) {
+            node.exclusiveMinimum = node.minimum;
+            node.minimum.reset();
+        }
+        if (schema.value("exclusiveMaximum", json()).is_boolean() &&
+            schema["exclusiveMaximum"].get<bool>()) {
+            node.exclusiveMaximum = node.maximum;
+            node.maximum.reset();
+        }
+        node.multipleOf = number(schema, "multipleOf");
+        if (node.multipleOf && *node.multipleOf <= 0) {
+            throw std::invalid_argument("CompiledSchema: \"multipleOf\" must be positive");
+        }
+
+        if (schema.contains("items")) {
+            const auto& items = schema["items"];
+            if (items.is_array()) {
+                node.tupleItems = list(schema, "items", pointer);
+            } else {
+                node.items = compile(items, pointer + "/items");
+            }
+        }
+        node.minItems = count(schema, "minItems");
+        node.maxItems = count(schema, "maxItems");
+        node.uniqueItems = schema.value("uniqueItems", false);
+
+        std::unordered_set<std::string> required;
+        if (schema.contains("required")) {
+            for (const auto& name : schema["required"]) {
+                required.insert(name.get<std::string>());
+            }
+        }
+        if (schema.contains("properties")) {
+            for (const auto& [name, sub] : schema["properties"].items()) {
+                uint32_t child = compile(sub, pointer + "/properties/" + escapePointerToken(name));
+                bool isRequired = required.erase(name) > 0;
+                node.propertyIndex.emplace(name, static_cast<uint32_t>(node.properties.size()));
+                node.properties.push_back({name, child, isRequired});
+                node.requiredInProperties += isRequired ? 1 : 0;
+            }
+        }
+        node.requiredElsewhere.assign(required.begin(), required.end());
+        if (schema.contains("patternProperties")) {
+            for (const auto& [source, sub] : schema["patternProperties"].items()) {
+                node.patternProperties.emplace_back(
+                    regex(source),
+                    compile(sub, pointer + "/patternProperties/" + escapePointerToken(source)));
+            }
+        }
+        if (schema.contains("additionalProperties")) {
+            const auto& additional = schema["additionalProperties"];
+            if (additional.is_boolean()) {
+                node.additionalAllowed = additional.get<bool>();
+            } else {
+                node.additionalSchema = compile(additional, pointer + "/additionalProperties");
+            }
+        }
+        node.minProperties = count(schema, "minProperties");
+        node.maxProperties = count(schema, "maxProperties");
+
+        node.allOf = list(schema, "allOf", pointer);
+        node.anyOf = list(schema, "anyOf", pointer);
+        node.oneOf = list(schema, "oneOf", pointer);
+        if (schema.contains("not")) node.notSchema = compile(schema["not"], pointer + "/not");
+        if (schema.contains("if")) {
+            node.ifSchema = compile(schema["if"], pointer + "/if");
+            if (schema.contains("then")) node.thenSchema = compile(schema["then"], pointer + "/then");
+            if (schema.contains("else")) node.elseSchema = compile(schema["else"], pointer + "/else");
+        }
+
+        nodes[index] = std::move(node);
+        return index;
+    }
+};
+
+// Validation context: path segments are kept as pointers and only joined when reporting
+
+struct CompiledSchema::Context {
+    struct Segment {
+        const std::string* key;
+        size_t index;
+    };
+
+    std::vector<SchemaValidationError>* errors;  // nullptr: probe mode, stop at first failure
+    size_t maxErrors;
+    std::vector<Segment> path;
+
+    bool collecting() const { return errors != nullptr; }
+    bool full() const { return errors && errors->size() >= maxErrors; }
+
+    void fail(const char* keyword, std::string message) {
+        if (!errors || errors->size() >= maxErrors) return;
+        std::string pointer;
+        for (const auto& seg : path) {
+            pointer += '/';
+            pointer += seg.key ? escapePointerToken(*seg.key) : std::to_string(seg.index);
+        }
+        errors->push_back({std::move(pointer), keyword, std::move(message)});
+    }
+};
+
+CompiledSchema::CompiledSchema() = default;
+CompiledSchema::~CompiledSchema() = default;
+
+size_t CompiledSchema::nodeCount() const { return nodes_.size(); }
+
+std::shared_ptr<const CompiledSchema> CompiledSchema::compile(const json& schema) {
+    std::shared_ptr<CompiledSchema> compiled(new CompiledSchema());
+    Compiler compiler{schema, compiled->nodes_, {}};
+    compiler.compile(schema, "");
+    compiled->hash_ = fnv1a(schema.dump());
+    return compiled;
+}
+
+namespace {
+
+struct SchemaCache {
+    std::mutex mutex;
+    // Keyed by hash, with the canonical text kept to rule out collisions
+    std::unordered_map<uint64_t, std::pair<std::string, std::shared_ptr<const CompiledSchema>>>
+        entries;
+
+    static SchemaCache& instance() {
+        static SchemaCache cache;
+        return cache;
+    }
+};
+
+template <typename CompileFn>
+std::shared_ptr<const CompiledSchema> lookupOrCompile(const std::string& key, CompileFn&& fn) {
+    auto& cache = SchemaCache::instance();
+    uint64_t h = fnv1a(key);
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.entries.find(h);
+        if (it != cache.entries.end() && it->second.first == key) {
+            return it->second.second;
+        }
+    }
+    // Compile outside the lock; a concurrent duplicate compile is harmless
+    auto compiled = fn();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries[h] = {key, compiled};
+    return compiled;
+}
+
+}  // namespace
+
+std::shared_ptr<const CompiledSchema> CompiledSchema::cached(const json& schema) {
+    return lookupOrCompile(schema.dump(), [&] { return compile(schema); });
+}
+
+std::shared_ptr<const CompiledSchema> CompiledSchema::cached(const std::string& schemaText) {
+    return lookupOrCompile(schemaText, [&] {
+        json schema = json::parse(schemaText, nullptr, /*allow_exceptions=*/false);
+        if (schema.is_discarded()) {
+            throw std::invalid_argument("CompiledSchema: schema text is not valid JSON");
+        }
+        return compile(schema);
+    });
+}
+
+size_t CompiledSchema::cacheSize() {
+    auto& cache = SchemaCache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.entries.size();
+}
+
+void CompiledSchema::clearCache() {
+    auto& cache = SchemaCache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.clear();
+}
+
+SchemaValidationResult CompiledSchema::validate(const json& instance, size_t maxErrors) const {
+    SchemaValidationResult result;
+    Context ctx{&result.errors, std::max<size_t>(1, maxErrors), {}};
+    validateNode(0, instance, ctx);
+    return result;
+}
+
+bool CompiledSchema::isValid(const json& instance) const {
+    Context ctx{nullptr, 0, {}};
+    return validateNode(0, instance, ctx);
+}
+
+bool CompiledSchema::validateNode(uint32_t index, const json& value, Context& ctx) const {
+    const Node& node = nodes_[index];
+    if (node.alwaysFalse) {
+        ctx.fail("false", "no value is allowed here");
+        return false;
+    }
+
+    bool ok = true;
+    // In probe mode return on the first failure; otherwise keep collecting up to maxErrors
+    auto check = [&](bool passed) {
+        ok = ok && passed;
+        return passed || ctx.collecting();
+    };
+
+    if (node.ref && !check(validateNode(*node.ref, value, ctx))) return false;
+
+    uint8_t bits = instanceTypeBits(value);
+    if ((node.typeMask & bits) == 0) {
+        ctx.fail("type", "expected " + typeMaskToString(node.typeMask) + ", got " +
+                             std::string(value.type_name()));
+        return false;  // Keyword checks below assume the type matched
+    }
+
+    if (node.hasEnum) {
+        bool found = node.stringEnum ? value.is_string() &&
+                                           node.enumKeys.count(value.get_ref<const std::string&>())
+                                     : node.enumKeys.count(value.dump()) > 0;
+        if (!found) ctx.fail("enum", "value is not one of the allowed values");
+        if (!check(found)) return false;
+    }
+    if (node.constValue) {
+        bool equal = value == *node.constValue;
+        if (!equal) ctx.fail("const", "value does not match const");
+        if (!check(equal)) return false;
+    }
+
+    if (bits & kString) {
+        const auto& s = value.get_ref<const std::string&>();
+        if (node.minLength || node.maxLength) {
+            size_t length = utf8Length(s);
+            if (node.minLength && length < *node.minLength) {
+                ctx.fail("minLength", "string shorter than " + std::to_string(*node.minLength));
+                if (!check(false)) return false;
+            }
+            if (node.maxLength && length > *node.maxLength) {
+                ctx.fail("maxLength", "string longer than " + std::to_string(*node.maxLength));
+                if (!check(false)) return false;
+            }
+        }
+        if (node.pattern && !std::regex_search(s, *node.pattern)) {
+            ctx.fail("pattern", "string does not match pattern " + node.patternSource);
+            if (!check(false)) return false;
+        }
+    } else if (bits & kNumber) {
+        double d = value.get<double>();
+        auto numberCheck = [&](bool passed, const char* keyword, const std::string& message) {
+            if (!passed) ctx.fail(keyword, message);
+            return check(passed);
+        };
+        if (node.minimum &&
+            !numberCheck(d >= *node.minimum, "minimum", "value below minimum")) return false;
+        if (node.maximum &&
+            !numberCheck(d <= *node.maximum, "maximum", "value above maximum")) return false;
+        if (node.exclusiveMinimum &&
+            !numberCheck(d > *node.exclusiveMinimum, "exclusiveMinimum",
+                         "value not above exclusiveMinimum")) return false;
+        if (node.exclusiveMaximum &&
+            !numberCheck(d < *node.exclusiveMaximum, "exclusiveMaximum",
+                         "value not below exclusiveMaximum")) return false;
+        if (node.multipleOf) {
+            double q = d / *node.multipleOf;
+            bool passed = std::fabs(q - std::round(q)) <= 1e-9 * std::max(1.0, std::fabs(q));
+            if (!numberCheck(passed, "multipleOf", "value is not a multiple of multipleOf"))
+                return false;
+        }
+    } else if (bits & kArray) {
+        if (!check(validateArray(node, value, ctx))) return false;
+    } else if (bits & kObject) {
+        if (!check(validateObject(node, value, ctx))) return false;
+    }
+
+    // Combinators always probe their branches; only the summary error is reported
+    for (uint32_t sub : node.allOf) {
+        if (!check(validateNode(sub, value, ctx))) return false;
+    }
+    if (!node.anyOf.empty()) {
+        bool any = false;
+        for (uint32_t sub : node.anyOf) {
+            Context probe{nullptr, 0, {}};
+            if (validateNode(sub, value, probe)) {
+                any = true;
+                break;
+            }
+        }
+        if (!any) ctx.fail("anyOf", "value does not match any schema in anyOf");
+        if (!check(any)) return false;
+    }
+    if (!node.oneOf.empty()) {
+        size_t matches = 0;
+        for (uint32_t sub : node.oneOf) {
+            Context probe{nullptr, 0, {}};
+            if (validateNode(sub, value, probe) && ++matches > 1) break;
+        }
+        if (matches != 1) {
+            ctx.fail("oneOf", matches == 0 ? "value does not match any schema in oneOf"
+                                           : "value matches more than one schema in oneOf");
+        }
+        if (!check(matches == 1)) return false;
+    }
+    if (node.notSchema) {
+        Context probe{nullptr, 0, {}};
+        bool matched = validateNode(*node.notSchema, value, probe);
+        if (matched) ctx.fail("not", "value must not match the \"not\" schema");
+        if (!check(!matched)) return false;
+    }
+    if (node.ifSchema) {
+        Context probe{nullptr, 0, {}};
+        if (validateNode(*node.ifSchema, value, probe)) {
+            if (node.thenSchema && !check(validateNode(*node.thenSchema, value, ctx)))
+                return false;
+        } else if (node.elseSchema && !check(validateNode(*node.elseSchema, value, ctx))) {
+            return false;
+        }
+    }
+    return ok;
+}
+
+bool CompiledSchema::validateArray(const Node& node, const json& value, Context& ctx) const {
+    bool ok = true;
+    size_t size = value.size();
+    if (node.minItems && size < *node.minItems) {
+        ctx.fail("minItems", "array has fewer than " + std::to_string(*node.minItems) + " items");
+        if (!ctx.collecting()) return false;
+        ok = false;
+    }
+    if (node.maxItems && size > *node.maxItems) {
+        ctx.fail("maxItems", "array has more than " + std::to_string(*node.maxItems) + " items");
+        if (!ctx.collecting()) return false;
+        ok = false;
+    }
+
+    if (node.items || !node.tupleItems.empty()) {
+        for (size_t i = 0; i < size && !ctx.full(); ++i) {
+            std::optional<uint32_t> sub = i < node.tupleItems.size()
+                                              ? std::optional<uint32_t>(node.tupleItems[i])
+                                              : (node.tupleItems.empty() ? node.items
+                                                                         : std::nullopt);
+            if (!sub) break;
+            ctx.path.push_back({nullptr, i});
+            bool passed = validateNode(*sub, value[i], ctx);
+            ctx.path.pop_back();
+            if (!passed) {
+                if (!ctx.collecting()) return false;
+                ok = false;
+            }
+        }
+    }
+
+    if (node.uniqueItems && size > 1) {
+        std::unordered_set<std::string> seen;
+        for (const auto& item : value) {
+            if (!seen.insert(item.dump()).second) {
+                ctx.fail("uniqueItems", "array items are not unique");
+                return false;
+            }
+        }
+    }
+    return ok;
+}
+
+bool CompiledSchema::validateObject(const Node& node, const json& value, Context& ctx) const {
+    bool ok = true;
+    auto failHere = [&](const char* keyword, std::string message) {
+        ctx.fail(keyword, std::move(message));
+        ok = false;
+        return ctx.collecting();
+    };
+
+    size_t size = value.size();
+    if (node.minProperties && size < *node.minProperties &&
+        !failHere("minProperties", "object has too few properties")) return false;
+    if (node.maxProperties && size > *node.maxProperties &&
+        !failHere("maxProperties", "object has too many properties")) return false;
+
+    // One pass over the instance: dispatch each key and count required hits
+    size_t requiredSeen = 0;
+    for (auto it = value.begin(); it != value.end() && !ctx.full(); ++it) {
+        const std::string& key = it.key();
+        bool matched = false;
+
+        if (auto found = node.propertyIndex.find(key); found != node.propertyIndex.end()) {
+            const auto& property = node.properties[found->second];
+            matched = true;
+            requiredSeen += property.required ? 1 : 0;
+            ctx.path.push_back({&key, 0});
+            bool passed = validateNode(property.node, it.value(), ctx);
+            ctx.path.pop_back();
+            if (!passed && !ctx.collecting()) return false;
+            ok = ok && passed;
+        }
+        for (const auto& [regex, sub] : node.patternProperties) {
+            if (std::regex_search(key, *regex)) {
+                matched = true;
+                ctx.path.push_back({&key, 0});
+                bool passed = validateNode(sub, it.value(), ctx);
+                ctx.path.pop_back();
+                if (!passed && !ctx.collecting()) return false;
+                ok = ok && passed;
+            }
+        }
+        if (!matched) {
+            if (!node.additionalAllowed) {
+                if (!failHere("additionalProperties",
+                              "unexpected property \"" + key + "\"")) return false;
+            } else if (node.additionalSchema) {
+                ctx.path.push_back({&key, 0});
+                bool passed = validateNode(*node.additionalSchema, it.value(), ctx);
+                ctx.path.pop_back();
+                if (!passed && !ctx.collecting()) return false;
+                ok = ok && passed;
+            }
+        }
+    }
+
+    // Missing names are only looked up on the failure path
+    if (requiredSeen < node.requiredInProperties) {
+        for (const auto& property : node.properties) {
+            if (property.required && !value.contains(property.name) &&
+                !failHere("required", "missing required property \"" + property.name + "\"")) {
+                return false;
+            }
+        }
+    }
+    for (const auto& name : node.requiredElsewhere) {
+        if (!value.contains(name) &&
+            !failHere("required", "missing required property \"" + name + "\"")) {
+            return false;
+        }
+    }
+    return ok;
+}
+
+std::string SchemaValidationResult::toString() const {
+    std::string out;
+    for (const auto& error : errors) {
+        if (!out.empty()) out += "; ";
+        out += error.path + ": " + error.message;
+    }
+    return out;
+}
+
+void validateStructuredOutput(const LLMRequestConfig& config, LLMResponse& response) {
+    // Tool-call turns carry function_calls instead of the final structured output
+    if (!config.validateOutput || !response.success || response.result.contains("function_calls")) {
+        return;
+    }
+    std::shared_ptr<const CompiledSchema> schema;
+    if (config.internedSchema) {
+        schema = CompiledSchema::cached(config.internedSchema->canonical());
+    } else if (config.schemaObject.has_value()) {
+        schema = CompiledSchema::cached(*config.schemaObject);
+    } else if (!config.jsonSchema.empty()) {
+        schema = CompiledSchema::cached(config.jsonSchema);
+    } else {
+        return;
+    }
+
+    auto result = schema->validate(response.result);
+    if (!result) {
+        response.success = false;
+        response.errorMessage = "Structured output failed schema validation: " + result.toString();
+    }
+}
+
+}  // namespace llmcpp
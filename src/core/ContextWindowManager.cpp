@@ -0,0 +1,209 @@
+#include "core/ContextWindowManager.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include "core/Logger.h"
+#include "core/ModelCatalog.h"
+
+namespace llmcpp {
+
+namespace {
+
+// Content string of a context message, or nullptr if it has structured content
+std::string* contentText(json& message) {
+    if (message.is_string()) {
+        return message.get_ptr<std::string*>();
+    }
+    if (message.is_object()) {
+        auto it = message.find("content");
+        if (it != message.end() && it->is_string()) {
+            return it->get_ptr<std::string*>();
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+ContextWindowManager::ContextWindowManager(TextTokenCounter countText)
+    : countText_(countText ? std::move(countText) : TextTokenCounter(estimateTokens)) {}
+
+ContextWindowManager::ContextWindowManager(std::shared_ptr<const BpeTokenizer> tokenizer)
+    : ContextWindowManager(tokenizer ? TextTokenCounter([tokenizer](std::string_view text) {
+          return tokenizer->countTokens(text);
+      })
+                                     : TextTokenCounter(estimateTokens)) {}
+
+size_t ContextWindowManager::estimateTokens(std::string_view text) {
+    return (text.size() + 3) / 4;
+}
+
+std::optional<ContextWindowManager::ModelLimits> ContextWindowManager::modelLimits(
+    std::string_view model) {
+    const auto* info = resolveModel(model);
+    if (!info || info->contextWindow == 0) {
+        return std::nullopt;
+    }
+    return ModelLimits{info->contextWindow, info->maxOutputTokens};
+}
+
+void ContextWindowManager::setSummarizer(Summarizer summarizer, size_t reserveTokens) {
+    summarizer_ = std::move(summarizer);
+    summaryReserveTokens_ = summarizer_ ? reserveTokens : 0;
+}
+
+std::optional<size_t> ContextWindowManager::budgetFor(const LLMRequest& request,
+                                                      std::string_view model) const {
+    size_t window = contextWindow_;
+    size_t maxOutput = 0;
+    if (window == 0) {
+        auto limits = modelLimits(model.empty() ? std::string_view(request.config.model) : model);
+        if (!limits) {
+            return std::nullopt;
+        }
+        window = limits->contextWindow;
+        maxOutput = limits->maxOutputTokens;
+    }
+    const auto& maxTokens = request.config.maxTokens;
+    size_t reserve = maxTokens && *maxTokens > 0 ? static_cast<size_t>(*maxTokens)
+                                                 : reservedOutputTokens_;
+    if (maxOutput > 0) {
+        reserve = std::min(reserve, maxOutput);
+    }
+    return window > reserve ? window - reserve : 0;
+}
+
+size_t ContextWindowManager::countTokens(const LLMRequest& request) const {
+    size_t total = countFixedRequestTokens(request, countText_);
+    for (const auto& entry : request.context) {
+        total += countMessageTokens(entry, countText_);
+    }
+    return total;
+}
+
+bool ContextWindowManager::truncateToTail(json& message, size_t maxTokens) const {
+    std::string* content = contentText(message);
+    if (!content) {
+        return false;
+    }
+    const std::string full = *content;
+    size_t keep = full.size();
+    for (int attempt = 0; attempt < 16; ++attempt) {
+        const size_t tokens = countMessageTokens(message, countText_);
+        if (tokens <= maxTokens) {
+            return true;
+        }
+        if (keep == 0) {
+            return false;
+        }
+        // Scale by the overshoot with 5% slack so most messages fit on the next count
+        keep = static_cast<size_t>(static_cast<double>(keep) * static_cast<double>(maxTokens) /
+                                   static_cast<double>(tokens) * 0.95);
+        size_t start = full.size() - keep;
+        while (start < full.size() && (static_cast<unsigned char>(full[start]) & 0xC0) == 0x80) {
+            ++start;  // Never start inside a UTF-8 sequence
+        }
+        *content = full.substr(start);
+        keep = full.size() - start;
+    }
+    return countMessageTokens(message, countText_) <= maxTokens;
+}
+
+ContextWindowManager::FitResult ContextWindowManager::fit(LLMRequest& request,
+                                                          std::string_view model) const {
+    FitResult result;
+    result.budget = budgetFor(request, model);
+    if (!result.budget) {
+        return result;
+    }
+    const size_t budget = *result.budget;
+
+    auto& context = request.context;
+    std::vector<size_t> costs;
+    costs.reserve(context.size());
+    size_t total = countFixedRequestTokens(request, countText_);
+    for (const auto& entry : context) {
+        costs.push_back(countMessageTokens(entry, countText_));
+        total += costs.back();
+    }
+    result.tokensBefore = total;
+    if (total <= budget) {
+        result.tokensAfter = total;
+        return result;
+    }
+
+    // Oldest first, always keeping the newest message
+    const size_t target =
+        budget > summaryReserveTokens_ ? budget - summaryReserveTokens_ : budget;
+    size_t evict = 0;
+    while (total > target && evict + 1 < context.size()) {
+        total -= costs[evict++];
+    }
+    if (total > target && evict < context.size()) {
+        const size_t others = total - costs.back();
+        json trimmed = context.back();
+        if (others < target && truncateToTail(trimmed, target - others)) {
+            context.back() = std::move(trimmed);
+            total = others + countMessageTokens(context.back(), countText_);
+            result.truncated = true;
+        } else {
+            total -= costs[evict++];
+        }
+    }
+
+    LLMContext evicted(std::make_move_iterator(context.begin()),
+                       std::make_move_iterator(context.begin() + static_cast<long>(evict)));
+    context.erase(context.begin(), context.begin() + static_cast<long>(evict));
+    result.evictedMessages = evict;
+
+    if (summarizer_ && !evicted.empty() && total < budget) {
+        LLMContext summary = summarizer_(evicted, budget - total);
+        size_t cost = 0;
+        for (const auto& entry : summary) {
+            cost += countMessageTokens(entry, countText_);
+        }
+        if (total + cost <= budget) {
+            context.insert(context.begin(), std::make_move_iterator(summary.begin()),
+                           std::make_move_iterator(summary.end()));
+            total += cost;
+            result.summarized = !summary.empty();
+        } else {
+            LLMCPP_LOG_WARN("context", "Summary does not fit; evicted messages dropped",
+                            {{"summary_tokens", cost}, {"available_tokens", budget - total}});
+        }
+    }
+
+    result.tokensAfter = total;
+    result.fits = total <= budget;
+    return result;
+}
+
+std::optional<LLMRequest> ContextWindowManager::fitted(const LLMRequest& request,
+                                                      std::string_view model,
+                                                      FitResult* result) const {
+    FitResult outcome;
+    outcome.budget = budgetFor(request, model);
+    std::optional<LLMRequest> copy;
+    if (outcome.budget) {
+        outcome.tokensBefore = outcome.tokensAfter = countTokens(request);
+        if (outcome.tokensBefore > *outcome.budget) {
+            copy = request;
+            outcome = fit(*copy, model);
+        }
+    }
+    if (result) {
+        *result = outcome;
+    }
+    if (!outcome.fits) {
+        std::string name(model.empty() ? std::string_view(request.config.model) : model);
+        throw std::length_error("Request needs " + std::to_string(outcome.tokensAfter) +
+                                " input tokens but the context budget of " + name + " is " +
+                                std::to_string(*outcome.budget));
+    }
+    return copy;
+}
+
+}  // namespace llmcpp
@@ -0,0 +1,443 @@
+#include "core/CostMeter.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "core/ContextWindowManager.h"
+#include "core/Logger.h"
+
+namespace llmcpp {
+
+namespace {
+
+constexpr size_t kShards = 16;
+constexpr char kKeySeparator = '\x1f';
+constexpr double kNanosPerUsd = 1e9;
+
+// One writer shard of a series: a single cache line, so threads on different shards never
+// share a line. Cost is kept in nano-USD so it can be added atomically.
+struct alignas(64) Counters {
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> inputTokens{0};
+    std::atomic<uint64_t> cachedInputTokens{0};
+    std::atomic<uint64_t> cacheCreationInputTokens{0};
+    std::atomic<uint64_t> outputTokens{0};
+    std::atomic<uint64_t> reasoningTokens{0};
+    std::atomic<uint64_t> costNanos{0};
+};
+
+uint64_t toNanos(double usd) {
+    return static_cast<uint64_t>(std::llround(std::max(usd, 0.0) * kNanosPerUsd));
+}
+
+}  // namespace
+
+BudgetReservation::BudgetReservation(BudgetReservation&& other) noexcept
+    : pending_(std::exchange(other.pending_, nullptr)), nanos_(std::exchange(other.nanos_, 0)) {}
+
+BudgetReservation& BudgetReservation::operator=(BudgetReservation&& other) noexcept {
+    if (this != &other) {
+        release();
+        pending_ = std::exchange(other.pending_, nullptr);
+        nanos_ = std::exchange(other.nanos_, 0);
+    }
+    return *this;
+}
+
+void BudgetReservation::release() {
+    if (pending_) {
+        pending_->fetch_sub(nanos_, std::memory_order_acq_rel);
+        pending_ = nullptr;
+        nanos_ = 0;
+    }
+}
+
+double BudgetReservation::usd() const { return static_cast<double>(nanos_) / kNanosPerUsd; }
+
+struct CostMeter::Entry {
+    explicit Entry(std::string_view k) : key(k) {}
+
+    const std::string key;
+    std::array<Counters, kShards> shards;
+
+    void add(const LLMUsage& usage, uint64_t costNanos) {
+        auto& shard = shards[shardIndex()];
+        auto bump = [](std::atomic<uint64_t>& counter, int value) {
+            if (value > 0) {
+                counter.fetch_add(static_cast<uint64_t>(value), std::memory_order_relaxed);
+            }
+        };
+        shard.requests.fetch_add(1, std::memory_order_relaxed);
+        bump(shard.inputTokens, usage.inputTokens);
+        bump(shard.cachedInputTokens, usage.cachedInputTokens);
+        bump(shard.cacheCreationInputTokens, usage.cacheCreationInputTokens);
+        bump(shard.outputTokens, usage.outputTokens);
+        bump(shard.reasoningTokens, usage.reasoningTokens);
+        shard.costNanos.fetch_add(costNanos, std::memory_order_relaxed);
+    }
+
+    CostMeter::Totals totals() const {
+        CostMeter::Totals totals;
+        uint64_t costNanos = 0;
+        for (const auto& shard : shards) {
+            totals.requests += shard.requests.load(std::memory_order_relaxed);
+            totals.inputTokens += shard.inputTokens.load(std::memory_order_relaxed);
+            totals.cachedInputTokens += shard.cachedInputTokens.load(std::memory_order_relaxed);
+            totals.cacheCreationInputTokens +=
+                shard.cacheCreationInputTokens.load(std::memory_order_relaxed);
+            totals.outputTokens += shard.outputTokens.load(std::memory_order_relaxed);
+            totals.reasoningTokens += shard.reasoningTokens.load(std::memory_order_relaxed);
+            costNanos += shard.costNanos.load(std::memory_order_relaxed);
+        }
+        totals.costUsd = static_cast<double>(costNanos) / kNanosPerUsd;
+        return totals;
+    }
+
+    void reset() {
+        for (auto& shard : shards) {
+            for (auto* counter :
+                 {&shard.requests, &shard.inputTokens, &shard.cachedInputTokens,
+                  &shard.cacheCreationInputTokens, &shard.outputTokens, &shard.reasoningTokens,
+                  &shard.costNanos}) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Threads are spread round-robin over the shards on first use
+    static size_t shardIndex() {
+        static std::atomic<size_t> nextShard{0};
+        thread_local const size_t index =
+            nextShard.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return index;
+    }
+};
+
+namespace {
+
+void accumulate(CostMeter::Totals& into, const CostMeter::Totals& from) {
+    into.requests += from.requests;
+    into.inputTokens += from.inputTokens;
+    into.cachedInputTokens += from.cachedInputTokens;
+    into.cacheCreationInputTokens += from.cacheCreationInputTokens;
+    into.outputTokens += from.outputTokens;
+    into.reasoningTokens += from.reasoningTokens;
+    into.costUsd += from.costUsd;
+}
+
+uint64_t hashKey(std::string_view key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : key) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return hash | 1;  // 0 marks an empty slot
+}
+
+std::string seriesKey(std::string_view tenant, std::string_view tag, std::string_view model) {
+    std::string key;
+    key.reserve(tenant.size() + tag.size() + model.size() + 2);
+    key.append(tenant).push_back(kKeySeparator);
+    key.append(tag).push_back(kKeySeparator);
+    key.append(model);
+    return key;
+}
+
+}  // namespace
+
+/**
+ * Insert-only open-addressing table of series. A slot is claimed by CAS on its hash and its
+ * entry published with a release store, so lookups and inserts never take a lock. Entries
+ * live until the meter is destroyed.
+ */
+class CostMeter::Table {
+   public:
+    explicit Table(size_t capacity)
+        : capacity_(std::max<size_t>(capacity, 1)),
+          mask_(std::bit_ceil(capacity_ * 2) - 1),
+          slots_(std::make_unique<Slot[]>(mask_ + 1)),
+          overflow_(seriesKey("*", "*", "*")) {}
+
+    ~Table() {
+        for (size_t i = 0; i <= mask_; ++i) {
+            delete slots_[i].entry.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Entry for `key`; inserts it unless the table is full, then returns the overflow entry
+    Entry& findOrInsert(std::string_view key) {
+        const uint64_t hash = hashKey(key);
+        for (size_t i = hash & mask_, probes = 0; probes <= mask_; i = (i + 1) & mask_, ++probes) {
+            Slot& slot = slots_[i];
+            uint64_t current = slot.hash.load(std::memory_order_acquire);
+            if (current == 0) {
+                if (size_.load(std::memory_order_relaxed) >= capacity_) {
+                    return overflow_;
+                }
+                if (slot.hash.compare_exchange_strong(current, hash, std::memory_order_acq_rel)) {
+                    size_.fetch_add(1, std::memory_order_relaxed);
+                    auto* entry = new Entry(key);
+                    slot.entry.store(entry, std::memory_order_release);
+                    return *entry;
+                }
+                // Lost the race; `current` now holds the winner's hash
+            }
+            if (current == hash) {
+                if (Entry* entry = published(slot); entry->key == key) {
+                    return *entry;
+                }
+            }
+        }
+        return overflow_;
+    }
+
+    const Entry* find(std::string_view key) const {
+        const uint64_t hash = hashKey(key);
+        for (size_t i = hash & mask_, probes = 0; probes <= mask_; i = (i + 1) & mask_, ++probes) {
+            const Slot& slot = slots_[i];
+            const uint64_t current = slot.hash.load(std::memory_order_acquire);
+            if (current == 0) {
+                return nullptr;
+            }
+            if (current == hash) {
+                if (const Entry* entry = published(slot); entry->key == key) {
+                    return entry;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t i = 0; i <= mask_; ++i) {
+            if (const Entry* entry = slots_[i].entry.load(std::memory_order_acquire)) {
+                fn(*entry);
+            }
+        }
+        fn(overflow_);
+    }
+
+    void reset() {
+        for (size_t i = 0; i <= mask_; ++i) {
+            if (Entry* entry = slots_[i].entry.load(std::memory_order_acquire)) {
+                entry->reset();
+            }
+        }
+        overflow_.reset();
+    }
+
+   private:
+    struct Slot {
+        std::atomic<uint64_t> hash{0};
+        std::atomic<Entry*> entry{nullptr};
+    };
+
+    // The claiming thread publishes the entry right after its CAS; wait out that window
+    static Entry* published(const Slot& slot) {
+        Entry* entry = slot.entry.load(std::memory_order_acquire);
+        while (!entry) {
+            std::this_thread::yield();
+            entry = slot.entry.load(std::memory_order_acquire);
+        }
+        return entry;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> size_{0};
+    Entry overflow_;
+};
+
+CostMeter::CostMeter(TextTokenCounter countText, size_t maxSeries)
+    : countText_(countText ? std::move(countText)
+                           : TextTokenCounter(ContextWindowManager::estimateTokens)),
+      series_(std::make_unique<Table>(maxSeries)),
+      tenants_(std::make_unique<Table>(maxSeries)) {}
+
+CostMeter::~CostMeter() = default;
+
+double CostMeter::cost(const LLMUsage& usage, const ModelPricing& pricing) {
+    const double cachedRate = pricing.cachedInput > 0.0 ? pricing.cachedInput : pricing.input;
+    const double writeRate = pricing.cacheWrite > 0.0 ? pricing.cacheWrite : pricing.input;
+    const int uncached =
+        std::max(0, usage.inputTokens - usage.cachedInputTokens - usage.cacheCreationInputTokens);
+    const double micros = uncached * pricing.input + usage.cachedInputTokens * cachedRate +
+                          usage.cacheCreationInputTokens * writeRate +
+                          usage.outputTokens * pricing.output;
+    return micros / 1e6;
+}
+
+std::optional<double> CostMeter::cost(const LLMUsage& usage, std::string_view model) const {
+    const auto* prices = pricing(model);
+    if (!prices) {
+        return std::nullopt;
+    }
+    return cost(usage, *prices);
+}
+
+const ModelPricing* CostMeter::pricing(std::string_view model) const {
+    if (!prices_.empty()) {
+        auto it = prices_.find(std::string(model));
+        if (it != prices_.end()) {
+            return &it->second;
+        }
+    }
+    const auto* info = resolveModel(model);
+    return info ? &info->pricing : nullptr;
+}
+
+void CostMeter::setPrice(std::string model, const ModelPricing& pricing) {
+    prices_[std::move(model)] = pricing;
+}
+
+void CostMeter::setBudget(std::string tenant, Budget budget) {
+    if (budget.limitUsd < 0.0) {
+        throw std::invalid_argument("CostMeter: budget limit must not be negative");
+    }
+    auto& state = budgets_[tenant];
+    state.budget = std::move(budget);
+    if (!state.spend) {
+        state.spend = std::make_unique<Entry>(tenant);
+    }
+}
+
+CostMeter::Entry* CostMeter::budgetedSpend(std::string_view tenant) const {
+    if (budgets_.empty()) {
+        return nullptr;
+    }
+    auto it = budgets_.find(std::string(tenant));
+    return it != budgets_.end() ? it->second.spend.get() : nullptr;
+}
+
+double CostMeter::record(const LLMUsage& usage, std::string_view model, std::string_view tenant,
+                         std::string_view tag) {
+    const double usd = cost(usage, model).value_or(0.0);
+    const auto nanos = toNanos(usd);
+    series_->findOrInsert(seriesKey(tenant, tag, model)).add(usage, nanos);
+    if (Entry* spend = budgetedSpend(tenant)) {
+        spend->add(usage, nanos);
+    } else {
+        tenants_->findOrInsert(tenant).add(usage, nanos);
+    }
+    return usd;
+}
+
+double CostMeter::estimate(const LLMRequest& request, std::string_view model) const {
+    const auto* prices = pricing(model);
+    if (!prices) {
+        return 0.0;
+    }
+    size_t inputTokens = countFixedRequestTokens(request, countText_);
+    for (const auto& entry : request.context) {
+        inputTokens += countMessageTokens(entry, countText_);
+    }
+    const auto& maxTokens = request.config.maxTokens;
+    LLMUsage usage;
+    usage.inputTokens = static_cast<int>(inputTokens);
+    usage.outputTokens = maxTokens && *maxTokens > 0 ? *maxTokens
+                                                     : static_cast<int>(expectedOutputTokens_);
+    return cost(usage, *prices);
+}
+
+CostMeter::Admission CostMeter::admit(const LLMRequest& request, std::string_view model) const {
+    Admission admission;
+    admission.model = model.empty() ? request.config.model : std::string(model);
+    auto budget = budgets_.find(request.config.tenant);
+    if (budget == budgets_.end()) {
+        return admission;
+    }
+    const BudgetState& state = budget->second;
+    const Budget& limits = state.budget;
+    admission.limitUsd = limits.limitUsd;
+    admission.spentUsd = tenantTotals(request.config.tenant).costUsd;
+    admission.estimatedCostUsd = estimate(request, admission.model);
+
+    // Reserve before checking, so requests admitted concurrently count against each other
+    auto reserve = [&state](double usd) {
+        const uint64_t nanos = toNanos(usd);
+        const uint64_t pending = state.pendingNanos.fetch_add(nanos, std::memory_order_acq_rel);
+        return std::pair{BudgetReservation(&state.pendingNanos, nanos), pending};
+    };
+    auto [reservation, pendingNanos] = reserve(admission.estimatedCostUsd);
+    admission.pendingUsd = static_cast<double>(pendingNanos) / kNanosPerUsd;
+    if (toNanos(admission.spentUsd) + pendingNanos + toNanos(admission.estimatedCostUsd) <=
+        toNanos(limits.limitUsd)) {
+        admission.reservation = std::move(reservation);
+        return admission;
+    }
+    reservation.release();
+
+    if (limits.mode == BudgetMode::Hard) {
+        admission.decision = Decision::Reject;
+        return admission;
+    }
+    if (!limits.downgradeModel.empty() && limits.downgradeModel != admission.model) {
+        admission.decision = Decision::Downgrade;
+        admission.model = limits.downgradeModel;
+        admission.estimatedCostUsd = estimate(request, admission.model);
+    } else {
+        LLMCPP_LOG_WARN("cost", "Soft budget exceeded",
+                        {{"tenant", request.config.tenant},
+                         {"spent_usd", admission.spentUsd},
+                         {"pending_usd", admission.pendingUsd},
+                         {"limit_usd", limits.limitUsd}});
+    }
+    // Soft budgets let the request through; its estimate still counts against later ones
+    admission.reservation = reserve(admission.estimatedCostUsd).first;
+    return admission;
+}
+
+CostMeter::Totals CostMeter::tenantTotals(std::string_view tenant) const {
+    Totals totals;
+    // Usage recorded before the tenant got its budget stays in the shared table
+    if (const Entry* entry = tenants_->find(tenant)) {
+        totals = entry->totals();
+    }
+    if (const Entry* spend = budgetedSpend(tenant)) {
+        accumulate(totals, spend->totals());
+    }
+    return totals;
+}
+
+CostMeter::Totals CostMeter::totals() const {
+    Totals totals;
+    tenants_->forEach([&](const Entry& entry) { accumulate(totals, entry.totals()); });
+    for (const auto& [tenant, state] : budgets_) {
+        accumulate(totals, state.spend->totals());
+    }
+    return totals;
+}
+
+std::vector<CostMeter::Series> CostMeter::snapshot() const {
+    std::vector<Series> result;
+    series_->forEach([&](const Entry& entry) {
+        Totals totals = entry.totals();
+        if (totals.requests == 0) {
+            return;
+        }
+        const std::string_view key = entry.key;
+        const size_t first = key.find(kKeySeparator);
+        const size_t second = key.find(kKeySeparator, first + 1);
+        result.push_back({std::string(key.substr(0, first)),
+                          std::string(key.substr(first + 1, second - first - 1)),
+                          std::string(key.substr(second + 1)), totals});
+    });
+    return result;
+}
+
+void CostMeter::reset() {
+    series_->reset();
+    tenants_->reset();
+    for (auto& [tenant, state] : budgets_) {
+        state.spend->reset();
+    }
+}
+
+}  // namespace llmcpp
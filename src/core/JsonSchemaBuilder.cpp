@@ -89,6 +89,11 @@ JsonSchemaBuilder& JsonSchemaBuilder::items(const JsonSchemaBuilder& itemSchema)
     return *this;
 }
 
+JsonSchemaBuilder& JsonSchemaBuilder::items(JsonSchemaBuilder&& itemSchema) {
+    schema_["items"] = std::move(itemSchema).build();
+    return *this;
+}
+
 // Object constraints
 JsonSchemaBuilder& JsonSchemaBuilder::property(const std::string& name,
                                                const JsonSchemaBuilder& propSchema) {
@@ -99,6 +104,15 @@ JsonSchemaBuilder& JsonSchemaBuilder::property(const std::string& name,
     return *this;
 }
 
+JsonSchemaBuilder& JsonSchemaBuilder::property(const std::string& name,
+                                               JsonSchemaBuilder&& propSchema) {
+    if (!schema_.contains("properties")) {
+        schema_["properties"] = json::object();
+    }
+    schema_["properties"][name] = std::move(propSchema).build();
+    return *this;
+}
+
 JsonSchemaBuilder& JsonSchemaBuilder::required(const std::vector<std::string>& requiredProps) {
     schema_["required"] = requiredProps;
     return *this;
@@ -114,6 +128,11 @@ JsonSchemaBuilder& JsonSchemaBuilder::additionalProperties(const JsonSchemaBuild
     return *this;
 }
 
+JsonSchemaBuilder& JsonSchemaBuilder::additionalProperties(JsonSchemaBuilder&& schema) {
+    schema_["additionalProperties"] = std::move(schema).build();
+    return *this;
+}
+
 JsonSchemaBuilder& JsonSchemaBuilder::minProperties(int min) {
     schema_["minProperties"] = min;
     return *this;
@@ -180,7 +199,13 @@ JsonSchemaBuilder& JsonSchemaBuilder::constValue(const json& value) {
 }
 
 // Build the final schema
-json JsonSchemaBuilder::build() const { return schema_; }
+json JsonSchemaBuilder::build() const& { return schema_; }
+
+json JsonSchemaBuilder::build() && { return std::move(schema_); }
+
+llmcpp::SchemaRef JsonSchemaBuilder::intern() const {
+    return llmcpp::SchemaInterner::intern(schema_);
+}
 
 // Utility methods
 JsonSchemaBuilder JsonSchemaBuilder::object() { return JsonSchemaBuilder().type("object"); }
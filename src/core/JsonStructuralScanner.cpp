@@ -0,0 +1,274 @@
+#include "core/JsonStructuralScanner.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define LLMCPP_SCAN_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+// AVX2 is compiled per function and selected at runtime, so no -mavx2 build flag is needed
+#define LLMCPP_SCAN_AVX2 1
+#endif
+#endif
+
+namespace llmcpp {
+
+namespace {
+
+constexpr size_t kBlock = 64;
+constexpr uint64_t kEvenBits = 0x5555555555555555ULL;
+
+// Per-block character masks; bit i is set when byte i of the block matches
+struct RawMasks {
+    uint64_t quote = 0;
+    uint64_t backslash = 0;
+    uint64_t open = 0;
+    uint64_t close = 0;
+};
+
+// String state carried from one block to the next
+struct StringState {
+    uint64_t inString = 0;  // All ones when the previous block ended inside a string
+    uint64_t escaped = 0;   // 1 when the first byte of this block is escaped
+};
+
+#ifdef LLMCPP_SCAN_SSE2
+inline uint64_t matches16(__m128i chunk, char c) {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(c))));
+}
+
+RawMasks classifySse2(const char* p, char open, char close) {
+    RawMasks m;
+    for (int i = 0; i < 4; ++i) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+        const int shift = 16 * i;
+        m.quote |= matches16(chunk, '"') << shift;
+        m.backslash |= matches16(chunk, '\\') << shift;
+        m.open |= matches16(chunk, open) << shift;
+        m.close |= matches16(chunk, close) << shift;
+    }
+    return m;
+}
+#endif
+
+#ifdef LLMCPP_SCAN_AVX2
+__attribute__((target("avx2"))) inline uint64_t matches32(__m256i chunk, char c) {
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(c))));
+}
+
+__attribute__((target("avx2"))) RawMasks classifyAvx2(const char* p, char open, char close) {
+    const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+    RawMasks m;
+    m.quote = matches32(low, '"') | matches32(high, '"') << 32;
+    m.backslash = matches32(low, '\\') | matches32(high, '\\') << 32;
+    m.open = matches32(low, open) | matches32(high, open) << 32;
+    m.close = matches32(low, close) | matches32(high, close) << 32;
+    return m;
+}
+#endif
+
+RawMasks classify(const char* p, char open, char close, JsonStructuralScanner::Isa isa) {
+#ifdef LLMCPP_SCAN_AVX2
+    if (isa == JsonStructuralScanner::Isa::AVX2) {
+        return classifyAvx2(p, open, close);
+    }
+#endif
+#ifdef LLMCPP_SCAN_SSE2
+    return classifySse2(p, open, close);
+#else
+    (void)p, (void)open, (void)close, (void)isa;
+    return {};  // Unreachable: Isa::Scalar never classifies in bulk
+#endif
+}
+
+// Bit i set when an odd number of quotes occur at or before i
+inline uint64_t prefixXor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Brackets outside strings, derived from the masks alone. Returns false, leaving `state`
+// untouched, when a backslash sits outside a string: a character scan ignores it there,
+// while the escape arithmetic would not.
+bool bulkStructurals(const RawMasks& raw, StringState& state, uint64_t& open, uint64_t& close) {
+    // A backslash escaped from the previous block does not start a new escape
+    const uint64_t backslash = raw.backslash & ~state.escaped;
+    const uint64_t followsEscape = backslash << 1 | state.escaped;
+    // Odd-length backslash runs escape the next character; the carry of the add splits
+    // runs by the parity of their start
+    const uint64_t oddSequenceStarts = backslash & ~kEvenBits & ~followsEscape;
+    const uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+    const bool carry = sequencesStartingOnEvenBits < backslash;
+    const uint64_t escaped = (kEvenBits ^ (sequencesStartingOnEvenBits << 1)) & followsEscape;
+
+    const uint64_t inString = prefixXor(raw.quote & ~escaped) ^ state.inString;
+    if (raw.backslash & ~inString) {
+        return false;
+    }
+
+    state.escaped = carry ? 1 : 0;
+    state.inString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+    open = raw.open & ~inString;
+    close = raw.close & ~inString;
+    return true;
+}
+
+// Character scan of one block: the scalar path, and the fallback for blocks the bulk
+// classifier cannot resolve
+void exactStructurals(const char* p, char openChar, char closeChar, StringState& state,
+                      uint64_t& open, uint64_t& close) {
+    bool inString = state.inString != 0;
+    bool escape = state.escaped != 0;
+    open = 0;
+    close = 0;
+    for (size_t i = 0; i < kBlock; ++i) {
+        const char c = p[i];
+        if (inString) {
+            if (escape) {
+                escape = false;
+            } else if (c == '\\') {
+                escape = true;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == openChar) {
+            open |= uint64_t(1) << i;
+        } else if (c == closeChar) {
+            close |= uint64_t(1) << i;
+        }
+    }
+    state.inString = inString ? ~uint64_t(0) : 0;
+    state.escaped = escape ? 1 : 0;
+}
+
+// Brackets outside strings in the 64 bytes starting at `block`; the tail is space-padded
+void scanBlock(std::string_view text, size_t block, char openChar, char closeChar,
+               JsonStructuralScanner::Isa isa, StringState& state, uint64_t& open,
+               uint64_t& close) {
+    const char* p = text.data() + block;
+    char padded[kBlock];
+    if (text.size() - block < kBlock) {
+        std::memset(padded, ' ', kBlock);
+        std::memcpy(padded, p, text.size() - block);
+        p = padded;
+    }
+    // A bit-parallel classifier without vector compares is slower than the plain loop
+    if (isa == JsonStructuralScanner::Isa::Scalar ||
+        !bulkStructurals(classify(p, openChar, closeChar, isa), state, open, close)) {
+        exactStructurals(p, openChar, closeChar, state, open, close);
+    }
+}
+
+JsonStructuralScanner::Isa supported(JsonStructuralScanner::Isa requested) {
+    return std::min(requested, JsonStructuralScanner::bestIsa());
+}
+
+}  // namespace
+
+JsonStructuralScanner::Isa JsonStructuralScanner::bestIsa() {
+#ifdef LLMCPP_SCAN_AVX2
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        return Isa::AVX2;
+    }
+#endif
+#ifdef LLMCPP_SCAN_SSE2
+    return Isa::SSE2;
+#else
+    return Isa::Scalar;
+#endif
+}
+
+const char* JsonStructuralScanner::isaName(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2:
+            return "avx2";
+        case Isa::SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+size_t JsonStructuralScanner::matchingBracketEnd(std::string_view text, size_t start, Isa isa) {
+    if (start >= text.size() || (text[start] != '[' && text[start] != '{')) {
+        return std::string_view::npos;
+    }
+    const char openChar = text[start];
+    const char closeChar = openChar == '[' ? ']' : '}';
+    isa = supported(isa);
+
+    StringState state;
+    size_t depth = 0;
+    for (size_t block = start; block < text.size(); block += kBlock) {
+        uint64_t open;
+        uint64_t close;
+        scanBlock(text, block, openChar, closeChar, isa, state, open, close);
+        for (uint64_t bits = open | close; bits != 0; bits &= bits - 1) {
+            const int i = std::countr_zero(bits);
+            if (open >> i & 1) {
+                ++depth;
+            } else if (--depth == 0) {
+                return block + i + 1;
+            }
+        }
+    }
+    return std::string_view::npos;
+}
+
+std::vector<JsonStructuralScanner::Range> JsonStructuralScanner::balancedObjects(
+    std::string_view text, Isa isa) {
+    isa = supported(isa);
+    std::vector<Range> ranges;
+    std::vector<size_t> open;
+
+    // Each pass starts at a top-level '{' with fresh string state and ends when its stack
+    // empties; the prose up to the next '{' is skipped without classification
+    for (size_t pos = text.find('{'); pos != std::string_view::npos;) {
+        StringState state;
+        size_t resume = std::string_view::npos;
+        for (size_t block = pos; block < text.size() && resume == std::string_view::npos;
+             block += kBlock) {
+            uint64_t opens;
+            uint64_t closes;
+            scanBlock(text, block, '{', '}', isa, state, opens, closes);
+            for (uint64_t bits = opens | closes; bits != 0; bits &= bits - 1) {
+                const int i = std::countr_zero(bits);
+                if (opens >> i & 1) {
+                    open.push_back(block + i);
+                    continue;
+                }
+                // A closed object replaces the objects nested in it
+                const size_t begin = open.back();
+                open.pop_back();
+                while (!ranges.empty() && ranges.back().begin > begin) {
+                    ranges.pop_back();
+                }
+                ranges.push_back({begin, block + i + 1});
+                if (open.empty()) {
+                    resume = block + i + 1;
+                    break;
+                }
+            }
+        }
+        if (resume == std::string_view::npos) {
+            break;  // Text ended inside an unclosed object
+        }
+        pos = text.find('{', resume);
+    }
+    return ranges;
+}
+
+}  // namespace llmcpp
@@ -1,4 +1,62 @@
 #include "core/LLMClient.h"
 
+#include <stdexcept>
+#include <utility>
+
+#include "core/ContextWindowManager.h"
+#include "core/CostMeter.h"
+#include "core/Tracing.h"
+
 // Implementation file for LLMClient
 // This is mostly an interface, but common functionality can be added here
+
+std::optional<LLMRequest> LLMClient::RequestHooks::prepare(
+    const LLMRequest& request, const std::string& model, llmcpp::Span& span,
+    llmcpp::BudgetReservation& reservation) const {
+    std::optional<LLMRequest> prepared;
+    std::string sentModel = model;
+
+    // Budget first: a downgrade changes the window the context has to fit
+    if (costMeter) {
+        auto admission = costMeter->admit(request, model);
+        span.setAttribute("llm.cost.estimated_usd", admission.estimatedCostUsd);
+        if (admission.decision == llmcpp::CostMeter::Decision::Reject) {
+            throw std::runtime_error("Budget exceeded for tenant '" + request.config.tenant +
+                                     "': spent $" + std::to_string(admission.spentUsd) +
+                                     " and $" + std::to_string(admission.pendingUsd) +
+                                     " in flight of $" +
+                                     std::to_string(admission.limitUsd.value_or(0.0)));
+        }
+        reservation = std::move(admission.reservation);
+        if (admission.decision == llmcpp::CostMeter::Decision::Downgrade) {
+            span.setAttribute("llm.cost.downgraded_from", model);
+            span.setAttribute("llm.model", admission.model);
+            prepared = request;
+            prepared->config.model = admission.model;
+            sentModel = admission.model;
+        }
+    }
+
+    // Fit the context before conversion so an oversized request is never uploaded
+    if (contextWindow) {
+        llmcpp::ContextWindowManager::FitResult fit;
+        auto fitted = contextWindow->fitted(prepared ? *prepared : request, sentModel, &fit);
+        span.setAttribute("llm.context.input_tokens", fit.tokensAfter);
+        span.setAttribute("llm.context.evicted_messages", fit.evictedMessages);
+        if (fitted) {
+            prepared = std::move(fitted);
+        }
+    }
+    return prepared;
+}
+
+void LLMClient::RequestHooks::recordCost(const LLMRequest& sent, const std::string& model,
+                                        const LLMUsage& usage, llmcpp::Span& span,
+                                        llmcpp::BudgetReservation& reservation) const {
+    if (costMeter && usage.totalTokens() > 0) {
+        double usd = costMeter->record(usage, model, sent.config.tenant, sent.config.costTag);
+        span.setAttribute("llm.cost.usd", usd);
+    }
+    // The actual cost is counted now, so the estimate no longer has to be held
+    reservation.release();
+}
@@ -0,0 +1,291 @@
+#include "core/Logger.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace llmcpp {
+
+namespace {
+
+uint64_t nowUnixNano() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count());
+}
+
+std::string formatTimestamp(uint64_t unixNano) {
+    auto seconds = static_cast<std::time_t>(unixNano / 1000000000ULL);
+    auto millis = static_cast<int>((unixNano / 1000000ULL) % 1000);
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &seconds);
+#else
+    gmtime_r(&seconds, &tm);
+#endif
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                  tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                  millis);
+    return buffer;
+}
+
+/**
+ * Bounded multi-producer/single-consumer ring buffer (Vyukov's sequence
+ * scheme). Each slot carries a sequence number that tells producers and the
+ * consumer whose turn it is, so pushes never take a lock.
+ */
+class RecordRing {
+   public:
+    explicit RecordRing(size_t capacity) : slots_(capacity), mask_(capacity - 1) {
+        for (size_t i = 0; i < capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(LogRecord&& record) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            size_t seq = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.record = std::move(record);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Single consumer only
+    bool tryPop(LogRecord& out) {
+        Slot& slot = slots_[dequeuePos_ & mask_];
+        size_t seq = slot.sequence.load(std::memory_order_acquire);
+        if (seq != dequeuePos_ + 1) {
+            return false;  // Empty (or the producer hasn't finished writing)
+        }
+        out = std::move(slot.record);
+        slot.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+   private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        LogRecord record;
+    };
+
+    std::vector<Slot> slots_;
+    const size_t mask_;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0;
+};
+
+}  // namespace
+
+std::string toString(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace:
+            return "TRACE";
+        case LogLevel::Debug:
+            return "DEBUG";
+        case LogLevel::Info:
+            return "INFO";
+        case LogLevel::Warn:
+            return "WARN";
+        case LogLevel::Error:
+            return "ERROR";
+        case LogLevel::Off:
+            return "OFF";
+    }
+    return "UNKNOWN";
+}
+
+nlohmann::json LogRecord::toJson() const {
+    nlohmann::json j = {{"timestamp", formatTimestamp(timestampUnixNano)},
+                        {"level", toString(level)},
+                        {"component", component},
+                        {"message", message}};
+    if (fields.is_object()) {
+        for (auto it = fields.begin(); it != fields.end(); ++it) {
+            j[it.key()] = it.value();
+        }
+    } else if (!fields.is_null()) {
+        j["fields"] = fields;
+    }
+    return j;
+}
+
+// Sinks
+
+void StderrLogSink::write(const LogRecord& record) {
+    std::string line = formatTimestamp(record.timestampUnixNano) + " " + toString(record.level) +
+                       " [" + record.component + "] " + record.message;
+    if (!record.fields.is_null()) {
+        line += " " + record.fields.dump();
+    }
+    line += "\n";
+    std::fwrite(line.data(), 1, line.size(), stderr);
+}
+
+void StderrLogSink::flush() { std::fflush(stderr); }
+
+void JsonStderrLogSink::write(const LogRecord& record) {
+    auto line = record.toJson().dump() + "\n";
+    std::fwrite(line.data(), 1, line.size(), stderr);
+}
+
+void JsonStderrLogSink::flush() { std::fflush(stderr); }
+
+// Logger
+
+class Logger::Impl {
+   public:
+    static constexpr size_t kCapacity = 8192;
+
+    Impl() : ring_(kCapacity), sink_(std::make_shared<StderrLogSink>()) {
+        worker_ = std::thread([this]() { run(); });
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    void push(LogRecord&& record) {
+        if (!ring_.tryPush(std::move(record))) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        enqueued_.fetch_add(1, std::memory_order_release);
+        // Unlocked notify: a missed wakeup only delays output by one poll interval
+        wake_.notify_one();
+    }
+
+    void setSink(std::shared_ptr<LogSink> sink) {
+        std::lock_guard<std::mutex> lock(sinkMutex_);
+        sink_ = std::move(sink);
+    }
+
+    void flush() {
+        uint64_t target = enqueued_.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.notify_one();
+        drained_.wait(lock, [&]() {
+            return written_.load(std::memory_order_acquire) >= target || stopping_;
+        });
+    }
+
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+   private:
+    void run() {
+        LogRecord record;
+        for (;;) {
+            bool wrote = false;
+            {
+                std::lock_guard<std::mutex> sinkLock(sinkMutex_);
+                while (ring_.tryPop(record)) {
+                    try {
+                        if (sink_) {
+                            sink_->write(record);
+                        }
+                    } catch (...) {
+                        // A failing sink must not take the logging thread down
+                    }
+                    written_.fetch_add(1, std::memory_order_release);
+                    wrote = true;
+                }
+                if (wrote && sink_) {
+                    try {
+                        sink_->flush();
+                    } catch (...) {
+                    }
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            drained_.notify_all();
+            if (stopping_ && written_.load(std::memory_order_acquire) >=
+                                 enqueued_.load(std::memory_order_acquire)) {
+                return;
+            }
+            wake_.wait_for(lock, std::chrono::milliseconds(50));
+        }
+    }
+
+    RecordRing ring_;
+    std::shared_ptr<LogSink> sink_;
+    std::mutex sinkMutex_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::thread worker_;
+};
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : impl_(std::make_unique<Impl>()) {}
+
+Logger::~Logger() = default;
+
+void Logger::setLevel(LogLevel level) {
+    runtimeLevel_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::getLevel() const {
+    return static_cast<LogLevel>(runtimeLevel_.load(std::memory_order_relaxed));
+}
+
+void Logger::setSink(std::shared_ptr<LogSink> sink) { impl_->setSink(std::move(sink)); }
+
+void Logger::log(LogLevel level, std::string component, std::string message) {
+    log(level, std::move(component), std::move(message), nullptr);
+}
+
+void Logger::log(LogLevel level, std::string component, std::string message,
+                 nlohmann::json fields) {
+    if (!shouldLog(level) || level == LogLevel::Off) {
+        return;
+    }
+    LogRecord record;
+    record.level = level;
+    record.timestampUnixNano = nowUnixNano();
+    record.component = std::move(component);
+    record.message = std::move(message);
+    record.fields = std::move(fields);
+    impl_->push(std::move(record));
+}
+
+void Logger::flush() { impl_->flush(); }
+
+uint64_t Logger::droppedCount() const { return impl_->dropped(); }
+
+}  // namespace llmcpp
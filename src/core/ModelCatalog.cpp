@@ -0,0 +1,15 @@
+#include "core/ModelCatalog.h"
+
+namespace llmcpp {
+
+std::vector<std::string> modelNames(ModelProvider provider, ModelFeature feature) {
+    std::vector<std::string> names;
+    for (const auto& info : modelCatalog()) {
+        if (info.provider == provider && info.supports(feature)) {
+            names.emplace_back(info.name);
+        }
+    }
+    return names;
+}
+
+}  // namespace llmcpp
@@ -0,0 +1,25 @@
+#include "core/PromptCache.h"
+
+#include <charconv>
+
+namespace llmcpp {
+
+double canonicalFloat(float value) {
+    char buffer[32];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    double widened = value;
+    if (ec == std::errc()) {
+        std::from_chars(buffer, end, widened);
+    }
+    return widened;
+}
+
+PromptPrefix PromptPrefix::of(const nlohmann::json& parts) {
+    PromptPrefix prefix;
+    // nlohmann::json objects are ordered maps, so dump() already sorts keys
+    prefix.bytes = parts.dump();
+    prefix.hash = SchemaHash128::of(prefix.bytes);
+    return prefix;
+}
+
+}  // namespace llmcpp
@@ -2,13 +2,138 @@
 
 #include <algorithm>
 #include <fstream>
-#include <iostream>
 #include <nlohmann/json.hpp>
-#include <regex>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
+
+#include "core/JsonStructuralScanner.h"
+#include "core/Logger.h"
 
 namespace llmcpp {
 
+namespace {
+
+// Single-pass scanners over the raw response text. Every search resumes where the previous
+// match ended, so each function is linear in the input and only allocates for its output.
+
+constexpr std::string_view kFence = "```";
+
+// ECMAScript \s
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+size_t skipSpace(std::string_view text, size_t pos) {
+    while (pos < text.size() && isSpace(text[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+std::string_view trim(std::string_view text) {
+    size_t begin = text.find_first_not_of(" \t\n\r");
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(begin, text.find_last_not_of(" \t\n\r") - begin + 1);
+}
+
+bool consume(std::string_view text, size_t& pos, std::string_view literal) {
+    if (text.substr(pos, literal.size()) != literal) {
+        return false;
+    }
+    pos += literal.size();
+    return true;
+}
+
+// Parse without throwing; discarded on invalid JSON
+nlohmann::json parseOrDiscard(std::string_view text) {
+    return nlohmann::json::parse(text.begin(), text.end(), nullptr, /*allow_exceptions=*/false);
+}
+
+// Body of the next ```[json] fence at or after `pos`; `pos` moves past the closing fence
+std::optional<std::string_view> nextFencedBlock(std::string_view text, size_t& pos) {
+    size_t open = text.find(kFence, pos);
+    if (open == std::string_view::npos) {
+        return std::nullopt;
+    }
+    size_t bodyStart = open + kFence.size();
+    consume(text, bodyStart, "json");
+    bodyStart = skipSpace(text, bodyStart);
+
+    size_t close = text.find(kFence, bodyStart);
+    if (close == std::string_view::npos) {
+        pos = text.size();
+        return std::nullopt;
+    }
+    pos = close + kFence.size();
+    return text.substr(bodyStart, close - bodyStart);
+}
+
+struct NamedElement {
+    std::string_view name;  // Value of the name="..." attribute
+    std::string_view body;
+};
+
+// Next <tag name="...">body</tag> at or after `pos`; `pos` moves past the closing tag.
+// Opening tags that do not have the expected shape, or whose name differs from a non-empty
+// `wantName`, are skipped.
+std::optional<NamedElement> nextNamedElement(std::string_view text, size_t& pos,
+                                             std::string_view tag, std::string_view closeTag,
+                                             std::string_view wantName = {}) {
+    while (pos < text.size()) {
+        size_t open = text.find('<', pos);
+        if (open == std::string_view::npos) {
+            break;
+        }
+        pos = open + 1;
+
+        size_t cursor = pos;
+        if (!consume(text, cursor, tag)) {
+            continue;
+        }
+        size_t afterTag = cursor;
+        cursor = skipSpace(text, cursor);
+        if (cursor == afterTag || !consume(text, cursor, "name")) {
+            continue;
+        }
+        cursor = skipSpace(text, cursor);
+        if (!consume(text, cursor, "=")) {
+            continue;
+        }
+        cursor = skipSpace(text, cursor);
+        if (cursor >= text.size() || (text[cursor] != '"' && text[cursor] != '\'')) {
+            continue;
+        }
+        size_t nameStart = ++cursor;
+        cursor = text.find_first_of("\"'", cursor);
+        if (cursor == std::string_view::npos || cursor == nameStart) {
+            continue;
+        }
+        std::string_view name = text.substr(nameStart, cursor - nameStart);
+        if (!wantName.empty() && name != wantName) {
+            continue;
+        }
+        cursor = skipSpace(text, cursor + 1);
+        if (!consume(text, cursor, ">")) {
+            continue;
+        }
+
+        size_t close = text.find(closeTag, cursor);
+        if (close == std::string_view::npos) {
+            // No closing tag anywhere after this point, so no later element can match either
+            break;
+        }
+        pos = close + closeTag.size();
+        return NamedElement{name, text.substr(cursor, close - cursor)};
+    }
+    pos = text.size();
+    return std::nullopt;
+}
+
+}  // namespace
+
 std::vector<ParsedResult> ResponseParser::parseStructuredResponse(const LLMResponse& response,
                                                                   const std::string& /*providerName*/,
                                                                   const std::string& /*functionName*/) {
@@ -121,21 +246,17 @@ std::vector<ParsedResult> ResponseParser::parseDirectFunctionTags(const std::str
 std::vector<ParsedResult> ResponseParser::parseOpenAIJsonResponse(const LLMResponse& response) {
     std::vector<ParsedResult> results;
 
-    std::cerr << "DEBUG: parseOpenAIJsonResponse called" << std::endl;
-    std::cerr << "DEBUG: response.result.is_object() = " << response.result.is_object()
-              << std::endl;
-    std::cerr << "DEBUG: response.result type = " << response.result.type_name() << std::endl;
-    std::cerr << "DEBUG: response.result dump = " << response.result.dump().substr(0, 200) << "..."
-              << std::endl;
+    LLMCPP_LOG_TRACE("response_parser", "parseOpenAIJsonResponse",
+                     {{"result_type", response.result.type_name()},
+                      {"result_prefix", response.result.dump().substr(0, 200)}});
 
     // Handle structured JSON response - return it exactly as-is
     if (response.result.is_object()) {
-        std::cerr << "DEBUG: Returning openai_structured" << std::endl;
         results.emplace_back("", response.result, "openai_structured");
         return results;
     }
 
-    std::cerr << "DEBUG: Response not structured, returning empty" << std::endl;
+    LLMCPP_LOG_DEBUG("response_parser", "OpenAI response not structured, returning empty");
     return results;
 }
 
@@ -177,7 +298,7 @@ std::vector<ParsedResult> ResponseParser::parseJsonArrayFromText(const std::stri
         results.emplace_back("", jsonArray, "json_array_text");
 
     } catch (const std::exception& e) {
-        std::cerr << "JSON parsing error: " << e.what() << std::endl;
+        LLMCPP_LOG_WARN("response_parser", "JSON parsing error", {{"error", e.what()}});
     }
 
     return results;
@@ -186,20 +307,12 @@ std::vector<ParsedResult> ResponseParser::parseJsonArrayFromText(const std::stri
 std::vector<ParsedResult> ResponseParser::parseMarkdownFencedJson(const std::string& text) {
     std::vector<ParsedResult> results;
 
-    std::regex jsonBlockRegex(R"(```(?:json)?\s*([\s\S]*?)```)");
-    std::sregex_iterator iter(text.begin(), text.end(), jsonBlockRegex);
-    std::sregex_iterator end;
-
-    for (; iter != end; ++iter) {
-        std::string jsonText = (*iter)[1].str();
-        jsonText = normalizeWhitespace(jsonText);
-
-        try {
-            auto json = nlohmann::json::parse(jsonText);
-            results.emplace_back("", json, "markdown_fenced");
-        } catch (const std::exception& e) {
-            // Continue to next block if this one fails
-            continue;
+    size_t pos = 0;
+    while (auto block = nextFencedBlock(text, pos)) {
+        auto json = parseOrDiscard(trim(*block));
+        // Skip blocks that are not valid JSON
+        if (!json.is_discarded()) {
+            results.emplace_back("", std::move(json), "markdown_fenced");
         }
     }
 
@@ -219,57 +332,44 @@ std::string ResponseParser::extractXmlContent(const std::string& text) {
 }
 
 std::vector<ParsedResult> ResponseParser::parseXmlFunctionCalls(const std::string& xmlText) {
+    static constexpr std::string_view kOpen = "<function_calls>";
+    static constexpr std::string_view kClose = "</function_calls>";
     std::vector<ParsedResult> results;
+    std::string_view text = xmlText;
+
+    for (size_t pos = text.find(kOpen); pos != std::string_view::npos;
+         pos = text.find(kOpen, pos)) {
+        size_t contentStart = pos + kOpen.size();
+        size_t contentEnd = text.find(kClose, contentStart);
+        if (contentEnd == std::string_view::npos) {
+            break;
+        }
+        pos = contentEnd + kClose.size();
+        std::string_view functionCallsContent = text.substr(contentStart, contentEnd - contentStart);
 
-    // Look for function_calls blocks first (use [\s\S] instead of . to match newlines)
-    std::regex functionCallsRegex(R"(<function_calls>([\s\S]*?)</function_calls>)");
-    std::sregex_iterator functionCallsIter(xmlText.begin(), xmlText.end(), functionCallsRegex);
-    std::sregex_iterator functionCallsEnd;
-
-    for (; functionCallsIter != functionCallsEnd; ++functionCallsIter) {
-        std::string functionCallsContent = (*functionCallsIter)[1].str();
-
-        // Look for invoke elements within function_calls (use [\s\S] instead of . to match
-        // newlines)
-        std::regex invokeRegex(
-            R"(<invoke\s+name\s*=\s*[\"']([^\"']+)[\"']\s*>([\s\S]*?)</invoke>)");
-        std::sregex_iterator invokeIter(functionCallsContent.begin(), functionCallsContent.end(),
-                                        invokeRegex);
-        std::sregex_iterator invokeEnd;
-
-        for (; invokeIter != invokeEnd; ++invokeIter) {
-            std::string functionName = (*invokeIter)[1].str();
-            std::string parameters = (*invokeIter)[2].str();
-
-            // Extract all parameters using a more generic approach
-            std::regex allParamsRegex(
-                R"(<parameter\s+name\s*=\s*[\"']([^\"']+)[\"']\s*>([\s\S]*?)</parameter>)");
-            std::sregex_iterator paramIter(parameters.begin(), parameters.end(), allParamsRegex);
-            std::sregex_iterator paramEnd;
-
+        size_t invokePos = 0;
+        while (auto invoke =
+                   nextNamedElement(functionCallsContent, invokePos, "invoke", "</invoke>")) {
             // Create result object with all parameters
             nlohmann::json resultData;
             std::string description;
 
-            for (; paramIter != paramEnd; ++paramIter) {
-                std::string paramName = (*paramIter)[1].str();
-                std::string paramValue = (*paramIter)[2].str();
-
-                // Trim whitespace
-                paramValue.erase(0, paramValue.find_first_not_of(" \t\n\r"));
-                paramValue.erase(paramValue.find_last_not_of(" \t\n\r") + 1);
+            size_t paramPos = 0;
+            while (auto param =
+                       nextNamedElement(invoke->body, paramPos, "parameter", "</parameter>")) {
+                std::string paramName(param->name);
+                std::string_view paramValue = trim(param->body);
 
                 if (paramName == "description") {
                     description = paramValue;
                 }
 
                 // Try to parse as JSON, fallback to string
-                try {
-                    auto json = nlohmann::json::parse(paramValue);
-                    resultData[paramName] = json;
-                } catch (const std::exception& e) {
-                    // Store as string if JSON parsing fails
+                auto json = parseOrDiscard(paramValue);
+                if (json.is_discarded()) {
                     resultData[paramName] = paramValue;
+                } else {
+                    resultData[paramName] = std::move(json);
                 }
             }
 
@@ -285,111 +385,38 @@ std::vector<ParsedResult> ResponseParser::parseXmlFunctionCalls(const std::strin
 
 std::string ResponseParser::extractParameterValue(const std::string& xmlText,
                                                   const std::string& paramName) {
-    // Handle both formats: <parameter name="param_name">value</parameter> (use [\s\S] to match
-    // newlines)
-    std::string pattern =
-        R"(<parameter\s+name\s*=\s*[\"'])" + paramName + R"([\"']\s*>([\s\S]*?)</parameter>)";
-    std::regex paramRegex(pattern);
-    std::smatch match;
-
-    if (std::regex_search(xmlText, match, paramRegex)) {
-        std::string value = match[1].str();
-        // Trim whitespace
-        value.erase(0, value.find_first_not_of(" \t\n\r"));
-        value.erase(value.find_last_not_of(" \t\n\r") + 1);
-        return value;
+    // Matches <parameter name="param_name">value</parameter>; paramName is compared literally
+    if (paramName.empty()) {
+        return "";
     }
-
-    return "";
+    size_t pos = 0;
+    auto param = nextNamedElement(xmlText, pos, "parameter", "</parameter>", paramName);
+    return param ? std::string(trim(param->body)) : "";
 }
 
 std::string ResponseParser::extractBalancedJsonArray(const std::string& text, size_t startPos) {
     if (startPos >= text.length() || text[startPos] != '[') {
         return "";
     }
-
-    int depth = 0;
-    bool inString = false;
-    bool escape = false;
-
-    for (size_t i = startPos; i < text.length(); ++i) {
-        char c = text[i];
-
-        if (inString) {
-            if (escape) {
-                escape = false;
-            } else if (c == '\\') {
-                escape = true;
-            } else if (c == '"') {
-                inString = false;
-            }
-        } else {
-            if (c == '"') {
-                inString = true;
-            } else if (c == '[') {
-                depth++;
-            } else if (c == ']') {
-                depth--;
-                if (depth == 0) {
-                    return text.substr(startPos, i - startPos + 1);
-                }
-            }
-        }
-    }
-
-    return "";  // Unbalanced
+    size_t end = JsonStructuralScanner::matchingBracketEnd(text, startPos);
+    return end == std::string::npos ? "" : text.substr(startPos, end - startPos);  // Unbalanced
 }
 
 std::string ResponseParser::extractBalancedJsonObject(const std::string& text, size_t startPos) {
     if (startPos >= text.length() || text[startPos] != '{') {
         return "";
     }
-
-    int depth = 0;
-    bool inString = false;
-    bool escape = false;
-
-    for (size_t i = startPos; i < text.length(); ++i) {
-        char c = text[i];
-
-        if (inString) {
-            if (escape) {
-                escape = false;
-            } else if (c == '\\') {
-                escape = true;
-            } else if (c == '"') {
-                inString = false;
-            }
-        } else {
-            if (c == '"') {
-                inString = true;
-            } else if (c == '{') {
-                depth++;
-            } else if (c == '}') {
-                depth--;
-                if (depth == 0) {
-                    return text.substr(startPos, i - startPos + 1);
-                }
-            }
-        }
-    }
-
-    return "";  // Unbalanced
+    size_t end = JsonStructuralScanner::matchingBracketEnd(text, startPos);
+    return end == std::string::npos ? "" : text.substr(startPos, end - startPos);  // Unbalanced
 }
 
 std::vector<std::string> ResponseParser::salvageJsonObjects(const std::string& text) {
+    auto ranges = JsonStructuralScanner::balancedObjects(text);
     std::vector<std::string> objects;
-
-    for (size_t pos = 0; pos < text.length(); ++pos) {
-        if (text[pos] == '{') {
-            std::string obj = extractBalancedJsonObject(text, pos);
-            if (!obj.empty()) {
-                objects.push_back(obj);
-                pos += obj.length() - 1;  // Skip past this object
-            }
-        }
+    objects.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        objects.push_back(text.substr(range.begin, range.end - range.begin));
     }
-
     return objects;
 }
 
@@ -409,11 +436,19 @@ std::string ResponseParser::rebuildJsonArray(const std::vector<std::string>& obj
 }
 
 std::string ResponseParser::stripMarkdownFences(const std::string& text) {
-    std::string result = text;
-
-    // Remove ```json and ``` fences
-    result = std::regex_replace(result, std::regex(R"(```(?:json)?\s*)"), "");
-    result = std::regex_replace(result, std::regex(R"(\s*```)"), "");
+    // Remove ```json and ``` fences and the whitespace that follows them. Fences are matched
+    // leftmost-first, so removing one never joins backticks into a new fence.
+    std::string result;
+    result.reserve(text.size());
+    size_t pos = 0;
+    for (size_t fence = text.find(kFence); fence != std::string::npos;
+         fence = text.find(kFence, pos)) {
+        result.append(text, pos, fence - pos);
+        pos = fence + kFence.size();
+        consume(text, pos, "json");
+        pos = skipSpace(text, pos);
+    }
+    result.append(text, pos, std::string::npos);
 
     return result;
 }
@@ -0,0 +1,186 @@
+#include "core/SchemaInterner.h"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace llmcpp {
+
+namespace {
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t fmix64(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+inline uint64_t load64(const unsigned char* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+struct InternTable {
+    std::mutex mutex;
+    std::unordered_map<SchemaHash128, std::weak_ptr<const InternedSchema>,
+                       SchemaHash128::Hasher> entries;
+    size_t insertsSinceSweep = 0;
+
+    static InternTable& instance() {
+        static InternTable table;
+        return table;
+    }
+
+    // Drop entries whose schema is no longer referenced; amortized over inserts
+    void sweepIfNeeded() {
+        if (++insertsSinceSweep < 64 || insertsSinceSweep < entries.size()) {
+            return;
+        }
+        insertsSinceSweep = 0;
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = it->second.expired() ? entries.erase(it) : std::next(it);
+        }
+    }
+};
+
+}  // namespace
+
+SchemaHash128 SchemaHash128::of(std::string_view bytes) {
+    const auto* data = reinterpret_cast<const unsigned char*>(bytes.data());
+    const size_t len = bytes.size();
+    const size_t nblocks = len / 16;
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+    uint64_t h1 = 0;
+    uint64_t h2 = 0;
+
+    for (size_t i = 0; i < nblocks; ++i) {
+        uint64_t k1 = load64(data + i * 16);
+        uint64_t k2 = load64(data + i * 16 + 8);
+
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+        h1 = rotl64(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+        h2 = rotl64(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    const unsigned char* tail = data + nblocks * 16;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    switch (len & 15) {
+        case 15: k2 ^= uint64_t(tail[14]) << 48; [[fallthrough]];
+        case 14: k2 ^= uint64_t(tail[13]) << 40; [[fallthrough]];
+        case 13: k2 ^= uint64_t(tail[12]) << 32; [[fallthrough]];
+        case 12: k2 ^= uint64_t(tail[11]) << 24; [[fallthrough]];
+        case 11: k2 ^= uint64_t(tail[10]) << 16; [[fallthrough]];
+        case 10: k2 ^= uint64_t(tail[9]) << 8; [[fallthrough]];
+        case 9:
+            k2 ^= uint64_t(tail[8]);
+            k2 *= c2;
+            k2 = rotl64(k2, 33);
+            k2 *= c1;
+            h2 ^= k2;
+            [[fallthrough]];
+        case 8: k1 ^= uint64_t(tail[7]) << 56; [[fallthrough]];
+        case 7: k1 ^= uint64_t(tail[6]) << 48; [[fallthrough]];
+        case 6: k1 ^= uint64_t(tail[5]) << 40; [[fallthrough]];
+        case 5: k1 ^= uint64_t(tail[4]) << 32; [[fallthrough]];
+        case 4: k1 ^= uint64_t(tail[3]) << 24; [[fallthrough]];
+        case 3: k1 ^= uint64_t(tail[2]) << 16; [[fallthrough]];
+        case 2: k1 ^= uint64_t(tail[1]) << 8; [[fallthrough]];
+        case 1:
+            k1 ^= uint64_t(tail[0]);
+            k1 *= c1;
+            k1 = rotl64(k1, 31);
+            k1 *= c2;
+            h1 ^= k1;
+            break;
+        default:
+            break;
+    }
+
+    h1 ^= len;
+    h2 ^= len;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64(h1);
+    h2 = fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+    return {h1, h2};
+}
+
+std::string SchemaHash128::toHex() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string out(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        out[15 - i] = digits[(high >> (4 * i)) & 0xF];
+        out[31 - i] = digits[(low >> (4 * i)) & 0xF];
+    }
+    return out;
+}
+
+SchemaRef SchemaInterner::intern(const nlohmann::json& schema) {
+    // json objects keep keys sorted, so dump() is already the canonical form
+    std::string canonical = schema.dump();
+    return internCanonical(nlohmann::json(schema), std::move(canonical));
+}
+
+SchemaRef SchemaInterner::intern(nlohmann::json&& schema) {
+    std::string canonical = schema.dump();
+    return internCanonical(std::move(schema), std::move(canonical));
+}
+
+SchemaRef SchemaInterner::internText(std::string_view schemaText) {
+    return intern(nlohmann::json::parse(schemaText));
+}
+
+SchemaRef SchemaInterner::internCanonical(nlohmann::json&& schema, std::string&& canonical) {
+    SchemaHash128 hash = SchemaHash128::of(canonical);
+    auto& table = InternTable::instance();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    auto it = table.entries.find(hash);
+    if (it != table.entries.end()) {
+        if (auto existing = it->second.lock()) {
+            // A 128-bit collision is not expected; fall through to a private copy if one happens
+            if (existing->canonical() == canonical) {
+                return existing;
+            }
+            return SchemaRef(new InternedSchema(std::move(schema), std::move(canonical), hash));
+        }
+    }
+
+    SchemaRef interned(new InternedSchema(std::move(schema), std::move(canonical), hash));
+    table.entries[hash] = interned;
+    table.sweepIfNeeded();
+    return interned;
+}
+
+size_t SchemaInterner::size() {
+    auto& table = InternTable::instance();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    size_t live = 0;
+    for (const auto& [hash, entry] : table.entries) {
+        live += entry.expired() ? 0 : 1;
+    }
+    return live;
+}
+
+}  // namespace llmcpp
@@ -0,0 +1,81 @@
+#include "core/SseParser.h"
+
+#include <stdexcept>
+
+namespace llmcpp {
+
+SseParser::SseParser(EventCallback onEvent) : onEvent_(std::move(onEvent)) {
+    if (!onEvent_) {
+        throw std::invalid_argument("SseParser: event callback is required");
+    }
+}
+
+void SseParser::feed(std::string_view chunk) {
+    for (size_t pos = 0; pos < chunk.size();) {
+        size_t newline = chunk.find('\n', pos);
+        if (newline == std::string_view::npos) {
+            line_.append(chunk.substr(pos));
+            return;
+        }
+        std::string_view line = chunk.substr(pos, newline - pos);
+        if (!line_.empty()) {
+            line_.append(line);
+            processLine(line_);
+            line_.clear();
+        } else {
+            processLine(line);
+        }
+        pos = newline + 1;
+    }
+}
+
+void SseParser::finish() {
+    if (!line_.empty()) {
+        processLine(line_);
+        line_.clear();
+    }
+    dispatch();
+}
+
+void SseParser::processLine(std::string_view line) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    if (line.empty()) {
+        dispatch();
+        return;
+    }
+    if (line.front() == ':') {
+        return;  // Comment / keep-alive
+    }
+
+    size_t colon = line.find(':');
+    std::string_view field = line.substr(0, colon);
+    std::string_view value;
+    if (colon != std::string_view::npos) {
+        value = line.substr(colon + 1);
+        if (!value.empty() && value.front() == ' ') {
+            value.remove_prefix(1);
+        }
+    }
+
+    if (field == "data") {
+        if (hasData_) {
+            current_.data += '\n';
+        }
+        current_.data.append(value);
+        hasData_ = true;
+    } else if (field == "event") {
+        current_.event.assign(value);
+    }
+}
+
+void SseParser::dispatch() {
+    if (hasData_) {
+        onEvent_(current_);
+    }
+    current_ = Event{};
+    hasData_ = false;
+}
+
+}  // namespace llmcpp
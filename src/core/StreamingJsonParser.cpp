@@ -0,0 +1,253 @@
+#include "core/StreamingJsonParser.h"
+
+#include <stdexcept>
+
+#include "core/Logger.h"
+
+namespace llmcpp {
+
+namespace {
+
+bool isJsonSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+// Split a JSON Pointer into unescaped reference tokens
+std::vector<std::string> parsePointer(std::string_view pointer) {
+    std::vector<std::string> tokens;
+    if (pointer.empty()) {
+        return tokens;
+    }
+    if (pointer.front() != '/') {
+        throw std::invalid_argument("StreamingJsonParser: container path must be a JSON Pointer");
+    }
+    for (size_t pos = 1;;) {
+        size_t slash = pointer.find('/', pos);
+        std::string_view raw = pointer.substr(pos, slash == std::string_view::npos
+                                                       ? std::string_view::npos
+                                                       : slash - pos);
+        std::string token;
+        for (size_t i = 0; i < raw.size(); ++i) {
+            if (raw[i] == '~' && i + 1 < raw.size() && (raw[i + 1] == '0' || raw[i + 1] == '1')) {
+                token += raw[++i] == '0' ? '~' : '/';
+            } else {
+                token += raw[i];
+            }
+        }
+        tokens.push_back(std::move(token));
+        if (slash == std::string_view::npos) {
+            break;
+        }
+        pos = slash + 1;
+    }
+    return tokens;
+}
+
+}  // namespace
+
+StreamingJsonParser::StreamingJsonParser(ValueCallback onValue)
+    : StreamingJsonParser("", std::move(onValue)) {}
+
+StreamingJsonParser::StreamingJsonParser(std::string_view containerPath, ValueCallback onValue)
+    : path_(parsePointer(containerPath)), onValue_(std::move(onValue)) {
+    if (!onValue_) {
+        throw std::invalid_argument("StreamingJsonParser: value callback is required");
+    }
+}
+
+void StreamingJsonParser::feed(std::string_view chunk) {
+    size_t pos = 0;
+    while (pos < chunk.size() && !done_ && !failed()) {
+        if (inString_ && !escape_) {
+            // Copy string contents up to the next quote or escape in one go
+            size_t stop = chunk.find_first_of("\"\\", pos);
+            std::string_view run = chunk.substr(pos, stop == std::string_view::npos
+                                                         ? std::string_view::npos
+                                                         : stop - pos);
+            if (readingKey_) {
+                key_ += run;
+            }
+            if (capturing_) {
+                element_ += run;
+            }
+            pos += run.size();
+            if (pos == chunk.size()) {
+                break;
+            }
+        }
+        consume(chunk[pos++]);
+    }
+}
+
+LLMStreamCallback StreamingJsonParser::streamCallback() {
+    return [this](const std::string& chunk) { feed(chunk); };
+}
+
+void StreamingJsonParser::reset() {
+    frames_.clear();
+    targetDepth_ = 0;
+    inString_ = false;
+    escape_ = false;
+    readingKey_ = false;
+    capturing_ = false;
+    done_ = false;
+    key_.clear();
+    element_.clear();
+    pending_ = StreamedValue{};
+    emitted_ = 0;
+    error_.clear();
+}
+
+void StreamingJsonParser::consume(char c) {
+    if (inString_) {
+        if (readingKey_) {
+            key_ += c;
+        }
+        if (capturing_) {
+            element_ += c;
+        }
+
+        if (escape_) {
+            escape_ = false;
+        } else if (c == '\\') {
+            escape_ = true;
+        } else if (c == '"') {
+            inString_ = false;
+            if (readingKey_) {
+                readingKey_ = false;
+                // Member names rarely contain escapes; only those need a real decode
+                if (key_.find('\\') == std::string::npos) {
+                    frames_.back().key = key_.substr(1, key_.size() - 2);
+                } else {
+                    auto decoded = nlohmann::json::parse(key_, nullptr, false);
+                    if (!decoded.is_string()) {
+                        fail("Invalid member name " + key_);
+                        return;
+                    }
+                    frames_.back().key = decoded.get<std::string>();
+                }
+            } else if (capturing_ && frames_.size() == targetDepth_) {
+                emitElement();  // A string element is complete at its closing quote
+            }
+        }
+        return;
+    }
+
+    // Skip prose or a markdown fence before the root value
+    if (frames_.empty() && c != '{' && c != '[') {
+        return;
+    }
+
+    switch (c) {
+        case '"':
+            inString_ = true;
+            if (frames_.back().isObject && frames_.back().expectKey) {
+                readingKey_ = true;
+                key_.assign(1, c);
+            } else {
+                beginElement();
+            }
+            if (capturing_) {
+                element_ += c;
+            }
+            break;
+
+        case '{':
+        case '[':
+            beginElement();
+            if (capturing_) {
+                element_ += c;
+            }
+            frames_.push_back(Frame{c == '{', c == '{', 0, {}});
+            if (targetDepth_ == 0 && framesMatchPath()) {
+                targetDepth_ = frames_.size();
+            }
+            break;
+
+        case '}':
+        case ']': {
+            const bool closesTarget = frames_.size() == targetDepth_;
+            if (capturing_ && closesTarget) {
+                emitElement();  // Number or literal ended by the closing bracket
+            } else if (capturing_) {
+                element_ += c;
+            }
+            frames_.pop_back();
+            if (closesTarget) {
+                targetDepth_ = 0;
+            } else if (capturing_ && frames_.size() == targetDepth_) {
+                emitElement();  // Object or array element closed
+            }
+            done_ = frames_.empty();
+            break;
+        }
+
+        case ',':
+            if (capturing_ && frames_.size() == targetDepth_) {
+                emitElement();
+            } else if (capturing_) {
+                element_ += c;
+            }
+            ++frames_.back().index;
+            frames_.back().expectKey = frames_.back().isObject;
+            break;
+
+        case ':':
+            if (capturing_) {
+                element_ += c;
+            }
+            frames_.back().expectKey = false;
+            break;
+
+        default:
+            if (!isJsonSpace(c)) {
+                beginElement();
+            }
+            if (capturing_) {
+                element_ += c;
+            }
+            break;
+    }
+}
+
+void StreamingJsonParser::beginElement() {
+    if (capturing_ || targetDepth_ == 0 || frames_.size() != targetDepth_) {
+        return;
+    }
+    const Frame& frame = frames_.back();
+    capturing_ = true;
+    element_.clear();
+    pending_.key = frame.isObject ? frame.key : std::string();
+    pending_.index = frame.index;
+}
+
+void StreamingJsonParser::emitElement() {
+    capturing_ = false;
+    auto value = nlohmann::json::parse(element_, nullptr, /*allow_exceptions=*/false);
+    if (value.is_discarded()) {
+        fail("Invalid JSON in streamed element " + std::to_string(pending_.index));
+        return;
+    }
+    pending_.value = std::move(value);
+    ++emitted_;
+    onValue_(std::move(pending_));
+    pending_ = StreamedValue{};
+}
+
+bool StreamingJsonParser::framesMatchPath() const {
+    if (frames_.size() != path_.size() + 1) {
+        return false;
+    }
+    for (size_t i = 0; i < path_.size(); ++i) {
+        const Frame& frame = frames_[i];
+        if (frame.isObject ? frame.key != path_[i] : std::to_string(frame.index) != path_[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StreamingJsonParser::fail(std::string message) {
+    LLMCPP_LOG_WARN("streaming_json", "Streamed JSON parse failed", {{"error", message}});
+    error_ = std::move(message);
+}
+
+}  // namespace llmcpp
@@ -0,0 +1,738 @@
+#include "core/Tokenizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+
+namespace llmcpp {
+
+namespace {
+
+// ---- Rank table hashing ---------------------------------------------------------------
+
+// Tokens are short: one multiply-xorshift per 8-byte word
+inline uint64_t hashBytes(std::string_view bytes) {
+    constexpr uint64_t kMul = 0x9e3779b97f4a7c15ULL;
+    uint64_t h = bytes.size() * kMul;
+    const char* p = bytes.data();
+    size_t len = bytes.size();
+    while (len >= 8) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        h = (h ^ v) * kMul;
+        h ^= h >> 29;
+        p += 8;
+        len -= 8;
+    }
+    if (len > 0) {
+        uint64_t v = 0;
+        std::memcpy(&v, p, len);
+        h = (h ^ v) * kMul;
+        h ^= h >> 29;
+    }
+    return h ^ (h >> 32);
+}
+
+// ---- Character classes ----------------------------------------------------------------
+
+// Letter classes split by case because o200k_base's pattern distinguishes them; Mark is
+// in neither \p{L} nor \p{N}, but o200k_base's word classes include it.
+enum CharClass : uint8_t {
+    Upper,        // Lu, Lt
+    Lower,        // Ll
+    LetterOther,  // Lm, Lo
+    Mark,         // M
+    Number,       // N
+    Space,        // \s except \r and \n
+    Newline,      // \r, \n
+    Other,        // Punctuation, symbols, controls, invalid UTF-8
+};
+
+struct Range {
+    uint32_t first;
+    uint32_t last;
+};
+
+constexpr Range kSpaces[] = {{0x85, 0x85},     {0xA0, 0xA0},     {0x1680, 0x1680},
+                             {0x2000, 0x200A}, {0x2028, 0x2029}, {0x202F, 0x202F},
+                             {0x205F, 0x205F}, {0x3000, 0x3000}};
+
+constexpr Range kNumbers[] = {
+    {0xB2, 0xB3},     {0xB9, 0xB9},     {0xBC, 0xBE},     {0x660, 0x669},   {0x6F0, 0x6F9},
+    {0x7C0, 0x7C9},   {0x966, 0x96F},   {0x9E6, 0x9EF},   {0xA66, 0xA6F},   {0xAE6, 0xAEF},
+    {0xB66, 0xB6F},   {0xBE6, 0xBF2},   {0xC66, 0xC6F},   {0xCE6, 0xCEF},   {0xD66, 0xD78},
+    {0xE50, 0xE59},   {0xED0, 0xED9},   {0xF20, 0xF33},   {0x1040, 0x1049}, {0x17E0, 0x17E9},
+    {0x2070, 0x2070}, {0x2074, 0x2079}, {0x2080, 0x2089}, {0x2150, 0x2182}, {0x2185, 0x2189},
+    {0x2460, 0x249B}, {0x24EA, 0x24FF}, {0x2776, 0x2793}, {0x3007, 0x3007}, {0x3021, 0x3029},
+    {0x3038, 0x303A}, {0x3192, 0x3195}, {0x3220, 0x3229}, {0x3248, 0x324F}, {0x3251, 0x325F},
+    {0x3280, 0x3289}, {0x32B1, 0x32BF}, {0xFF10, 0xFF19}, {0x1D7CE, 0x1D7FF}};
+
+constexpr Range kMarks[] = {
+    {0x300, 0x36F},     {0x483, 0x489},   {0x591, 0x5BD},   {0x5BF, 0x5BF},   {0x5C1, 0x5C2},
+    {0x5C4, 0x5C5},     {0x5C7, 0x5C7},   {0x610, 0x61A},   {0x64B, 0x65F},   {0x670, 0x670},
+    {0x6D6, 0x6DC},     {0x6DF, 0x6E4},   {0x6E7, 0x6E8},   {0x6EA, 0x6ED},   {0x900, 0x903},
+    {0x93A, 0x93C},     {0x93E, 0x94F},   {0x951, 0x957},   {0x962, 0x963},   {0x981, 0x983},
+    {0x9BC, 0x9BC},     {0x9BE, 0x9CD},   {0xE31, 0xE31},   {0xE34, 0xE3A},   {0xE47, 0xE4E},
+    {0x1AB0, 0x1AFF},   {0x1DC0, 0x1DFF}, {0x20D0, 0x20F0}, {0x302A, 0x302F}, {0x3099, 0x309A},
+    {0xFE00, 0xFE0F},   {0xFE20, 0xFE2F}, {0xE0100, 0xE01EF}};
+
+constexpr Range kOthers[] = {
+    {0xA1, 0xA9},       {0xAB, 0xB4},       {0xB6, 0xB9},       {0xBB, 0xBF},
+    {0xD7, 0xD7},       {0xF7, 0xF7},       {0x2C2, 0x2C5},     {0x2D2, 0x2DF},
+    {0x37E, 0x37E},     {0x384, 0x385},     {0x387, 0x387},     {0x55A, 0x55F},
+    {0x589, 0x58A},     {0x5BE, 0x5BE},     {0x5C0, 0x5C0},     {0x5C3, 0x5C3},
+    {0x5C6, 0x5C6},     {0x5F3, 0x5F4},     {0x600, 0x60F},     {0x61B, 0x61F},
+    {0x66A, 0x66D},     {0x6D4, 0x6D4},     {0x964, 0x965},     {0x970, 0x970},
+    {0xE3F, 0xE3F},     {0xE4F, 0xE4F},     {0xE5A, 0xE5B},     {0x2010, 0x2027},
+    {0x2030, 0x205E},   {0x2060, 0x206F},   {0x200B, 0x200F},   {0x207A, 0x207E},
+    {0x208A, 0x208E},   {0x20A0, 0x20CF},   {0x2100, 0x214F},   {0x2190, 0x245F},
+    {0x249C, 0x24E9},   {0x2500, 0x2775},   {0x2794, 0x2BFF},   {0x2E00, 0x2E7F},
+    {0x3001, 0x3004},   {0x3008, 0x3020},   {0x3030, 0x3030},   {0x303D, 0x303F},
+    {0x309B, 0x309C},   {0x30A0, 0x30A0},   {0x30FB, 0x30FB},   {0xE000, 0xF8FF},
+    {0xFD3E, 0xFD3F},   {0xFE10, 0xFE19},   {0xFE30, 0xFE6F},   {0xFEFF, 0xFEFF},
+    {0xFF01, 0xFF0F},   {0xFF1A, 0xFF20},   {0xFF3B, 0xFF40},   {0xFF5B, 0xFF65},
+    {0xFFE0, 0xFFEE},   {0xFFF9, 0xFFFD},   {0x1F000, 0x1FAFF}, {0xF0000, 0x10FFFF}};
+
+template <size_t N>
+bool inRanges(const Range (&ranges)[N], uint32_t cp) {
+    for (const auto& range : ranges) {
+        if (cp >= range.first && cp <= range.last) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Case of letters in blocks that alternate upper/lower code points
+CharClass evenUpper(uint32_t cp) { return cp % 2 == 0 ? Upper : Lower; }
+CharClass oddUpper(uint32_t cp) { return cp % 2 == 1 ? Upper : Lower; }
+
+CharClass letterCase(uint32_t cp) {
+    if (cp < 0xC0) {
+        return cp == 0xB5 ? Lower : LetterOther;  // µ, and the ordinals ª º
+    }
+    if (cp < 0x100) {
+        return cp <= 0xDE ? Upper : Lower;  // Latin-1; 0xD7 and 0xF7 are symbols
+    }
+    if (cp < 0x180) {
+        if (cp == 0x138 || cp == 0x149 || cp == 0x17F) return Lower;
+        if (cp == 0x178) return Upper;
+        if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E)) return oddUpper(cp);
+        return evenUpper(cp);
+    }
+    if (cp < 0x250) return cp >= 0x1CD && cp <= 0x1DC ? oddUpper(cp) : evenUpper(cp);
+    if (cp < 0x2B0) return Lower;  // IPA
+    if (cp < 0x370) return LetterOther;
+    if (cp < 0x400) {
+        if (cp == 0x386 || (cp >= 0x388 && cp <= 0x3AB) || cp == 0x3CF) return Upper;
+        return cp >= 0x3AC ? Lower : LetterOther;
+    }
+    if (cp < 0x530) {
+        if (cp < 0x430) return Upper;
+        if (cp < 0x460) return Lower;
+        if (cp == 0x4C0) return Upper;
+        if (cp == 0x4CF) return Lower;
+        if (cp >= 0x4C1 && cp <= 0x4CE) return oddUpper(cp);
+        return evenUpper(cp);
+    }
+    if (cp >= 0x531 && cp <= 0x556) return Upper;  // Armenian
+    if (cp >= 0x561 && cp <= 0x587) return Lower;
+    if (cp >= 0x10A0 && cp <= 0x10C5) return Upper;  // Georgian
+    if (cp >= 0x1E00 && cp <= 0x1EFF) {
+        if (cp >= 0x1E96 && cp <= 0x1E9D) return Lower;
+        return cp == 0x1E9E ? Upper : evenUpper(cp);
+    }
+    if (cp >= 0x1F00 && cp <= 0x1FFF) return Lower;  // Greek extended, mostly lowercase
+    if (cp >= 0xFF21 && cp <= 0xFF3A) return Upper;  // Fullwidth Latin
+    if (cp >= 0xFF41 && cp <= 0xFF5A) return Lower;
+    return LetterOther;
+}
+
+CharClass classifyCodePoint(uint32_t cp) {
+    if (inRanges(kSpaces, cp)) return Space;
+    if (inRanges(kNumbers, cp)) return Number;
+    if (inRanges(kMarks, cp)) return Mark;
+    if (inRanges(kOthers, cp)) return Other;
+    return letterCase(cp);
+}
+
+struct AsciiClasses {
+    CharClass table[128];
+
+    constexpr AsciiClasses() : table() {
+        for (int c = 0; c < 128; ++c) {
+            if (c >= 'A' && c <= 'Z') {
+                table[c] = Upper;
+            } else if (c >= 'a' && c <= 'z') {
+                table[c] = Lower;
+            } else if (c >= '0' && c <= '9') {
+                table[c] = Number;
+            } else if (c == '\r' || c == '\n') {
+                table[c] = Newline;
+            } else if (c == ' ' || c == '\t' || c == '\v' || c == '\f') {
+                table[c] = Space;
+            } else {
+                table[c] = Other;
+            }
+        }
+    }
+};
+
+constexpr AsciiClasses kAscii;
+
+struct Char {
+    CharClass cls;
+    uint32_t length;
+};
+
+// Class and byte length of the character at `pos`; invalid UTF-8 is one Other byte
+inline Char charAt(std::string_view text, size_t pos) {
+    const auto b0 = static_cast<unsigned char>(text[pos]);
+    if (b0 < 0x80) {
+        return {kAscii.table[b0], 1};
+    }
+    uint32_t length = b0 >= 0xF0 ? 4 : b0 >= 0xE0 ? 3 : b0 >= 0xC0 ? 2 : 0;
+    if (length == 0 || b0 > 0xF4 || pos + length > text.size()) {
+        return {Other, 1};
+    }
+    uint32_t cp = b0 & (0x7F >> length);
+    for (uint32_t i = 1; i < length; ++i) {
+        const auto b = static_cast<unsigned char>(text[pos + i]);
+        if ((b & 0xC0) != 0x80) {
+            return {Other, 1};
+        }
+        cp = (cp << 6) | (b & 0x3F);
+    }
+    return {classifyCodePoint(cp), length};
+}
+
+inline bool isLetter(CharClass c) { return c <= LetterOther; }
+inline bool isSpace(CharClass c) { return c == Space || c == Newline; }
+// [^\s\p{L}\p{N}]
+inline bool isPunct(CharClass c) { return c == Mark || c == Other; }
+// [^\r\n\p{L}\p{N}]
+inline bool isWordPrefix(CharClass c) { return c == Mark || c == Other || c == Space; }
+// o200k_base: [\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}] and [\p{Ll}\p{Lm}\p{Lo}\p{M}]
+inline bool isUpperWord(CharClass c) { return c == Upper || c == LetterOther || c == Mark; }
+inline bool isLowerWord(CharClass c) { return c == Lower || c == LetterOther || c == Mark; }
+
+constexpr size_t npos = std::string_view::npos;
+
+class Splitter {
+   public:
+    explicit Splitter(std::string_view text) : text_(text) {}
+
+    // End of the cl100k_base piece starting at `pos`
+    size_t nextCl100k(size_t pos) const {
+        // (?i:'s|'t|'re|'ve|'m|'ll|'d)
+        if (size_t n = contraction(pos)) {
+            return pos + n;
+        }
+        const Char c = charAt(text_, pos);
+        // [^\r\n\p{L}\p{N}]?\p{L}+
+        if (isLetter(c.cls)) {
+            return skip(pos, isLetter);
+        }
+        if (isWordPrefix(c.cls) && pos + c.length < text_.size() &&
+            isLetter(charAt(text_, pos + c.length).cls)) {
+            return skip(pos + c.length, isLetter);
+        }
+        // \p{N}{1,3}
+        if (c.cls == Number) {
+            return numbers(pos);
+        }
+        // ' ?[^\s\p{L}\p{N}]+[\r\n]*'
+        if (size_t end = punctuation(pos, c, false); end != npos) {
+            return end;
+        }
+        return whitespace(pos);
+    }
+
+    // End of the o200k_base piece starting at `pos`
+    size_t nextO200k(size_t pos) const {
+        const Char c = charAt(text_, pos);
+        // [^\r\n\p{L}\p{N}]?[upper]*[lower]+(contraction)?, then [^\r\n\p{L}\p{N}]?[upper]+[lower]*(...)?
+        for (bool upperFirst : {false, true}) {
+            if (isWordPrefix(c.cls) && pos + c.length < text_.size()) {
+                if (size_t end = word(pos + c.length, upperFirst); end != npos) {
+                    return end + contraction(end);
+                }
+            }
+            if (size_t end = word(pos, upperFirst); end != npos) {
+                return end + contraction(end);
+            }
+        }
+        if (c.cls == Number) {
+            return numbers(pos);
+        }
+        // ' ?[^\s\p{L}\p{N}]+[\r\n/]*'
+        if (size_t end = punctuation(pos, c, true); end != npos) {
+            return end;
+        }
+        return whitespace(pos);
+    }
+
+   private:
+    size_t contraction(size_t pos) const {
+        if (pos + 1 >= text_.size() || text_[pos] != '\'') {
+            return 0;
+        }
+        auto lower = [this](size_t i) {
+            return i < text_.size() ? static_cast<char>(text_[i] | 0x20) : '\0';
+        };
+        const char a = lower(pos + 1);
+        if (a == 's' || a == 't' || a == 'm' || a == 'd') {
+            return 2;
+        }
+        const char b = lower(pos + 2);
+        if ((a == 'r' && b == 'e') || (a == 'v' && b == 'e') || (a == 'l' && b == 'l')) {
+            return 3;
+        }
+        return 0;
+    }
+
+    template <typename Pred>
+    size_t skip(size_t pos, Pred pred) const {
+        while (pos < text_.size()) {
+            const Char c = charAt(text_, pos);
+            if (!pred(c.cls)) {
+                break;
+            }
+            pos += c.length;
+        }
+        return pos;
+    }
+
+    size_t numbers(size_t pos) const {
+        for (int i = 0; i < 3 && pos < text_.size(); ++i) {
+            const Char c = charAt(text_, pos);
+            if (c.cls != Number) {
+                break;
+            }
+            pos += c.length;
+        }
+        return pos;
+    }
+
+    size_t punctuation(size_t pos, Char c, bool slash) const {
+        size_t start = pos;
+        if (!isPunct(c.cls)) {
+            if (text_[pos] != ' ' || pos + 1 >= text_.size() ||
+                !isPunct(charAt(text_, pos + 1).cls)) {
+                return npos;
+            }
+            start = pos + 1;
+        }
+        size_t end = skip(start, isPunct);
+        while (end < text_.size() &&
+               (text_[end] == '\r' || text_[end] == '\n' || (slash && text_[end] == '/'))) {
+            ++end;
+        }
+        return end;
+    }
+
+    // [upper]*[lower]+ when !upperFirst, [upper]+[lower]* otherwise
+    size_t word(size_t pos, bool upperFirst) const {
+        size_t end = pos;
+        size_t lastShared = npos;  // End of the last char in both classes
+        while (end < text_.size()) {
+            const Char c = charAt(text_, end);
+            if (!isUpperWord(c.cls)) {
+                break;
+            }
+            end += c.length;
+            if (c.cls != Upper) {
+                lastShared = end;
+            }
+        }
+        if (upperFirst) {
+            return end == pos ? npos : skip(end, isLowerWord);
+        }
+        if (end < text_.size() && charAt(text_, end).cls == Lower) {
+            return skip(end, isLowerWord);
+        }
+        // [upper]* gives back characters until one of them can start [lower]+
+        return lastShared;
+    }
+
+    // \s*[\r\n]+ | \s+(?!\S) | \s+
+    size_t whitespace(size_t pos) const {
+        size_t end = pos;
+        size_t lastStart = pos;
+        size_t afterNewline = npos;
+        while (end < text_.size()) {
+            const Char c = charAt(text_, end);
+            if (!isSpace(c.cls)) {
+                break;
+            }
+            lastStart = end;
+            end += c.length;
+            if (c.cls == Newline) {
+                afterNewline = end;
+            }
+        }
+        if (end == pos) {
+            return pos + charAt(text_, pos).length;  // Unreachable for well-formed classes
+        }
+        if (afterNewline != npos) {
+            return afterNewline;
+        }
+        if (end == text_.size() || lastStart == pos) {
+            return end;
+        }
+        return lastStart;  // Leave one space to prefix the next word
+    }
+
+    std::string_view text_;
+};
+
+template <typename OnPiece>
+void split(BpeTokenizer::Encoding encoding, std::string_view text, OnPiece&& onPiece) {
+    Splitter splitter(text);
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = encoding == BpeTokenizer::Encoding::O200kBase ? splitter.nextO200k(pos)
+                                                                   : splitter.nextCl100k(pos);
+        onPiece(text.substr(pos, end - pos));
+        pos = end;
+    }
+}
+
+// ---- Vocabulary loading ---------------------------------------------------------------
+
+int base64Value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+bool decodeBase64(std::string_view in, std::string& out) {
+    out.clear();
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : in) {
+        if (c == '=') {
+            break;
+        }
+        int value = base64Value(c);
+        if (value < 0) {
+            return false;
+        }
+        buffer = (buffer << 6) | static_cast<uint32_t>(value);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<char>((buffer >> bits) & 0xFF));
+        }
+    }
+    return !out.empty();
+}
+
+// ---- Merge scratch --------------------------------------------------------------------
+
+struct MergeCandidate {
+    BpeRanks::Rank rank;
+    uint32_t left;
+    uint32_t right;
+    uint32_t end;
+
+    // Min-heap on rank; equal ranks merge leftmost first, as tiktoken does
+    bool operator<(const MergeCandidate& other) const {
+        return rank != other.rank ? rank > other.rank : left > other.left;
+    }
+};
+
+struct MergeScratch {
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> prev;
+    std::vector<BpeRanks::Rank> rank;  // Rank of the part starting here
+    std::vector<MergeCandidate> heap;
+};
+
+}  // namespace
+
+// ---- BpeRanks -------------------------------------------------------------------------
+
+void BpeRanks::reserve(size_t count) {
+    size_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    if (capacity <= slots_.size()) {
+        return;
+    }
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(capacity, Slot{});
+    for (const Slot& slot : old) {
+        if (slot.rank != npos) {
+            std::string_view bytes(arena_.data() + slot.offset, slot.length);
+            slots_[probe(bytes, slot.hash)] = slot;
+        }
+    }
+}
+
+void BpeRanks::grow() { reserve(std::max<size_t>(size_ + 1, slots_.size())); }
+
+size_t BpeRanks::probe(std::string_view bytes, uint64_t hash) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots_[i];
+        if (slot.rank == npos) {
+            return i;
+        }
+        if (slot.hash == hash && slot.length == bytes.size() &&
+            std::memcmp(arena_.data() + slot.offset, bytes.data(), bytes.size()) == 0) {
+            return i;
+        }
+    }
+}
+
+void BpeRanks::insert(std::string_view bytes, Rank rank) {
+    if ((size_ + 1) * 2 > slots_.size()) {
+        grow();
+    }
+    const uint64_t hash = hashBytes(bytes);
+    size_t i = probe(bytes, hash);
+    if (slots_[i].rank == npos) {
+        slots_[i] = {hash, static_cast<uint32_t>(arena_.size()),
+                     static_cast<uint32_t>(bytes.size()), rank};
+        arena_.append(bytes);
+        ++size_;
+    } else {
+        slots_[i].rank = rank;
+    }
+}
+
+BpeRanks::Rank BpeRanks::find(std::string_view bytes) const {
+    if (slots_.empty()) {
+        return npos;
+    }
+    return slots_[probe(bytes, hashBytes(bytes))].rank;
+}
+
+// ---- BpeTokenizer ---------------------------------------------------------------------
+
+BpeTokenizer::BpeTokenizer(Encoding encoding, BpeRanks ranks)
+    : encoding_(encoding), ranks_(std::move(ranks)) {
+    pairRanks_.resize(256 * 256);
+    for (int first = 0; first < 256; ++first) {
+        char bytes[2] = {static_cast<char>(first), 0};
+        byteRanks_[first] = ranks_.find(std::string_view(bytes, 1));
+        for (int second = 0; second < 256; ++second) {
+            bytes[1] = static_cast<char>(second);
+            pairRanks_[first * 256 + second] = ranks_.find(std::string_view(bytes, 2));
+        }
+    }
+}
+
+BpeTokenizer BpeTokenizer::fromTiktokenFile(const std::string& path, Encoding encoding) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("BpeTokenizer: cannot open vocabulary file " + path);
+    }
+    return fromTiktoken(in, encoding);
+}
+
+BpeTokenizer BpeTokenizer::fromTiktoken(std::istream& in, Encoding encoding) {
+    BpeRanks ranks;
+    ranks.reserve(encoding == Encoding::O200kBase ? 200000 : 100000);
+    std::string line;
+    std::string bytes;
+    size_t lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            continue;
+        }
+        const size_t space = line.find(' ');
+        Rank rank = 0;
+        bool valid = space != std::string::npos && space + 1 < line.size() &&
+                     decodeBase64(std::string_view(line).substr(0, space), bytes);
+        for (size_t i = space + 1; valid && i < line.size(); ++i) {
+            valid = line[i] >= '0' && line[i] <= '9';
+            rank = rank * 10 + static_cast<Rank>(line[i] - '0');
+        }
+        if (!valid) {
+            throw std::runtime_error("BpeTokenizer: malformed vocabulary line " +
+                                     std::to_string(lineNumber));
+        }
+        ranks.insert(bytes, rank);
+    }
+    if (ranks.size() == 0) {
+        throw std::runtime_error("BpeTokenizer: empty vocabulary");
+    }
+    return BpeTokenizer(encoding, std::move(ranks));
+}
+
+BpeTokenizer::Encoding BpeTokenizer::encodingForModel(std::string_view model) {
+    for (std::string_view prefix : {"gpt-4o", "gpt-4.1", "gpt-4.5", "gpt-5", "chatgpt-4o",
+                                    "gpt-oss", "o1", "o3", "o4"}) {
+        if (model.substr(0, prefix.size()) == prefix) {
+            return Encoding::O200kBase;
+        }
+    }
+    return Encoding::Cl100kBase;
+}
+
+const char* BpeTokenizer::encodingName(Encoding encoding) {
+    return encoding == Encoding::O200kBase ? "o200k_base" : "cl100k_base";
+}
+
+std::vector<std::string_view> BpeTokenizer::pretokenize(std::string_view text) const {
+    std::vector<std::string_view> pieces;
+    split(encoding_, text, [&](std::string_view piece) { pieces.push_back(piece); });
+    return pieces;
+}
+
+template <typename Emit>
+void BpeTokenizer::bytePairMerge(std::string_view piece, Emit&& emit) const {
+    const Rank whole = ranks_.find(piece);
+    const auto n = static_cast<uint32_t>(piece.size());
+    if (whole != BpeRanks::npos || n == 1) {
+        emit(whole);  // A byte missing from the vocabulary still counts as one token
+        return;
+    }
+
+    // Part i spans [i, next[i]); a part merged into its left neighbour gets next = 0
+    thread_local MergeScratch scratch;
+    auto& next = scratch.next;
+    auto& prev = scratch.prev;
+    auto& partRank = scratch.rank;
+    auto& heap = scratch.heap;
+    next.resize(n);
+    prev.resize(n);
+    partRank.resize(n);
+    heap.clear();
+    auto rankOf = [&](uint32_t begin, uint32_t end) {
+        return ranks_.find(piece.substr(begin, end - begin));
+    };
+    auto push = [&](uint32_t left, uint32_t right, uint32_t end) {
+        Rank rank = rankOf(left, end);
+        if (rank != BpeRanks::npos) {
+            heap.push_back({rank, left, right, end});
+            std::push_heap(heap.begin(), heap.end());
+        }
+    };
+
+    for (uint32_t i = 0; i < n; ++i) {
+        next[i] = i + 1;
+        prev[i] = i - 1;
+        partRank[i] = byteRanks_[static_cast<unsigned char>(piece[i])];
+    }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(piece.data());
+    for (uint32_t i = 0; i + 1 < n; ++i) {
+        Rank rank = pairRanks_[bytes[i] * 256 + bytes[i + 1]];
+        if (rank != BpeRanks::npos) {
+            heap.push_back({rank, i, i + 1, i + 2});
+        }
+    }
+    std::make_heap(heap.begin(), heap.end());
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end());
+        const MergeCandidate top = heap.back();
+        heap.pop_back();
+        // Stale once either side has merged with something else
+        if (next[top.left] != top.right || next[top.right] != top.end) {
+            continue;
+        }
+        next[top.left] = top.end;
+        next[top.right] = 0;
+        partRank[top.left] = top.rank;
+        if (top.end < n) {
+            prev[top.end] = top.left;
+            push(top.left, top.end, next[top.end]);
+        }
+        if (top.left > 0) {
+            push(prev[top.left], top.left, top.end);
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i = next[i]) {
+        emit(partRank[i]);
+    }
+}
+
+std::vector<BpeTokenizer::Rank> BpeTokenizer::encode(std::string_view text) const {
+    std::vector<Rank> tokens;
+    tokens.reserve(text.size() / 3);
+    split(encoding_, text, [&](std::string_view piece) {
+        bytePairMerge(piece, [&](Rank rank) { tokens.push_back(rank); });
+    });
+    return tokens;
+}
+
+size_t BpeTokenizer::countTokens(std::string_view text) const {
+    size_t count = 0;
+    split(encoding_, text,
+          [&](std::string_view piece) { bytePairMerge(piece, [&](Rank) { ++count; }); });
+    return count;
+}
+
+size_t BpeTokenizer::countTokens(const LLMRequest& request) const {
+    TextTokenCounter countText = [this](std::string_view text) { return countTokens(text); };
+    size_t total = countFixedRequestTokens(request, countText);
+    for (const auto& entry : request.context) {
+        total += countMessageTokens(entry, countText);
+    }
+    return total;
+}
+
+size_t countMessageTokens(const nlohmann::json& entry, const TextTokenCounter& countText) {
+    auto message = [&](std::string_view role, std::string_view content) {
+        return BpeTokenizer::kTokensPerMessage + countText(role) + countText(content);
+    };
+    if (entry.is_string()) {
+        return message("user", entry.get_ref<const std::string&>());
+    }
+    auto content = entry.is_object() ? entry.find("content") : entry.end();
+    if (content == entry.end()) {
+        return message("user", entry.dump());
+    }
+    const auto role = entry.value("role", std::string("user"));
+    if (content->is_string()) {
+        return message(role, content->get_ref<const std::string&>());
+    }
+    if (!content->is_array()) {
+        return message(role, content->dump());
+    }
+    // Text parts count as text; other parts (images, files) by their JSON
+    size_t total = message(role, "");
+    for (const auto& part : *content) {
+        auto text = part.is_object() ? part.find("text") : part.end();
+        total += text != part.end() && text->is_string()
+                     ? countText(text->get_ref<const std::string&>())
+                     : countText(part.dump());
+    }
+    return total;
+}
+
+size_t countFixedRequestTokens(const LLMRequest& request, const TextTokenCounter& countText) {
+    size_t total = BpeTokenizer::kReplyPrimingTokens;
+    if (!request.prompt.empty()) {
+        total += BpeTokenizer::kTokensPerMessage + countText("system") + countText(request.prompt);
+    }
+    const auto& config = request.config;
+    if (config.internedSchema) {
+        total += countText(config.internedSchema->canonical());
+    } else if (config.schemaObject.has_value()) {
+        total += countText(config.schemaObject->dump());
+    } else if (!config.jsonSchema.empty()) {
+        total += countText(config.jsonSchema);
+    }
+    auto tools = config.extensions.find("tools");
+    if (tools != config.extensions.end() && !tools->empty()) {
+        total += countText(tools->dump());
+    }
+    return total;
+}
+
+}  // namespace llmcpp
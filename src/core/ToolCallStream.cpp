@@ -0,0 +1,100 @@
+#include "core/ToolCallStream.h"
+
+#include <stdexcept>
+
+#include "core/Logger.h"
+
+namespace llmcpp {
+
+ToolCallAssembler::ToolCallAssembler(CallCallback onCall) : onCall_(std::move(onCall)) {
+    if (!onCall_) {
+        throw std::invalid_argument("ToolCallAssembler: call callback is required");
+    }
+}
+
+void ToolCallAssembler::begin(size_t index, std::string id, std::string name) {
+    open_[index] = Pending{std::move(id), std::move(name), {}};
+}
+
+void ToolCallAssembler::append(size_t index, std::string_view delta) {
+    auto it = open_.find(index);
+    if (it != open_.end()) {
+        it->second.arguments.append(delta);
+    }
+}
+
+bool ToolCallAssembler::finish(size_t index, std::optional<std::string_view> arguments) {
+    auto it = open_.find(index);
+    if (it == open_.end()) {
+        return false;
+    }
+    Pending pending = std::move(it->second);
+    open_.erase(it);
+    if (arguments) {
+        pending.arguments.assign(*arguments);
+    }
+
+    nlohmann::json parsed = nlohmann::json::object();
+    if (!pending.arguments.empty()) {
+        parsed = nlohmann::json::parse(pending.arguments, nullptr, /*allow_exceptions=*/false);
+        if (parsed.is_discarded()) {
+            parsed = std::move(pending.arguments);
+        }
+    }
+    ++emitted_;
+    onCall_(ToolCall{std::move(pending.id), std::move(pending.name), std::move(parsed)});
+    return true;
+}
+
+StreamingToolDispatcher::StreamingToolDispatcher(const ToolRunner& runner,
+                                                 EventHandler applyEvent)
+    : runner_(runner),
+      applyEvent_(std::move(applyEvent)),
+      assembler_([this](ToolCall call) {
+          LLMCPP_LOG_DEBUG("tool_stream", "Dispatching streamed tool call",
+                           {{"id", call.id}, {"name", call.name}});
+          auto future = runner_.dispatch(call);
+          std::lock_guard<std::mutex> lock(mutex_);
+          pending_.push_back(std::move(future));
+      }),
+      sse_([this](const SseParser::Event& event) {
+          auto data = nlohmann::json::parse(event.data, nullptr, /*allow_exceptions=*/false);
+          if (!data.is_discarded()) {
+              onEvent(data);  // Non-JSON frames such as "[DONE]" are skipped
+          }
+      }) {
+    if (!applyEvent_) {
+        throw std::invalid_argument("StreamingToolDispatcher: event handler is required");
+    }
+}
+
+void StreamingToolDispatcher::onEvent(const nlohmann::json& event) {
+    applyEvent_(assembler_, event);
+}
+
+LLMStreamCallback StreamingToolDispatcher::streamCallback() {
+    return [this](const std::string& chunk) { sse_.feed(chunk); };
+}
+
+size_t StreamingToolDispatcher::dispatched() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_.size() + pending_.size();
+}
+
+std::vector<ToolCallResult> StreamingToolDispatcher::results() {
+    sse_.finish();
+    std::vector<std::future<ToolCallResult>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending.swap(pending_);
+    }
+    for (auto& future : pending) {
+        auto result = future.get();
+        std::lock_guard<std::mutex> lock(mutex_);
+        finished_.push_back(std::move(result));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_;
+}
+
+}  // namespace llmcpp
@@ -0,0 +1,239 @@
+#include "core/ToolRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "core/Logger.h"
+#include "core/Tracing.h"
+
+namespace llmcpp {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// A call that passed validation, waiting for a worker
+struct Job {
+    size_t slot;  // Index into the batch results
+    std::shared_ptr<const ToolRunner::Handler> handler;
+    nlohmann::json arguments;
+};
+
+// State shared with the workers; outlives execute() when calls overrun the deadline
+struct Batch {
+    std::vector<Job> jobs;
+    std::atomic<size_t> next{0};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<ToolCallResult> results;
+    std::vector<bool> finished;
+    size_t remaining = 0;
+};
+
+void runJob(const Job& job, ToolCallResult& result) {
+    const auto started = Clock::now();
+    try {
+        result.output = (*job.handler)(job.arguments);
+    } catch (const std::exception& e) {
+        result.output = e.what();
+        result.isError = true;
+    } catch (...) {
+        result.output = "Tool threw a non-standard exception";
+        result.isError = true;
+    }
+    result.durationMs =
+        std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+}
+
+void work(const std::shared_ptr<Batch>& batch) {
+    for (size_t i = batch->next++; i < batch->jobs.size(); i = batch->next++) {
+        const Job& job = batch->jobs[i];
+        ToolCallResult result;
+        runJob(job, result);
+
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        auto& slot = batch->results[job.slot];
+        slot.output = std::move(result.output);
+        slot.isError = result.isError;
+        slot.durationMs = result.durationMs;
+        batch->finished[job.slot] = true;
+        if (--batch->remaining == 0) {
+            batch->done.notify_all();
+        }
+    }
+}
+
+}  // namespace
+
+ToolRunner& ToolRunner::addTool(ToolDefinition definition, Handler handler) {
+    if (!handler) {
+        throw std::invalid_argument("ToolRunner: handler for '" + definition.name + "' is empty");
+    }
+    if (byName_.count(definition.name) != 0) {
+        throw std::invalid_argument("ToolRunner: tool '" + definition.name +
+                                    "' is already registered");
+    }
+    byName_.emplace(definition.name, tools_.size());
+    tools_.push_back(
+        Tool{std::move(definition), std::make_shared<const Handler>(std::move(handler))});
+    return *this;
+}
+
+std::vector<ToolDefinition> ToolRunner::definitions() const {
+    std::vector<ToolDefinition> definitions;
+    definitions.reserve(tools_.size());
+    for (const auto& tool : tools_) {
+        definitions.push_back(tool.definition);
+    }
+    return definitions;
+}
+
+bool ToolRunner::hasTool(std::string_view name) const {
+    return byName_.count(std::string(name)) != 0;
+}
+
+std::vector<ToolCallResult> ToolRunner::execute(const std::vector<ToolCall>& calls,
+                                                std::optional<Clock::time_point> deadline) const {
+    auto batch = std::make_shared<Batch>();
+    batch->results.resize(calls.size());
+    batch->finished.assign(calls.size(), true);
+
+    for (size_t i = 0; i < calls.size(); ++i) {
+        if (auto handler = resolve(calls[i], batch->results[i])) {
+            batch->jobs.push_back(Job{i, std::move(handler), calls[i].arguments});
+            batch->finished[i] = false;
+        }
+    }
+    batch->remaining = batch->jobs.size();
+
+    // A lone call without a deadline gains nothing from a worker thread
+    if (batch->jobs.size() == 1 && !deadline) {
+        work(batch);
+        return std::move(batch->results);
+    }
+
+    const size_t workers =
+        std::min(batch->jobs.size(), std::max<size_t>(1, options_.maxParallel));
+    for (size_t i = 0; i < workers; ++i) {
+        std::thread([batch]() { work(batch); }).detach();
+    }
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    auto allDone = [&batch]() { return batch->remaining == 0; };
+    if (deadline) {
+        batch->done.wait_until(lock, *deadline, allDone);
+    } else {
+        batch->done.wait(lock, allDone);
+    }
+
+    std::vector<ToolCallResult> results = batch->results;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!batch->finished[i]) {
+            results[i].output = "Tool call timed out";
+            results[i].isError = true;
+        }
+    }
+    return results;
+}
+
+std::future<ToolCallResult> ToolRunner::dispatch(const ToolCall& call) const {
+    ToolCallResult result;
+    auto handler = resolve(call, result);
+    if (!handler) {
+        std::promise<ToolCallResult> rejected;
+        rejected.set_value(std::move(result));
+        return rejected.get_future();
+    }
+    return std::async(std::launch::async,
+                      [job = Job{0, std::move(handler), call.arguments},
+                       result = std::move(result)]() mutable {
+                          runJob(job, result);
+                          return std::move(result);
+                      });
+}
+
+std::shared_ptr<const ToolRunner::Handler> ToolRunner::resolve(const ToolCall& call,
+                                                               ToolCallResult& result) const {
+    result.id = call.id;
+    result.name = call.name;
+    auto it = byName_.find(call.name);
+    if (it == byName_.end()) {
+        result.output = "Unknown tool: " + call.name;
+        result.isError = true;
+        return nullptr;
+    }
+    if (!call.arguments.is_object()) {
+        result.output = "Arguments for " + call.name + " must be a JSON object";
+        result.isError = true;
+        return nullptr;
+    }
+    return tools_[it->second].handler;
+}
+
+ToolRunner::Result ToolRunner::run(ToolSession& session) const {
+    std::optional<Clock::time_point> deadline;
+    if (options_.timeout.count() > 0) {
+        deadline = Clock::now() + options_.timeout;
+    }
+    auto pastDeadline = [&deadline]() { return deadline && Clock::now() >= *deadline; };
+
+    Result result;
+    try {
+        ToolTurn turn = session.start(definitions());
+        for (;;) {
+            ++result.steps;
+            result.usage.inputTokens += turn.usage.inputTokens;
+            result.usage.outputTokens += turn.usage.outputTokens;
+            result.usage.cachedInputTokens += turn.usage.cachedInputTokens;
+            result.usage.cacheCreationInputTokens += turn.usage.cacheCreationInputTokens;
+            result.responseId = turn.responseId;
+            result.text = turn.text;
+
+            if (turn.calls.empty()) {
+                result.success = true;
+                return result;
+            }
+            if (result.steps >= options_.maxSteps) {
+                result.errorMessage =
+                    "Tool loop stopped after " + std::to_string(result.steps) + " steps";
+                return result;
+            }
+            if (pastDeadline()) {
+                result.errorMessage = "Tool loop deadline exceeded";
+                return result;
+            }
+
+            Span span("llm.tools.execute");
+            span.setAttribute("llm.tool.count", turn.calls.size());
+            auto results = execute(turn.calls, deadline);
+            const auto failed = std::count_if(results.begin(), results.end(),
+                                              [](const ToolCallResult& r) { return r.isError; });
+            span.setAttribute("llm.tool.failed", failed);
+            span.end();
+            LLMCPP_LOG_DEBUG("tool_runner", "Executed tool calls",
+                             {{"step", result.steps},
+                              {"calls", results.size()},
+                              {"failed", failed}});
+
+            result.toolResults.insert(result.toolResults.end(), results.begin(), results.end());
+            if (pastDeadline()) {
+                result.errorMessage = "Tool loop deadline exceeded";
+                return result;
+            }
+            turn = session.submit(results);
+        }
+    } catch (const std::exception& e) {
+        LLMCPP_LOG_WARN("tool_runner", "Tool loop failed",
+                        {{"step", result.steps}, {"error", e.what()}});
+        result.success = false;
+        result.errorMessage = e.what();
+    }
+    return result;
+}
+
+}  // namespace llmcpp
@@ -0,0 +1,312 @@
+#include "core/Tracing.h"
+
+#include <atomic>
+#include <random>
+#include <stdexcept>
+
+#include "llmcpp_version.h"
+
+namespace llmcpp {
+
+namespace {
+
+std::shared_ptr<SpanExporter> g_exporter;
+std::mutex g_exporterMutex;
+std::atomic<bool> g_enabled{false};
+
+thread_local Span* t_currentSpan = nullptr;
+
+bool isLowerHex(const std::string& s) {
+    for (char c : s) {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isAllZero(const std::string& s) { return s.find_first_not_of('0') == std::string::npos; }
+
+std::string randomHex(size_t bytes) {
+    static const char* digits = "0123456789abcdef";
+    thread_local std::mt19937_64 rng{std::random_device{}()};
+    std::string out;
+    out.reserve(bytes * 2);
+    uint64_t bits = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        if (i % 8 == 0) {
+            bits = rng();
+        }
+        auto byte = static_cast<unsigned>(bits & 0xff);
+        bits >>= 8;
+        out.push_back(digits[byte >> 4]);
+        out.push_back(digits[byte & 0x0f]);
+    }
+    // All-zero ids are invalid per W3C/OTLP
+    if (isAllZero(out)) {
+        out.back() = '1';
+    }
+    return out;
+}
+
+uint64_t nowUnixNano() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count());
+}
+
+}  // namespace
+
+// TraceContext
+
+bool TraceContext::isValid() const {
+    return traceId.size() == 32 && spanId.size() == 16 && isLowerHex(traceId) &&
+           isLowerHex(spanId) && !isAllZero(traceId) && !isAllZero(spanId);
+}
+
+std::optional<TraceContext> TraceContext::fromTraceparent(const std::string& header) {
+    // version(2) - trace-id(32) - parent-id(16) - flags(2)
+    if (header.size() < 55 || header[2] != '-' || header[35] != '-' || header[52] != '-') {
+        return std::nullopt;
+    }
+    std::string version = header.substr(0, 2);
+    if (!isLowerHex(version) || version == "ff" || (version == "00" && header.size() != 55)) {
+        return std::nullopt;
+    }
+
+    TraceContext ctx;
+    ctx.traceId = header.substr(3, 32);
+    ctx.spanId = header.substr(36, 16);
+    std::string flags = header.substr(53, 2);
+    if (!isLowerHex(flags) || !ctx.isValid()) {
+        return std::nullopt;
+    }
+    ctx.sampled = (std::stoi(flags, nullptr, 16) & 0x01) != 0;
+    return ctx;
+}
+
+std::string TraceContext::toTraceparent() const {
+    return "00-" + traceId + "-" + spanId + (sampled ? "-01" : "-00");
+}
+
+// InMemorySpanExporter
+
+void InMemorySpanExporter::exportSpan(const SpanData& span) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans_.push_back(span);
+}
+
+std::vector<SpanData> InMemorySpanExporter::getSpans() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return spans_;
+}
+
+void InMemorySpanExporter::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spans_.clear();
+}
+
+// OtlpJsonFileExporter
+
+OtlpJsonFileExporter::OtlpJsonFileExporter(const std::string& path, const std::string& serviceName)
+    : out_(path, std::ios::out | std::ios::app), serviceName_(serviceName) {
+    if (!out_) {
+        throw std::runtime_error("Failed to open trace output file: " + path);
+    }
+}
+
+void OtlpJsonFileExporter::exportSpan(const SpanData& span) {
+    auto line = toOtlpJson(span, serviceName_).dump();
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_ << line << '\n';
+}
+
+void OtlpJsonFileExporter::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_.flush();
+}
+
+namespace {
+
+nlohmann::json toOtlpValue(const nlohmann::json& value) {
+    if (value.is_string()) {
+        return {{"stringValue", value.get<std::string>()}};
+    }
+    if (value.is_boolean()) {
+        return {{"boolValue", value.get<bool>()}};
+    }
+    if (value.is_number_integer()) {
+        // OTLP/JSON encodes 64-bit integers as strings
+        return {{"intValue", std::to_string(value.get<int64_t>())}};
+    }
+    if (value.is_number()) {
+        return {{"doubleValue", value.get<double>()}};
+    }
+    return {{"stringValue", value.dump()}};
+}
+
+nlohmann::json toOtlpAttributes(const nlohmann::json& attributes) {
+    auto result = nlohmann::json::array();
+    for (auto it = attributes.begin(); it != attributes.end(); ++it) {
+        result.push_back({{"key", it.key()}, {"value", toOtlpValue(it.value())}});
+    }
+    return result;
+}
+
+}  // namespace
+
+nlohmann::json OtlpJsonFileExporter::toOtlpJson(const SpanData& span,
+                                                const std::string& serviceName) {
+    // Enum values follow opentelemetry-proto trace.proto
+    int kind = span.kind == SpanData::Kind::Client ? 3 : 1;
+    int status = span.status == SpanData::StatusCode::Ok      ? 1
+                 : span.status == SpanData::StatusCode::Error ? 2
+                                                              : 0;
+
+    nlohmann::json otlpSpan = {
+        {"traceId", span.traceId},
+        {"spanId", span.spanId},
+        {"name", span.name},
+        {"kind", kind},
+        {"startTimeUnixNano", std::to_string(span.startTimeUnixNano)},
+        {"endTimeUnixNano", std::to_string(span.endTimeUnixNano)},
+        {"attributes", toOtlpAttributes(span.attributes)},
+        {"status", {{"code", status}}}
+    };
+    if (!span.parentSpanId.empty()) {
+        otlpSpan["parentSpanId"] = span.parentSpanId;
+    }
+    if (!span.statusMessage.empty()) {
+        otlpSpan["status"]["message"] = span.statusMessage;
+    }
+
+    nlohmann::json resource = {
+        {"attributes", toOtlpAttributes({{"service.name", serviceName}})}
+    };
+    nlohmann::json scope = {
+        {"name", "llmcpp"},
+        {"version", LLMCPP_VERSION}
+    };
+
+    return {
+        {"resourceSpans",
+         {{{"resource", resource},
+           {"scopeSpans", {{{"scope", scope}, {"spans", {otlpSpan}}}}}}}}
+    };
+}
+
+// Tracer
+
+void Tracer::setExporter(std::shared_ptr<SpanExporter> exporter) {
+    std::lock_guard<std::mutex> lock(g_exporterMutex);
+    g_exporter = std::move(exporter);
+    g_enabled.store(g_exporter != nullptr, std::memory_order_release);
+}
+
+std::shared_ptr<SpanExporter> Tracer::getExporter() {
+    std::lock_guard<std::mutex> lock(g_exporterMutex);
+    return g_exporter;
+}
+
+bool Tracer::isEnabled() { return g_enabled.load(std::memory_order_acquire); }
+
+// Span
+
+Span::Span(std::string name, SpanData::Kind kind) : Span(std::move(name), std::nullopt, kind) {}
+
+Span::Span(std::string name, const std::optional<TraceContext>& parent, SpanData::Kind kind) {
+    if (!Tracer::isEnabled()) {
+        return;
+    }
+    exporter_ = Tracer::getExporter();
+    if (!exporter_) {
+        return;
+    }
+
+    data_ = std::make_unique<SpanData>();
+    data_->name = std::move(name);
+    data_->kind = kind;
+    data_->spanId = randomHex(8);
+
+    if (parent && parent->isValid()) {
+        data_->traceId = parent->traceId;
+        data_->parentSpanId = parent->spanId;
+        data_->sampled = parent->sampled;
+    } else if (t_currentSpan && t_currentSpan->data_) {
+        data_->traceId = t_currentSpan->data_->traceId;
+        data_->parentSpanId = t_currentSpan->data_->spanId;
+        data_->sampled = t_currentSpan->data_->sampled;
+    } else {
+        data_->traceId = randomHex(16);
+    }
+
+    data_->startTimeUnixNano = nowUnixNano();
+    start_ = std::chrono::steady_clock::now();
+    previous_ = t_currentSpan;
+    t_currentSpan = this;
+}
+
+Span::~Span() { end(); }
+
+TraceContext Span::context() const {
+    if (!data_) {
+        return {};
+    }
+    return TraceContext{data_->traceId, data_->spanId, data_->sampled};
+}
+
+void Span::setAttribute(const std::string& key, const nlohmann::json& value) {
+    if (data_) {
+        data_->attributes[key] = value;
+    }
+}
+
+void Span::setStatus(SpanData::StatusCode code, const std::string& message) {
+    if (data_) {
+        data_->status = code;
+        data_->statusMessage = message;
+    }
+}
+
+void Span::recordError(const std::string& message) {
+    setStatus(SpanData::StatusCode::Error, message);
+}
+
+void Span::end() {
+    if (!data_) {
+        return;
+    }
+    // Wall-clock start plus monotonic duration so clock adjustments can't skew spans
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_);
+    data_->endTimeUnixNano = data_->startTimeUnixNano + static_cast<uint64_t>(elapsed.count());
+
+    // Spans ended out of order are unlinked from the middle of the chain, so no active span
+    // is left pointing at this one
+    if (t_currentSpan == this) {
+        t_currentSpan = previous_;
+    } else {
+        for (Span* span = t_currentSpan; span; span = span->previous_) {
+            if (span->previous_ == this) {
+                span->previous_ = previous_;
+                break;
+            }
+        }
+    }
+    previous_ = nullptr;
+
+    auto data = std::move(data_);
+    auto exporter = std::move(exporter_);
+    if (!data->sampled) {
+        return;
+    }
+    try {
+        exporter->exportSpan(*data);
+    } catch (...) {
+        // Exporters must never break the request path
+    }
+}
+
+Span* Span::current() { return t_currentSpan; }
+
+}  // namespace llmcpp
@@ -0,0 +1,286 @@
+#include "core/TypedSchema.h"
+
+#include <charconv>
+
+namespace llmcpp {
+
+namespace {
+
+// Nesting limit for skipValue, matching the depth a schema-constrained output can reach
+constexpr int kMaxSkipDepth = 512;
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+}  // namespace
+
+void JsonReader::skipWhitespace() {
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            break;
+        }
+        ++pos_;
+    }
+}
+
+bool JsonReader::atEnd() {
+    skipWhitespace();
+    return pos_ >= text_.size();
+}
+
+char JsonReader::peek() {
+    skipWhitespace();
+    return pos_ < text_.size() ? text_[pos_] : '\0';
+}
+
+bool JsonReader::consume(char c) {
+    if (peek() == c) {
+        ++pos_;
+        return true;
+    }
+    return false;
+}
+
+void JsonReader::expect(char c) {
+    if (!consume(c)) {
+        fail(std::string("expected '") + c + "'");
+    }
+}
+
+void JsonReader::fail(const std::string& message) const {
+    throw TypedParseError(message + " at offset " + std::to_string(pos_), pos_);
+}
+
+bool JsonReader::readBool() {
+    skipWhitespace();
+    if (text_.substr(pos_, 4) == "true") {
+        pos_ += 4;
+        return true;
+    }
+    if (text_.substr(pos_, 5) == "false") {
+        pos_ += 5;
+        return false;
+    }
+    fail("expected boolean");
+}
+
+bool JsonReader::readNull() {
+    skipWhitespace();
+    if (text_.substr(pos_, 4) == "null") {
+        pos_ += 4;
+        return true;
+    }
+    return false;
+}
+
+std::string_view JsonReader::numberToken() {
+    skipWhitespace();
+    size_t start = pos_;
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            ++pos_;
+        } else {
+            break;
+        }
+    }
+    if (start == pos_) {
+        fail("expected number");
+    }
+    return text_.substr(start, pos_ - start);
+}
+
+int64_t JsonReader::readInt64() {
+    auto token = numberToken();
+    int64_t value = 0;
+    auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec == std::errc() && end == token.data() + token.size()) {
+        return value;
+    }
+    // Integral values written in float form, e.g. 3.0 or 1e3; the cast is undefined outside
+    // the int64 range, so that is checked first
+    double d = 0.0;
+    auto [dend, dec] = std::from_chars(token.data(), token.data() + token.size(), d);
+    if (dec == std::errc() && dend == token.data() + token.size() && d >= -0x1p63 && d < 0x1p63 &&
+        d == static_cast<double>(static_cast<int64_t>(d))) {
+        return static_cast<int64_t>(d);
+    }
+    fail("expected integer");
+}
+
+uint64_t JsonReader::readUInt64() {
+    auto token = numberToken();
+    uint64_t value = 0;
+    auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec != std::errc() || end != token.data() + token.size()) {
+        fail("expected non-negative integer");
+    }
+    return value;
+}
+
+double JsonReader::readDouble() {
+    auto token = numberToken();
+    double value = 0.0;
+    auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (ec != std::errc() || end != token.data() + token.size()) {
+        fail("expected number");
+    }
+    return value;
+}
+
+void JsonReader::appendEscape(std::string& out) {
+    // pos_ is on the character after the backslash
+    if (pos_ >= text_.size()) {
+        fail("unterminated string");
+    }
+    char c = text_[pos_++];
+    switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+            out += c;
+            return;
+        case 'b':
+            out += '\b';
+            return;
+        case 'f':
+            out += '\f';
+            return;
+        case 'n':
+            out += '\n';
+            return;
+        case 'r':
+            out += '\r';
+            return;
+        case 't':
+            out += '\t';
+            return;
+        case 'u':
+            break;
+        default:
+            fail("invalid escape");
+    }
+
+    auto hex4 = [&]() {
+        if (pos_ + 4 > text_.size()) {
+            fail("truncated \\u escape");
+        }
+        uint32_t v = 0;
+        auto [end, ec] = std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, v, 16);
+        if (ec != std::errc() || end != text_.data() + pos_ + 4) {
+            fail("invalid \\u escape");
+        }
+        pos_ += 4;
+        return v;
+    };
+    uint32_t cp = hex4();
+    if (cp >= 0xD800 && cp <= 0xDBFF && text_.substr(pos_, 2) == "\\u") {
+        pos_ += 2;
+        uint32_t low = hex4();
+        if (low < 0xDC00 || low > 0xDFFF) {
+            fail("invalid surrogate pair");
+        }
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+    }
+    appendUtf8(out, cp);
+}
+
+void JsonReader::readString(std::string& out) {
+    expect('"');
+    out.clear();
+    for (;;) {
+        // Copy the unescaped run in one go
+        size_t run = pos_;
+        while (run < text_.size() && text_[run] != '"' && text_[run] != '\\') {
+            ++run;
+        }
+        out.append(text_.data() + pos_, run - pos_);
+        pos_ = run;
+        if (pos_ >= text_.size()) {
+            fail("unterminated string");
+        }
+        if (text_[pos_++] == '"') {
+            return;
+        }
+        appendEscape(out);
+    }
+}
+
+std::string_view JsonReader::readKey(std::string& scratch) {
+    expect('"');
+    size_t start = pos_;
+    while (pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\') {
+        ++pos_;
+    }
+    if (pos_ < text_.size() && text_[pos_] == '"') {
+        return text_.substr(start, pos_++ - start);
+    }
+    // Escaped key: rewind and decode
+    pos_ = start - 1;
+    readString(scratch);
+    return scratch;
+}
+
+void JsonReader::skipString() {
+    expect('"');
+    while (pos_ < text_.size()) {
+        char c = text_[pos_++];
+        if (c == '"') {
+            return;
+        }
+        if (c == '\\') {
+            ++pos_;
+        }
+    }
+    fail("unterminated string");
+}
+
+void JsonReader::skipValue() {
+    char c = peek();
+    if (c == '"') {
+        skipString();
+    } else if (c == '{' || c == '[') {
+        if (++depth_ > kMaxSkipDepth) {
+            fail("nesting too deep");
+        }
+        char close = c == '{' ? '}' : ']';
+        ++pos_;
+        if (!consume(close)) {
+            do {
+                if (c == '{') {
+                    skipString();
+                    expect(':');
+                }
+                skipValue();
+            } while (consume(','));
+            expect(close);
+        }
+        --depth_;
+    } else if (c == 't' || c == 'f') {
+        readBool();
+    } else if (c == 'n') {
+        if (!readNull()) {
+            fail("unexpected token");
+        }
+    } else {
+        readDouble();
+    }
+}
+
+}  // namespace llmcpp
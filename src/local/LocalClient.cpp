@@ -0,0 +1,202 @@
+#include "local/LocalClient.h"
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include "core/CompiledSchema.h"
+#include "core/CostMeter.h"
+#include "core/Tracing.h"
+#include "openai/OpenAIHttpClient.h"
+
+namespace Local {
+
+namespace {
+
+OpenAI::OpenAIConfig transportConfig(const LocalConfig& config) {
+    OpenAI::OpenAIConfig transport;
+    transport.apiKey = config.apiKey;
+    transport.baseUrl = config.baseUrl;
+    transport.headers = config.headers;
+    transport.timeoutSeconds = config.timeoutSeconds;
+    transport.maxRetries = config.maxRetries;
+    return transport;
+}
+
+const char* endpointPath(Endpoint endpoint) {
+    return endpoint == Endpoint::Completions ? "/completions" : "/chat/completions";
+}
+
+}  // namespace
+
+/**
+ * PIMPL implementation for LocalClient
+ */
+class LocalClient::ClientImpl {
+   public:
+    explicit ClientImpl(const LocalConfig& config)
+        : config_(config), httpClient_(std::make_unique<OpenAIHttpClient>(transportConfig(config))) {}
+
+    void sendRequest(const LLMRequest& request, LLMResponseCallback callback,
+                     RequestHooks hooks) {
+        auto enqueuedAt = std::chrono::steady_clock::now();
+        std::thread([this, request, callback, enqueuedAt, hooks]() {
+            callback(execute(request, nullptr, false, hooks, enqueuedAt));
+        }).detach();
+    }
+
+    void sendStreamingRequest(const LLMRequest& request, LLMResponseCallback onDone,
+                              LLMStreamCallback onChunk, RequestHooks hooks) {
+        auto enqueuedAt = std::chrono::steady_clock::now();
+        std::thread([this, request, onDone, onChunk, enqueuedAt, hooks]() {
+            onDone(execute(request, onChunk, true, hooks, enqueuedAt));
+        }).detach();
+    }
+
+    LLMResponse execute(
+        const LLMRequest& request, const LLMStreamCallback& onChunk, bool stream,
+        const RequestHooks& hooks,
+        std::optional<std::chrono::steady_clock::time_point> enqueuedAt = std::nullopt) {
+        llmcpp::Span span("llm.client.request", request.traceContext,
+                          llmcpp::SpanData::Kind::Client);
+        span.setAttribute("llm.system", "local");
+        span.setAttribute("llm.stream", stream);
+        if (enqueuedAt) {
+            std::chrono::duration<double, std::milli> queued =
+                std::chrono::steady_clock::now() - *enqueuedAt;
+            span.setAttribute("llm.queue_time_ms", queued.count());
+        }
+
+        LLMResponse response;
+        try {
+            // Budget check and context fitting happen before the body is built
+            const std::string model =
+                request.config.model.empty() ? config_.defaultModel : request.config.model;
+            llmcpp::BudgetReservation reservation;  // Released on failure
+            auto prepared = hooks.prepare(request, model, span, reservation);
+            const LLMRequest& sent = prepared ? *prepared : request;
+
+            auto body = buildRequestBody(sent, config_, stream);
+            const std::string sentModel = body.value("model", std::string());
+            if (!sentModel.empty()) {
+                span.setAttribute("llm.model", sentModel);
+            }
+
+            bool expectStructured = request.config.hasSchema();
+            if (stream) {
+                StreamAccumulator accumulator(onChunk);
+                auto http = httpClient_
+                                ->postStreaming(endpointPath(config_.endpoint), body,
+                                                [&accumulator](const std::string& bytes) {
+                                                    accumulator.feed(bytes);
+                                                },
+                                                request.cancellation)
+                                .get();
+                response = http.success ? accumulator.finish(expectStructured)
+                                        : httpFailure(http);
+            } else {
+                auto http =
+                    httpClient_->post(endpointPath(config_.endpoint), body, request.cancellation);
+                response = http.success ? parseResponse(json::parse(http.body), expectStructured)
+                                        : httpFailure(http);
+            }
+            if (response.success) {
+                hooks.recordCost(sent, sentModel, response.usage, span, reservation);
+                llmcpp::validateStructuredOutput(request.config, response);
+            }
+        } catch (const std::exception& e) {
+            response = LLMResponse{};
+            response.success = false;
+            response.errorMessage = e.what();
+        }
+
+        span.setAttribute("llm.response.id", response.responseId);
+        span.setAttribute("llm.usage.input_tokens", response.usage.inputTokens);
+        span.setAttribute("llm.usage.output_tokens", response.usage.outputTokens);
+        span.setAttribute("llm.usage.cached_input_tokens", response.usage.cachedInputTokens);
+        if (response.success) {
+            span.setStatus(llmcpp::SpanData::StatusCode::Ok);
+        } else {
+            span.recordError(response.errorMessage);
+        }
+        return response;
+    }
+
+    std::vector<std::string> getAvailableModels() const {
+        std::vector<std::string> models;
+        try {
+            auto http = httpClient_->get("/models");
+            if (!http.success) {
+                return models;
+            }
+            auto body = json::parse(http.body);
+            if (body.contains("data") && body["data"].is_array()) {
+                for (const auto& model : body["data"]) {
+                    if (model.contains("id") && model["id"].is_string()) {
+                        models.push_back(model["id"].get<std::string>());
+                    }
+                }
+            }
+        } catch (const std::exception&) {
+            // Unreachable server or non-JSON reply: report no models
+        }
+        return models;
+    }
+
+    const LocalConfig& getConfig() const { return config_; }
+
+   private:
+    static LLMResponse httpFailure(const OpenAIHttpClient::HttpResponse& http) {
+        LLMResponse response;
+        response.success = false;
+        response.errorMessage = http.errorMessage.empty()
+                                    ? "HTTP " + std::to_string(http.statusCode)
+                                    : http.errorMessage;
+        return response;
+    }
+
+    LocalConfig config_;
+    std::unique_ptr<OpenAIHttpClient> httpClient_;
+};
+
+LocalClient::LocalClient(const LocalConfig& config)
+    : pImpl(std::make_unique<ClientImpl>(config)) {}
+
+LocalClient::LocalClient(const std::string& baseUrl)
+    : pImpl(std::make_unique<ClientImpl>(LocalConfig(baseUrl))) {}
+
+LocalClient::~LocalClient() = default;
+
+LocalClient::LocalClient(LocalClient&& other) noexcept = default;
+LocalClient& LocalClient::operator=(LocalClient&& other) noexcept = default;
+
+void LocalClient::sendRequest(const LLMRequest& request, LLMResponseCallback callback) {
+    pImpl->sendRequest(request, std::move(callback), hooks_);
+}
+
+void LocalClient::sendStreamingRequest(const LLMRequest& request, LLMResponseCallback onDone,
+                                       LLMStreamCallback onChunk) {
+    pImpl->sendStreamingRequest(request, std::move(onDone), std::move(onChunk), hooks_);
+}
+
+std::vector<std::string> LocalClient::getAvailableModels() const {
+    return pImpl->getAvailableModels();
+}
+
+bool LocalClient::supportsStreaming() const { return true; }
+
+std::string LocalClient::getClientName() const { return "LocalClient"; }
+
+LLMResponse LocalClient::sendRequest(const LLMRequest& request) {
+    return pImpl->execute(request, nullptr, false, hooks_);
+}
+
+LLMResponse LocalClient::sendStreamingRequest(const LLMRequest& request,
+                                              LLMStreamCallback onChunk) {
+    return pImpl->execute(request, onChunk, true, hooks_);
+}
+
+const LocalConfig& LocalClient::getConfig() const { return pImpl->getConfig(); }
+
+}  // namespace Local
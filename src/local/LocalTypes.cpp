@@ -0,0 +1,177 @@
+#include "local/LocalTypes.h"
+
+#include <stdexcept>
+
+#include "core/PromptCache.h"
+
+namespace Local {
+
+namespace {
+
+// Completions choices carry `text` where chat choices carry a message or a stream delta
+void moveTextInto(json& body, const char* field) {
+    auto choices = body.find("choices");
+    if (choices == body.end() || !choices->is_array()) {
+        return;
+    }
+    for (auto& choice : *choices) {
+        auto text = choice.find("text");
+        if (text != choice.end() && !choice.contains(field)) {
+            json content = std::move(*text);
+            choice.erase(text);
+            choice[field] = {{"role", "assistant"}, {"content", std::move(content)}};
+        }
+    }
+}
+
+std::string errorMessage(const json& error) {
+    if (error.is_object() && error.contains("message") && error["message"].is_string()) {
+        return error["message"].get<std::string>();
+    }
+    return error.is_string() ? error.get<std::string>() : error.dump();
+}
+
+LLMResponse toLLMResponse(const OpenAI::ChatCompletionResponse& chat,
+                          bool expectStructuredOutput) {
+    try {
+        return chat.toLLMResponse(expectStructuredOutput);
+    } catch (const json::parse_error& e) {
+        LLMResponse response;
+        response.responseId = chat.id;
+        response.usage = chat.usage;
+        response.errorMessage = "Structured output is not valid JSON: " + std::string(e.what());
+        response.result = json{{"text", chat.choices.front().message.content}};
+        return response;
+    }
+}
+
+}  // namespace
+
+std::string toString(Endpoint endpoint) {
+    return endpoint == Endpoint::Completions ? "completions" : "chat_completions";
+}
+
+Endpoint endpointFromString(const std::string& name) {
+    if (name == "completions") {
+        return Endpoint::Completions;
+    }
+    if (name == "chat_completions" || name == "chat") {
+        return Endpoint::ChatCompletions;
+    }
+    throw std::invalid_argument("Unknown local endpoint: " + name);
+}
+
+json LocalConfig::toJson() const {
+    json j = {{"base_url", baseUrl},
+              {"endpoint", toString(endpoint)},
+              {"timeout_seconds", timeoutSeconds},
+              {"max_retries", maxRetries}};
+    if (!apiKey.empty()) j["api_key"] = apiKey;
+    if (!defaultModel.empty()) j["default_model"] = defaultModel;
+    if (!headers.empty()) j["headers"] = headers;
+    return j;
+}
+
+LocalConfig LocalConfig::fromJson(const json& j) {
+    LocalConfig config;
+    if (j.contains("base_url")) config.baseUrl = j["base_url"].get<std::string>();
+    if (j.contains("api_key")) config.apiKey = j["api_key"].get<std::string>();
+    if (j.contains("default_model")) config.defaultModel = j["default_model"].get<std::string>();
+    if (j.contains("endpoint")) config.endpoint = endpointFromString(j["endpoint"]);
+    if (j.contains("headers"))
+        config.headers = j["headers"].get<std::map<std::string, std::string>>();
+    if (j.contains("timeout_seconds")) config.timeoutSeconds = j["timeout_seconds"].get<int>();
+    if (j.contains("max_retries")) config.maxRetries = j["max_retries"].get<int>();
+    return config;
+}
+
+json buildRequestBody(const LLMRequest& request, const LocalConfig& config, bool stream) {
+    const auto& c = request.config;
+    json body;
+    if (config.endpoint == Endpoint::ChatCompletions) {
+        auto chat = OpenAI::ChatCompletionRequest::fromLLMRequest(request);
+        if (chat.model.empty()) {
+            chat.model = config.defaultModel;
+        }
+        if (stream) {
+            chat.stream = true;
+        }
+        body = chat.toJson();
+    } else {
+        // Completions take one prompt string: context first, then the instruction
+        std::string prompt;
+        for (const auto& message : OpenAI::chatMessagesFromContext(request.context)) {
+            prompt += message.content;
+            prompt += "\n\n";
+        }
+        prompt += request.prompt;
+        body = {{"model", c.model.empty() ? config.defaultModel : c.model},
+                {"prompt", std::move(prompt)}};
+
+        if (c.maxTokens && *c.maxTokens > 0) body["max_tokens"] = *c.maxTokens;
+        if (c.temperature && *c.temperature >= 0.0f) {
+            body["temperature"] = llmcpp::canonicalFloat(*c.temperature);
+        }
+        if (c.topP) body["top_p"] = llmcpp::canonicalFloat(*c.topP);
+        if (c.stopSequences && !c.stopSequences->empty()) body["stop"] = *c.stopSequences;
+        if (stream) {
+            body["stream"] = true;
+            body["stream_options"] = {{"include_usage", true}};
+        }
+    }
+
+    // llama.cpp serves one model and accepts any name
+    if (body["model"].get_ref<const std::string&>().empty()) {
+        body.erase("model");
+    }
+    if (c.topK) body["top_k"] = *c.topK;  // llama.cpp and vLLM extension
+    return body;
+}
+
+LLMResponse parseResponse(json body, bool expectStructuredOutput) {
+    if (body.contains("error")) {
+        LLMResponse response;
+        response.errorMessage = errorMessage(body["error"]);
+        return response;
+    }
+    moveTextInto(body, "message");
+    return toLLMResponse(OpenAI::ChatCompletionResponse::fromJson(body), expectStructuredOutput);
+}
+
+StreamAccumulator::StreamAccumulator(LLMStreamCallback onText)
+    : onText_(std::move(onText)), sse_([this](const auto& event) { onEvent(event); }) {}
+
+void StreamAccumulator::feed(std::string_view bytes) { sse_.feed(bytes); }
+
+void StreamAccumulator::onEvent(const llmcpp::SseParser::Event& event) {
+    if (event.data == "[DONE]") {
+        done_ = true;
+        return;
+    }
+    auto chunk = json::parse(event.data, nullptr, false);
+    if (chunk.is_discarded() || !chunk.is_object()) {
+        return;
+    }
+    if (chunk.contains("error")) {
+        error_ = errorMessage(chunk["error"]);
+        return;
+    }
+    moveTextInto(chunk, "delta");
+    auto delta = OpenAI::applyChatCompletionChunk(response_, chunk);
+    if (!delta.empty() && onText_) {
+        onText_(delta);
+    }
+}
+
+LLMResponse StreamAccumulator::finish(bool expectStructuredOutput) {
+    sse_.finish();
+    if (!error_.empty()) {
+        LLMResponse response;
+        response.responseId = response_.id;
+        response.errorMessage = error_;
+        return response;
+    }
+    return toLLMResponse(response_, expectStructuredOutput);
+}
+
+}  // namespace Local
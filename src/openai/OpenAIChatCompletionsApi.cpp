@@ -0,0 +1,203 @@
+#include "openai/OpenAIChatCompletionsApi.h"
+
+#include <stdexcept>
+
+#include "core/Logger.h"
+#include "core/SseParser.h"
+#include "core/Tracing.h"
+#include "openai/OpenAIHttpClient.h"
+#include "openai/OpenAIStrictSchema.h"
+
+namespace {
+
+const char* const kChatCompletionsEndpoint = "/chat/completions";
+
+std::string apiErrorMessage(const json& error) {
+    if (error.is_object() && error.contains("message") && error["message"].is_string()) {
+        return error["message"].get<std::string>();
+    }
+    return error.dump();
+}
+
+}  // namespace
+
+OpenAIChatCompletionsApi::OpenAIChatCompletionsApi(std::shared_ptr<OpenAIHttpClient> httpClient)
+    : httpClient_(std::move(httpClient)) {}
+
+OpenAI::ChatCompletionResponse OpenAIChatCompletionsApi::sendChatCompletion(
+    const OpenAI::ChatCompletionRequest& request, const llmcpp::CancellationToken& cancel) {
+    validateRequest(request);
+    auto requestJson = buildRequestJson(request);
+    requestJson.erase("stream");
+
+    auto httpResponse = httpClient_->post(kChatCompletionsEndpoint, requestJson, cancel);
+    if (httpResponse.cancelled) {
+        throw llmcpp::OperationCancelled();
+    }
+    if (!httpResponse.success) {
+        LLMCPP_LOG_ERROR("openai.chat", "HTTP request failed",
+                         {{"status", httpResponse.statusCode}, {"body", httpResponse.body}});
+        throw std::runtime_error("HTTP request failed: " + httpResponse.errorMessage);
+    }
+
+    llmcpp::Span parseSpan("llm.response.parse");
+    parseSpan.setAttribute("llm.response.body_size", httpResponse.body.size());
+    try {
+        return parseResponse(json::parse(httpResponse.body));
+    } catch (const json::exception& e) {
+        throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
+    }
+}
+
+std::future<OpenAI::ChatCompletionResponse> OpenAIChatCompletionsApi::sendChatCompletionAsync(
+    const OpenAI::ChatCompletionRequest& request,
+    std::function<void(const OpenAI::ChatCompletionResponse&)> callback,
+    llmcpp::CancellationToken cancel) {
+    return std::async(std::launch::async, [this, request, callback, cancel]() {
+        auto response = sendChatCompletion(request, cancel);
+        if (callback) {
+            callback(response);
+        }
+        return response;
+    });
+}
+
+std::future<OpenAI::ChatCompletionResponse> OpenAIChatCompletionsApi::sendChatCompletionStreaming(
+    const OpenAI::ChatCompletionRequest& request,
+    std::function<void(const std::string&)> streamCallback,
+    std::function<void(const OpenAI::ChatCompletionResponse&)> finalCallback,
+    llmcpp::CancellationToken cancel) {
+    return std::async(std::launch::async, [this, request, streamCallback, finalCallback, cancel]() {
+        auto response = streamChatCompletion(request, streamCallback, cancel);
+        if (finalCallback) {
+            finalCallback(response);
+        }
+        return response;
+    });
+}
+
+OpenAI::ChatCompletionResponse OpenAIChatCompletionsApi::streamChatCompletion(
+    const OpenAI::ChatCompletionRequest& request,
+    const std::function<void(const std::string&)>& streamCallback,
+    const llmcpp::CancellationToken& cancel) {
+    validateRequest(request);
+    auto streamingRequest = request;
+    streamingRequest.stream = true;
+    auto requestJson = buildRequestJson(streamingRequest);
+
+    // Chunks are merged as they arrive; nothing is re-parsed once the stream ends
+    OpenAI::ChatCompletionResponse response;
+    std::string streamError;
+    bool complete = false;
+    llmcpp::SseParser sse([&](const llmcpp::SseParser::Event& event) {
+        if (isStreamingComplete(event.data)) {
+            complete = true;
+            return;
+        }
+        auto chunk = json::parse(event.data, nullptr, false);
+        if (chunk.is_discarded() || !chunk.is_object()) {
+            return;
+        }
+        if (chunk.contains("error")) {
+            streamError = apiErrorMessage(chunk["error"]);
+            return;
+        }
+        auto delta = OpenAI::applyChatCompletionChunk(response, chunk);
+        if (!delta.empty() && streamCallback) {
+            streamCallback(delta);
+        }
+    });
+
+    auto httpResponse =
+        httpClient_
+            ->postStreaming(kChatCompletionsEndpoint, requestJson,
+                            [&sse](const std::string& bytes) { sse.feed(bytes); }, cancel)
+            .get();
+    if (httpResponse.cancelled) {
+        throw llmcpp::OperationCancelled();
+    }
+    sse.finish();
+
+    if (!httpResponse.success) {
+        throw std::runtime_error("HTTP request failed: " + httpResponse.errorMessage);
+    }
+    if (!streamError.empty()) {
+        throw std::runtime_error("OpenAI API error: " + streamError);
+    }
+    if (!complete) {
+        LLMCPP_LOG_WARN("openai.chat", "Stream ended without [DONE]", {{"id", response.id}});
+    }
+    return response;
+}
+
+std::string OpenAIChatCompletionsApi::parseStreamingChunk(const std::string& chunk) {
+    if (isStreamingComplete(chunk)) {
+        return "";
+    }
+    auto parsed = json::parse(chunk, nullptr, false);
+    if (parsed.is_discarded() || !parsed.is_object()) {
+        return "";
+    }
+    OpenAI::ChatCompletionResponse scratch;
+    return OpenAI::applyChatCompletionChunk(scratch, parsed);
+}
+
+bool OpenAIChatCompletionsApi::isStreamingComplete(const std::string& chunk) {
+    return chunk == "[DONE]";
+}
+
+json OpenAIChatCompletionsApi::buildRequestJson(const OpenAI::ChatCompletionRequest& request) const {
+    json requestJson = request.toJson();
+
+    // Strict structured outputs use the same normalized schema as the Responses API
+    const auto& text = request.text;
+    if (text && text->schema() && text->strict()) {
+        requestJson["response_format"]["json_schema"]["schema"] =
+            OpenAI::strictSchemaFor(text->schema())->value();
+    }
+    return requestJson;
+}
+
+OpenAI::ChatCompletionResponse OpenAIChatCompletionsApi::parseResponse(const json& response) const {
+    if (response.contains("error") && !response["error"].is_null()) {
+        throw std::runtime_error("OpenAI API error: " + apiErrorMessage(response["error"]));
+    }
+    return OpenAI::ChatCompletionResponse::fromJson(response);
+}
+
+void OpenAIChatCompletionsApi::validateRequest(const OpenAI::ChatCompletionRequest& request) const {
+    if (request.model.empty()) {
+        throw std::invalid_argument("Invalid request: model is required");
+    }
+    if (request.n && *request.n < 1) {
+        throw std::invalid_argument("Invalid request: n must be at least 1");
+    }
+    validateMessages(request.messages);
+    if (request.tools) {
+        validateTools(*request.tools);
+    }
+}
+
+void OpenAIChatCompletionsApi::validateTools(const std::vector<OpenAI::ToolVariant>& tools) const {
+    for (const auto& tool : tools) {
+        if (!std::holds_alternative<OpenAI::FunctionTool>(tool)) {
+            throw std::invalid_argument(
+                "Invalid request: Chat Completions only supports function tools");
+        }
+        if (std::get<OpenAI::FunctionTool>(tool).name.empty()) {
+            throw std::invalid_argument("Invalid request: function tool name is required");
+        }
+    }
+}
+
+void OpenAIChatCompletionsApi::validateMessages(
+    const std::vector<OpenAI::ChatMessage>& messages) const {
+    if (messages.empty()) {
+        throw std::invalid_argument("Invalid request: at least one message is required");
+    }
+    for (const auto& message : messages) {
+        if (message.role.empty()) {
+            throw std::invalid_argument("Invalid request: message role is required");
+        }
+    }
+}
@@ -4,17 +4,14 @@
 #include <future>
 #include <stdexcept>
 
-#include "openai/OpenAIResponsesApi.h"
-
-// #include "openai/OpenAIChatCompletionsApi.h"
+#include "core/CompiledSchema.h"
+#include "core/ModelCatalog.h"
+#include "core/CostMeter.h"
+#include "core/Tracing.h"
+#include "openai/OpenAIChatCompletionsApi.h"
 #include "openai/OpenAIHttpClient.h"
-
-// For now, create minimal stub classes to make unique_ptr work
-class OpenAIChatCompletionsApi {
-   public:
-    OpenAIChatCompletionsApi() = default;
-    virtual ~OpenAIChatCompletionsApi() = default;
-};
+#include "openai/OpenAIResponsesApi.h"
+#include "openai/OpenAIStrictSchema.h"
 
 OpenAIClient::OpenAIClient(const std::string& apiKey)
     : config_{apiKey, "https://api.openai.com/v1", "", "", {}, 30, 3, true, true} {
@@ -33,7 +30,7 @@ OpenAIClient::OpenAIClient(const std::string& apiKey, OpenAI::Model /*defaultMod
 }
 
 // Destructor implementation - can handle unique_ptr destruction here
-// because complete types are available (either from includes or stubs above)
+// because complete types are available from the includes above
 OpenAIClient::~OpenAIClient() = default;
 
 // Move constructor
@@ -55,11 +52,7 @@ void OpenAIClient::sendStreamingRequest(const LLMRequest& request, LLMResponseCa
 }
 
 std::vector<std::string> OpenAIClient::getAvailableModels() const {
-    std::vector<std::string> models;
-    models.insert(models.end(), RESPONSES_MODELS.begin(), RESPONSES_MODELS.end());
-    models.insert(models.end(), CHAT_COMPLETION_MODELS.begin(),
-                  CHAT_COMPLETION_MODELS.end());
-    return models;
+    return llmcpp::modelNames(llmcpp::ModelProvider::OpenAI);
 }
 
 bool OpenAIClient::supportsStreaming() const { return true; }
@@ -123,8 +116,8 @@ std::string OpenAIClient::getApiKey() const { return config_.apiKey; }
 bool OpenAIClient::isConfigured() const { return !config_.apiKey.empty(); }
 
 bool OpenAIClient::isModelSupported(const std::string& modelName) const {
-    auto models = getAvailableModels();
-    return std::find(models.begin(), models.end(), modelName) != models.end();
+    const auto* info = llmcpp::resolveModel(modelName);
+    return info && info->provider == llmcpp::ModelProvider::OpenAI;
 }
 
 bool OpenAIClient::isModelSupported(OpenAI::Model model) const {
@@ -156,7 +149,7 @@ json OpenAIClient::getClientConfig() const {
 
 // OpenAI-specific methods - now implemented using real API
 OpenAI::ResponsesResponse OpenAIClient::sendResponsesRequest(
-    const OpenAI::ResponsesRequest& request) {
+    const OpenAI::ResponsesRequest& request, const llmcpp::CancellationToken& cancel) {
     if (!responsesApi_) {
         throw std::runtime_error("Responses API not initialized");
     }
@@ -167,7 +160,7 @@ OpenAI::ResponsesResponse OpenAIClient::sendResponsesRequest(
     }
 
     // Create initial response
-    auto response = responsesApi_->create(request);
+    auto response = responsesApi_->create(request, cancel);
 
     // If the model returns a non-completed status (e.g., queued/in_progress/incomplete),
     // poll until completion or failure. This particularly affects reasoning models like GPT-5.
@@ -175,7 +168,9 @@ OpenAI::ResponsesResponse OpenAIClient::sendResponsesRequest(
         try {
             // Reasonable defaults: wait up to 90s, polling every 2s
             response = responsesApi_->waitForCompletion(response.id, /*timeoutSeconds=*/90,
-                                                        /*pollIntervalSeconds=*/2);
+                                                        /*pollIntervalSeconds=*/2, cancel);
+        } catch (const llmcpp::OperationCancelled&) {
+            throw;
         } catch (const std::exception& /*e*/) {
             // Fall through and return the last known response (likely non-completed)
         }
@@ -186,7 +181,8 @@ OpenAI::ResponsesResponse OpenAIClient::sendResponsesRequest(
 
 std::future<OpenAI::ResponsesResponse> OpenAIClient::sendResponsesRequestAsync(
     const OpenAI::ResponsesRequest& request,
-    std::function<void(const OpenAI::ResponsesResponse&)> callback) {
+    std::function<void(const OpenAI::ResponsesResponse&)> callback,
+    llmcpp::CancellationToken cancel) {
     if (!responsesApi_) {
         throw std::runtime_error("Responses API not initialized");
     }
@@ -196,7 +192,7 @@ std::future<OpenAI::ResponsesResponse> OpenAIClient::sendResponsesRequestAsync(
         throw std::invalid_argument("Invalid request: " + errorMessage);
     }
 
-    return responsesApi_->createAsync(request, callback);
+    return responsesApi_->createAsync(request, callback, std::move(cancel));
 }
 
 OpenAI::ResponsesResponse OpenAIClient::retrieveResponse(const std::string& responseId) {
@@ -222,8 +218,35 @@ OpenAI::ResponsesResponse OpenAIClient::deleteResponse(const std::string& respon
 }
 
 OpenAI::ChatCompletionResponse OpenAIClient::sendChatCompletion(
-    const OpenAI::ChatCompletionRequest& request [[maybe_unused]]) {
-    throw std::runtime_error("OpenAIClient::sendChatCompletion not yet implemented");
+    const OpenAI::ChatCompletionRequest& request, const llmcpp::CancellationToken& cancel) {
+    if (!chatCompletionsApi_) {
+        throw std::runtime_error("Chat Completions API not initialized");
+    }
+    return chatCompletionsApi_->sendChatCompletion(request, cancel);
+}
+
+std::future<OpenAI::ChatCompletionResponse> OpenAIClient::sendChatCompletionAsync(
+    const OpenAI::ChatCompletionRequest& request,
+    std::function<void(const OpenAI::ChatCompletionResponse&)> callback,
+    llmcpp::CancellationToken cancel) {
+    if (!chatCompletionsApi_) {
+        throw std::runtime_error("Chat Completions API not initialized");
+    }
+    return chatCompletionsApi_->sendChatCompletionAsync(request, std::move(callback),
+                                                        std::move(cancel));
+}
+
+std::future<OpenAI::ChatCompletionResponse> OpenAIClient::sendChatCompletionStreaming(
+    const OpenAI::ChatCompletionRequest& request,
+    std::function<void(const std::string&)> streamCallback,
+    std::function<void(const OpenAI::ChatCompletionResponse&)> finalCallback,
+    llmcpp::CancellationToken cancel) {
+    if (!chatCompletionsApi_) {
+        throw std::runtime_error("Chat Completions API not initialized");
+    }
+    return chatCompletionsApi_->sendChatCompletionStreaming(request, std::move(streamCallback),
+                                                            std::move(finalCallback),
+                                                            std::move(cancel));
 }
 
 // Configuration
@@ -242,6 +265,10 @@ OpenAI::ApiType OpenAIClient::getPreferredApiType() const { return preferredApiT
 
 // Private methods - now implemented with real routing
 void OpenAIClient::initializeApiHandlers() {
+    if (config_.apiKey.empty()) {
+        throw std::invalid_argument("OpenAI API key cannot be empty");
+    }
+
     // Create HTTP client with current configuration
     httpClient_ = std::make_unique<OpenAIHttpClient>(config_);
 
@@ -251,47 +278,111 @@ void OpenAIClient::initializeApiHandlers() {
 
     // Initialize API handlers with shared HTTP client
     responsesApi_ = std::make_unique<OpenAIResponsesApi>(sharedHttpClient);
-    chatCompletionsApi_ = std::make_unique<OpenAIChatCompletionsApi>();
+    chatCompletionsApi_ = std::make_unique<OpenAIChatCompletionsApi>(sharedHttpClient);
 }
 
-LLMResponse OpenAIClient::routeRequest(const LLMRequest& request) {
+OpenAI::ApiType OpenAIClient::resolveApiType(const LLMRequest& request) const {
+    return preferredApiType_ != OpenAI::ApiType::AUTO_DETECT ? preferredApiType_
+                                                              : detectApiType(request);
+}
+
+LLMResponse OpenAIClient::routeRequest(
+    const LLMRequest& request, std::optional<std::chrono::steady_clock::time_point> enqueuedAt,
+    LLMStreamCallback streamCallback) {
+    llmcpp::Span span("llm.client.request", request.traceContext, llmcpp::SpanData::Kind::Client);
+    span.setAttribute("llm.system", "openai");
+    span.setAttribute("llm.model", request.config.model);
+    if (enqueuedAt) {
+        std::chrono::duration<double, std::milli> queued =
+            std::chrono::steady_clock::now() - *enqueuedAt;
+        span.setAttribute("llm.queue_time_ms", queued.count());
+    }
+
+    LLMResponse response;
     try {
-        // Detect which API to use
-        OpenAI::ApiType apiType = detectApiType(request);
+        llmcpp::throwIfCancelled(request.cancellation);
 
-        if (preferredApiType_ != OpenAI::ApiType::AUTO_DETECT) {
-            apiType = preferredApiType_;
-        }
+        // Budget check and context fitting happen before API detection and conversion
+        llmcpp::BudgetReservation reservation;  // Released on failure
+        auto prepared = hooks_.prepare(request, request.config.model, span, reservation);
+        const LLMRequest& sent = prepared ? *prepared : request;
+
+        // Detect which API to use
+        OpenAI::ApiType apiType = resolveApiType(sent);
+        span.setAttribute("llm.api", apiType == OpenAI::ApiType::CHAT_COMPLETIONS
+                                         ? "chat_completions"
+                                         : "responses");
 
         // Route to appropriate API
         if (apiType == OpenAI::ApiType::RESPONSES || apiType == OpenAI::ApiType::AUTO_DETECT) {
             // Use Responses API (preferred for modern features)
-            auto responsesRequest = OpenAI::ResponsesRequest::fromLLMRequest(request);
-            auto responsesResponse = sendResponsesRequest(responsesRequest);
+            auto responsesRequest = OpenAI::ResponsesRequest::fromLLMRequest(sent);
+            span.setAttribute("llm.prompt.prefix_hash",
+                              responsesRequest.staticPrefix().hash.toHex());
+            auto responsesResponse = sendResponsesRequest(responsesRequest, request.cancellation);
             // Check if structured output is expected based on JSON schema
-            bool expectStructured =
-                !request.config.jsonSchema.empty() || request.config.schemaObject.has_value();
-            return responsesResponse.toLLMResponse(expectStructured);
+            bool expectStructured = request.config.hasSchema();
+            response = responsesResponse.toLLMResponse(expectStructured);
+            hooks_.recordCost(sent, responsesRequest.model, response.usage, span, reservation);
+            const auto& text = responsesRequest.text;
+            if (request.config.validateOutput && text && text->strict() && text->schema()) {
+                // The model answered the strict-normalized schema (optional fields nullable)
+                LLMRequestConfig strictConfig = request.config;
+                strictConfig.internedSchema = OpenAI::strictSchemaFor(text->schema());
+                llmcpp::validateStructuredOutput(strictConfig, response);
+            } else {
+                llmcpp::validateStructuredOutput(request.config, response);
+            }
         } else if (apiType == OpenAI::ApiType::CHAT_COMPLETIONS) {
-            // Chat Completions API - not yet implemented
-            throw std::runtime_error("Chat Completions API not yet implemented");
+            auto chatRequest = OpenAI::ChatCompletionRequest::fromLLMRequest(sent);
+            auto chatResponse =
+                streamCallback ? chatCompletionsApi_->streamChatCompletion(
+                                     chatRequest, streamCallback, request.cancellation)
+                               : sendChatCompletion(chatRequest, request.cancellation);
+            bool expectStructured = request.config.hasSchema();
+            response = chatResponse.toLLMResponse(expectStructured);
+            hooks_.recordCost(sent, chatRequest.model, response.usage, span, reservation);
+            const auto& text = chatRequest.text;
+            if (request.config.validateOutput && text && text->strict() && text->schema()) {
+                LLMRequestConfig strictConfig = request.config;
+                strictConfig.internedSchema = OpenAI::strictSchemaFor(text->schema());
+                llmcpp::validateStructuredOutput(strictConfig, response);
+            } else {
+                llmcpp::validateStructuredOutput(request.config, response);
+            }
         } else {
             throw std::runtime_error("Unknown API type");
         }
 
+    } catch (const llmcpp::OperationCancelled& e) {
+        response = LLMResponse{};
+        response.success = false;
+        response.errorMessage = e.what();
+        span.setAttribute("llm.cancelled", true);
     } catch (const std::exception& e) {
-        LLMResponse errorResponse;
-        errorResponse.success = false;
-        errorResponse.errorMessage = e.what();
-        return errorResponse;
+        response = LLMResponse{};
+        response.success = false;
+        response.errorMessage = e.what();
     }
+
+    span.setAttribute("llm.response.id", response.responseId);
+    span.setAttribute("llm.usage.input_tokens", response.usage.inputTokens);
+    span.setAttribute("llm.usage.output_tokens", response.usage.outputTokens);
+    span.setAttribute("llm.usage.cached_input_tokens", response.usage.cachedInputTokens);
+    if (response.success) {
+        span.setStatus(llmcpp::SpanData::StatusCode::Ok);
+    } else {
+        span.recordError(response.errorMessage);
+    }
+    return response;
 }
 
 std::future<LLMResponse> OpenAIClient::routeRequestAsync(const LLMRequest& request,
                                                          LLMResponseCallback callback) {
-    return std::async(std::launch::async, [this, request, callback]() {
+    auto enqueuedAt = std::chrono::steady_clock::now();
+    return std::async(std::launch::async, [this, request, callback, enqueuedAt]() {
         try {
-            auto response = routeRequest(request);
+            auto response = routeRequest(request, enqueuedAt);
 
             // Call callback after the future is ready, not before
             if (callback) {
@@ -316,14 +407,17 @@ std::future<LLMResponse> OpenAIClient::routeRequestAsync(const LLMRequest& reque
 std::future<LLMResponse> OpenAIClient::routeStreamingRequest(const LLMRequest& request,
                                                              LLMStreamCallback streamCallback,
                                                              LLMResponseCallback finalCallback) {
-    return std::async(std::launch::async, [this, request, streamCallback, finalCallback]() {
+    auto enqueuedAt = std::chrono::steady_clock::now();
+    return std::async(std::launch::async, [this, request, streamCallback, finalCallback,
+                                           enqueuedAt]() {
         try {
-            // For now, implement streaming as regular request with callback
-            // Real streaming will be implemented when Responses API streaming is ready
-            auto response = routeRequest(request);
+            // Chat Completions stream text deltas as they arrive; Responses API requests
+            // still complete first and deliver the whole result as a single chunk
+            bool streamsDeltas = resolveApiType(request) == OpenAI::ApiType::CHAT_COMPLETIONS;
+            auto response =
+                routeRequest(request, enqueuedAt, streamsDeltas ? streamCallback : nullptr);
 
-            if (streamCallback && response.success) {
-                // Simulate streaming by sending the complete response
+            if (!streamsDeltas && streamCallback && response.success) {
                 streamCallback(response.result.dump());
             }
 
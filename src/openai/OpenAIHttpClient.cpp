@@ -8,17 +8,20 @@
 #include <stdexcept>
 #include <thread>
 
+#include "core/Tracing.h"
+
 /**
  * Private implementation class using Pimpl idiom
  */
 class OpenAIHttpClient::HttpClientImpl {
    public:
     explicit HttpClientImpl(const OpenAI::OpenAIConfig& config) : config_(config) {
-        // Create HTTPS client for OpenAI API
+        // Split the base URL into scheme, host[:port] and base path
         auto baseUrl = config_.baseUrl;
         if (baseUrl.find("://") != std::string::npos) {
             // Extract hostname from full URL
             auto protocolEnd = baseUrl.find("://") + 3;
+            scheme_ = baseUrl.substr(0, protocolEnd - 3);
             auto pathStart = baseUrl.find('/', protocolEnd);
             if (pathStart != std::string::npos) {
                 hostname_ = baseUrl.substr(protocolEnd, pathStart - protocolEnd);
@@ -32,82 +35,161 @@ class OpenAIHttpClient::HttpClientImpl {
             basePath_ = "/v1";
         }
 
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-        client_ = std::make_unique<httplib::SSLClient>(hostname_);
+        client_ = makeClient();
+    }
 
-        // Configure client
-        client_->set_connection_timeout(config_.timeoutSeconds);
-        client_->set_read_timeout(config_.timeoutSeconds);
-        client_->set_write_timeout(config_.timeoutSeconds);
+    OpenAIHttpClient::HttpResponse postBody(const std::string& endpoint, const std::string& bodyStr,
+                                            const llmcpp::CancellationToken& cancel) {
+        httplib::Request req;
+        req.method = "POST";
+        req.path = buildUrl(endpoint);
+        req.headers = buildHeaders();
+        req.body = bodyStr;
+        req.set_header("Content-Type", "application/json");
 
-        // Enable SSL verification
-        client_->enable_server_certificate_verification(true);
-#else
-        throw std::runtime_error(
-            "SSL support not available. Please ensure OpenSSL is properly linked.");
-#endif
-    }
+        llmcpp::Span span("HTTP POST", llmcpp::SpanData::Kind::Client);
+        injectTraceContext(span, req.headers);
 
-    OpenAIHttpClient::HttpResponse post(const std::string& endpoint, const json& requestBody) {
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-        auto headers = buildHeaders();
-        auto url = buildUrl(endpoint);
-        auto bodyStr = requestBody.dump();
+        return traceResponse(span, "POST", req.path, send(req, cancel));
+    }
 
-        auto result = client_->Post(url, headers, bodyStr, "application/json");
+    // POST with the response body delivered to `onData` as it arrives. Error responses are
+    // buffered instead, so the caller only ever sees bytes of a successful stream.
+    OpenAIHttpClient::HttpResponse postStream(const std::string& endpoint,
+                                              const std::string& bodyStr,
+                                              const std::function<void(const std::string&)>& onData,
+                                              const llmcpp::CancellationToken& cancel) {
+        httplib::Request req;
+        req.method = "POST";
+        req.path = buildUrl(endpoint);
+        req.headers = buildHeaders();
+        req.headers.emplace("Accept", "text/event-stream");
+        req.body = bodyStr;
+        req.set_header("Content-Type", "application/json");
+
+        llmcpp::Span span("HTTP POST", llmcpp::SpanData::Kind::Client);
+        injectTraceContext(span, req.headers);
+
+        std::string errorBody;
+        int status = 0;
+        req.response_handler = [&status](const httplib::Response& res) {
+            status = res.status;
+            return true;
+        };
+        req.content_receiver = [&](const char* data, size_t length, uint64_t, uint64_t) {
+            if (status >= 200 && status < 300) {
+                if (onData) {
+                    onData(std::string(data, length));
+                }
+            } else {
+                errorBody.append(data, length);
+            }
+            return !cancel.stop_requested();
+        };
 
-        return processResponse(result);
-#else
-        OpenAIHttpClient::HttpResponse response;
-        response.success = false;
-        response.statusCode = 0;
-        response.errorMessage = "SSL support not available";
-        return response;
-#endif
+        auto response = send(req, cancel);
+        if (response.statusCode != 0 && !response.success) {
+            response.body = errorBody;
+            response.errorMessage = extractErrorMessage(errorBody, response.statusCode);
+        }
+        return traceResponse(span, "POST", req.path, std::move(response));
     }
 
-    OpenAIHttpClient::HttpResponse get(const std::string& endpoint) {
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-        auto headers = buildHeaders();
-        auto url = buildUrl(endpoint);
+    OpenAIHttpClient::HttpResponse get(const std::string& endpoint,
+                                       const llmcpp::CancellationToken& cancel) {
+        httplib::Request req;
+        req.method = "GET";
+        req.path = buildUrl(endpoint);
+        req.headers = buildHeaders();
 
-        auto result = client_->Get(url, headers);
+        llmcpp::Span span("HTTP GET", llmcpp::SpanData::Kind::Client);
+        injectTraceContext(span, req.headers);
 
-        return processResponse(result);
-#else
-        OpenAIHttpClient::HttpResponse response;
-        response.success = false;
-        response.statusCode = 0;
-        response.errorMessage = "SSL support not available";
-        return response;
-#endif
+        return traceResponse(span, "GET", req.path, send(req, cancel));
     }
 
     void setConfig(const OpenAI::OpenAIConfig& config) {
         config_ = config;
-#ifdef CPPHTTPLIB_OPENSSL_SUPPORT
         // Update client timeouts
         client_->set_connection_timeout(config_.timeoutSeconds);
         client_->set_read_timeout(config_.timeoutSeconds);
         client_->set_write_timeout(config_.timeoutSeconds);
-#endif
     }
 
     OpenAI::OpenAIConfig getConfig() const { return config_; }
 
    private:
     OpenAI::OpenAIConfig config_;
+    std::unique_ptr<httplib::Client> client_;  // HTTPS or plain HTTP depending on baseUrl
+    std::string scheme_ = "https";
+    std::string hostname_;
+    std::string basePath_;
+
+    std::unique_ptr<httplib::Client> makeClient() const {
+        std::unique_ptr<httplib::Client> client;
+        if (scheme_ == "http") {
+            // Plain HTTP for local OpenAI-compatible servers and mocks
+            client = std::make_unique<httplib::Client>("http://" + hostname_);
+        } else {
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
-    std::unique_ptr<httplib::SSLClient> client_;
+            client = std::make_unique<httplib::Client>("https://" + hostname_);
+
+            client->enable_server_certificate_verification(config_.verifySSL);
 #else
-    std::unique_ptr<httplib::Client> client_;  // Use regular HTTP client when SSL not available
+            throw std::runtime_error(
+                "SSL support not available. Please ensure OpenSSL is properly linked.");
 #endif
-    std::string hostname_;
-    std::string basePath_;
+        }
+
+        // Configure client
+        client->set_connection_timeout(config_.timeoutSeconds);
+        client->set_read_timeout(config_.timeoutSeconds);
+        client->set_write_timeout(config_.timeoutSeconds);
+        return client;
+    }
+
+    // Cancellable requests get a connection of their own: stop() shuts down whatever socket a
+    // client has open, which on the shared client may carry another caller's request. They
+    // pay for a new connection (and TLS handshake) instead of reusing a kept-alive one.
+    OpenAIHttpClient::HttpResponse send(httplib::Request& req,
+                                        const llmcpp::CancellationToken& cancel) const {
+        if (!cancel.stop_possible()) {
+            return processResponse(client_->send(req));
+        }
+        if (cancel.stop_requested()) {
+            return cancelledResponse();
+        }
+        auto client = makeClient();
+        // stop() before the socket exists has nothing to shut down. httplib sets socket options
+        // while holding its socket lock, so a stop() issued from there waits for the connection
+        // to be up and then shuts it down.
+        std::jthread lateStop;
+        client->set_socket_options([&](auto) {
+            if (cancel.stop_requested() && !lateStop.joinable()) {
+                lateStop = std::jthread([&client]() { client->stop(); });
+            }
+        });
+        std::stop_callback abortRead(cancel, [&client]() { client->stop(); });
+        req.progress = [&cancel](uint64_t, uint64_t) { return !cancel.stop_requested(); };
+        auto result = client->send(req);
+        if (cancel.stop_requested()) {
+            return cancelledResponse();
+        }
+        return processResponse(result);
+    }
+
+    static OpenAIHttpClient::HttpResponse cancelledResponse() {
+        OpenAIHttpClient::HttpResponse response;
+        response.cancelled = true;
+        response.errorMessage = "Request cancelled";
+        return response;
+    }
 
     httplib::Headers buildHeaders() const {
         httplib::Headers headers;
-        headers.emplace("Authorization", "Bearer " + config_.apiKey);
+        if (!config_.apiKey.empty()) {  // Self-hosted servers often run without a key
+            headers.emplace("Authorization", "Bearer " + config_.apiKey);
+        }
         headers.emplace("User-Agent", "llmcpp/1.0.0");
 
         if (!config_.organization.empty()) {
@@ -118,6 +200,10 @@ class OpenAIHttpClient::HttpClientImpl {
             headers.emplace("OpenAI-Project", config_.project);
         }
 
+        for (const auto& [key, value] : config_.headers) {
+            headers.emplace(key, value);
+        }
+
         return headers;
     }
 
@@ -155,6 +241,29 @@ class OpenAIHttpClient::HttpClientImpl {
         return response;
     }
 
+    // Propagate the HTTP span to the provider via the W3C traceparent header
+    static void injectTraceContext(const llmcpp::Span& span, httplib::Headers& headers) {
+        if (span.isRecording()) {
+            headers.emplace("traceparent", span.context().toTraceparent());
+        }
+    }
+
+    OpenAIHttpClient::HttpResponse traceResponse(llmcpp::Span& span, const std::string& method,
+                                                 const std::string& url,
+                                                 OpenAIHttpClient::HttpResponse response) const {
+        if (span.isRecording()) {
+            span.setAttribute("http.request.method", method);
+            span.setAttribute("server.address", hostname_);
+            span.setAttribute("url.path", url);
+            span.setAttribute("http.status_code", response.statusCode);
+            span.setAttribute("http.response.body.size", response.body.size());
+            if (!response.success) {
+                span.recordError(response.errorMessage);
+            }
+        }
+        return response;
+    }
+
     std::string extractErrorMessage(const std::string& body, int statusCode) const {
         try {
             auto errorJson = json::parse(body);
@@ -182,40 +291,59 @@ OpenAIHttpClient::OpenAIHttpClient(const OpenAI::OpenAIConfig& config)
 OpenAIHttpClient::~OpenAIHttpClient() = default;
 
 OpenAIHttpClient::HttpResponse OpenAIHttpClient::post(const std::string& endpoint,
-                                                      const json& requestBody) {
+                                                      const json& requestBody,
+                                                      const llmcpp::CancellationToken& cancel) {
     validateEndpoint(endpoint);
     validateRequestBody(requestBody);
 
+    const auto body = requestBody.dump();
     return executeWithRetry(
-        [this, &endpoint, &requestBody]() { return impl_->post(endpoint, requestBody); });
+        [this, &endpoint, &body, &cancel]() { return impl_->postBody(endpoint, body, cancel); },
+        cancel);
 }
 
-OpenAIHttpClient::HttpResponse OpenAIHttpClient::get(const std::string& endpoint) {
+OpenAIHttpClient::HttpResponse OpenAIHttpClient::postSerialized(
+    const std::string& endpoint, const std::string& body, const llmcpp::CancellationToken& cancel) {
     validateEndpoint(endpoint);
+    if (body.empty()) {
+        throw std::invalid_argument("Request body cannot be empty");
+    }
 
-    return executeWithRetry([this, &endpoint]() { return impl_->get(endpoint); });
+    return executeWithRetry(
+        [this, &endpoint, &body, &cancel]() { return impl_->postBody(endpoint, body, cancel); },
+        cancel);
 }
 
-std::future<OpenAIHttpClient::HttpResponse> OpenAIHttpClient::postAsync(const std::string& endpoint,
-                                                                        const json& requestBody) {
-    return std::async(std::launch::async,
-                      [this, endpoint, requestBody]() { return post(endpoint, requestBody); });
+OpenAIHttpClient::HttpResponse OpenAIHttpClient::get(const std::string& endpoint,
+                                                     const llmcpp::CancellationToken& cancel) {
+    validateEndpoint(endpoint);
+
+    return executeWithRetry(
+        [this, &endpoint, &cancel]() { return impl_->get(endpoint, cancel); }, cancel);
+}
+
+std::future<OpenAIHttpClient::HttpResponse> OpenAIHttpClient::postAsync(
+    const std::string& endpoint, const json& requestBody, llmcpp::CancellationToken cancel) {
+    return std::async(std::launch::async, [this, endpoint, requestBody, cancel]() {
+        return post(endpoint, requestBody, cancel);
+    });
 }
 
 std::future<OpenAIHttpClient::HttpResponse> OpenAIHttpClient::getAsync(
-    const std::string& endpoint) {
-    return std::async(std::launch::async, [this, endpoint]() { return get(endpoint); });
+    const std::string& endpoint, llmcpp::CancellationToken cancel) {
+    return std::async(std::launch::async,
+                      [this, endpoint, cancel]() { return get(endpoint, cancel); });
 }
 
 std::future<OpenAIHttpClient::HttpResponse> OpenAIHttpClient::postStreaming(
     const std::string& endpoint, const json& requestBody,
-    std::function<void(const std::string&)> streamCallback) {
-    return std::async(std::launch::async, [this, endpoint, requestBody, streamCallback]() {
-        auto response = post(endpoint, requestBody);
-        if (response.success && streamCallback) {
-            streamCallback(response.body);
-        }
-        return response;
+    std::function<void(const std::string&)> streamCallback, llmcpp::CancellationToken cancel) {
+    validateEndpoint(endpoint);
+    validateRequestBody(requestBody);
+
+    // Not retried: chunks already handed to the callback cannot be taken back
+    return std::async(std::launch::async, [this, endpoint, requestBody, streamCallback, cancel]() {
+        return impl_->postStream(endpoint, requestBody.dump(), streamCallback, cancel);
     });
 }
 
@@ -252,7 +380,9 @@ void OpenAIHttpClient::removeDefaultHeader(const std::string& key) { defaultHead
 std::unordered_map<std::string, std::string> OpenAIHttpClient::buildHeaders(
     const json& requestBody [[maybe_unused]]) const {
     std::unordered_map<std::string, std::string> headers;
-    headers["Authorization"] = "Bearer " + config_.apiKey;
+    if (!config_.apiKey.empty()) {
+        headers["Authorization"] = "Bearer " + config_.apiKey;
+    }
     headers["User-Agent"] = userAgent_;
 
     if (!config_.organization.empty()) {
@@ -263,7 +393,10 @@ std::unordered_map<std::string, std::string> OpenAIHttpClient::buildHeaders(
         headers["OpenAI-Project"] = config_.project;
     }
 
-    // Add default headers
+    // Configured headers, then per-client defaults
+    for (const auto& [key, value] : config_.headers) {
+        headers[key] = value;
+    }
     for (const auto& [key, value] : defaultHeaders_) {
         headers[key] = value;
     }
@@ -320,28 +453,48 @@ bool OpenAIHttpClient::isRetryableError(int statusCode) const {
 }
 
 OpenAIHttpClient::HttpResponse OpenAIHttpClient::executeWithRetry(
-    std::function<HttpResponse()> requestFunc) {
+    std::function<HttpResponse()> requestFunc, const llmcpp::CancellationToken& cancel) {
     HttpResponse lastResponse;
+    // Captured before any attempt span becomes current
+    auto* parentSpan = llmcpp::Span::current();
+    int retries = 0;
 
     for (int attempt = 0; attempt <= config_.maxRetries; ++attempt) {
-        lastResponse = requestFunc();
+        retries = attempt;
+        {
+            llmcpp::Span attemptSpan("llm.retry.attempt");
+            attemptSpan.setAttribute("llm.retry.attempt", attempt);
+            lastResponse = requestFunc();
+            attemptSpan.setAttribute("http.status_code", lastResponse.statusCode);
+            if (!lastResponse.success) {
+                attemptSpan.recordError(lastResponse.errorMessage);
+            }
+        }
 
-        if (lastResponse.success || !isRetryableError(lastResponse.statusCode)) {
+        if (lastResponse.success || lastResponse.cancelled ||
+            !isRetryableError(lastResponse.statusCode)) {
             break;
         }
 
-        if (attempt < config_.maxRetries) {
-            waitForRetry(attempt);
+        if (attempt < config_.maxRetries && !waitForRetry(attempt, cancel)) {
+            lastResponse.cancelled = true;
+            lastResponse.errorMessage = "Request cancelled";
+            break;
         }
     }
 
+    if (parentSpan) {
+        parentSpan->setAttribute("llm.retry.count", retries);
+    }
+
     return lastResponse;
 }
 
-void OpenAIHttpClient::waitForRetry(int attemptNumber) const {
+bool OpenAIHttpClient::waitForRetry(int attemptNumber,
+                                    const llmcpp::CancellationToken& cancel) const {
     // Exponential backoff: 1s, 2s, 4s, 8s...
     auto delay = std::chrono::seconds(1 << attemptNumber);
-    std::this_thread::sleep_for(delay);
+    return llmcpp::sleepFor(cancel, delay);
 }
 
 void OpenAIHttpClient::processStreamingData(const std::string& data,
@@ -357,10 +510,8 @@ std::string OpenAIHttpClient::extractStreamingChunk(const std::string& line
 }
 
 void OpenAIHttpClient::validateConfig() const {
-    if (config_.apiKey.empty()) {
-        throw std::invalid_argument("OpenAI API key cannot be empty");
-    }
-
+    // An empty API key is allowed here (OpenAI-compatible local servers); OpenAIClient
+    // requires one for the OpenAI platform
     if (config_.timeoutSeconds <= 0) {
         throw std::invalid_argument("Timeout must be positive");
     }
@@ -1,124 +1,126 @@
 #include "openai/OpenAIMcpUtils.h"
 
+#include <algorithm>
+#include <string_view>
+
 namespace OpenAI {
 namespace McpUtils {
 
-std::vector<McpToolCall> extractMcpCalls(const ResponsesResponse& response) {
-    std::vector<McpToolCall> calls;
-
-    if (response.output.empty()) {
-        return calls;
-    }
+namespace {
 
-    for (const auto& item : response.output) {
-        if (!item.is_object() || !item.contains("type")) {
-            continue;
-        }
+using ItemType = ResponseOutputIndex::ItemType;
 
-        std::string type = item["type"].get<std::string>();
+bool callSucceeded(const json& item) { return !item.contains("error") && item.contains("output"); }
 
-        // Look for mcp_call type items
-        if (type == "mcp_call") {
-            McpToolCall call;
+// Calls fn(item) for each mcp_call naming `tool`, through `index` when one is given
+template <typename Fn>
+void forEachCallOf(const ResponsesResponse& response, const ResponseOutputIndex* index,
+                   std::string_view tool, Fn&& fn) {
+    if (index) {
+        for (size_t pos : index->mcpCalls(tool)) fn(response.output[pos]);
+        return;
+    }
+    ResponseOutputIndex::forEachItem(response.output, nullptr, ItemType::McpCall,
+                                     [&](const json& item) {
+                                         auto name = item.find("name");
+                                         std::string_view called =
+                                             name != item.end() && name->is_string()
+                                                 ? name->get_ref<const std::string&>()
+                                                 : std::string_view();
+                                         if (called == tool) fn(item);
+                                     });
+}
 
-            if (item.contains("id")) {
-                call.id = item["id"].get<std::string>();
-            }
+McpToolCall mcpCallFrom(const json& item) {
+    McpToolCall call;
 
-            if (item.contains("name")) {
-                call.tool = item["name"].get<std::string>();
-            }
+    if (item.contains("id")) {
+        call.id = item["id"].get<std::string>();
+    }
 
-            if (item.contains("input")) {
-                call.input = item["input"];
-            }
+    if (item.contains("name")) {
+        call.tool = item["name"].get<std::string>();
+    }
 
-            // Check for output
-            if (item.contains("output")) {
-                call.output = item["output"];
-                call.success = true;
-            }
+    if (item.contains("input")) {
+        call.input = item["input"];
+    }
 
-            // Check for error
-            if (item.contains("error")) {
-                call.error = item["error"].is_string() ? item["error"].get<std::string>()
-                                                       : item["error"].dump();
-                call.success = false;
-            }
+    // Check for output
+    if (item.contains("output")) {
+        call.output = item["output"];
+        call.success = true;
+    }
 
-            calls.push_back(call);
-        }
+    // Check for error
+    if (item.contains("error")) {
+        call.error =
+            item["error"].is_string() ? item["error"].get<std::string>() : item["error"].dump();
+        call.success = false;
     }
 
+    return call;
+}
+
+std::vector<McpToolCall> extractMcpCalls(const ResponsesResponse& response,
+                                         const ResponseOutputIndex* index) {
+    std::vector<McpToolCall> calls;
+    if (index) {
+        calls.reserve(index->items(ItemType::McpCall).size());
+    }
+    ResponseOutputIndex::forEachItem(response.output, index, ItemType::McpCall,
+                                     [&](const json& item) { calls.push_back(mcpCallFrom(item)); });
     return calls;
 }
 
-bool wasToolCalled(const ResponsesResponse& response, const std::string& toolName) {
-    auto calls = extractMcpCalls(response);
-    for (const auto& call : calls) {
-        if (call.tool == toolName) {
-            return true;
-        }
+bool wasToolCalled(const ResponsesResponse& response, const ResponseOutputIndex* index,
+                   const std::string& toolName) {
+    if (index) {
+        return !index->mcpCalls(toolName).empty();
     }
-    return false;
+    bool called = false;
+    forEachCallOf(response, nullptr, toolName, [&](const json&) { called = true; });
+    return called;
 }
 
-std::optional<json> getToolOutput(const ResponsesResponse& response, const std::string& toolName) {
-    auto calls = extractMcpCalls(response);
-    for (const auto& call : calls) {
-        if (call.tool == toolName && call.output.has_value()) {
-            return call.output.value();
+std::optional<json> getToolOutput(const ResponsesResponse& response,
+                                  const ResponseOutputIndex* index, const std::string& toolName) {
+    std::optional<json> output;
+    forEachCallOf(response, index, toolName, [&](const json& item) {
+        if (!output && item.contains("output")) {
+            output = item["output"];
         }
-    }
-    return std::nullopt;
+    });
+    return output;
 }
 
 std::vector<json> getAllToolOutputs(const ResponsesResponse& response,
+                                    const ResponseOutputIndex* index,
                                     const std::string& toolName) {
     std::vector<json> outputs;
-    auto calls = extractMcpCalls(response);
-
-    for (const auto& call : calls) {
-        if (call.tool == toolName && call.output.has_value()) {
-            outputs.push_back(call.output.value());
+    forEachCallOf(response, index, toolName, [&](const json& item) {
+        if (item.contains("output")) {
+            outputs.push_back(item["output"]);
         }
-    }
-
+    });
     return outputs;
 }
 
-bool wereMcpToolsListed(const ResponsesResponse& response) {
-    if (response.output.empty()) {
-        return false;
-    }
-
-    for (const auto& item : response.output) {
-        if (item.is_object() && item.contains("type")) {
-            std::string type = item["type"].get<std::string>();
-            if (type == "mcp_list_tools") {
-                return true;
-            }
-        }
-    }
-
-    return false;
+bool wereMcpToolsListed(const ResponsesResponse& response, const ResponseOutputIndex* index) {
+    bool listed = false;
+    ResponseOutputIndex::forEachItem(response.output, index, ItemType::McpListTools,
+                                     [&](const json&) { listed = true; });
+    return listed;
 }
 
-std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response) {
+std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response,
+                                              const ResponseOutputIndex* index) {
     std::vector<std::string> tools;
-
-    if (response.output.empty()) {
-        return tools;
-    }
-
-    for (const auto& item : response.output) {
-        if (!item.is_object() || !item.contains("type")) {
-            continue;
-        }
-
-        std::string type = item["type"].get<std::string>();
-
-        if (type == "mcp_list_tools" && item.contains("tools") && item["tools"].is_array()) {
+    ResponseOutputIndex::forEachItem(
+        response.output, index, ItemType::McpListTools, [&](const json& item) {
+            if (!item.contains("tools") || !item["tools"].is_array()) {
+                return;
+            }
             for (const auto& tool : item["tools"]) {
                 if (tool.is_object() && tool.contains("name")) {
                     tools.push_back(tool["name"].get<std::string>());
@@ -126,57 +128,96 @@ std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response)
                     tools.push_back(tool.get<std::string>());
                 }
             }
-        }
-    }
-
+        });
     return tools;
 }
 
+}  // namespace
+
+std::vector<McpToolCall> extractMcpCalls(const ResponsesResponse& response) {
+    return extractMcpCalls(response, nullptr);
+}
+
+std::vector<McpToolCall> extractMcpCalls(const ResponsesResponse& response,
+                                         const ResponseOutputIndex& index) {
+    return extractMcpCalls(response, &index);
+}
+
+bool wasToolCalled(const ResponsesResponse& response, const std::string& toolName) {
+    return wasToolCalled(response, nullptr, toolName);
+}
+
+bool wasToolCalled(const ResponsesResponse& response, const ResponseOutputIndex& index,
+                   const std::string& toolName) {
+    return wasToolCalled(response, &index, toolName);
+}
+
+std::optional<json> getToolOutput(const ResponsesResponse& response, const std::string& toolName) {
+    return getToolOutput(response, nullptr, toolName);
+}
+
+std::optional<json> getToolOutput(const ResponsesResponse& response,
+                                  const ResponseOutputIndex& index, const std::string& toolName) {
+    return getToolOutput(response, &index, toolName);
+}
+
+std::vector<json> getAllToolOutputs(const ResponsesResponse& response,
+                                    const std::string& toolName) {
+    return getAllToolOutputs(response, nullptr, toolName);
+}
+
+std::vector<json> getAllToolOutputs(const ResponsesResponse& response,
+                                    const ResponseOutputIndex& index,
+                                    const std::string& toolName) {
+    return getAllToolOutputs(response, &index, toolName);
+}
+
+bool wereMcpToolsListed(const ResponsesResponse& response) {
+    return wereMcpToolsListed(response, nullptr);
+}
+
+bool wereMcpToolsListed(const ResponsesResponse& response, const ResponseOutputIndex& index) {
+    return wereMcpToolsListed(response, &index);
+}
+
+std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response) {
+    return getAvailableMcpTools(response, nullptr);
+}
+
+std::vector<std::string> getAvailableMcpTools(const ResponsesResponse& response,
+                                              const ResponseOutputIndex& index) {
+    return getAvailableMcpTools(response, &index);
+}
+
 bool wereAllToolsCalled(const ResponsesResponse& response,
                         const std::vector<std::string>& expectedTools) {
-    auto calls = extractMcpCalls(response);
-
-    for (const auto& expectedTool : expectedTools) {
-        bool found = false;
-        for (const auto& call : calls) {
-            if (call.tool == expectedTool) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            return false;
-        }
-    }
+    // One lookup per tool: worth indexing even for a single call
+    return wereAllToolsCalled(response, response.outputIndex(), expectedTools);
+}
 
-    return true;
+bool wereAllToolsCalled(const ResponsesResponse&, const ResponseOutputIndex& index,
+                        const std::vector<std::string>& expectedTools) {
+    return std::all_of(expectedTools.begin(), expectedTools.end(),
+                       [&](const std::string& tool) { return !index.mcpCalls(tool).empty(); });
 }
 
 json getMcpUsageStats(const ResponsesResponse& response) {
-    auto calls = extractMcpCalls(response);
+    return getMcpUsageStats(response, response.outputIndex());
+}
 
-    int totalCalls = static_cast<int>(calls.size());
-    int successfulCalls = 0;
-    int failedCalls = 0;
-    std::vector<std::string> toolsUsed;
-
-    for (const auto& call : calls) {
-        if (call.success) {
-            successfulCalls++;
-        } else {
-            failedCalls++;
-        }
+json getMcpUsageStats(const ResponsesResponse& response, const ResponseOutputIndex& index) {
+    const auto calls = index.items(ItemType::McpCall);
 
-        // Track unique tools used
-        if (std::find(toolsUsed.begin(), toolsUsed.end(), call.tool) == toolsUsed.end()) {
-            toolsUsed.push_back(call.tool);
-        }
-    }
+    int totalCalls = static_cast<int>(calls.size());
+    int successfulCalls = static_cast<int>(
+        std::count_if(calls.begin(), calls.end(),
+                      [&](size_t pos) { return callSucceeded(response.output[pos]); }));
+    int failedCalls = totalCalls - successfulCalls;
 
     return json{{"total_calls", totalCalls},
                 {"successful_calls", successfulCalls},
                 {"failed_calls", failedCalls},
-                {"tools_used", toolsUsed}};
+                {"tools_used", index.mcpToolsUsed()}};
 }
 
 }  // namespace McpUtils
@@ -1,18 +1,29 @@
 #include "openai/OpenAIResponsesApi.h"
 
 #include <future>
-#include <iostream>
 #include <stdexcept>
 
 #include "openai/OpenAIHttpClient.h"
+#include "openai/OpenAIStrictSchema.h"
 #include "core/LLMTypes.h"  // Include for complete type definitions
+#include "core/Logger.h"
+#include "core/ModelCatalog.h"
+#include "core/Tracing.h"
 
 OpenAIResponsesApi::OpenAIResponsesApi(std::shared_ptr<OpenAIHttpClient> httpClient)
     : httpClient_(std::move(httpClient)) {}
 
 
 // Core Responses API methods
-OpenAI::ResponsesResponse OpenAIResponsesApi::create(const OpenAI::ResponsesRequest& request) {
+OpenAI::ResponsesResponse OpenAIResponsesApi::create(const OpenAI::ResponsesRequest& request,
+                                                     const llmcpp::CancellationToken& cancel) {
+    // Strict structured outputs: normalize once per interned schema and reject incompatible
+    // schemas here (std::invalid_argument) instead of with a 400 from the API
+    llmcpp::SchemaRef outputSchema = request.text ? request.text->schema() : nullptr;
+    if (outputSchema && request.text->strict()) {
+        outputSchema = OpenAI::strictSchemaFor(outputSchema);
+    }
+
     try {
         // Preprocess the request
         json requestJson = preprocessRequest(request);
@@ -25,15 +36,21 @@ OpenAI::ResponsesResponse OpenAIResponsesApi::create(const OpenAI::ResponsesRequ
 
         // Make the HTTP request
         std::string url = buildCreateUrl();
-        auto httpResponse = httpClient_->post(url, requestJson);
+        auto httpResponse = httpClient_->postSerialized(
+            url, request.spliceSchema(requestJson.dump(), outputSchema), cancel);
 
+        if (httpResponse.cancelled) {
+            throw llmcpp::OperationCancelled();
+        }
         if (!httpResponse.success) {
-            std::cerr << "❌ HTTP request failed! Status: " << httpResponse.statusCode << std::endl;
-            std::cerr << "❌ HTTP response body: " << httpResponse.body << std::endl;
+            LLMCPP_LOG_ERROR("openai.responses", "HTTP request failed",
+                             {{"status", httpResponse.statusCode}, {"body", httpResponse.body}});
             throw std::runtime_error("HTTP request failed: " + httpResponse.errorMessage);
         }
 
         // Parse the JSON response
+        llmcpp::Span parseSpan("llm.response.parse");
+        parseSpan.setAttribute("llm.response.body_size", httpResponse.body.size());
         json responseJson = json::parse(httpResponse.body);
 
         // Extra debug for GPT-5 incomplete
@@ -41,11 +58,10 @@ OpenAI::ResponsesResponse OpenAIResponsesApi::create(const OpenAI::ResponsesRequ
             auto model = safeGetRequiredJson<std::string>(responseJson, "model");
             auto status = safeGetJson(responseJson, "status", std::string(""));
             if (model == "gpt-5" && status != "completed") {
-                std::cerr << "⚠️ GPT-5 non-completed status: " << status << std::endl;
-                if (responseJson.contains("incomplete_details")) {
-                    std::cerr << "⚠️ Incomplete details: "
-                              << responseJson["incomplete_details"].dump(2) << std::endl;
-                }
+                LLMCPP_LOG_WARN("openai.responses", "GPT-5 non-completed status",
+                                {{"status", status},
+                                 {"incomplete_details",
+                                  safeGetJson(responseJson, "incomplete_details", json())}});
             }
         } catch (...) {}
 
@@ -60,28 +76,41 @@ OpenAI::ResponsesResponse OpenAIResponsesApi::create(const OpenAI::ResponsesRequ
 
         // Post-process the response
         postprocessResponse(response);
+        parseSpan.end();
 
         return response;
 
+    } catch (const llmcpp::OperationCancelled&) {
+        throw;
     } catch (const json::exception& e) {
-        std::cerr << "❌ JSON parsing error: " << e.what() << std::endl;
+        LLMCPP_LOG_ERROR("openai.responses", "JSON parsing error", {{"error", e.what()}});
         throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
     } catch (const std::exception& e) {
-        std::cerr << "❌ Exception: " << e.what() << std::endl;
+        LLMCPP_LOG_ERROR("openai.responses", "Request failed", {{"error", e.what()}});
         throw std::runtime_error("API call failed: " + std::string(e.what()));
     }
 }
 
 std::future<OpenAI::ResponsesResponse> OpenAIResponsesApi::createAsync(
     const OpenAI::ResponsesRequest& request,
-    std::function<void(const OpenAI::ResponsesResponse&)> callback) {
-    return std::async(std::launch::async, [this, request, callback]() {
+    std::function<void(const OpenAI::ResponsesResponse&)> callback,
+    llmcpp::CancellationToken cancel) {
+    return std::async(std::launch::async, [this, request, callback, cancel]() {
         try {
-            auto response = create(request);
+            auto response = create(request, cancel);
             if (callback) {
                 callback(response);
             }
             return response;
+        } catch (const llmcpp::OperationCancelled& e) {
+            OpenAI::ResponsesResponse cancelledResponse;
+            cancelledResponse.status = OpenAI::ResponseStatus::Cancelled;
+            cancelledResponse.error = json{{"message", e.what()}};
+
+            if (callback) {
+                callback(cancelledResponse);
+            }
+            return cancelledResponse;
         } catch (const std::exception& e) {
             // Create error response
             OpenAI::ResponsesResponse errorResponse;
@@ -104,15 +133,21 @@ std::future<OpenAI::ResponsesResponse> OpenAIResponsesApi::createStreaming(
 }
 
 // Response management methods
-OpenAI::ResponsesResponse OpenAIResponsesApi::retrieve(const std::string& responseId) {
+OpenAI::ResponsesResponse OpenAIResponsesApi::retrieve(const std::string& responseId,
+                                                       const llmcpp::CancellationToken& cancel) {
     try {
         std::string url = buildRetrieveUrl(responseId);
-        auto httpResponse = httpClient_->get(url);
+        auto httpResponse = httpClient_->get(url, cancel);
 
+        if (httpResponse.cancelled) {
+            throw llmcpp::OperationCancelled();
+        }
         if (!httpResponse.success) {
             throw std::runtime_error("HTTP request failed: " + httpResponse.errorMessage);
         }
 
+        llmcpp::Span parseSpan("llm.response.parse");
+        parseSpan.setAttribute("llm.response.body_size", httpResponse.body.size());
         json responseJson = json::parse(httpResponse.body);
 
         // Check for API errors using safe JSON function
@@ -123,9 +158,12 @@ OpenAI::ResponsesResponse OpenAIResponsesApi::retrieve(const std::string& respon
 
         auto response = processResponse(responseJson);
         postprocessResponse(response);
+        parseSpan.end();
 
         return response;
 
+    } catch (const llmcpp::OperationCancelled&) {
+        throw;
     } catch (const json::exception& e) {
         throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
     } catch (const std::exception& e) {
@@ -133,9 +171,29 @@ OpenAI::ResponsesResponse OpenAIResponsesApi::retrieve(const std::string& respon
     }
 }
 
-OpenAI::ResponsesResponse OpenAIResponsesApi::cancel(const std::string& responseId
-                                                     [[maybe_unused]]) {
-    throw std::runtime_error("OpenAIResponsesApi::cancel not yet implemented");
+OpenAI::ResponsesResponse OpenAIResponsesApi::cancel(const std::string& responseId) {
+    try {
+        auto httpResponse = httpClient_->post(buildCancelUrl(responseId), json::object());
+
+        if (!httpResponse.success) {
+            throw std::runtime_error("HTTP request failed: " + httpResponse.errorMessage);
+        }
+
+        json responseJson = json::parse(httpResponse.body);
+        auto error = safeGetOptionalJson<json>(responseJson, "error");
+        if (error.has_value()) {
+            handleApiError(responseJson);
+        }
+
+        auto response = processResponse(responseJson);
+        postprocessResponse(response);
+        return response;
+
+    } catch (const json::exception& e) {
+        throw std::runtime_error("JSON parsing error: " + std::string(e.what()));
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Cancel failed: " + std::string(e.what()));
+    }
 }
 
 bool OpenAIResponsesApi::deleteResponse(const std::string& responseId [[maybe_unused]]) {
@@ -152,13 +210,11 @@ bool OpenAIResponsesApi::isProcessing(const std::string& responseId [[maybe_unus
     throw std::runtime_error("OpenAIResponsesApi::isProcessing not yet implemented");
 }
 
-OpenAI::ResponsesResponse OpenAIResponsesApi::waitForCompletion(const std::string& responseId
-                                                                [[maybe_unused]],
-                                                                int timeoutSeconds [[maybe_unused]],
-                                                                int pollIntervalSeconds
-                                                                [[maybe_unused]]) {
+OpenAI::ResponsesResponse OpenAIResponsesApi::waitForCompletion(
+    const std::string& responseId, int timeoutSeconds, int pollIntervalSeconds,
+    const llmcpp::CancellationToken& cancel) {
     const int maxAttempts = std::max(1, timeoutSeconds / std::max(1, pollIntervalSeconds));
-    return pollForCompletion(responseId, maxAttempts, pollIntervalSeconds);
+    return pollForCompletion(responseId, maxAttempts, pollIntervalSeconds, cancel);
 }
 
 std::future<OpenAI::ResponsesResponse> OpenAIResponsesApi::resumeStreaming(
@@ -168,17 +224,25 @@ std::future<OpenAI::ResponsesResponse> OpenAIResponsesApi::resumeStreaming(
 }
 
 OpenAI::ResponsesResponse OpenAIResponsesApi::continueConversation(
-    const std::string& previousResponseId [[maybe_unused]],
-    const OpenAI::ResponsesInput& newInput [[maybe_unused]],
-    const std::optional<std::vector<OpenAI::ToolVariant>>& tools [[maybe_unused]]) {
-    throw std::runtime_error("OpenAIResponsesApi::continueConversation not yet implemented");
+    const std::string& previousResponseId, const OpenAI::ResponsesInput& newInput,
+    const std::optional<std::vector<OpenAI::ToolVariant>>& tools) {
+    // Every request must name a model; reuse the one that produced the previous response.
+    // Tools and instructions are not inherited, so pass `tools` again if the model needs them.
+    OpenAI::ResponsesRequest request;
+    request.model = retrieve(previousResponseId).model;
+    request.previousResponseId = previousResponseId;
+    request.input = newInput;
+    if (tools.has_value()) {
+        request.tools = *tools;
+    }
+    return create(request);
 }
 
 OpenAI::ResponsesResponse OpenAIResponsesApi::forkConversation(
-    const std::string& forkFromResponseId [[maybe_unused]],
-    const OpenAI::ResponsesInput& newInput [[maybe_unused]],
-    const std::optional<std::vector<OpenAI::ToolVariant>>& tools [[maybe_unused]]) {
-    throw std::runtime_error("OpenAIResponsesApi::forkConversation not yet implemented");
+    const std::string& forkFromResponseId, const OpenAI::ResponsesInput& newInput,
+    const std::optional<std::vector<OpenAI::ToolVariant>>& tools) {
+    // Stored responses are immutable, so continuing from an earlier one forks the history
+    return continueConversation(forkFromResponseId, newInput, tools);
 }
 
 OpenAI::ResponsesResponse OpenAIResponsesApi::approveMcpRequest(const std::string& responseId
@@ -190,9 +254,12 @@ OpenAI::ResponsesResponse OpenAIResponsesApi::approveMcpRequest(const std::strin
 }
 
 OpenAI::ResponsesResponse OpenAIResponsesApi::submitFunctionOutputs(
-    const std::string& responseId [[maybe_unused]],
-    const std::vector<OpenAI::FunctionCallOutput>& outputs [[maybe_unused]]) {
-    throw std::runtime_error("OpenAIResponsesApi::submitFunctionOutputs not yet implemented");
+    const std::string& responseId, const std::vector<OpenAI::FunctionCallOutput>& outputs) {
+    OpenAI::ResponsesRequest request;
+    request.model = retrieve(responseId).model;
+    request.previousResponseId = responseId;
+    request.functionOutputs = outputs;
+    return create(request);
 }
 
 // Configuration and validation
@@ -205,9 +272,7 @@ bool OpenAIResponsesApi::validateRequest(const OpenAI::ResponsesRequest& request
     }
 
     // Validate model is supported
-    auto supportedModels = getSupportedModels();
-    if (std::find(supportedModels.begin(), supportedModels.end(), request.model) ==
-        supportedModels.end()) {
+    if (!llmcpp::modelSupports(request.model, llmcpp::ModelFeature::ResponsesApi)) {
         errorMessage = "Model '" + request.model + "' is not supported for Responses API";
         return false;
     }
@@ -263,9 +328,7 @@ std::vector<std::string> OpenAIResponsesApi::getSupportedModels() const {
 }
 
 bool OpenAIResponsesApi::supportsBackgroundProcessing(const std::string& model) const {
-    // Most reasoning models support background processing
-    return model.find("o1") != std::string::npos || model.find("o3") != std::string::npos ||
-           model.find("o4") != std::string::npos;
+    return llmcpp::modelSupports(model, llmcpp::ModelFeature::Background);
 }
 
 bool OpenAIResponsesApi::supportsStreaming(const std::string& model [[maybe_unused]]) const {
@@ -274,9 +337,7 @@ bool OpenAIResponsesApi::supportsStreaming(const std::string& model [[maybe_unus
 }
 
 bool OpenAIResponsesApi::supportsTools(const std::string& model) const {
-    // Most modern models support tools
-    return model.find("gpt-4") != std::string::npos || model.find("o1") != std::string::npos ||
-           model.find("o3") != std::string::npos || model.find("o4") != std::string::npos;
+    return llmcpp::modelSupports(model, llmcpp::ModelFeature::Tools);
 }
 
 bool OpenAIResponsesApi::supportsImageGeneration(const std::string& model) const {
@@ -294,9 +355,7 @@ bool OpenAIResponsesApi::supportsWebSearch(const std::string& model) const {
 }
 
 bool OpenAIResponsesApi::supportsMcp(const std::string& model) const {
-    // MCP is supported by newer models
-    return model.find("gpt-4.1") != std::string::npos || model.find("o3") != std::string::npos ||
-           model.find("o4") != std::string::npos;
+    return llmcpp::modelSupports(model, llmcpp::ModelFeature::Mcp);
 }
 
 // Private helper methods implementation
@@ -357,11 +416,10 @@ void OpenAIResponsesApi::handleApiError(const json& errorResponse) const {
 }
 
 json OpenAIResponsesApi::preprocessRequest(const OpenAI::ResponsesRequest& request) const {
-    auto requestJson = request.toJson();
+    // The structured-output schema is spliced in as pre-serialized bytes when posting
+    auto requestJson = request.toJson(/*schemaPlaceholder=*/true);
 
-    // Debug: Log the actual request being sent
-    std::cout << "🔍 DEBUG: Actual JSON being sent to Responses API:" << std::endl;
-    std::cout << requestJson.dump(2) << std::endl;
+    LLMCPP_LOG_DEBUG("openai.responses", "Sending Responses API request", {{"body", requestJson}});
 
     return requestJson;
 }
@@ -410,20 +468,31 @@ void OpenAIResponsesApi::extractConvenienceFields(OpenAI::ResponsesResponse& res
     }
 }
 
-OpenAI::ResponsesResponse OpenAIResponsesApi::pollForCompletion(const std::string& responseId
-                                                                [[maybe_unused]],
-                                                                int maxAttempts [[maybe_unused]],
-                                                                int intervalSeconds
-                                                                [[maybe_unused]]) {
-    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
-        auto resp = retrieve(responseId);
-        if (resp.status == OpenAI::ResponseStatus::Completed ||
-            resp.status == OpenAI::ResponseStatus::Failed ||
-            resp.status == OpenAI::ResponseStatus::Cancelled) {
-            return resp;
+OpenAI::ResponsesResponse OpenAIResponsesApi::pollForCompletion(
+    const std::string& responseId, int maxAttempts, int intervalSeconds,
+    const llmcpp::CancellationToken& cancel) {
+    try {
+        for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+            auto resp = retrieve(responseId, cancel);
+            if (resp.status == OpenAI::ResponseStatus::Completed ||
+                resp.status == OpenAI::ResponseStatus::Failed ||
+                resp.status == OpenAI::ResponseStatus::Cancelled) {
+                return resp;
+            }
+            if (!llmcpp::sleepFor(cancel, std::chrono::seconds(std::max(1, intervalSeconds)))) {
+                throw llmcpp::OperationCancelled();
+            }
+        }
+        // Final retrieve before giving up
+        return retrieve(responseId, cancel);
+    } catch (const llmcpp::OperationCancelled&) {
+        // Nobody is waiting for the result any more: stop paying for its generation
+        try {
+            this->cancel(responseId);
+        } catch (const std::exception& e) {
+            LLMCPP_LOG_WARN("openai.responses", "Remote cancel failed",
+                            {{"id", responseId}, {"error", e.what()}});
         }
-        std::this_thread::sleep_for(std::chrono::seconds(std::max(1, intervalSeconds)));
+        throw;
     }
-    // Final retrieve before giving up
-    return retrieve(responseId);
 }
@@ -0,0 +1,324 @@
+#include "openai/OpenAIStrictSchema.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "core/Logger.h"
+
+namespace OpenAI {
+
+namespace {
+
+// Constructs strict mode rejects outright
+const std::unordered_set<std::string>& rejectedKeywords() {
+    static const std::unordered_set<std::string> keywords = {
+        "allOf",           "not",           "if",           "then",
+        "else",            "dependentRequired", "dependentSchemas", "patternProperties",
+        "unevaluatedProperties", "propertyNames", "prefixItems",  "unevaluatedItems"};
+    return keywords;
+}
+
+// Type-specific constraints strict mode does not enforce; dropped or reported
+const std::unordered_set<std::string>& unsupportedKeywords() {
+    static const std::unordered_set<std::string> keywords = {
+        "minLength",   "maxLength",   "minProperties", "maxProperties",
+        "uniqueItems", "contains",    "minContains",   "maxContains"};
+    return keywords;
+}
+
+std::string escapeToken(const std::string& token) {
+    std::string out;
+    for (char c : token) {
+        if (c == '~') {
+            out += "~0";
+        } else if (c == '/') {
+            out += "~1";
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+class Normalizer {
+   public:
+    Normalizer(const StrictSchemaOptions& options, std::vector<StrictSchemaIssue>& issues)
+        : options_(options), issues_(issues) {}
+
+    void normalizeRoot(json& schema) {
+        if (!schema.is_object()) {
+            error("", "type", "root schema must be an object schema");
+            return;
+        }
+        if (schema.contains("anyOf")) {
+            error("", "anyOf", "root schema must not be anyOf");
+        }
+        if (schema.value("type", json("object")) != "object") {
+            error("", "type", "root schema must have type \"object\"");
+        }
+        normalize(schema, "", 0);
+
+        if (propertyCount_ > options_.maxProperties) {
+            error("", "properties",
+                  "schema has " + std::to_string(propertyCount_) + " properties (limit " +
+                      std::to_string(options_.maxProperties) + ")");
+        }
+        if (enumCount_ > options_.maxEnumValues) {
+            error("", "enum",
+                  "schema has " + std::to_string(enumCount_) + " enum values (limit " +
+                      std::to_string(options_.maxEnumValues) + ")");
+        }
+    }
+
+   private:
+    void normalize(json& node, const std::string& path, int depth) {
+        if (!node.is_object()) {
+            error(path, "type", "boolean schemas are not supported");
+            return;
+        }
+
+        for (auto it = node.begin(); it != node.end();) {
+            const std::string& key = it.key();
+            if (rejectedKeywords().count(key)) {
+                error(path, key, "\"" + key + "\" is not supported in strict mode");
+                ++it;
+            } else if (unsupportedKeywords().count(key)) {
+                if (options_.dropUnsupportedKeywords) {
+                    warn(path, key, "dropped unsupported keyword \"" + key + "\"");
+                    it = node.erase(it);
+                } else {
+                    error(path, key, "\"" + key + "\" is not supported in strict mode");
+                    ++it;
+                }
+            } else {
+                ++it;
+            }
+        }
+
+        if (node.contains("enum") && node["enum"].is_array()) {
+            enumCount_ += node["enum"].size();
+        }
+
+        bool isObject = node.contains("properties") || typeIncludes(node, "object");
+        if (isObject) {
+            normalizeObject(node, path, depth + 1);
+        }
+
+        if (node.contains("items")) {
+            if (node["items"].is_array()) {
+                error(path, "items", "tuple-form \"items\" is not supported in strict mode");
+            } else {
+                normalize(node["items"], path + "/items", depth);
+            }
+        }
+
+        if (node.contains("anyOf") && node["anyOf"].is_array()) {
+            auto& branches = node["anyOf"];
+            for (size_t i = 0; i < branches.size(); ++i) {
+                normalize(branches[i], path + "/anyOf/" + std::to_string(i), depth);
+            }
+        }
+
+        for (const char* defsKey : {"$defs", "definitions"}) {
+            if (node.contains(defsKey) && node[defsKey].is_object()) {
+                for (auto& [name, def] : node[defsKey].items()) {
+                    normalize(def, path + "/" + defsKey + "/" + escapeToken(name), depth);
+                }
+            }
+        }
+    }
+
+    void normalizeObject(json& node, const std::string& path, int depth) {
+        if (depth > options_.maxDepth) {
+            error(path, "properties",
+                  "objects nested deeper than " + std::to_string(options_.maxDepth) + " levels");
+        }
+
+        if (!node.contains("additionalProperties")) {
+            node["additionalProperties"] = false;
+        } else if (node["additionalProperties"].is_boolean()) {
+            if (node["additionalProperties"].get<bool>()) {
+                warn(path, "additionalProperties", "additionalProperties set to false");
+                node["additionalProperties"] = false;
+            }
+        } else {
+            error(path, "additionalProperties",
+                  "schema-valued additionalProperties is not supported in strict mode");
+        }
+
+        if (!node.contains("properties")) {
+            node["properties"] = json::object();
+        }
+        auto& properties = node["properties"];
+        propertyCount_ += properties.size();
+
+        std::unordered_set<std::string> required;
+        if (node.contains("required") && node["required"].is_array()) {
+            for (const auto& name : node["required"]) {
+                if (name.is_string()) {
+                    required.insert(name.get<std::string>());
+                }
+            }
+        }
+
+        json allRequired = json::array();
+        for (auto& [name, property] : properties.items()) {
+            std::string propertyPath = path + "/properties/" + escapeToken(name);
+            normalize(property, propertyPath, depth);
+            if (!required.count(name)) {
+                makeNullable(property);
+                warn(propertyPath, "required", "optional property \"" + name + "\" made nullable");
+            }
+            allRequired.push_back(name);
+        }
+        node["required"] = std::move(allRequired);
+    }
+
+    static bool typeIncludes(const json& node, const std::string& type) {
+        if (!node.contains("type")) {
+            return false;
+        }
+        const auto& t = node["type"];
+        if (t.is_string()) {
+            return t == type;
+        }
+        return t.is_array() && std::find(t.begin(), t.end(), json(type)) != t.end();
+    }
+
+    static void makeNullable(json& node) {
+        if (node.contains("type")) {
+            auto& type = node["type"];
+            if (type.is_string() && type != "null") {
+                type = json::array({type, "null"});
+            } else if (type.is_array() && std::find(type.begin(), type.end(), json("null")) == type.end()) {
+                type.push_back("null");
+            }
+            if (node.contains("enum") && node["enum"].is_array()) {
+                auto& values = node["enum"];
+                if (std::find(values.begin(), values.end(), json(nullptr)) == values.end()) {
+                    values.push_back(nullptr);
+                }
+            }
+        } else if (node.contains("anyOf") && node["anyOf"].is_array()) {
+            node["anyOf"].push_back({{"type", "null"}});
+        } else {
+            // $ref, const or untyped enum: wrap in a nullable union
+            json wrapped = {{"anyOf", json::array({node, {{"type", "null"}}})}};
+            if (node.contains("description")) {
+                wrapped["description"] = node["description"];
+            }
+            node = std::move(wrapped);
+        }
+    }
+
+    void warn(const std::string& path, const std::string& keyword, std::string message) {
+        issues_.push_back(
+            {StrictSchemaIssue::Severity::Warning, path, keyword, std::move(message)});
+    }
+
+    void error(const std::string& path, const std::string& keyword, std::string message) {
+        issues_.push_back({StrictSchemaIssue::Severity::Error, path, keyword, std::move(message)});
+    }
+
+    const StrictSchemaOptions& options_;
+    std::vector<StrictSchemaIssue>& issues_;
+    size_t propertyCount_ = 0;
+    size_t enumCount_ = 0;
+};
+
+struct StrictCache {
+    struct Entry {
+        std::weak_ptr<const llmcpp::InternedSchema> source;
+        llmcpp::SchemaRef normalized;
+        std::string error;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<llmcpp::SchemaHash128, Entry, llmcpp::SchemaHash128::Hasher> entries;
+
+    static StrictCache& instance() {
+        static StrictCache cache;
+        return cache;
+    }
+
+    // Forget schemas nobody references any more
+    void sweep() {
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = it->second.source.expired() ? entries.erase(it) : std::next(it);
+        }
+    }
+};
+
+}  // namespace
+
+bool StrictSchemaResult::ok() const {
+    return std::none_of(issues.begin(), issues.end(), [](const StrictSchemaIssue& issue) {
+        return issue.severity == StrictSchemaIssue::Severity::Error;
+    });
+}
+
+std::string StrictSchemaResult::errorSummary() const {
+    std::string out;
+    for (const auto& issue : issues) {
+        if (issue.severity != StrictSchemaIssue::Severity::Error) {
+            continue;
+        }
+        if (!out.empty()) {
+            out += "; ";
+        }
+        out += (issue.path.empty() ? "/" : issue.path) + ": " + issue.message;
+    }
+    return out;
+}
+
+StrictSchemaResult normalizeStrictSchema(const json& schema, const StrictSchemaOptions& options) {
+    StrictSchemaResult result;
+    result.schema = schema;
+    Normalizer(options, result.issues).normalizeRoot(result.schema);
+    return result;
+}
+
+llmcpp::SchemaRef strictSchemaFor(const llmcpp::SchemaRef& schema) {
+    if (!schema) {
+        return schema;
+    }
+
+    auto& cache = StrictCache::instance();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.entries.find(schema->hash());
+        if (it != cache.entries.end() && it->second.source.lock() == schema) {
+            if (!it->second.error.empty()) {
+                throw std::invalid_argument(it->second.error);
+            }
+            return it->second.normalized;
+        }
+    }
+
+    auto result = normalizeStrictSchema(schema->value());
+    StrictCache::Entry entry{schema, nullptr, ""};
+    if (result.ok()) {
+        entry.normalized = llmcpp::SchemaInterner::intern(std::move(result.schema));
+        for (const auto& issue : result.issues) {
+            LLMCPP_LOG_DEBUG("openai.strict", issue.message, {{"path", issue.path}});
+        }
+    } else {
+        entry.error = "Schema is not compatible with OpenAI strict mode: " + result.errorSummary();
+        LLMCPP_LOG_WARN("openai.strict", "Schema rejected locally", {{"error", entry.error}});
+    }
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.entries.size() >= 256) {
+        cache.sweep();
+    }
+    auto& stored = cache.entries[schema->hash()] = std::move(entry);
+    if (!stored.error.empty()) {
+        throw std::invalid_argument(stored.error);
+    }
+    return stored.normalized;
+}
+
+}  // namespace OpenAI
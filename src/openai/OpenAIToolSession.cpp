@@ -0,0 +1,131 @@
+#include "openai/OpenAIToolSession.h"
+
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include "openai/OpenAIClient.h"
+#include "openai/OpenAIStrictSchema.h"
+
+namespace OpenAI {
+
+ResponsesToolSession::ResponsesToolSession(OpenAIClient& client, ResponsesRequest request)
+    : ResponsesToolSession(
+          [&client](const ResponsesRequest& r) { return client.sendResponsesRequest(r); },
+          std::move(request)) {}
+
+ResponsesToolSession::ResponsesToolSession(Sender send, ResponsesRequest request)
+    : send_(std::move(send)), request_(std::move(request)) {
+    if (!request_.store) {
+        throw std::invalid_argument(
+            "ResponsesToolSession: follow-up turns need a stored response (store = true)");
+    }
+}
+
+llmcpp::ToolTurn ResponsesToolSession::start(const std::vector<llmcpp::ToolDefinition>& tools) {
+    for (const auto& definition : tools) {
+        FunctionTool tool;
+        tool.name = definition.name;
+        tool.parameters = definition.parameters;
+        if (!definition.description.empty()) {
+            tool.description = definition.description;
+        }
+        // Strict only when the schema already follows the strict-mode rules; rewriting it
+        // would turn omitted optional arguments into explicit nulls for the handler
+        auto strict = normalizeStrictSchema(definition.parameters);
+        tool.strict = strict.ok() && strict.schema == definition.parameters;
+        request_.tools.push_back(std::move(tool));
+    }
+    return send(request_);
+}
+
+llmcpp::ToolTurn ResponsesToolSession::submit(
+    const std::vector<llmcpp::ToolCallResult>& results) {
+    ResponsesRequest next = request_;
+    next.input.reset();
+    next.previousResponseId = last_.id;
+    next.functionOutputs.reserve(results.size());
+    for (const auto& result : results) {
+        FunctionCallOutput output;
+        output.callId = result.id;
+        output.output = result.isError ? json{{"error", result.outputText()}}.dump()
+                                       : result.outputText();
+        next.functionOutputs.push_back(std::move(output));
+    }
+    return send(next);
+}
+
+llmcpp::ToolTurn ResponsesToolSession::send(const ResponsesRequest& request) {
+    last_ = send_(request);
+    if (last_.hasError()) {
+        throw std::runtime_error("Responses API turn failed: " +
+                                 (last_.error ? last_.error->dump() : toString(last_.status)));
+    }
+
+    llmcpp::ToolTurn turn;
+    turn.text = last_.getOutputText();
+    turn.usage = last_.usage;
+    turn.responseId = last_.id;
+    for (auto& call : last_.getFunctionCalls()) {
+        // Arguments arrive as a JSON-encoded string; anything unparseable is passed on as
+        // is and reported back to the model by the runner
+        json arguments = std::move(call.arguments);
+        if (arguments.is_string()) {
+            auto parsed = json::parse(arguments.get_ref<const std::string&>(), nullptr, false);
+            if (!parsed.is_discarded()) {
+                arguments = std::move(parsed);
+            }
+        }
+        turn.calls.push_back({std::move(call.id), std::move(call.name), std::move(arguments)});
+    }
+    return turn;
+}
+
+namespace {
+
+// Full argument text repeated by a closing event; absent means "keep the buffered deltas"
+std::optional<std::string_view> closingArguments(const json& object) {
+    auto it = object.find("arguments");
+    if (it == object.end() || !it->is_string()) {
+        return std::nullopt;
+    }
+    return it->get_ref<const std::string&>();
+}
+
+}  // namespace
+
+bool applyResponsesStreamEvent(llmcpp::ToolCallAssembler& assembler, const json& event) {
+    auto type = event.find("type");
+    if (type == event.end() || !type->is_string()) {
+        return false;
+    }
+    const auto& name = type->get_ref<const std::string&>();
+    const size_t index = event.value("output_index", size_t{0});
+
+    if (name == "response.function_call_arguments.delta") {
+        assembler.append(index, event.value("delta", std::string()));
+        return true;
+    }
+    if (name == "response.function_call_arguments.done") {
+        assembler.finish(index, closingArguments(event));
+        return true;
+    }
+    if (name == "response.output_item.added" || name == "response.output_item.done") {
+        auto item = event.find("item");
+        if (item == event.end() || !item->is_object() ||
+            item->value("type", std::string()) != "function_call") {
+            return false;
+        }
+        if (name == "response.output_item.added") {
+            assembler.begin(index, item->value("call_id", item->value("id", std::string())),
+                            item->value("name", std::string()));
+        } else {
+            // Already closed by .done unless that event was dropped
+            assembler.finish(index, closingArguments(*item));
+        }
+        return true;
+    }
+    return false;
+}
+
+}  // namespace OpenAI
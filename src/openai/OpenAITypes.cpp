@@ -1,9 +1,75 @@
 #include "openai/OpenAITypes.h"
 
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
 #include "core/LLMTypes.h"  // Include for complete type definitions
+#include "core/PromptCache.h"
 
 namespace OpenAI {
 
+namespace {
+
+// Structured-output format for the request schema, shared by the Responses and Chat mappings
+std::optional<TextOutputConfig> textOutputFromConfig(const LLMRequestConfig& config) {
+    // Use the function name as schema name (like aideas-core does)
+    std::string schemaName = config.functionName;
+    if (schemaName.empty()) {
+        schemaName = "response_schema";
+    }
+
+    if (config.internedSchema) {
+        // Shared, pre-serialized schema: referenced rather than copied
+        return TextOutputConfig(schemaName, config.internedSchema, true);
+    }
+    if (config.schemaObject.has_value()) {
+        return TextOutputConfig(schemaName, config.schemaObject.value(), true);
+    }
+    if (!config.jsonSchema.empty()) {
+        // Fallback to string schema for backward compatibility
+        try {
+            return TextOutputConfig(schemaName, json::parse(config.jsonSchema), true);
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Invalid JSON schema: " + std::string(e.what()));
+        }
+    }
+    return std::nullopt;
+}
+
+std::string stringOrEmpty(const json& value) {
+    return value.is_string() ? value.get<std::string>() : std::string();
+}
+
+// Parsed tool-call arguments; text that is not JSON (e.g. a truncated stream) stays a string
+json toolCallArguments(const json& function) {
+    auto it = function.find("arguments");
+    if (it == function.end() || !it->is_string()) {
+        return it == function.end() ? json::object() : *it;
+    }
+    const auto& text = it->get_ref<const std::string&>();
+    if (text.empty()) {
+        return json::object();
+    }
+    auto parsed = json::parse(text, nullptr, false);
+    return parsed.is_discarded() ? *it : parsed;
+}
+
+ChatCompletionChoice& choiceAt(ChatCompletionResponse& response, int index) {
+    auto it = std::lower_bound(
+        response.choices.begin(), response.choices.end(), index,
+        [](const ChatCompletionChoice& choice, int value) { return choice.index < value; });
+    if (it == response.choices.end() || it->index != index) {
+        ChatCompletionChoice choice;
+        choice.index = index;
+        choice.message.role = "assistant";
+        it = response.choices.insert(it, std::move(choice));
+    }
+    return *it;
+}
+
+}  // namespace
+
 // Implementation of ResponsesRequest::fromLLMRequest moved from header to avoid circular dependency
 ResponsesRequest ResponsesRequest::fromLLMRequest(const LLMRequest& request) {
     ResponsesRequest responsesReq;
@@ -58,6 +124,7 @@ ResponsesRequest ResponsesRequest::fromLLMRequest(const LLMRequest& request) {
         // If both context and prompt are empty, do not set input at all
         responsesReq.input = std::nullopt;
     }
+    responsesReq.previousResponseId = request.previousResponseId;
     responsesReq.toolChoice =
         ToolChoiceMode::Auto;  // Explicitly initialize to fix cppcheck warning
     if (request.config.maxTokens.has_value() && *request.config.maxTokens > 0) {
@@ -67,6 +134,7 @@ ResponsesRequest ResponsesRequest::fromLLMRequest(const LLMRequest& request) {
     if (request.config.temperature.has_value() && *request.config.temperature >= 0.0f) {
         responsesReq.temperature = static_cast<double>(*request.config.temperature);
     }
+    responsesReq.topP = request.config.topP;
 
     // Handle tools from extensions (if present)
     if (hasTools(request.config)) {
@@ -86,29 +154,7 @@ ResponsesRequest ResponsesRequest::fromLLMRequest(const LLMRequest& request) {
     }
 
     // Handle JSON schema for structured outputs
-    if (request.config.schemaObject.has_value()) {
-        // Use the structured schema object directly
-        const json& schemaJson = request.config.schemaObject.value();
-        // Use the function name as schema name (like aideas-core does)
-        std::string schemaName = request.config.functionName;
-        if (schemaName.empty()) {
-            schemaName = "response_schema";
-        }
-        responsesReq.text = TextOutputConfig(schemaName, schemaJson, true);
-    } else if (!request.config.jsonSchema.empty()) {
-        // Fallback to string schema for backward compatibility
-        try {
-            json schemaJson = json::parse(request.config.jsonSchema);
-            // Use the function name as schema name (like aideas-core does)
-            std::string schemaName = request.config.functionName;
-            if (schemaName.empty()) {
-                schemaName = "response_schema";
-            }
-            responsesReq.text = TextOutputConfig(schemaName, schemaJson, true);
-        } catch (const std::exception& e) {
-            throw std::runtime_error("Invalid JSON schema: " + std::string(e.what()));
-        }
-    }
+    responsesReq.text = textOutputFromConfig(request.config);
 
     return responsesReq;
 }
@@ -166,18 +212,51 @@ LLMResponse ResponsesResponse::toLLMResponse(bool expectStructuredOutput) const
     return llmResp;
 }
 
+std::vector<ChatMessage> chatMessagesFromContext(const LLMContext& context) {
+    auto contentText = [](const json& content) {
+        return content.is_string() ? content.get<std::string>() : content.dump();
+    };
+    auto isMessage = [](const json& item) {
+        return item.is_object() && item.contains("role") && item.contains("content");
+    };
+
+    std::vector<ChatMessage> messages;
+    for (const auto& contextItem : context) {
+        if (isMessage(contextItem)) {
+            messages.push_back(ChatMessage{contextItem["role"].get<std::string>(),
+                                           contentText(contextItem["content"]), ""});
+        } else if (contextItem.is_array()) {
+            for (const auto& item : contextItem) {
+                if (isMessage(item)) {
+                    messages.push_back(ChatMessage{item["role"].get<std::string>(),
+                                                   contentText(item["content"]), ""});
+                }
+            }
+        } else {
+            messages.push_back(ChatMessage{"user", contentText(contextItem), ""});
+        }
+    }
+    return messages;
+}
+
 // Implementation of ChatCompletionRequest::fromLLMRequest moved from header to avoid circular
 // dependency
 ChatCompletionRequest ChatCompletionRequest::fromLLMRequest(const LLMRequest& request) {
     ChatCompletionRequest chatReq;
     chatReq.model = request.config.model;
 
-    // Convert prompt to messages
-    if (!request.prompt.empty()) {
-        ChatMessage userMsg;
-        userMsg.role = "user";
-        userMsg.content = request.prompt;
-        chatReq.messages.push_back(userMsg);
+    // Same mapping as the Responses API: with context, the prompt is the system instruction
+    if (request.context.empty()) {
+        if (!request.prompt.empty()) {
+            chatReq.messages.push_back(ChatMessage{"user", request.prompt, ""});
+        }
+    } else {
+        if (!request.prompt.empty()) {
+            chatReq.messages.push_back(ChatMessage{"system", request.prompt, ""});
+        }
+        auto context = chatMessagesFromContext(request.context);
+        chatReq.messages.insert(chatReq.messages.end(), std::make_move_iterator(context.begin()),
+                                std::make_move_iterator(context.end()));
     }
 
     if (request.config.maxTokens.has_value() && *request.config.maxTokens > 0) {
@@ -187,10 +266,99 @@ ChatCompletionRequest ChatCompletionRequest::fromLLMRequest(const LLMRequest& re
     if (request.config.temperature.has_value() && *request.config.temperature >= 0.0f) {
         chatReq.temperature = static_cast<double>(*request.config.temperature);
     }
+    chatReq.topP = request.config.topP;
+    if (request.config.stopSequences && !request.config.stopSequences->empty()) {
+        chatReq.stop = request.config.stopSequences;
+    }
+    // Chat Completions can sample several choices; requested through extensions["n"]
+    if (request.config.extensions.contains("n")) {
+        chatReq.n = request.config.extensions["n"].get<int>();
+    }
 
+    if (hasTools(request.config)) {
+        std::vector<ToolVariant> tools;
+        for (const auto& toolJson : getToolsJson(request.config)) {
+            if (toolJson.value("type", std::string()) == "function") {
+                tools.push_back(FunctionTool::fromJson(toolJson));
+            }
+        }
+        if (!tools.empty()) {
+            chatReq.tools = std::move(tools);
+        }
+    }
+
+    chatReq.text = textOutputFromConfig(request.config);
     return chatReq;
 }
 
+json ChatCompletionRequest::toJson() const {
+    json j = {{"model", model}};
+    json msgs = json::array();
+    for (const auto& msg : messages) {
+        msgs.push_back(msg.toJson());
+    }
+    j["messages"] = msgs;
+    const auto* info = llmcpp::resolveModel(model);
+    const bool sampling = !info || info->supports(llmcpp::ModelFeature::Sampling);
+    if (temperature.has_value() && sampling) {
+        j["temperature"] = llmcpp::canonicalFloat(*temperature);
+    }
+    if (maxTokens.has_value()) j["max_tokens"] = maxTokens.value();
+    if (topP.has_value() && sampling) j["top_p"] = llmcpp::canonicalFloat(*topP);
+    if (n.has_value()) j["n"] = n.value();
+    if (stop.has_value()) j["stop"] = stop.value();
+    if (stream.has_value()) {
+        j["stream"] = stream.value();
+        if (stream.value()) {
+            j["stream_options"] = {{"include_usage", true}};
+        }
+    }
+    if (user.has_value()) j["user"] = user.value();
+
+    if (tools.has_value() && !tools->empty()) {
+        json toolsJson = json::array();
+        for (const auto& tool : *tools) {
+            const auto* function = std::get_if<FunctionTool>(&tool);
+            if (!function) {
+                throw std::invalid_argument("Chat Completions only supports function tools");
+            }
+            // Chat Completions nests the definition under "function"
+            json definition = function->toJson();
+            definition.erase("type");
+            toolsJson.push_back({{"type", "function"}, {"function", std::move(definition)}});
+        }
+        j["tools"] = std::move(toolsJson);
+        if (toolChoice.has_value()) j["tool_choice"] = toString(toolChoice.value());
+    }
+
+    if (text.has_value() && text->schema()) {
+        j["response_format"] = {{"type", "json_schema"},
+                                {"json_schema",
+                                 {{"name", text->name()},
+                                  {"schema", text->schema()->value()},
+                                  {"strict", text->strict()}}}};
+    }
+    return j;
+}
+
+ChatCompletionRequest ChatCompletionRequest::fromJson(const json& j) {
+    ChatCompletionRequest request;
+    request.model = j.value("model", std::string());
+    if (j.contains("messages")) {
+        for (const auto& msg : j["messages"]) {
+            request.messages.push_back(ChatMessage::fromJson(msg));
+        }
+    }
+    if (j.contains("temperature")) request.temperature = j["temperature"].get<float>();
+    if (j.contains("max_tokens")) request.maxTokens = j["max_tokens"].get<int>();
+    if (j.contains("top_p")) request.topP = j["top_p"].get<float>();
+    if (j.contains("n")) request.n = j["n"].get<int>();
+    if (j.contains("stop")) request.stop = j["stop"].get<std::vector<std::string>>();
+    if (j.contains("stream")) request.stream = j["stream"].get<bool>();
+    if (j.contains("user")) request.user = j["user"].get<std::string>();
+    return request;
+}
+
 // Implementation of ChatCompletionRequest::toLLMRequest moved from header to avoid circular
 // dependency
 LLMRequest ChatCompletionRequest::toLLMRequest() const {
@@ -216,12 +384,8 @@ LLMRequest ChatCompletionRequest::toLLMRequest() const {
 
 // Implementation of detectApiType moved from header to avoid circular dependency
 ApiType detectApiType(const LLMRequest& request) {
-    const std::string& model = request.config.model;
-
-    // Check if it's a Responses API model
-    if (std::any_of(
-            RESPONSES_MODELS.begin(), RESPONSES_MODELS.end(),
-            [&model](const std::string& responsesModel) { return model == responsesModel; })) {
+    // Responses API wherever the model supports it
+    if (llmcpp::modelSupports(request.config.model, llmcpp::ModelFeature::ResponsesApi)) {
         return ApiType::RESPONSES;
     }
 
@@ -234,26 +398,120 @@ bool ResponsesResponse::hasError() const {
            status == ResponseStatus::Incomplete;
 }
 
+ResponseOutputIndex::ItemType ResponseOutputIndex::typeOf(const json& item) {
+    if (!item.is_object()) {
+        return ItemType::Other;
+    }
+    auto it = item.find("type");
+    if (it == item.end() || !it->is_string()) {
+        return ItemType::Other;
+    }
+    const auto& type = it->get_ref<const std::string&>();
+    if (type == "message") return ItemType::Message;
+    if (type == "function_call") return ItemType::FunctionCall;
+    if (type == "mcp_call") return ItemType::McpCall;
+    if (type == "text") return ItemType::Text;
+    if (type == "image") return ItemType::Image;
+    if (type == "mcp_list_tools") return ItemType::McpListTools;
+    return ItemType::Other;
+}
+
+ResponseOutputIndex::ResponseOutputIndex(const std::vector<json>& output) {
+    for (size_t i = 0; i < output.size(); ++i) {
+        const auto type = typeOf(output[i]);
+        byType_[static_cast<size_t>(type)].push_back(i);
+        if (type != ItemType::McpCall) {
+            continue;
+        }
+        auto name = output[i].find("name");
+        std::string tool = name != output[i].end() && name->is_string()
+                               ? name->get<std::string>()
+                               : std::string();
+        auto [slot, inserted] = callsByTool_.try_emplace(tool);
+        slot->second.push_back(i);
+        if (inserted) {
+            toolsUsed_.push_back(std::move(tool));
+        }
+    }
+}
+
+std::span<const size_t> ResponseOutputIndex::mcpCalls(std::string_view tool) const {
+    auto it = callsByTool_.find(tool);
+    if (it == callsByTool_.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+namespace {
+
+using ItemType = ResponseOutputIndex::ItemType;
+
+// Text of a message or legacy text item, appended on its own line
+void appendOutputText(const json& item, ItemType type, std::string& result) {
+    if (type == ItemType::Message) {
+        auto content = item.find("content");
+        if (content == item.end() || !content->is_array()) {
+            return;
+        }
+        for (const auto& contentItem : *content) {
+            if (contentItem.contains("type") && contentItem["type"] == "output_text" &&
+                contentItem.contains("text")) {
+                if (!result.empty()) result += "\n";
+                result += contentItem["text"].get<std::string>();
+            }
+        }
+    } else if (item.contains("text")) {
+        if (!result.empty()) result += "\n";
+        result += item["text"].get<std::string>();
+    }
+}
+
+FunctionCall functionCallFrom(const json& item) {
+    FunctionCall call;
+    // call_id pairs the call with its function_call_output; id names the output item
+    if (item.contains("call_id")) {
+        call.id = item["call_id"].get<std::string>();
+    } else if (item.contains("id")) {
+        call.id = item["id"].get<std::string>();
+    }
+    if (item.contains("name")) call.name = item["name"].get<std::string>();
+    if (item.contains("arguments")) call.arguments = item["arguments"];
+    return call;
+}
+
+ImageGenerationCall imageGenerationFrom(const json& item) {
+    ImageGenerationCall img;
+    if (item.contains("url")) img.url = item["url"].get<std::string>();
+    if (item.contains("prompt")) img.prompt = item["prompt"].get<std::string>();
+    return img;
+}
+
+}  // namespace
+
 std::string ResponsesResponse::getOutputText() const {
     std::string result;
     for (const auto& item : output) {
-        // Check if this is a message with content
-        if (item.contains("type") && item["type"] == "message" && item.contains("content")) {
-            const auto& content = item["content"];
-            if (content.is_array()) {
-                for (const auto& contentItem : content) {
-                    if (contentItem.contains("type") && contentItem["type"] == "output_text" &&
-                        contentItem.contains("text")) {
-                        if (!result.empty()) result += "\n";
-                        result += contentItem["text"].get<std::string>();
-                    }
-                }
-            }
+        const auto type = ResponseOutputIndex::typeOf(item);
+        if (type == ItemType::Message || type == ItemType::Text) {
+            appendOutputText(item, type, result);
         }
-        // Also support simple text items (legacy format)
-        else if (item.contains("type") && item["type"] == "text" && item.contains("text")) {
-            if (!result.empty()) result += "\n";
-            result += item["text"].get<std::string>();
+    }
+    return result;
+}
+
+std::string ResponsesResponse::getOutputText(const ResponseOutputIndex& index) const {
+    // Messages and legacy text items, merged back into output order
+    const auto messages = index.items(ItemType::Message);
+    const auto texts = index.items(ItemType::Text);
+    std::string result;
+    auto message = messages.begin();
+    auto text = texts.begin();
+    while (message != messages.end() || text != texts.end()) {
+        if (text == texts.end() || (message != messages.end() && *message < *text)) {
+            appendOutputText(output[*message++], ItemType::Message, result);
+        } else {
+            appendOutputText(output[*text++], ItemType::Text, result);
         }
     }
     return result;
@@ -261,38 +519,67 @@ std::string ResponsesResponse::getOutputText() const {
 
 std::vector<FunctionCall> ResponsesResponse::getFunctionCalls() const {
     std::vector<FunctionCall> calls;
-    for (const auto& item : output) {
-        if (item.contains("type") && item["type"] == "function_call") {
-            FunctionCall call;
-            if (item.contains("name")) call.name = item["name"].get<std::string>();
-            if (item.contains("arguments")) call.arguments = item["arguments"];
-            calls.push_back(call);
-        }
+    ResponseOutputIndex::forEachItem(output, nullptr, ItemType::FunctionCall,
+                                     [&](const json& item) {
+                                         calls.push_back(functionCallFrom(item));
+                                     });
+    return calls;
+}
+
+std::vector<FunctionCall> ResponsesResponse::getFunctionCalls(
+    const ResponseOutputIndex& index) const {
+    const auto positions = index.items(ItemType::FunctionCall);
+    std::vector<FunctionCall> calls;
+    calls.reserve(positions.size());
+    for (size_t pos : positions) {
+        calls.push_back(functionCallFrom(output[pos]));
     }
     return calls;
 }
 
 std::vector<ImageGenerationCall> ResponsesResponse::getImageGenerations() const {
     std::vector<ImageGenerationCall> images;
-    for (const auto& item : output) {
-        if (item.contains("type") && item["type"] == "image") {
-            ImageGenerationCall img;
-            if (item.contains("url")) img.url = item["url"].get<std::string>();
-            if (item.contains("prompt")) img.prompt = item["prompt"].get<std::string>();
-            images.push_back(img);
-        }
+    ResponseOutputIndex::forEachItem(output, nullptr, ItemType::Image, [&](const json& item) {
+        images.push_back(imageGenerationFrom(item));
+    });
+    return images;
+}
+
+std::vector<ImageGenerationCall> ResponsesResponse::getImageGenerations(
+    const ResponseOutputIndex& index) const {
+    const auto positions = index.items(ItemType::Image);
+    std::vector<ImageGenerationCall> images;
+    images.reserve(positions.size());
+    for (size_t pos : positions) {
+        images.push_back(imageGenerationFrom(output[pos]));
     }
     return images;
 }
 
-json ResponsesRequest::toJson() const {
+json ResponsesRequest::toJson(bool schemaPlaceholder) const {
     json j;
     j["model"] = model;
 
-    if (input.has_value()) {
+    if (!functionOutputs.empty()) {
+        // Tool results are input items, so text input becomes a user message ahead of them
+        json items = json::array();
+        if (input.has_value() && input->type == ResponsesInput::Type::String) {
+            items.push_back({{"role", "user"}, {"content", input->textInput}});
+        } else if (input.has_value()) {
+            items = input->toJson();
+        }
+        for (const auto& output : functionOutputs) {
+            items.push_back(output.toJson());
+        }
+        j["input"] = std::move(items);
+    } else if (input.has_value()) {
         j["input"] = input->toJson();
     }
 
+    if (!previousResponseId.empty()) {
+        j["previous_response_id"] = previousResponseId;
+    }
+
     if (!include.empty()) {
         j["include"] = include;
     }
@@ -306,7 +593,7 @@ json ResponsesRequest::toJson() const {
     }
 
     if (text.has_value()) {
-        j["text"] = text->toJson();
+        j["text"] = text->toJson(schemaPlaceholder);
     }
 
     // Add tool choice
@@ -327,14 +614,15 @@ json ResponsesRequest::toJson() const {
         j["tools"] = toolsArray;
     }
 
-    if (topP.has_value()) {
-        j["top_p"] = topP.value();
+    // Reasoning models reject sampling parameters; unknown models get them as given
+    const auto* info = llmcpp::resolveModel(model);
+    const bool sampling = !info || info->supports(llmcpp::ModelFeature::Sampling);
+    if (topP.has_value() && sampling) {
+        j["top_p"] = llmcpp::canonicalFloat(*topP);
     }
 
-    // Filter out temperature for reasoning models (o3, o3-mini)
-    bool isReasoningModel = (model.find("o3") != std::string::npos);
-    if (temperature.has_value() && !isReasoningModel) {
-        j["temperature"] = temperature.value();
+    if (temperature.has_value() && sampling) {
+        j["temperature"] = llmcpp::canonicalFloat(*temperature);
     }
 
     if (!user.empty()) {
@@ -358,6 +646,41 @@ json ResponsesRequest::toJson() const {
     return j;
 }
 
+llmcpp::PromptPrefix ResponsesRequest::staticPrefix() const {
+    json toolsJson = json::array();
+    for (const auto& tool : tools) {
+        toolsJson.push_back(std::visit([](const auto& t) { return t.toJson(); }, tool));
+    }
+    // The schema is represented by its placeholder, which embeds the schema hash
+    json textJson = text.has_value() ? text->toJson(true) : json();
+    return llmcpp::PromptPrefix::of(json::array({toolsJson, instructions, textJson}));
+}
+
+std::string ResponsesRequest::spliceSchema(std::string body) const {
+    return spliceSchema(std::move(body), text.has_value() ? text->schema() : nullptr);
+}
+
+std::string ResponsesRequest::spliceSchema(std::string body,
+                                           const llmcpp::SchemaRef& schema) const {
+    if (!text.has_value() || !text->schema() || !schema) {
+        return body;
+    }
+    // The token is a plain JSON string, so it appears quoted and unescaped in the dump. An
+    // input or instructions string equal to it would match too, so only the "schema" field
+    // under "text" -> "format" is searched; dumped keys are sorted and unspaced.
+    constexpr std::string_view formatKey = "\"text\":{\"format\":{";
+    const std::string field = "\"schema\":\"" + text->schemaPlaceholderToken() + "\"";
+    auto pos = body.find(formatKey);
+    if (pos != std::string::npos) {
+        pos = body.find(field, pos + formatKey.size());
+    }
+    if (pos != std::string::npos) {
+        constexpr size_t keySize = std::string_view("\"schema\":").size();
+        body.replace(pos + keySize, field.size() - keySize, schema->canonical());
+    }
+    return body;
+}
+
 ResponsesResponse ResponsesResponse::fromJson(const json& j) {
     ResponsesResponse resp;
 
@@ -388,21 +711,8 @@ ResponsesResponse ResponsesResponse::fromJson(const json& j) {
     if (j.contains("reasoning_effort"))
         resp.reasoningEffort = j["reasoning_effort"].get<std::string>();
 
-    // Parse usage - LLMUsage uses inputTokens/outputTokens
-    if (j.contains("usage")) {
-        const auto& usage = j["usage"];
-        // Try both naming conventions
-        if (usage.contains("input_tokens")) {
-            resp.usage.inputTokens = usage["input_tokens"].get<int>();
-        } else if (usage.contains("prompt_tokens")) {
-            resp.usage.inputTokens = usage["prompt_tokens"].get<int>();
-        }
-
-        if (usage.contains("output_tokens")) {
-            resp.usage.outputTokens = usage["output_tokens"].get<int>();
-        } else if (usage.contains("completion_tokens")) {
-            resp.usage.outputTokens = usage["completion_tokens"].get<int>();
-        }
+    if (j.contains("usage") && j["usage"].is_object()) {
+        resp.usage = usageFromJson(j["usage"]);
     }
 
     // Parse output
@@ -417,19 +727,187 @@ ChatCompletionChoice ChatCompletionChoice::fromJson(const json& j) {
     ChatCompletionChoice choice;
 
     if (j.contains("index")) choice.index = j["index"].get<int>();
-    if (j.contains("finish_reason")) choice.finishReason = j["finish_reason"].get<std::string>();
-    if (j.contains("logprobs")) choice.logprobs = j["logprobs"];
+    if (j.contains("finish_reason") && j["finish_reason"].is_string()) {
+        choice.finishReason = j["finish_reason"].get<std::string>();
+    }
+    if (j.contains("logprobs") && !j["logprobs"].is_null()) choice.logprobs = j["logprobs"];
 
-    // Parse message
+    // Parse message; content is null when the model only calls tools
     if (j.contains("message")) {
         const auto& msg = j["message"];
         if (msg.contains("role")) choice.message.role = msg["role"].get<std::string>();
-        if (msg.contains("content")) choice.message.content = msg["content"].get<std::string>();
+        if (msg.contains("content")) choice.message.content = stringOrEmpty(msg["content"]);
+        if (msg.contains("tool_calls") && msg["tool_calls"].is_array()) {
+            choice.toolCalls = msg["tool_calls"];
+        }
     }
 
     return choice;
 }
 
+ChatCompletionResponse ChatCompletionResponse::fromJson(const json& j) {
+    ChatCompletionResponse resp;
+    resp.id = j.value("id", std::string());
+    resp.object = j.value("object", std::string());
+    resp.created = j.value("created", int64_t{0});
+    resp.model = j.value("model", std::string());
+    if (j.contains("system_fingerprint") && j["system_fingerprint"].is_string()) {
+        resp.systemFingerprint = j["system_fingerprint"].get<std::string>();
+    }
+    if (j.contains("choices") && j["choices"].is_array()) {
+        for (const auto& choice : j["choices"]) {
+            resp.choices.push_back(ChatCompletionChoice::fromJson(choice));
+        }
+        std::stable_sort(resp.choices.begin(), resp.choices.end(),
+                         [](const auto& a, const auto& b) { return a.index < b.index; });
+    }
+    if (j.contains("usage") && j["usage"].is_object()) {
+        resp.usage = usageFromJson(j["usage"]);
+    }
+    return resp;
+}
+
+LLMResponse ChatCompletionResponse::toLLMResponse(bool expectStructuredOutput) const {
+    LLMResponse llmResp;
+    llmResp.responseId = id;
+    llmResp.usage = usage;
+    if (choices.empty()) {
+        llmResp.errorMessage = "Chat completion contained no choices";
+        return llmResp;
+    }
+
+    const auto& first = choices.front();
+    if (first.message.content.empty()) {
+        llmResp.result = json::object();
+    } else if (expectStructuredOutput) {
+        // Parse as JSON for structured output
+        llmResp.result = json::parse(first.message.content);
+    } else {
+        llmResp.result = json{{"text", first.message.content}};
+    }
+
+    // Same shape as the Responses API function calls
+    if (first.toolCalls && !first.toolCalls->empty()) {
+        json calls = json::array();
+        for (const auto& call : *first.toolCalls) {
+            const auto& function = call.value("function", json::object());
+            calls.push_back({{"id", call.value("id", std::string())},
+                             {"name", function.value("name", std::string())},
+                             {"arguments", toolCallArguments(function)}});
+        }
+        llmResp.result["function_calls"] = std::move(calls);
+    }
+
+    // Structured results stay schema-shaped; the other choices remain on `choices`
+    if (choices.size() > 1 && !expectStructuredOutput) {
+        json texts = json::array();
+        for (const auto& choice : choices) {
+            texts.push_back(choice.message.content);
+        }
+        llmResp.result["choices"] = std::move(texts);
+    }
+
+    llmResp.success = true;
+    return llmResp;
+}
+
+std::string applyChatCompletionChunk(ChatCompletionResponse& response, const json& chunk) {
+    if (response.id.empty()) response.id = chunk.value("id", std::string());
+    if (response.model.empty()) response.model = chunk.value("model", std::string());
+    if (response.created == 0) response.created = chunk.value("created", int64_t{0});
+    response.object = "chat.completion";
+
+    if (chunk.contains("usage") && chunk["usage"].is_object()) {
+        response.usage = usageFromJson(chunk["usage"]);
+    }
+
+    std::string firstDelta;
+    auto choices = chunk.find("choices");
+    if (choices == chunk.end() || !choices->is_array()) {
+        return firstDelta;
+    }
+    for (const auto& choiceJson : *choices) {
+        auto& choice = choiceAt(response, choiceJson.value("index", 0));
+        if (choiceJson.contains("finish_reason") && choiceJson["finish_reason"].is_string()) {
+            choice.finishReason = choiceJson["finish_reason"].get<std::string>();
+        }
+
+        auto delta = choiceJson.find("delta");
+        if (delta == choiceJson.end() || !delta->is_object()) {
+            continue;
+        }
+        if (delta->contains("content")) {
+            auto text = stringOrEmpty((*delta)["content"]);
+            choice.message.content += text;
+            if (choice.index == 0) {
+                firstDelta += text;
+            }
+        }
+
+        // Tool calls stream as {index, id?, function: {name?, arguments delta}}
+        if (delta->contains("tool_calls") && (*delta)["tool_calls"].is_array()) {
+            if (!choice.toolCalls) {
+                choice.toolCalls = json::array();
+            }
+            auto& calls = *choice.toolCalls;
+            for (const auto& callDelta : (*delta)["tool_calls"]) {
+                // Indexes count up from 0, so a new call is always the next one
+                size_t position = callDelta.value("index", size_t{0});
+                if (position > calls.size()) {
+                    throw std::runtime_error("Tool call index " + std::to_string(position) +
+                                             " skips ahead of " + std::to_string(calls.size()) +
+                                             " streamed calls");
+                }
+                if (position == calls.size()) {
+                    calls.push_back({{"id", ""},
+                                     {"type", "function"},
+                                     {"function", {{"name", ""}, {"arguments", ""}}}});
+                }
+                auto& call = calls[position];
+                if (callDelta.contains("id")) call["id"] = stringOrEmpty(callDelta["id"]);
+                const auto& function = callDelta.value("function", json::object());
+                if (function.contains("name")) {
+                    call["function"]["name"] = stringOrEmpty(function["name"]);
+                }
+                if (function.contains("arguments")) {
+                    call["function"]["arguments"].get_ref<std::string&>().append(
+                        stringOrEmpty(function["arguments"]));
+                }
+            }
+        }
+    }
+    return firstDelta;
+}
+
+LLMUsage usageFromJson(const json& usage) {
+    auto count = [&usage](const char* key) {
+        auto it = usage.find(key);
+        return it != usage.end() && it->is_number_integer() ? it->get<int>() : 0;
+    };
+    auto detail = [&usage](const char* details, const char* key) {
+        auto it = usage.find(details);
+        if (it == usage.end() || !it->is_object()) {
+            return 0;
+        }
+        auto tokens = it->find(key);
+        return tokens != it->end() && tokens->is_number_integer() ? tokens->get<int>() : 0;
+    };
+
+    // Responses names first, then Chat Completions names
+    LLMUsage result;
+    result.inputTokens = usage.contains("input_tokens") ? count("input_tokens")
+                                                         : count("prompt_tokens");
+    result.outputTokens = usage.contains("output_tokens") ? count("output_tokens")
+                                                           : count("completion_tokens");
+    result.cachedInputTokens = usage.contains("input_tokens_details")
+                                   ? detail("input_tokens_details", "cached_tokens")
+                                   : detail("prompt_tokens_details", "cached_tokens");
+    result.reasoningTokens = usage.contains("output_tokens_details")
+                                 ? detail("output_tokens_details", "reasoning_tokens")
+                                 : detail("completion_tokens_details", "reasoning_tokens");
+    return result;
+}
+
 // Helper functions for working with tools in LLMRequestConfig
 void setTools(LLMRequestConfig& config, const std::vector<ToolVariant>& tools) {
     json toolsJson = json::array();
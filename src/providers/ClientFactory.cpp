@@ -1,37 +1,91 @@
 #include "providers/ClientFactory.h"
 
-#include <iostream>
+#include <algorithm>
+#include <map>
+#include <mutex>
 
 #include "anthropic/AnthropicClient.h"
+#include "local/LocalClient.h"
 #include "openai/OpenAIClient.h"
 
 namespace llmcpp {
 
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, ClientFactory::Constructor, std::less<>> constructors;
+};
+
+// The built-in providers are registered here rather than from their own translation units:
+// with a static llmcpp library the linker would drop an otherwise unreferenced registrar
+Registry& registry() {
+    static Registry* instance = [] {
+        auto* r = new Registry();  // Never destroyed: usable from other static destructors
+        r->constructors["openai"] = [](const json& config) -> std::unique_ptr<LLMClient> {
+            return std::make_unique<OpenAIClient>(OpenAI::OpenAIConfig::fromJson(config));
+        };
+        r->constructors["anthropic"] = [](const json& config) -> std::unique_ptr<LLMClient> {
+            return std::make_unique<Anthropic::AnthropicClient>(
+                Anthropic::AnthropicConfig::fromJson(config));
+        };
+        r->constructors["local"] = [](const json& config) -> std::unique_ptr<LLMClient> {
+            return std::make_unique<Local::LocalClient>(Local::LocalConfig::fromJson(config));
+        };
+        return r;
+    }();
+    return *instance;
+}
+
+}  // namespace
+
+void ClientFactory::registerProvider(const std::string& provider, Constructor constructor) {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.constructors[provider] = std::move(constructor);
+}
+
+bool ClientFactory::unregisterProvider(const std::string& provider) {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.constructors.erase(provider) > 0;
+}
+
+bool ClientFactory::isProviderSupported(const std::string& provider) {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.constructors.find(provider) != r.constructors.end();
+}
+
+std::vector<std::string> ClientFactory::getSupportedProviders() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::vector<std::string> names;
+    names.reserve(r.constructors.size());
+    std::transform(r.constructors.begin(), r.constructors.end(), std::back_inserter(names),
+                   [](const auto& pair) { return pair.first; });
+    return names;
+}
+
 std::unique_ptr<LLMClient> ClientFactory::createClient(const std::string& provider,
                                                        const json& config) {
-    // Extract API key from config
-    std::string apiKey;
-    if (config.contains("api_key")) {
-        apiKey = config["api_key"];
-    } else if (config.contains("apiKey")) {
-        apiKey = config["apiKey"];
-    } else {
-        return nullptr;  // API key is required
+    Constructor constructor;
+    {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto it = r.constructors.find(provider);
+        if (it == r.constructors.end()) {
+            return nullptr;
+        }
+        constructor = it->second;  // Run outside the lock; constructors may do I/O
     }
-    return createClient(provider, apiKey);
+    return constructor(config);
 }
 
 std::unique_ptr<LLMClient> ClientFactory::createClient(const std::string& provider,
                                                        const std::string& apiKey) {
-    if (provider == "openai") {
-        return std::make_unique<OpenAIClient>(apiKey);
-    }
-
-    if (provider == "anthropic") {
-        return std::make_unique<Anthropic::AnthropicClient>(apiKey);
-    }
-
-    return nullptr;
+    return createClient(provider, json{{"api_key", apiKey}});
 }
 
 }  // namespace llmcpp
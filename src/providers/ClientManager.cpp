@@ -2,23 +2,106 @@
 
 #include <algorithm>
 #include <mutex>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct CachedSnapshot {
+    uint64_t owner = 0;
+    uint64_t generation = 0;
+    std::weak_ptr<const void> alive;  // Expires with the owning manager
+    std::shared_ptr<const std::unordered_map<std::string, std::shared_ptr<LLMClient>>> clients;
+};
+
+// One entry per manager this thread has looked up in; a handful at most
+struct SnapshotCache {
+    uint64_t sweptAt = 0;  // retiredManagers when dead managers were last dropped
+    std::vector<CachedSnapshot> entries;
+};
+
+thread_local SnapshotCache snapshotCache;
+std::atomic<uint64_t> retiredManagers{0};
+
+// Drop the calling thread's snapshot of manager `owner`, if it has one
+void forget(uint64_t owner) {
+    auto& entries = snapshotCache.entries;
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [owner](const CachedSnapshot& entry) { return entry.owner == owner; });
+    if (it != entries.end()) {
+        *it = std::move(entries.back());
+        entries.pop_back();
+    }
+}
+
+}  // namespace
+
+ClientManager::~ClientManager() {
+    forget(id_);
+    alive_.reset();  // Expire before other threads are told to sweep
+    retiredManagers.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t ClientManager::nextId() {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
+
+const ClientManager::ClientMap& ClientManager::snapshot() const {
+    auto& cache = snapshotCache;
+    const auto retired = retiredManagers.load(std::memory_order_acquire);
+    if (cache.sweptAt != retired) {
+        // Snapshots of destroyed managers would otherwise keep their clients alive
+        std::erase_if(cache.entries,
+                      [](const CachedSnapshot& entry) { return entry.alive.expired(); });
+        cache.sweptAt = retired;
+    }
+
+    auto it = std::find_if(cache.entries.begin(), cache.entries.end(),
+                           [this](const CachedSnapshot& entry) { return entry.owner == id_; });
+    if (it == cache.entries.end()) {
+        it = cache.entries.insert(cache.entries.end(), CachedSnapshot{id_, 0, alive_, nullptr});
+    } else if (it->generation == generation_.load(std::memory_order_acquire)) {
+        return *it->clients;
+    }
+
+    // Release the previous snapshot outside the lock; it may hold the last reference to a
+    // removed client
+    auto previous = std::move(it->clients);
+    std::lock_guard<std::mutex> lock(mutex_);
+    it->generation = generation_.load(std::memory_order_relaxed);
+    it->clients = clients_;
+    return *it->clients;
+}
+
+std::shared_ptr<const ClientManager::ClientMap> ClientManager::publish(
+    std::shared_ptr<const ClientMap> clients) {
+    // Caller holds mutex_ and lets go of the previous map after unlocking
+    auto previous = std::exchange(clients_, std::move(clients));
+    generation_.fetch_add(1, std::memory_order_release);
+    return previous;
+}
 
 bool ClientManager::addClient(const std::string& name, std::shared_ptr<LLMClient> client) {
+    forget(id_);  // Stale after the write; dropped before locking
+    std::shared_ptr<const ClientMap> previous;
     std::lock_guard<std::mutex> lock(mutex_);
 
-    if (clients_.find(name) != clients_.end()) {
+    if (clients_->find(name) != clients_->end()) {
         return false;  // Client with this name already exists
     }
 
-    clients_[name] = client;
+    auto next = std::make_shared<ClientMap>(*clients_);
+    (*next)[name] = std::move(client);
+    previous = publish(std::move(next));
     return true;
 }
 
 std::shared_ptr<LLMClient> ClientManager::getClient(const std::string& name) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& clients = snapshot();
 
-    auto it = clients_.find(name);
-    if (it != clients_.end()) {
+    auto it = clients.find(name);
+    if (it != clients.end()) {
         return it->second;
     }
 
@@ -26,40 +109,44 @@ std::shared_ptr<LLMClient> ClientManager::getClient(const std::string& name) con
 }
 
 bool ClientManager::removeClient(const std::string& name) {
+    // This thread's snapshot and the previous map may hold the last references to the client;
+    // both are released outside the lock
+    forget(id_);
+    std::shared_ptr<const ClientMap> previous;
     std::lock_guard<std::mutex> lock(mutex_);
 
-    auto it = clients_.find(name);
-    if (it != clients_.end()) {
-        clients_.erase(it);
-        return true;
+    if (clients_->find(name) == clients_->end()) {
+        return false;
     }
 
-    return false;
+    auto next = std::make_shared<ClientMap>(*clients_);
+    next->erase(name);
+    previous = publish(std::move(next));
+    return true;
 }
 
 bool ClientManager::hasClient(const std::string& name) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return clients_.find(name) != clients_.end();
+    const auto& clients = snapshot();
+    return clients.find(name) != clients.end();
 }
 
 std::vector<std::string> ClientManager::getClientNames() const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& clients = snapshot();
 
     std::vector<std::string> names;
-    names.reserve(clients_.size());
+    names.reserve(clients.size());
 
-    std::transform(clients_.begin(), clients_.end(), std::back_inserter(names),
+    std::transform(clients.begin(), clients.end(), std::back_inserter(names),
                    [](const auto& pair) { return pair.first; });
 
     return names;
 }
 
-size_t ClientManager::getClientCount() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return clients_.size();
-}
+size_t ClientManager::getClientCount() const { return snapshot().size(); }
 
 void ClientManager::clear() {
+    forget(id_);
+    std::shared_ptr<const ClientMap> previous;
     std::lock_guard<std::mutex> lock(mutex_);
-    clients_.clear();
+    previous = publish(std::make_shared<const ClientMap>());
 }
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "llmcpp_version.h"
+
+namespace llmcpp::bench {
+
+/**
+ * @brief Keep a value alive so the optimizer cannot drop the computation producing it
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief Heap allocation counters
+ *
+ * Only populated when the benchmark binary replaces the global operator new
+ * (see llmcpp_microbench.cpp); otherwise allocation fields are reported as absent.
+ */
+struct AllocationCounters {
+    static inline std::atomic<bool> installed{false};
+    static inline std::atomic<bool> enabled{false};
+    static inline std::atomic<uint64_t> count{0};
+    static inline std::atomic<uint64_t> bytes{0};
+
+    static void record(size_t size) {
+        if (enabled.load(std::memory_order_relaxed)) {
+            count.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @brief Size parameter for a benchmark case, e.g. {"100KB", 102400}
+ */
+struct SizeParam {
+    std::string label;
+    size_t bytes = 0;
+
+    /**
+     * @brief Parse "10KB", "1MB", "512" (bytes)
+     */
+    static SizeParam parse(const std::string& spec) {
+        size_t unit = 1;
+        std::string digits = spec;
+        auto endsWith = [&](const std::string& suffix) {
+            return digits.size() > suffix.size() &&
+                   digits.compare(digits.size() - suffix.size(), suffix.size(), suffix) == 0;
+        };
+        if (endsWith("MB")) {
+            unit = 1024 * 1024;
+            digits.resize(digits.size() - 2);
+        } else if (endsWith("KB")) {
+            unit = 1024;
+            digits.resize(digits.size() - 2);
+        }
+        return {spec, static_cast<size_t>(std::stoull(digits)) * unit};
+    }
+};
+
+struct BenchResult {
+    std::string name;
+    std::string param;
+    size_t inputBytes = 0;
+    uint64_t iterations = 0;  // Per sample
+    int samples = 0;
+    double nsMedian = 0.0;
+    double nsMin = 0.0;
+    double nsMean = 0.0;
+    double nsStddev = 0.0;
+    std::vector<double> nsSamples;  // Per-op time of each sample, for bootstrap comparisons
+    std::optional<double> allocsPerOp;
+    std::optional<double> allocBytesPerOp;
+
+    double bytesPerSecond() const {
+        return nsMedian > 0 && inputBytes > 0 ? static_cast<double>(inputBytes) * 1e9 / nsMedian
+                                              : 0.0;
+    }
+
+    nlohmann::json toJson() const {
+        nlohmann::json j = {{"name", name},
+                            {"param", param},
+                            {"input_bytes", inputBytes},
+                            {"iterations", iterations},
+                            {"samples", samples},
+                            {"ns_per_op",
+                             {{"median", nsMedian},
+                              {"min", nsMin},
+                              {"mean", nsMean},
+                              {"stddev", nsStddev}}},
+                            {"samples_ns", nsSamples}};
+        if (inputBytes > 0) {
+            j["bytes_per_second"] = bytesPerSecond();
+        }
+        if (allocsPerOp) {
+            j["allocs_per_op"] = *allocsPerOp;
+            j["alloc_bytes_per_op"] = allocBytesPerOp.value_or(0.0);
+        }
+        return j;
+    }
+};
+
+/**
+ * @brief Minimal self-calibrating microbenchmark runner with JSON output
+ *
+ * Each case is calibrated so one sample runs for at least `minSampleTime`, then
+ * `samples` samples are taken and summarized. The JSON document produced by
+ * toJson() is the format consumed by the regression tooling.
+ */
+class MicroBench {
+   public:
+    struct Options {
+        std::string filter;  // Substring match on "name/param"
+        int samples = 15;
+        std::chrono::nanoseconds minSampleTime = std::chrono::milliseconds(20);
+        bool quiet = false;
+    };
+
+    explicit MicroBench(Options options) : options_(std::move(options)) {}
+
+    template <typename Fn>
+    void run(const std::string& name, const std::string& param, size_t inputBytes, Fn&& fn) {
+        std::string id = param.empty() ? name : name + "/" + param;
+        if (!options_.filter.empty() && id.find(options_.filter) == std::string::npos) {
+            return;
+        }
+
+        using clock = std::chrono::steady_clock;
+        auto timeBatch = [&](uint64_t iterations) {
+            auto start = clock::now();
+            for (uint64_t i = 0; i < iterations; ++i) {
+                fn();
+            }
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+        };
+
+        // Calibrate: grow the batch until it spans the minimum sample time
+        uint64_t iterations = 1;
+        for (;;) {
+            auto elapsed = timeBatch(iterations);
+            if (elapsed >= options_.minSampleTime || iterations >= (uint64_t{1} << 30)) {
+                break;
+            }
+            double scale = elapsed.count() > 0
+                               ? static_cast<double>(options_.minSampleTime.count()) /
+                                     static_cast<double>(elapsed.count())
+                               : 10.0;
+            iterations = std::max(iterations + 1,
+                                  static_cast<uint64_t>(static_cast<double>(iterations) *
+                                                        std::min(10.0, scale * 1.2)));
+        }
+
+        std::vector<double> perOp;
+        perOp.reserve(static_cast<size_t>(options_.samples));
+        for (int s = 0; s < options_.samples; ++s) {
+            perOp.push_back(static_cast<double>(timeBatch(iterations).count()) /
+                            static_cast<double>(iterations));
+        }
+
+        BenchResult result;
+        result.nsSamples = perOp;
+        std::sort(perOp.begin(), perOp.end());
+
+        // Count allocations outside the timed samples so counting never skews timings
+        if (AllocationCounters::installed.load()) {
+            uint64_t calls = std::min<uint64_t>(iterations, 64);
+            AllocationCounters::count = 0;
+            AllocationCounters::bytes = 0;
+            AllocationCounters::enabled = true;
+            for (uint64_t i = 0; i < calls; ++i) {
+                fn();
+            }
+            AllocationCounters::enabled = false;
+            result.allocsPerOp = static_cast<double>(AllocationCounters::count.load()) /
+                                 static_cast<double>(calls);
+            result.allocBytesPerOp = static_cast<double>(AllocationCounters::bytes.load()) /
+                                     static_cast<double>(calls);
+        }
+
+        result.name = name;
+        result.param = param;
+        result.inputBytes = inputBytes;
+        result.iterations = iterations;
+        result.samples = options_.samples;
+        result.nsMin = perOp.front();
+        result.nsMedian = perOp[perOp.size() / 2];
+        result.nsMean = std::accumulate(perOp.begin(), perOp.end(), 0.0) /
+                        static_cast<double>(perOp.size());
+        double variance = 0.0;
+        for (double v : perOp) {
+            variance += (v - result.nsMean) * (v - result.nsMean);
+        }
+        result.nsStddev = std::sqrt(variance / static_cast<double>(perOp.size()));
+
+        if (!options_.quiet) {
+            std::cout << formatRow(id, result) << std::endl;
+        }
+        results_.push_back(std::move(result));
+    }
+
+    const std::vector<BenchResult>& results() const { return results_; }
+
+    nlohmann::json toJson() const {
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto& r : results_) {
+            list.push_back(r.toJson());
+        }
+        return {{"schema_version", 1},
+                {"library_version", LLMCPP_VERSION},
+                {"compiler", compilerId()},
+                {"timestamp", static_cast<int64_t>(std::time(nullptr))},
+                {"results", list}};
+    }
+
+    bool writeJson(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) {
+            return false;
+        }
+        out << toJson().dump(2) << "\n";
+        return static_cast<bool>(out);
+    }
+
+   private:
+    static std::string formatRow(const std::string& id, const BenchResult& r) {
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-60s %14.1f ns/op  (min %.1f, sd %.1f)", id.c_str(),
+                      r.nsMedian, r.nsMin, r.nsStddev);
+        std::string row = line;
+        if (r.inputBytes > 0) {
+            std::snprintf(line, sizeof(line), "  %9.1f MB/s", r.bytesPerSecond() / (1024 * 1024));
+            row += line;
+        }
+        if (r.allocsPerOp) {
+            std::snprintf(line, sizeof(line), "  %.1f allocs/op", *r.allocsPerOp);
+            row += line;
+        }
+        return row;
+    }
+
+    static std::string compilerId() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    Options options_;
+    std::vector<BenchResult> results_;
+};
+
+}  // namespace llmcpp::bench
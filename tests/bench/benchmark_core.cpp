@@ -1,6 +1,7 @@
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include "core/Logger.h"
 #include "openai/OpenAITypes.h"
 
 using namespace OpenAI;
@@ -63,3 +64,26 @@ TEST_CASE("Benchmark: Model enum conversions", "[benchmark]") {
     BENCHMARK("modelToString") { return toString(Model::GPT_4o); };
     BENCHMARK("stringToModel") { return modelFromString("gpt-4o"); };
 }
+
+TEST_CASE("Benchmark: Logger hot path", "[benchmark]") {
+    auto& logger = llmcpp::Logger::instance();
+    auto previousLevel = logger.getLevel();
+    auto requestJson = makeRequest().toJson();
+
+    // What every request pays when debug logging is off (the default)
+    logger.setLevel(llmcpp::LogLevel::Warn);
+    BENCHMARK("disabled debug statement") {
+        LLMCPP_LOG_DEBUG("bench", "Sending Responses API request", {{"body", requestJson}});
+    };
+
+    // Enqueue cost when enabled; the sink discards so only the producer side is measured
+    logger.setSink(nullptr);
+    logger.setLevel(llmcpp::LogLevel::Debug);
+    BENCHMARK("enabled debug statement (enqueue only)") {
+        LLMCPP_LOG_DEBUG("bench", "Sending Responses API request", {{"model", "gpt-4o"}});
+    };
+    logger.flush();
+
+    logger.setLevel(previousLevel);
+    logger.setSink(std::make_shared<llmcpp::StderrLogSink>());
+}
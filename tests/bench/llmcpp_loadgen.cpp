@@ -0,0 +1,244 @@
+// Load generator: drives the real OpenAI/Anthropic clients against MockLlmServer
+//
+// Usage:
+//   llmcpp_loadgen [--provider openai|anthropic] [--requests N] [--concurrency C]
+//                  [--ttft SPEC] [--tps N] [--tokens N] [--payload-bytes N]
+//                  [--rate-429 P] [--rate-5xx P] [--server URL] [--json]
+//
+// SPEC is a latency distribution, e.g. "fixed:20", "uniform:10,50", "lognormal:40,0.5".
+// With --server the mock is not started in-process, so CPU/request covers the client only.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "anthropic/AnthropicClient.h"
+#include "mock/MockLlmServer.h"
+#include "openai/OpenAIClient.h"
+
+using json = nlohmann::json;
+using llmcpp::mock::LatencyDistribution;
+using llmcpp::mock::MockLlmServer;
+using llmcpp::mock::MockServerConfig;
+
+namespace {
+
+struct Options {
+    std::string provider = "openai";
+    int requests = 1000;
+    int concurrency = 8;
+    std::string serverUrl;
+    bool jsonOutput = false;
+    MockServerConfig server;
+};
+
+void printUsage() {
+    std::cerr << "Usage: llmcpp_loadgen [--provider openai|anthropic] [--requests N]\n"
+                 "                      [--concurrency C] [--ttft SPEC] [--tps N] [--tokens N]\n"
+                 "                      [--payload-bytes N] [--rate-429 P] [--rate-5xx P]\n"
+                 "                      [--server URL] [--json]\n";
+}
+
+bool parseArgs(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--provider") {
+            options.provider = next();
+        } else if (arg == "--requests") {
+            options.requests = std::stoi(next());
+        } else if (arg == "--concurrency") {
+            options.concurrency = std::max(1, std::stoi(next()));
+        } else if (arg == "--ttft") {
+            auto spec = next();
+            auto dist = LatencyDistribution::parse(spec);
+            if (!dist) {
+                throw std::invalid_argument("Invalid latency distribution: " + spec);
+            }
+            options.server.timeToFirstToken = *dist;
+        } else if (arg == "--tps") {
+            options.server.tokensPerSecond = std::stod(next());
+        } else if (arg == "--tokens") {
+            options.server.outputTokens = std::stoi(next());
+        } else if (arg == "--payload-bytes") {
+            options.server.payloadBytes = static_cast<size_t>(std::stoul(next()));
+        } else if (arg == "--rate-429") {
+            options.server.rate429 = std::stod(next());
+        } else if (arg == "--rate-5xx") {
+            options.server.rate5xx = std::stod(next());
+        } else if (arg == "--server") {
+            options.serverUrl = next();
+        } else if (arg == "--json") {
+            options.jsonOutput = true;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else {
+            throw std::invalid_argument("Unknown argument: " + arg);
+        }
+    }
+    if (options.provider != "openai" && options.provider != "anthropic") {
+        throw std::invalid_argument("Unknown provider: " + options.provider);
+    }
+    return true;
+}
+
+// Blocking send bound to a concrete client (the LLMClient callback API is fire-and-forget)
+using SyncSend = std::function<LLMResponse(const LLMRequest&)>;
+
+SyncSend makeClient(const std::string& provider, const std::string& baseUrl) {
+    if (provider == "anthropic") {
+        Anthropic::AnthropicConfig config("mock-key");
+        config.baseUrl = baseUrl;
+        auto client = std::make_shared<Anthropic::AnthropicClient>(config);
+        return [client](const LLMRequest& request) { return client->sendRequest(request); };
+    }
+    OpenAI::OpenAIConfig config;
+    config.apiKey = "mock-key";
+    config.baseUrl = baseUrl + "/v1";
+    config.enableDeprecationWarnings = false;
+    auto client = std::make_shared<OpenAIClient>(config);
+    return [client](const LLMRequest& request) { return client->sendRequest(request); };
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    auto index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        if (!parseArgs(argc, argv, options)) {
+            printUsage();
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        printUsage();
+        return 2;
+    }
+
+    std::unique_ptr<MockLlmServer> server;
+    std::string baseUrl = options.serverUrl;
+    if (baseUrl.empty()) {
+        server = std::make_unique<MockLlmServer>(options.server);
+        server->start();
+        baseUrl = server->baseUrl();
+    }
+
+    std::string model =
+        options.provider == "anthropic" ? "claude-3-5-haiku-20241022" : "gpt-4o-mini";
+    LLMRequestConfig requestConfig;
+    requestConfig.client = options.provider;
+    requestConfig.model = model;
+    requestConfig.maxTokens = options.server.outputTokens;
+    LLMRequest request(requestConfig, "Summarize the input in one sentence.",
+                       json{{"text", "The quick brown fox jumps over the lazy dog."}});
+
+    // One client per worker so connection reuse mirrors a real deployment
+    std::vector<SyncSend> clients;
+    for (int w = 0; w < options.concurrency; ++w) {
+        clients.push_back(makeClient(options.provider, baseUrl));
+    }
+
+    std::atomic<int> nextRequest{0};
+    std::atomic<int> failures{0};
+    std::vector<std::vector<double>> latencies(static_cast<size_t>(options.concurrency));
+
+    auto cpuStart = std::clock();
+    auto wallStart = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < options.concurrency; ++w) {
+        workers.emplace_back([&, w]() {
+            auto& send = clients[static_cast<size_t>(w)];
+            auto& samples = latencies[static_cast<size_t>(w)];
+            while (nextRequest.fetch_add(1) < options.requests) {
+                auto start = std::chrono::steady_clock::now();
+                LLMResponse response = send(request);
+                std::chrono::duration<double, std::milli> elapsed =
+                    std::chrono::steady_clock::now() - start;
+                samples.push_back(elapsed.count());
+                if (!response.success) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+    double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    std::vector<double> all;
+    for (auto& samples : latencies) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::sort(all.begin(), all.end());
+    double completed = static_cast<double>(all.size());
+
+    json report = {
+        {"provider", options.provider},
+        {"requests", all.size()},
+        {"failures", failures.load()},
+        {"concurrency", options.concurrency},
+        {"wall_seconds", wall.count()},
+        {"throughput_rps", wall.count() > 0 ? completed / wall.count() : 0.0},
+        {"latency_p50_ms", percentile(all, 0.50)},
+        {"latency_p99_ms", percentile(all, 0.99)},
+        {"latency_max_ms", all.empty() ? 0.0 : all.back()},
+        {"cpu_us_per_request", completed > 0 ? cpuSeconds * 1e6 / completed : 0.0},
+        {"cpu_includes_server", server != nullptr}
+    };
+
+    // Evenly spaced order statistics (at most 1000) so baselines can bootstrap the latency
+    json samples = json::array();
+    size_t keep = std::min<size_t>(all.size(), 1000);
+    for (size_t i = 0; i < keep; ++i) {
+        samples.push_back(all[i * all.size() / keep]);
+    }
+    report["latency_samples_ms"] = samples;
+    if (server) {
+        auto stats = server->stats();
+        report["server"] = {{"requests", stats.requests},
+                            {"injected_429", stats.injected429},
+                            {"injected_5xx", stats.injected5xx}};
+        server->stop();
+    }
+
+    if (options.jsonOutput) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::cout << "provider:        " << options.provider << "\n"
+                  << "requests:        " << all.size() << " (" << failures.load()
+                  << " failed)\n"
+                  << "concurrency:     " << options.concurrency << "\n"
+                  << "throughput:      " << report["throughput_rps"].get<double>() << " req/s\n"
+                  << "latency p50:     " << report["latency_p50_ms"].get<double>() << " ms\n"
+                  << "latency p99:     " << report["latency_p99_ms"].get<double>() << " ms\n"
+                  << "cpu/request:     " << report["cpu_us_per_request"].get<double>() << " us"
+                  << (server ? " (client + in-process server)" : " (client only)") << "\n";
+    }
+    return 0;
+}
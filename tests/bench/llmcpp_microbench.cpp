@@ -0,0 +1,598 @@
+// Microbenchmarks for the serialization and parsing hot paths
+//
+// Usage:
+//   llmcpp_microbench [--json PATH] [--filter SUBSTR] [--sizes 10KB,100KB,1MB]
+//                     [--samples N] [--min-time-ms N] [--vocab PATH] [--quiet]
+//
+// Every case is parameterized by input size; --json writes the results in the
+// format consumed by the regression tooling so runs can be compared between releases.
+// --vocab loads a tiktoken vocabulary (e.g. o200k_base.tiktoken) for the tokenizer
+// cases; without it they run on a small synthetic vocabulary.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "MicroBench.h"
+#include "anthropic/AnthropicTypes.h"
+#include "core/ClientManager.h"
+#include "core/CompiledSchema.h"
+#include "core/JsonSchemaBuilder.h"
+#include "core/JsonStructuralScanner.h"
+#include "core/LLMTypes.h"
+#include "core/ResponseParser.h"
+#include "core/StreamingJsonParser.h"
+#include "core/Tokenizer.h"
+#include "core/TypedSchema.h"
+#include "openai/OpenAIMcpUtils.h"
+#include "openai/OpenAITypes.h"
+
+using llmcpp::bench::AllocationCounters;
+using llmcpp::bench::doNotOptimize;
+using llmcpp::bench::MicroBench;
+using llmcpp::bench::SizeParam;
+
+// Count heap allocations for allocs/op and bytes/op. Every copy of a string or JSON
+// node in the measured paths allocates, so alloc bytes/op doubles as a bytes-copied proxy.
+void* operator new(std::size_t size) {
+    AllocationCounters::record(size);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace bench_types {
+
+struct Item {
+    int64_t id = 0;
+    std::string title;
+    std::vector<std::string> tags;
+    std::optional<double> score;
+};
+LLMCPP_SCHEMA(Item, id, title, tags, score)
+
+struct ItemList {
+    std::vector<Item> items;
+};
+LLMCPP_SCHEMA(ItemList, items)
+
+}  // namespace bench_types
+
+namespace {
+
+class NullClient : public LLMClient {
+   public:
+    void sendRequest(const LLMRequest&, LLMResponseCallback) override {}
+    std::string getClientName() const override { return "null"; }
+};
+
+// ClientManager's lookup before snapshots: one mutex around the map, kept as the baseline
+class MutexClientMap {
+   public:
+    void add(const std::string& name, std::shared_ptr<LLMClient> client) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clients_[name] = std::move(client);
+    }
+
+    std::shared_ptr<LLMClient> get(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = clients_.find(name);
+        return it != clients_.end() ? it->second : nullptr;
+    }
+
+   private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<LLMClient>> clients_;
+};
+
+// Run `lookup(i)` `perThread` times on each of `threads` threads, released together
+template <typename Lookup>
+void runContended(int threads, size_t perThread, const Lookup& lookup) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(threads));
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < perThread; ++i) {
+                doNotOptimize(lookup(i + static_cast<size_t>(t)));
+            }
+        });
+    }
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+// Deterministic filler text of exactly `bytes` characters
+std::string filler(size_t bytes, size_t seed = 0) {
+    static const char* const words[] = {"alpha", "beta",  "gamma", "delta", "epsilon",
+                                        "zeta",  "theta", "kappa", "lambda"};
+    std::string text;
+    text.reserve(bytes + 16);
+    for (size_t i = seed; text.size() < bytes; ++i) {
+        text += words[i % 9];
+        text += ' ';
+    }
+    text.resize(bytes);
+    return text;
+}
+
+// ~256-byte chat turns alternating user/assistant until `bytes` of content
+LLMContext makeContext(size_t bytes) {
+    LLMContext context;
+    for (size_t used = 0, i = 0; used < bytes; used += 256, ++i) {
+        context.push_back(
+            {{"role", i % 2 == 0 ? "user" : "assistant"}, {"content", filler(256, i)}});
+    }
+    return context;
+}
+
+Anthropic::MessagesRequest makeMessagesRequest(size_t bytes) {
+    LLMRequestConfig config;
+    config.model = "claude-3-5-haiku-20241022";
+    config.maxTokens = 1024;
+    return Anthropic::MessagesRequest::fromLLMRequest(
+        LLMRequest(config, "Summarize the conversation.", makeContext(bytes)));
+}
+
+// Responses output with ~1 KB message items, and a function_call after every fourth message
+OpenAI::ResponsesResponse makeResponsesResponse(size_t bytes) {
+    OpenAI::ResponsesResponse response;
+    for (size_t used = 0, i = 0; used < bytes; used += 1024, ++i) {
+        response.output.push_back(
+            {{"type", "message"},
+             {"id", "msg_" + std::to_string(i)},
+             {"role", "assistant"},
+             {"content",
+              json::array({json{{"type", "output_text"}, {"text", filler(1024, i)}}})}});
+        if (i % 4 == 3) {
+            response.output.push_back({{"type", "function_call"},
+                                       {"call_id", "call_" + std::to_string(i)},
+                                       {"name", "lookup"},
+                                       {"arguments", R"({"query":"item )" + std::to_string(i) +
+                                                         R"("})"}});
+        }
+    }
+    return response;
+}
+
+// Responses output with ~1 KB mcp_call items and a single mcp_list_tools item
+OpenAI::ResponsesResponse makeMcpResponse(size_t bytes) {
+    OpenAI::ResponsesResponse response;
+    json tools = json::array();
+    for (int t = 0; t < 16; ++t) {
+        tools.push_back({{"name", "tool_" + std::to_string(t)}});
+    }
+    response.output.push_back({{"type", "mcp_list_tools"}, {"tools", tools}});
+    for (size_t used = 0, i = 0; used < bytes; used += 1024, ++i) {
+        json item = {{"type", "mcp_call"},
+                     {"id", "mcp_" + std::to_string(i)},
+                     {"name", "tool_" + std::to_string(i % 16)},
+                     {"input", {{"q", "search " + std::to_string(i)}}}};
+        if (i % 10 == 9) {
+            item["error"] = "tool failed";
+        } else {
+            item["output"] = filler(960, i);
+        }
+        response.output.push_back(item);
+    }
+    return response;
+}
+
+json makeMessagesResponseJson(size_t bytes) {
+    json content = json::array();
+    for (size_t used = 0, i = 0; used < bytes; used += 1024, ++i) {
+        if (i % 8 == 7) {
+            content.push_back({{"type", "tool_use"},
+                               {"id", "toolu_" + std::to_string(i)},
+                               {"name", "lookup"},
+                               {"input", {{"query", filler(960, i)}}}});
+        } else {
+            content.push_back({{"type", "text"}, {"text", filler(1024, i)}});
+        }
+    }
+    return {{"id", "msg_1"},
+            {"type", "message"},
+            {"role", "assistant"},
+            {"model", "claude-3-5-haiku-20241022"},
+            {"content", content},
+            {"stop_reason", "end_turn"},
+            {"stop_sequence", nullptr},
+            {"usage", {{"input_tokens", 100}, {"output_tokens", 200}}}};
+}
+
+// Prose with ~1 KB ```json blocks. Blocks stay small on purpose: std::regex recurses per
+// character, so a single fenced block of ~100 KB overflows the stack in libstdc++.
+std::string makeFencedText(size_t bytes) {
+    std::string text;
+    for (size_t i = 0; text.size() < bytes; ++i) {
+        text += filler(200, i);
+        text += "\n```json\n";
+        text += json{{"id", i}, {"title", filler(64, i)}, {"body", filler(700, i + 1)}}.dump(2);
+        text += "\n```\n";
+    }
+    return text;
+}
+
+std::string makeXmlFunctionCalls(size_t bytes) {
+    std::string text;
+    for (size_t i = 0; text.size() < bytes; ++i) {
+        text += "<function_calls>\n<invoke name=\"create_item\">\n";
+        text += "<parameter name=\"description\">" + filler(120, i) + "</parameter>\n";
+        text += "<parameter name=\"payload\">" +
+                json{{"id", i}, {"tags", {"a", "b", "c"}}, {"text", filler(600, i)}}.dump() +
+                "</parameter>\n";
+        text += "</invoke>\n</function_calls>\n";
+    }
+    return text;
+}
+
+// Prose followed by a JSON array of ~1 KB objects that is cut off mid-object, as in a
+// truncated completion; parseJsonArrayFromText has to salvage the complete objects
+std::string makeTruncatedArrayText(size_t bytes) {
+    std::string text = "Here are the results:\n[";
+    for (size_t i = 0; text.size() < bytes; ++i) {
+        text += json{{"id", i}, {"note", "say \"hi\" {" + std::to_string(i) + "}"},
+                     {"body", filler(960, i)}}
+                    .dump();
+        text += ",\n";
+    }
+    text += R"({"id": -1, "body": "trunc)";
+    return text;
+}
+
+// Nested object schema `depth` levels deep with a few scalar and array properties per level
+JsonSchemaBuilder makeDeepSchema(int depth) {
+    JsonSchemaBuilder leaf;
+    leaf.type("object")
+        .property("name", JsonSchemaBuilder().type("string").minLength(1))
+        .property("count", JsonSchemaBuilder().type("integer").minimum(0))
+        .required({"name"});
+    for (int level = 0; level < depth; ++level) {
+        JsonSchemaBuilder node;
+        node.type("object")
+            .description("Level " + std::to_string(level))
+            .property("id", JsonSchemaBuilder().type("string").format("uuid"))
+            .property("tags", JsonSchemaBuilder().type("array").items(
+                                  JsonSchemaBuilder().type("string")))
+            .property("kind", JsonSchemaBuilder().type("string").enumValues(
+                                  std::vector<json>{"a", "b", "c"}))
+            .property("child", leaf)
+            .required({"id", "child"})
+            .additionalProperties(false);
+        leaf = node;
+    }
+    return leaf;
+}
+
+// Structured output text for bench_types::ItemList with ~256-byte items
+std::string makeItemListText(size_t bytes) {
+    json items = json::array();
+    for (size_t used = 0, i = 0; used < bytes; used += 256, ++i) {
+        items.push_back({{"id", i},
+                         {"title", filler(160, i)},
+                         {"tags", {"alpha", "beta"}},
+                         {"score", i % 3 == 0 ? json(nullptr) : json(0.5 * static_cast<double>(i))}});
+    }
+    return json{{"items", items}}.dump();
+}
+
+// Instance matching makeDeepSchema(depth)
+json makeDeepInstance(int depth) {
+    json node = {{"name", "leaf"}, {"count", 3}};
+    for (int level = 0; level < depth; ++level) {
+        node = {{"id", "0f8fad5b-d9cb-469f-a165-70867728950e"},
+                {"tags", {"x", "y", "z"}},
+                {"kind", "b"},
+                {"child", node}};
+    }
+    return node;
+}
+
+// Every byte plus all inner substrings of the filler words, so each word takes several
+// merges instead of being one whole-piece lookup
+llmcpp::BpeTokenizer makeSyntheticTokenizer() {
+    std::vector<std::string> tokens;
+    for (const char* word : {"alpha", "beta", "gamma", "delta", "epsilon", "zeta", "theta",
+                             "kappa", "lambda"}) {
+        for (const std::string piece : {std::string(word), " " + std::string(word)}) {
+            for (size_t length = 2; length < piece.size(); ++length) {
+                for (size_t start = 0; start + length <= piece.size(); ++start) {
+                    tokens.push_back(piece.substr(start, length));
+                }
+            }
+        }
+    }
+    std::stable_sort(tokens.begin(), tokens.end(),
+                     [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    llmcpp::BpeRanks ranks;
+    for (int b = 0; b < 256; ++b) {
+        ranks.insert(std::string(1, static_cast<char>(b)), static_cast<llmcpp::BpeRanks::Rank>(b));
+    }
+    llmcpp::BpeRanks::Rank next = 256;
+    for (const auto& token : tokens) {
+        if (ranks.find(token) == llmcpp::BpeRanks::npos) {
+            ranks.insert(token, next++);
+        }
+    }
+    return llmcpp::BpeTokenizer(llmcpp::BpeTokenizer::Encoding::Cl100kBase, std::move(ranks));
+}
+
+std::vector<SizeParam> parseSizes(const std::string& list) {
+    std::vector<SizeParam> sizes;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            sizes.push_back(SizeParam::parse(item));
+        }
+    }
+    return sizes;
+}
+
+void runAll(MicroBench& bench, const std::vector<SizeParam>& sizes,
+            const llmcpp::BpeTokenizer& tokenizer, const std::string& vocabName) {
+    for (const auto& size : sizes) {
+        {
+            LLMRequestConfig config;
+            config.model = "gpt-4o";
+            config.maxTokens = 1024;
+            LLMRequest request(config, "Summarize the conversation.", makeContext(size.bytes));
+            bench.run("ResponsesRequest::fromLLMRequest", size.label, size.bytes, [&] {
+                doNotOptimize(OpenAI::ResponsesRequest::fromLLMRequest(request));
+            });
+        }
+        {
+            auto request = makeMessagesRequest(size.bytes);
+            bench.run("MessagesRequest::toJson", size.label, size.bytes,
+                      [&] { doNotOptimize(request.toJson()); });
+        }
+        {
+            auto response = makeResponsesResponse(size.bytes);
+            bench.run("ResponsesResponse::getOutputText", size.label, size.bytes,
+                      [&] { doNotOptimize(response.getOutputText()); });
+            bench.run("ResponsesResponse::getFunctionCalls", size.label, size.bytes,
+                      [&] { doNotOptimize(response.getFunctionCalls()); });
+        }
+        {
+            auto body = makeMessagesResponseJson(size.bytes);
+            bench.run("MessagesResponse::fromJson", size.label, size.bytes,
+                      [&] { doNotOptimize(Anthropic::MessagesResponse::fromJson(body)); });
+        }
+        {
+            auto text = makeFencedText(size.bytes);
+            bench.run("ResponseParser::parseMarkdownFencedJson", size.label, text.size(), [&] {
+                doNotOptimize(llmcpp::ResponseParser::parseMarkdownFencedJson(text));
+            });
+        }
+        {
+            auto text = makeXmlFunctionCalls(size.bytes);
+            bench.run("ResponseParser::parseXmlFunctionCalls", size.label, text.size(), [&] {
+                doNotOptimize(llmcpp::ResponseParser::parseXmlFunctionCalls(text));
+            });
+        }
+        {
+            auto text = makeTruncatedArrayText(size.bytes);
+            bench.run("ResponseParser::parseJsonArrayFromText(truncated)", size.label,
+                      text.size(), [&] {
+                          doNotOptimize(llmcpp::ResponseParser::parseJsonArrayFromText(text));
+                      });
+            using Scanner = llmcpp::JsonStructuralScanner;
+            for (auto isa : {Scanner::Isa::Scalar, Scanner::Isa::SSE2, Scanner::Isa::AVX2}) {
+                if (isa > Scanner::bestIsa()) {
+                    continue;
+                }
+                bench.run(std::string("JsonStructuralScanner::balancedObjects(") +
+                              Scanner::isaName(isa) + ")",
+                          size.label, text.size(),
+                          [&] { doNotOptimize(Scanner::balancedObjects(text, isa)); });
+            }
+        }
+        {
+            // Prose mixed with pretty-printed JSON: words, punctuation, digits and newlines
+            auto text = makeFencedText(size.bytes);
+            bench.run("BpeTokenizer::countTokens(" + vocabName + ")", size.label, text.size(),
+                      [&] { doNotOptimize(tokenizer.countTokens(text)); });
+
+            LLMRequestConfig config;
+            config.model = "gpt-4o";
+            LLMRequest request(config, "Summarize the conversation.", makeContext(size.bytes));
+            bench.run("BpeTokenizer::countTokens(LLMRequest)", size.label, size.bytes,
+                      [&] { doNotOptimize(tokenizer.countTokens(request)); });
+        }
+        {
+            // Structured output streamed in 64-byte deltas, items emitted as they complete
+            auto text = makeItemListText(size.bytes);
+            bench.run("StreamingJsonParser::feed", size.label, text.size(), [&] {
+                size_t items = 0;
+                llmcpp::StreamingJsonParser parser("/items",
+                                                   [&](llmcpp::StreamedValue) { ++items; });
+                for (size_t pos = 0; pos < text.size(); pos += 64) {
+                    parser.feed(std::string_view(text).substr(pos, 64));
+                }
+                doNotOptimize(items);
+            });
+        }
+        {
+            auto text = makeItemListText(size.bytes);
+            bench.run("TypedSchema::parseStructured", size.label, text.size(), [&] {
+                doNotOptimize(
+                    llmcpp::parseStructured<bench_types::ItemList>(std::string_view(text)));
+            });
+            bench.run("TypedSchema::parseStructured(dom)", size.label, text.size(), [&] {
+                doNotOptimize(llmcpp::parseStructured<bench_types::ItemList>(json::parse(text)));
+            });
+        }
+        {
+            auto response = makeMcpResponse(size.bytes);
+            bench.run("McpUtils::extractMcpCalls", size.label, size.bytes,
+                      [&] { doNotOptimize(OpenAI::McpUtils::extractMcpCalls(response)); });
+            bench.run("McpUtils::getMcpUsageStats", size.label, size.bytes,
+                      [&] { doNotOptimize(OpenAI::McpUtils::getMcpUsageStats(response)); });
+            bench.run("McpUtils::getAvailableMcpTools", size.label, size.bytes,
+                      [&] { doNotOptimize(OpenAI::McpUtils::getAvailableMcpTools(response)); });
+            bench.run("McpUtils::getAllToolOutputs", size.label, size.bytes, [&] {
+                doNotOptimize(OpenAI::McpUtils::getAllToolOutputs(response, "tool_3"));
+            });
+            bench.run("ResponsesResponse::outputIndex", size.label, size.bytes,
+                      [&] { doNotOptimize(response.outputIndex()); });
+            // Typical post-processing: several queries against one response
+            bench.run("McpUtils::postProcess(8 queries)", size.label, size.bytes, [&] {
+                for (const char* tool : {"tool_1", "tool_3", "tool_7", "tool_15"}) {
+                    doNotOptimize(OpenAI::McpUtils::wasToolCalled(response, tool));
+                    doNotOptimize(OpenAI::McpUtils::getToolOutput(response, tool));
+                }
+            });
+            bench.run("McpUtils::postProcess(8 queries, indexed)", size.label, size.bytes, [&] {
+                const auto index = response.outputIndex();
+                for (const char* tool : {"tool_1", "tool_3", "tool_7", "tool_15"}) {
+                    doNotOptimize(OpenAI::McpUtils::wasToolCalled(response, index, tool));
+                    doNotOptimize(OpenAI::McpUtils::getToolOutput(response, index, tool));
+                }
+            });
+        }
+    }
+
+    // Structured-output request serialization with a large schema: copied vs interned
+    {
+        auto schema = makeDeepSchema(48).build();
+        std::string label = std::to_string(schema.dump().size() / 1024) + "KB-schema";
+        LLMRequestConfig config;
+        config.model = "gpt-4o";
+        config.functionName = "extract";
+        config.schemaObject = schema;
+        LLMRequest copied(config, "Extract the record.");
+        bench.run("ResponsesRequest::serialize(schemaObject)", label, 0, [&] {
+            doNotOptimize(OpenAI::ResponsesRequest::fromLLMRequest(copied).toJson().dump());
+        });
+
+        config.schemaObject.reset();
+        config.internedSchema = llmcpp::SchemaInterner::intern(schema);
+        LLMRequest interned(config, "Extract the record.");
+        bench.run("ResponsesRequest::serialize(interned)", label, 0, [&] {
+            auto request = OpenAI::ResponsesRequest::fromLLMRequest(interned);
+            doNotOptimize(request.spliceSchema(request.toJson(true).dump()));
+        });
+    }
+
+    // Client lookup under contention: each op is one batch of 4096 lookups per thread, so
+    // compare the two variants at the same thread count rather than across counts
+    {
+        const std::vector<std::string> names = {"openai", "anthropic", "local", "fallback"};
+        ClientManager manager;
+        MutexClientMap baseline;
+        for (const auto& name : names) {
+            auto client = std::make_shared<NullClient>();
+            manager.addClient(name, client);
+            baseline.add(name, client);
+        }
+        constexpr size_t perThread = 4096;
+        for (int threads : {1, 2, 4, 8, 16, 32, 64, 128}) {
+            std::string label = std::to_string(threads) + "threads";
+            bench.run("ClientManager::getClient(mutex)", label, 0, [&] {
+                runContended(threads, perThread,
+                             [&](size_t i) { return baseline.get(names[i % names.size()]); });
+            });
+            bench.run("ClientManager::getClient(snapshot)", label, 0, [&] {
+                runContended(threads, perThread,
+                             [&](size_t i) { return manager.getClient(names[i % names.size()]); });
+            });
+        }
+    }
+
+    // Schema building scales with nesting depth rather than bytes
+    for (int depth : {4, 16, 64}) {
+        auto builder = makeDeepSchema(depth);
+        bench.run("JsonSchemaBuilder::build", "depth" + std::to_string(depth), 0,
+                  [&] { doNotOptimize(builder.build()); });
+
+        auto schema = llmcpp::CompiledSchema::compile(builder.build());
+        auto instance = makeDeepInstance(depth);
+        bench.run("CompiledSchema::validate", "depth" + std::to_string(depth), 0,
+                  [&] { doNotOptimize(schema->validate(instance)); });
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    MicroBench::Options options;
+    std::string jsonPath;
+    std::string sizeList = "10KB,100KB,1MB";
+    std::string vocabPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << "\n";
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--json") {
+            jsonPath = next();
+        } else if (arg == "--filter") {
+            options.filter = next();
+        } else if (arg == "--sizes") {
+            sizeList = next();
+        } else if (arg == "--samples") {
+            options.samples = std::max(1, std::stoi(next()));
+        } else if (arg == "--min-time-ms") {
+            options.minSampleTime = std::chrono::milliseconds(std::stoi(next()));
+        } else if (arg == "--vocab") {
+            vocabPath = next();
+        } else if (arg == "--quiet") {
+            options.quiet = true;
+        } else {
+            std::cerr << "Usage: llmcpp_microbench [--json PATH] [--filter SUBSTR]\n"
+                         "                         [--sizes 10KB,100KB,1MB] [--samples N]\n"
+                         "                         [--min-time-ms N] [--vocab PATH] [--quiet]\n";
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    std::optional<llmcpp::BpeTokenizer> tokenizer;
+    std::string vocabName = "synthetic";
+    if (vocabPath.empty()) {
+        tokenizer = makeSyntheticTokenizer();
+    } else {
+        auto encoding = vocabPath.find("o200k") != std::string::npos
+                            ? llmcpp::BpeTokenizer::Encoding::O200kBase
+                            : llmcpp::BpeTokenizer::Encoding::Cl100kBase;
+        try {
+            tokenizer = llmcpp::BpeTokenizer::fromTiktokenFile(vocabPath, encoding);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << "\n";
+            return 1;
+        }
+        vocabName = llmcpp::BpeTokenizer::encodingName(encoding);
+    }
+
+    AllocationCounters::installed = true;
+    MicroBench bench(options);
+    runAll(bench, parseSizes(sizeList), *tokenizer, vocabName);
+
+    if (!jsonPath.empty() && !bench.writeJson(jsonPath)) {
+        std::cerr << "Failed to write " << jsonPath << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,611 @@
+#include "MockLlmServer.h"
+
+#include <httplib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using json = nlohmann::json;
+
+namespace llmcpp::mock {
+
+namespace {
+
+const char* const kWords[] = {"lorem",      "ipsum", "dolor", "sit", "amet",    "consectetur",
+                              "adipiscing", "elit",  "sed",   "do",  "eiusmod", "tempor"};
+
+// Fill a JSON schema with placeholder values so structured-output requests round-trip
+json sampleFromSchema(const json& schema, const std::string& text) {
+    std::string type = "object";
+    if (schema.contains("type") && schema["type"].is_string()) {
+        type = schema["type"].get<std::string>();
+    } else if (schema.contains("type") && schema["type"].is_array()) {
+        // Strict mode makes optional fields nullable: ["integer", "null"]
+        for (const auto& option : schema["type"]) {
+            if (option.is_string() && option != "null") {
+                type = option.get<std::string>();
+                break;
+            }
+        }
+    }
+    if (schema.contains("enum") && schema["enum"].is_array() && !schema["enum"].empty()) {
+        return schema["enum"][0];
+    }
+    if (type == "string") {
+        return text;
+    }
+    if (type == "integer") {
+        return 1;
+    }
+    if (type == "number") {
+        return 1.0;
+    }
+    if (type == "boolean") {
+        return true;
+    }
+    if (type == "array") {
+        json items = schema.value("items", json::object());
+        return json::array({sampleFromSchema(items, text)});
+    }
+    json result = json::object();
+    if (schema.contains("properties") && schema["properties"].is_object()) {
+        for (const auto& [key, property] : schema["properties"].items()) {
+            result[key] = sampleFromSchema(property, text);
+        }
+    }
+    return result;
+}
+
+int estimateInputTokens(const std::string& body) {
+    // Rough 4-bytes-per-token heuristic; good enough for a mock
+    return std::max(1, static_cast<int>(body.size() / 4));
+}
+
+void setJsonError(httplib::Response& res, int status, const std::string& type,
+                  const std::string& message, bool anthropicStyle) {
+    json body;
+    if (anthropicStyle) {
+        body = {{"type", "error"}, {"error", {{"type", type}, {"message", message}}}};
+    } else {
+        body = {{"error", {{"type", type}, {"message", message}, {"code", nullptr}}}};
+    }
+    res.status = status;
+    if (status == 429) {
+        res.set_header("retry-after", "0");
+    }
+    res.set_content(body.dump(), "application/json");
+}
+
+}  // namespace
+
+// LatencyDistribution
+
+std::optional<LatencyDistribution> LatencyDistribution::parse(const std::string& spec) {
+    auto colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::vector<double> params;
+    if (colon != std::string::npos) {
+        std::stringstream ss(spec.substr(colon + 1));
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            try {
+                params.push_back(std::stod(item));
+            } catch (const std::exception&) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    auto need = [&](size_t n) { return params.size() == n; };
+    if (kind == "fixed" && need(1)) return fixed(params[0]);
+    if (kind == "uniform" && need(2)) return uniform(params[0], params[1]);
+    if (kind == "normal" && need(2)) return normal(params[0], params[1]);
+    if (kind == "lognormal" && need(2)) return logNormal(params[0], params[1]);
+    if (kind == "exp" && need(1)) return exponential(params[0]);
+    return std::nullopt;
+}
+
+double LatencyDistribution::sampleMs(std::mt19937_64& rng) const {
+    double value = 0.0;
+    switch (kind) {
+        case Kind::Fixed:
+            value = a;
+            break;
+        case Kind::Uniform:
+            value = std::uniform_real_distribution<double>(a, std::max(a, b))(rng);
+            break;
+        case Kind::Normal:
+            value = std::normal_distribution<double>(a, b)(rng);
+            break;
+        case Kind::LogNormal:
+            value = a > 0 ? std::lognormal_distribution<double>(std::log(a), b)(rng) : 0.0;
+            break;
+        case Kind::Exponential:
+            value = a > 0 ? std::exponential_distribution<double>(1.0 / a)(rng) : 0.0;
+            break;
+    }
+    return std::max(0.0, value);
+}
+
+// Payload builders
+
+std::string MockLlmServer::makeText(int tokens, size_t payloadBytes) {
+    std::string text;
+    const size_t wordCount = sizeof(kWords) / sizeof(kWords[0]);
+    for (int i = 0; i < tokens; ++i) {
+        if (i > 0) {
+            text += ' ';
+        }
+        text += kWords[static_cast<size_t>(i) % wordCount];
+    }
+    if (payloadBytes > 0) {
+        if (text.empty()) {
+            text = "x";
+        }
+        std::string padded;
+        padded.reserve(payloadBytes);
+        while (padded.size() < payloadBytes) {
+            padded += text;
+            padded += ' ';
+        }
+        padded.resize(payloadBytes);
+        text = std::move(padded);
+    }
+    return text;
+}
+
+std::vector<std::string> MockLlmServer::splitTokens(const std::string& text, int tokens) {
+    std::vector<std::string> chunks;
+    if (tokens <= 0 || text.empty()) {
+        if (!text.empty()) {
+            chunks.push_back(text);
+        }
+        return chunks;
+    }
+    size_t n = std::min(static_cast<size_t>(tokens), text.size());
+    size_t base = text.size() / n;
+    size_t extra = text.size() % n;
+    size_t pos = 0;
+    for (size_t i = 0; i < n; ++i) {
+        size_t len = base + (i < extra ? 1 : 0);
+        chunks.push_back(text.substr(pos, len));
+        pos += len;
+    }
+    return chunks;
+}
+
+bool MockLlmServer::wantsStructuredOutput(const json& request) {
+    if (request.contains("tools") && request["tools"].is_array() && !request["tools"].empty() &&
+        request["tools"][0].contains("input_schema")) {
+        return true;
+    }
+    if (request.contains("response_format") &&
+        request["response_format"].value("type", std::string()) == "json_schema") {
+        return true;
+    }
+    return request.contains("text") && request["text"].contains("format") &&
+           request["text"]["format"].value("type", std::string()) == "json_schema";
+}
+
+std::string MockLlmServer::sseFrame(const std::string& event, const json& data) {
+    return "event: " + event + "\ndata: " + data.dump() + "\n\n";
+}
+
+json MockLlmServer::makeResponsesBody(const json& request, const std::string& id,
+                                      const std::string& text, int inputTokens,
+                                      int outputTokens) {
+    std::string outputText = text;
+    auto format = request.value("text", json::object()).value("format", json::object());
+    if (format.value("type", std::string()) == "json_schema") {
+        outputText = sampleFromSchema(format.value("schema", json::object()), text).dump();
+    }
+    json content = {
+        {"type", "output_text"},
+        {"text", outputText},
+        {"annotations", json::array()}
+    };
+    json message = {
+        {"type", "message"},
+        {"id", "msg_" + id},
+        {"status", "completed"},
+        {"role", "assistant"},
+        {"content", json::array({content})}
+    };
+    return {
+        {"id", "resp_" + id},
+        {"object", "response"},
+        {"created_at", static_cast<int>(std::time(nullptr))},
+        {"status", "completed"},
+        {"model", request.value("model", std::string("gpt-4o-mini"))},
+        {"output", json::array({message})},
+        {"usage",
+         {{"input_tokens", inputTokens},
+          {"output_tokens", outputTokens},
+          {"total_tokens", inputTokens + outputTokens}}}
+    };
+}
+
+std::vector<std::string> MockLlmServer::makeResponsesEvents(const json& request,
+                                                            const std::string& id,
+                                                            const std::string& text,
+                                                            int inputTokens, int outputTokens) {
+    json finalBody = makeResponsesBody(request, id, text, inputTokens, outputTokens);
+    std::string outputText = finalBody["output"][0]["content"][0]["text"];
+    std::string itemId = finalBody["output"][0]["id"];
+
+    json inProgress = finalBody;
+    inProgress["status"] = "in_progress";
+    inProgress["output"] = json::array();
+    inProgress.erase("usage");
+
+    std::vector<std::string> events;
+    int sequence = 0;
+    events.push_back(sseFrame("response.created", {{"type", "response.created"},
+                                                   {"sequence_number", sequence++},
+                                                   {"response", inProgress}}));
+    for (const auto& chunk : splitTokens(outputText, outputTokens)) {
+        events.push_back(sseFrame("response.output_text.delta",
+                                  {{"type", "response.output_text.delta"},
+                                   {"sequence_number", sequence++},
+                                   {"item_id", itemId},
+                                   {"output_index", 0},
+                                   {"content_index", 0},
+                                   {"delta", chunk}}));
+    }
+    events.push_back(sseFrame("response.output_text.done", {{"type", "response.output_text.done"},
+                                                            {"sequence_number", sequence++},
+                                                            {"item_id", itemId},
+                                                            {"output_index", 0},
+                                                            {"content_index", 0},
+                                                            {"text", outputText}}));
+    events.push_back(sseFrame("response.completed", {{"type", "response.completed"},
+                                                     {"sequence_number", sequence++},
+                                                     {"response", finalBody}}));
+    return events;
+}
+
+json MockLlmServer::makeMessagesBody(const json& request, const std::string& id,
+                                     const std::string& text, int inputTokens, int outputTokens) {
+    json content = json::array();
+    std::string stopReason = "end_turn";
+    auto tools = request.value("tools", json::array());
+    if (tools.is_array() && !tools.empty() && tools[0].contains("input_schema")) {
+        const auto& tool = tools[0];
+        content.push_back({{"type", "tool_use"},
+                           {"id", "toolu_" + id},
+                           {"name", tool.value("name", std::string("tool"))},
+                           {"input", sampleFromSchema(tool["input_schema"], text)}});
+        stopReason = "tool_use";
+    } else {
+        content.push_back({{"type", "text"}, {"text", text}});
+    }
+    return {
+        {"id", "msg_" + id},
+        {"type", "message"},
+        {"role", "assistant"},
+        {"model", request.value("model", std::string("claude-3-5-haiku-20241022"))},
+        {"content", content},
+        {"stop_reason", stopReason},
+        {"stop_sequence", nullptr},
+        {"usage", {{"input_tokens", inputTokens}, {"output_tokens", outputTokens}}}
+    };
+}
+
+std::vector<std::string> MockLlmServer::makeMessagesEvents(const json& request,
+                                                           const std::string& id,
+                                                           const std::string& text,
+                                                           int inputTokens, int outputTokens) {
+    json finalBody = makeMessagesBody(request, id, text, inputTokens, outputTokens);
+    const auto& block = finalBody["content"][0];
+    bool isToolUse = block["type"] == "tool_use";
+
+    json start = finalBody;
+    start["content"] = json::array();
+    start["stop_reason"] = nullptr;
+    start["usage"] = {{"input_tokens", inputTokens}, {"output_tokens", 1}};
+
+    std::vector<std::string> events;
+    events.push_back(sseFrame("message_start", {{"type", "message_start"}, {"message", start}}));
+
+    json blockStart = block;
+    std::string payload;
+    if (isToolUse) {
+        blockStart["input"] = json::object();
+        payload = block["input"].dump();
+    } else {
+        blockStart["text"] = "";
+        payload = block["text"];
+    }
+    events.push_back(sseFrame("content_block_start", {{"type", "content_block_start"},
+                                                      {"index", 0},
+                                                      {"content_block", blockStart}}));
+    for (const auto& chunk : splitTokens(payload, outputTokens)) {
+        json delta = isToolUse ? json{{"type", "input_json_delta"}, {"partial_json", chunk}}
+                               : json{{"type", "text_delta"}, {"text", chunk}};
+        events.push_back(sseFrame(
+            "content_block_delta",
+            {{"type", "content_block_delta"}, {"index", 0}, {"delta", delta}}));
+    }
+    events.push_back(
+        sseFrame("content_block_stop", {{"type", "content_block_stop"}, {"index", 0}}));
+    events.push_back(sseFrame(
+        "message_delta",
+        {{"type", "message_delta"},
+         {"delta", {{"stop_reason", finalBody["stop_reason"]}, {"stop_sequence", nullptr}}},
+         {"usage", {{"output_tokens", outputTokens}}}}));
+    events.push_back(sseFrame("message_stop", {{"type", "message_stop"}}));
+    return events;
+}
+
+json MockLlmServer::makeChatCompletionsBody(const json& request, const std::string& id,
+                                           const std::string& text, int inputTokens,
+                                           int outputTokens) {
+    bool legacy = request.contains("prompt");
+    std::string outputText = text;
+    auto format = request.value("response_format", json::object());
+    if (format.value("type", std::string()) == "json_schema") {
+        auto schema = format.value("json_schema", json::object()).value("schema", json::object());
+        outputText = sampleFromSchema(schema, text).dump();
+    }
+
+    int n = std::max(1, request.value("n", 1));
+    json choices = json::array();
+    for (int i = 0; i < n; ++i) {
+        json choice = {{"index", i}, {"finish_reason", "stop"}};
+        if (legacy) {
+            choice["text"] = outputText;
+        } else {
+            choice["message"] = {{"role", "assistant"}, {"content", outputText}};
+        }
+        choices.push_back(std::move(choice));
+    }
+    return {
+        {"id", (legacy ? "cmpl-" : "chatcmpl-") + id},
+        {"object", legacy ? "text_completion" : "chat.completion"},
+        {"created", static_cast<int>(std::time(nullptr))},
+        {"model", request.value("model", std::string("local-model"))},
+        {"choices", choices},
+        {"usage",
+         {{"prompt_tokens", inputTokens},
+          {"completion_tokens", outputTokens * n},
+          {"total_tokens", inputTokens + outputTokens * n}}}
+    };
+}
+
+std::vector<std::string> MockLlmServer::makeChatCompletionsEvents(const json& request,
+                                                                  const std::string& id,
+                                                                  const std::string& text,
+                                                                  int inputTokens,
+                                                                  int outputTokens) {
+    json finalBody = makeChatCompletionsBody(request, id, text, inputTokens, outputTokens);
+    bool legacy = request.contains("prompt");
+    const auto& first = finalBody["choices"][0];
+    std::string outputText = legacy ? first["text"] : first["message"]["content"];
+
+    auto frame = [](const json& data) { return "data: " + data.dump() + "\n\n"; };
+    auto chunk = [&](json choices) {
+        return json{{"id", finalBody["id"]},
+                    {"object", legacy ? "text_completion" : "chat.completion.chunk"},
+                    {"created", finalBody["created"]},
+                    {"model", finalBody["model"]},
+                    {"choices", std::move(choices)}};
+    };
+
+    std::vector<std::string> events;
+    for (const auto& piece : splitTokens(outputText, outputTokens)) {
+        json choices = json::array();
+        for (const auto& choice : finalBody["choices"]) {
+            json delta = {{"index", choice["index"]}, {"finish_reason", nullptr}};
+            if (legacy) {
+                delta["text"] = piece;
+            } else {
+                delta["delta"] = {{"content", piece}};
+            }
+            choices.push_back(std::move(delta));
+        }
+        events.push_back(frame(chunk(std::move(choices))));
+    }
+    if (request.value("stream_options", json::object()).value("include_usage", false)) {
+        json usageChunk = chunk(json::array());
+        usageChunk["usage"] = finalBody["usage"];
+        events.push_back(frame(usageChunk));
+    }
+    events.push_back("data: [DONE]\n\n");
+    return events;
+}
+
+// Server
+
+class MockLlmServer::Impl {
+   public:
+    explicit Impl(MockServerConfig config) : config_(std::move(config)), rng_(config_.seed) {
+        server_.new_task_queue = [threads = config_.threads]() {
+            return new httplib::ThreadPool(static_cast<size_t>(std::max(1, threads)));
+        };
+        server_.Post("/v1/responses", [this](const httplib::Request& req, httplib::Response& res) {
+            handle(req, res, Api::Responses);
+        });
+        server_.Post("/v1/messages", [this](const httplib::Request& req, httplib::Response& res) {
+            handle(req, res, Api::Messages);
+        });
+        auto chat = [this](const httplib::Request& req, httplib::Response& res) {
+            handle(req, res, Api::ChatCompletions);
+        };
+        server_.Post("/v1/chat/completions", chat);
+        server_.Post("/v1/completions", chat);
+    }
+
+    ~Impl() { stop(); }
+
+    int start(const std::string& host, int port) {
+        if (port == 0) {
+            port_ = server_.bind_to_any_port(host);
+        } else {
+            port_ = server_.bind_to_port(host, port) ? port : -1;
+        }
+        if (port_ <= 0) {
+            throw std::runtime_error("MockLlmServer: failed to bind " + host);
+        }
+        host_ = host;
+        thread_ = std::thread([this]() { server_.listen_after_bind(); });
+        server_.wait_until_ready();
+        return port_;
+    }
+
+    void stop() {
+        if (thread_.joinable()) {
+            server_.stop();
+            thread_.join();
+        }
+    }
+
+    int port() const { return port_; }
+    std::string baseUrl() const { return "http://" + host_ + ":" + std::to_string(port_); }
+
+    MockServerStats stats() const {
+        MockServerStats s;
+        s.requests = requests_.load();
+        s.streamed = streamed_.load();
+        s.injected429 = injected429_.load();
+        s.injected5xx = injected5xx_.load();
+        return s;
+    }
+
+   private:
+    enum class Api { Responses, Messages, ChatCompletions };
+
+    struct Draw {
+        double ttftMs;
+        double roll;
+        int status5xx;
+    };
+
+    Draw draw() {
+        std::lock_guard<std::mutex> lock(rngMutex_);
+        Draw d;
+        d.ttftMs = config_.timeToFirstToken.sampleMs(rng_);
+        d.roll = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+        static const int codes[] = {500, 502, 503};
+        d.status5xx = codes[std::uniform_int_distribution<int>(0, 2)(rng_)];
+        return d;
+    }
+
+    void handle(const httplib::Request& req, httplib::Response& res, Api api) {
+        bool anthropic = api == Api::Messages;
+        auto id = std::to_string(++requests_);
+        auto d = draw();
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(d.ttftMs));
+
+        if (d.roll < config_.rate429) {
+            ++injected429_;
+            setJsonError(res, 429, anthropic ? "rate_limit_error" : "rate_limit_exceeded",
+                         "Rate limit exceeded (mock)", anthropic);
+            return;
+        }
+        if (d.roll < config_.rate429 + config_.rate5xx) {
+            ++injected5xx_;
+            setJsonError(res, d.status5xx, anthropic ? "api_error" : "server_error",
+                         "Injected server error (mock)", anthropic);
+            return;
+        }
+
+        json request = json::parse(req.body, nullptr, /*allow_exceptions=*/false);
+        if (request.is_discarded() || !request.is_object()) {
+            setJsonError(res, 400, "invalid_request_error", "Malformed JSON body", anthropic);
+            return;
+        }
+
+        int inputTokens = estimateInputTokens(req.body);
+        int outputTokens = config_.outputTokens;
+        auto text = makeText(outputTokens, config_.payloadBytes);
+
+        if (!request.value("stream", false)) {
+            json body;
+            switch (api) {
+                case Api::Responses:
+                    body = makeResponsesBody(request, id, text, inputTokens, outputTokens);
+                    break;
+                case Api::Messages:
+                    body = makeMessagesBody(request, id, text, inputTokens, outputTokens);
+                    break;
+                case Api::ChatCompletions:
+                    body = makeChatCompletionsBody(request, id, text, inputTokens, outputTokens);
+                    break;
+            }
+            res.status = 200;
+            res.set_content(body.dump(), "application/json");
+            return;
+        }
+
+        ++streamed_;
+        auto events = std::make_shared<std::vector<std::string>>();
+        switch (api) {
+            case Api::Responses:
+                *events = makeResponsesEvents(request, id, text, inputTokens, outputTokens);
+                break;
+            case Api::Messages:
+                *events = makeMessagesEvents(request, id, text, inputTokens, outputTokens);
+                break;
+            case Api::ChatCompletions:
+                *events = makeChatCompletionsEvents(request, id, text, inputTokens, outputTokens);
+                break;
+        }
+        double tokensPerSecond = config_.tokensPerSecond;
+        res.status = 200;
+        res.set_header("Cache-Control", "no-cache");
+        res.set_chunked_content_provider(
+            "text/event-stream", [events, tokensPerSecond](size_t, httplib::DataSink& sink) {
+                auto interval = tokensPerSecond > 0
+                                    ? std::chrono::duration<double>(1.0 / tokensPerSecond)
+                                    : std::chrono::duration<double>(0.0);
+                for (const auto& frame : *events) {
+                    if (!sink.write(frame.data(), frame.size())) {
+                        return false;  // Client went away
+                    }
+                    if (interval.count() > 0) {
+                        std::this_thread::sleep_for(interval);
+                    }
+                }
+                sink.done();
+                return true;
+            });
+    }
+
+    MockServerConfig config_;
+    httplib::Server server_;
+    std::thread thread_;
+    std::string host_ = "127.0.0.1";
+    int port_ = -1;
+
+    std::mutex rngMutex_;
+    std::mt19937_64 rng_;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> streamed_{0};
+    std::atomic<uint64_t> injected429_{0};
+    std::atomic<uint64_t> injected5xx_{0};
+};
+
+MockLlmServer::MockLlmServer(MockServerConfig config)
+    : impl_(std::make_unique<Impl>(std::move(config))) {}
+
+MockLlmServer::~MockLlmServer() = default;
+
+int MockLlmServer::start(const std::string& host, int port) { return impl_->start(host, port); }
+
+void MockLlmServer::stop() { impl_->stop(); }
+
+int MockLlmServer::port() const { return impl_->port(); }
+
+std::string MockLlmServer::baseUrl() const { return impl_->baseUrl(); }
+
+MockServerStats MockLlmServer::stats() const { return impl_->stats(); }
+
+}  // namespace llmcpp::mock
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace llmcpp::mock {
+
+/**
+ * @brief Latency model used by the mock server (all values in milliseconds)
+ */
+struct LatencyDistribution {
+    enum class Kind { Fixed, Uniform, Normal, LogNormal, Exponential };
+
+    Kind kind = Kind::Fixed;
+    double a = 0.0;  // Fixed: value, Uniform: min, Normal: mean, LogNormal: median, Exp: mean
+    double b = 0.0;  // Uniform: max, Normal: stddev, LogNormal: sigma
+
+    static LatencyDistribution fixed(double ms) { return {Kind::Fixed, ms, 0.0}; }
+    static LatencyDistribution uniform(double minMs, double maxMs) {
+        return {Kind::Uniform, minMs, maxMs};
+    }
+    static LatencyDistribution normal(double meanMs, double stddevMs) {
+        return {Kind::Normal, meanMs, stddevMs};
+    }
+    static LatencyDistribution logNormal(double medianMs, double sigma) {
+        return {Kind::LogNormal, medianMs, sigma};
+    }
+    static LatencyDistribution exponential(double meanMs) {
+        return {Kind::Exponential, meanMs, 0.0};
+    }
+
+    /**
+     * @brief Parse "fixed:50", "uniform:10,100", "normal:80,20", "lognormal:80,0.5" or "exp:50"
+     */
+    static std::optional<LatencyDistribution> parse(const std::string& spec);
+
+    // Draw a sample; never negative
+    double sampleMs(std::mt19937_64& rng) const;
+};
+
+/**
+ * @brief Behaviour of the mock server
+ */
+struct MockServerConfig {
+    LatencyDistribution timeToFirstToken;  // Delay before the response (or first SSE event)
+    double tokensPerSecond = 0.0;          // SSE pacing; 0 streams as fast as possible
+    int outputTokens = 32;                 // Tokens per response
+    size_t payloadBytes = 0;               // Pad/truncate output text to this size (0 = natural)
+    double rate429 = 0.0;                  // Probability of an injected 429
+    double rate5xx = 0.0;                  // Probability of an injected 500/502/503
+    int threads = 32;                      // Server worker threads
+    uint64_t seed = 42;
+};
+
+struct MockServerStats {
+    uint64_t requests = 0;
+    uint64_t streamed = 0;
+    uint64_t injected429 = 0;
+    uint64_t injected5xx = 0;
+};
+
+/**
+ * @brief In-process OpenAI/Anthropic look-alike built on httplib::Server
+ *
+ * Implements `POST /v1/responses` (OpenAI Responses API), `POST /v1/messages`
+ * (Anthropic Messages API) and the OpenAI-compatible `POST /v1/chat/completions` and
+ * `POST /v1/completions` served by llama.cpp and vLLM, all as plain JSON and as SSE when
+ * the request sets `"stream": true`. Intended for deterministic load and latency benchmarks
+ * that must not depend on real API keys or the internet.
+ *
+ * Example usage:
+ * @code
+ * llmcpp::mock::MockLlmServer server({.outputTokens = 64});
+ * server.start();
+ * OpenAI::OpenAIConfig config;
+ * config.apiKey = "mock";
+ * config.baseUrl = server.baseUrl() + "/v1";
+ * OpenAIClient client(config);
+ * @endcode
+ */
+class MockLlmServer {
+   public:
+    explicit MockLlmServer(MockServerConfig config = {});
+    ~MockLlmServer();
+
+    MockLlmServer(const MockLlmServer&) = delete;
+    MockLlmServer& operator=(const MockLlmServer&) = delete;
+
+    // Bind and start serving on a background thread; port 0 picks a free port
+    int start(const std::string& host = "127.0.0.1", int port = 0);
+    void stop();
+
+    int port() const;
+    std::string baseUrl() const;
+    MockServerStats stats() const;
+
+    // Canned payload builders (public so they can be unit tested without sockets)
+    static std::string makeText(int tokens, size_t payloadBytes);
+    static std::vector<std::string> splitTokens(const std::string& text, int tokens);
+    static bool wantsStructuredOutput(const nlohmann::json& request);
+
+    static nlohmann::json makeResponsesBody(const nlohmann::json& request, const std::string& id,
+                                            const std::string& text, int inputTokens,
+                                            int outputTokens);
+    static std::vector<std::string> makeResponsesEvents(const nlohmann::json& request,
+                                                        const std::string& id,
+                                                        const std::string& text, int inputTokens,
+                                                        int outputTokens);
+
+    static nlohmann::json makeMessagesBody(const nlohmann::json& request, const std::string& id,
+                                           const std::string& text, int inputTokens,
+                                           int outputTokens);
+    static std::vector<std::string> makeMessagesEvents(const nlohmann::json& request,
+                                                       const std::string& id,
+                                                       const std::string& text, int inputTokens,
+                                                       int outputTokens);
+
+    // Chat Completions, or legacy Completions when the request has a "prompt"; honours `n`
+    static nlohmann::json makeChatCompletionsBody(const nlohmann::json& request,
+                                                  const std::string& id, const std::string& text,
+                                                  int inputTokens, int outputTokens);
+    // Data-only frames ending with `data: [DONE]`, as OpenAI-compatible servers send them
+    static std::vector<std::string> makeChatCompletionsEvents(const nlohmann::json& request,
+                                                              const std::string& id,
+                                                              const std::string& text,
+                                                              int inputTokens, int outputTokens);
+
+    static std::string sseFrame(const std::string& event, const nlohmann::json& data);
+
+   private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace llmcpp::mock
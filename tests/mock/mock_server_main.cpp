@@ -0,0 +1,79 @@
+// Standalone mock server, for driving llmcpp_loadgen --server from another process
+//
+// Usage: llmcpp_mock_server [--port N] [--ttft SPEC] [--tps N] [--tokens N]
+//                           [--payload-bytes N] [--rate-429 P] [--rate-5xx P] [--threads N]
+
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "mock/MockLlmServer.h"
+
+using llmcpp::mock::LatencyDistribution;
+using llmcpp::mock::MockLlmServer;
+using llmcpp::mock::MockServerConfig;
+
+namespace {
+volatile std::sig_atomic_t stopRequested = 0;
+void onSignal(int) { stopRequested = 1; }
+}  // namespace
+
+int main(int argc, char** argv) {
+    MockServerConfig config;
+    int port = 8089;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            std::string value = argv[++i];
+            if (arg == "--port") {
+                port = std::stoi(value);
+            } else if (arg == "--ttft") {
+                auto dist = LatencyDistribution::parse(value);
+                if (!dist) {
+                    throw std::invalid_argument("Invalid latency distribution: " + value);
+                }
+                config.timeToFirstToken = *dist;
+            } else if (arg == "--tps") {
+                config.tokensPerSecond = std::stod(value);
+            } else if (arg == "--tokens") {
+                config.outputTokens = std::stoi(value);
+            } else if (arg == "--payload-bytes") {
+                config.payloadBytes = static_cast<size_t>(std::stoul(value));
+            } else if (arg == "--rate-429") {
+                config.rate429 = std::stod(value);
+            } else if (arg == "--rate-5xx") {
+                config.rate5xx = std::stod(value);
+            } else if (arg == "--threads") {
+                config.threads = std::stoi(value);
+            } else {
+                throw std::invalid_argument("Unknown argument: " + arg);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    MockLlmServer server(config);
+    server.start("127.0.0.1", port);
+    std::cout << "Mock LLM server listening on " << server.baseUrl() << std::endl;
+
+    while (!stopRequested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    server.stop();
+
+    auto stats = server.stats();
+    std::cout << "Served " << stats.requests << " requests (" << stats.streamed << " streamed, "
+              << stats.injected429 << " x 429, " << stats.injected5xx << " x 5xx)" << std::endl;
+    return 0;
+}
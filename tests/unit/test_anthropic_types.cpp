@@ -342,3 +342,107 @@ TEST_CASE("Anthropic AnthropicConfig structure", "[anthropic][unit]") {
         REQUIRE(config.timeoutSeconds == 60);
     }
 }
+
+TEST_CASE("Anthropic AnthropicConfig JSON round trip", "[anthropic][unit]") {
+    Anthropic::AnthropicConfig config("api-key");
+    config.baseUrl = "http://127.0.0.1:8080";
+    config.defaultModel = Anthropic::Model::CLAUDE_HAIKU_3_5;
+    config.timeoutSeconds = 90;
+
+    auto j = config.toJson();
+    REQUIRE(j["default_model"] == "claude-3-5-haiku-20241022");
+
+    auto parsed = Anthropic::AnthropicConfig::fromJson(j);
+    REQUIRE(parsed.apiKey == "api-key");
+    REQUIRE(parsed.baseUrl == "http://127.0.0.1:8080");
+    REQUIRE(parsed.anthropicVersion == "2023-06-01");
+    REQUIRE(parsed.defaultModel == Anthropic::Model::CLAUDE_HAIKU_3_5);
+    REQUIRE(parsed.timeoutSeconds == 90);
+
+    // Unset fields keep their defaults; camelCase apiKey is accepted
+    auto minimal = Anthropic::AnthropicConfig::fromJson(json{{"apiKey", "k"}});
+    REQUIRE(minimal.apiKey == "k");
+    REQUIRE(minimal.baseUrl == "https://api.anthropic.com");
+    REQUIRE(minimal.timeoutSeconds == 30);
+}
+
+TEST_CASE("Anthropic prompt caching", "[anthropic][unit]") {
+    SECTION("cache_control on content, tools and system blocks") {
+        auto block = Anthropic::MessageContent::createText("Long reference document");
+        block.cacheControl = Anthropic::CacheControl{};
+        REQUIRE(block.toJson()["cache_control"] == json{{"type", "ephemeral"}});
+
+        Anthropic::Tool tool{"lookup", "Find a record", {{"type", "object"}}};
+        tool.cacheControl = Anthropic::CacheControl::fromJson({{"type", "ephemeral"},
+                                                               {"ttl", "1h"}});
+        REQUIRE(tool.toJson()["cache_control"]["ttl"] == "1h");
+
+        Anthropic::MessagesRequest request;
+        request.model = "claude-3-5-haiku-20241022";
+        request.system = "ignored when blocks are set";
+        request.systemBlocks.push_back(block);
+        auto j = request.toJson();
+        REQUIRE(j["system"].is_array());
+        REQUIRE(j["system"][0]["text"] == "Long reference document");
+        REQUIRE(j["system"][0]["cache_control"]["type"] == "ephemeral");
+
+        auto plain = Anthropic::MessageContent::createText("hi").toJson();
+        REQUIRE_FALSE(plain.contains("cache_control"));
+    }
+
+    SECTION("fromLLMRequest moves the prompt ahead of the context when caching") {
+        LLMRequestConfig config;
+        config.model = "claude-3-5-haiku-20241022";
+        config.temperature = 0.7f;
+        config.extensions["cache_control"] = "ephemeral";
+        LLMContext context = {json{{"role", "user"}, {"content", "Ticket #1"}}};
+
+        auto request = Anthropic::MessagesRequest::fromLLMRequest(
+            LLMRequest(config, "Classify the ticket", context));
+        REQUIRE(request.messages.size() == 1);
+        REQUIRE(request.messages[0].content[0].text == "Ticket #1");
+        REQUIRE(request.systemBlocks.size() == 1);
+        REQUIRE(request.systemBlocks[0].text == "Classify the ticket");
+        REQUIRE(request.systemBlocks[0].cacheControl.has_value());
+        REQUIRE(request.toJson()["temperature"].dump() == "0.7");
+
+        // Same prompt, different context: same cached prefix
+        LLMContext other = {json{{"role", "user"}, {"content", "Ticket #2"}}};
+        auto next = Anthropic::MessagesRequest::fromLLMRequest(
+            LLMRequest(config, "Classify the ticket", other));
+        REQUIRE(next.staticPrefix() == request.staticPrefix());
+
+        auto changed = Anthropic::MessagesRequest::fromLLMRequest(
+            LLMRequest(config, "Summarize the ticket", context));
+        REQUIRE(changed.staticPrefix() != request.staticPrefix());
+    }
+
+    SECTION("Without context the prompt stays the cached user message") {
+        LLMRequestConfig config;
+        config.extensions["cache_control"] = {{"type", "ephemeral"}};
+        auto request = Anthropic::MessagesRequest::fromLLMRequest(LLMRequest(config, "Hello"));
+        REQUIRE(request.systemBlocks.empty());
+        REQUIRE(request.messages.size() == 1);
+        REQUIRE(request.messages[0].content[0].cacheControl.has_value());
+        REQUIRE(request.staticPrefix().bytes.find("Hello") != std::string::npos);
+    }
+
+    SECTION("Cache usage counters") {
+        json responseJson = {
+            {"content", json::array({{{"type", "text"}, {"text", "ok"}}})},
+            {"usage",
+             {{"input_tokens", 12},
+              {"output_tokens", 4},
+              {"cache_read_input_tokens", 2048},
+              {"cache_creation_input_tokens", nullptr}}}};
+        auto response = Anthropic::MessagesResponse::fromJson(responseJson);
+        REQUIRE(response.usage.cacheReadInputTokens == 2048);
+        REQUIRE(response.usage.cacheCreationInputTokens == 0);
+
+        auto usage = response.toLLMResponse(false).usage;
+        REQUIRE(usage.inputTokens == 2060);
+        REQUIRE(usage.cachedInputTokens == 2048);
+        REQUIRE(usage.outputTokens == 4);
+        REQUIRE(usage.cacheHitRate() > 0.99);
+    }
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "core/CancellationToken.h"
+#include "core/LLMTypes.h"
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+TEST_CASE("Default tokens are never cancelled", "[cancellation][unit]") {
+    llmcpp::CancellationToken token;
+    REQUIRE_FALSE(token.stop_possible());
+    REQUIRE_NOTHROW(llmcpp::throwIfCancelled(token));
+    REQUIRE(llmcpp::sleepFor(token, 1ms));
+
+    LLMRequestConfig config;
+    LLMRequest request(config, "hello");
+    REQUIRE_FALSE(request.cancellation.stop_possible());
+}
+
+TEST_CASE("Cancelling a source reaches every copy of its token", "[cancellation][unit]") {
+    llmcpp::CancellationSource source;
+    LLMRequestConfig config;
+    LLMRequest request(config, "hello");
+    request.cancellation = source.get_token();
+    LLMRequest copy = request;
+
+    std::atomic<int> callbacks{0};
+    std::stop_callback onCancel(copy.cancellation, [&callbacks]() { ++callbacks; });
+    REQUIRE_NOTHROW(llmcpp::throwIfCancelled(copy.cancellation));
+
+    source.request_stop();
+    REQUIRE(callbacks == 1);
+    REQUIRE_THROWS_AS(llmcpp::throwIfCancelled(request.cancellation), llmcpp::OperationCancelled);
+    REQUIRE_THROWS_AS(llmcpp::throwIfCancelled(copy.cancellation), llmcpp::OperationCancelled);
+
+    // A second request changes nothing
+    source.request_stop();
+    REQUIRE(callbacks == 1);
+}
+
+TEST_CASE("Polling sleeps wake up on cancellation", "[cancellation][unit]") {
+    llmcpp::CancellationSource source;
+
+    SECTION("Uncancelled sleeps run to completion") {
+        auto start = Clock::now();
+        REQUIRE(llmcpp::sleepFor(source.get_token(), 20ms));
+        REQUIRE(Clock::now() - start >= 20ms);
+    }
+
+    SECTION("Cancellation from another thread ends the sleep early") {
+        std::thread canceller([&source]() {
+            std::this_thread::sleep_for(20ms);
+            source.request_stop();
+        });
+        auto start = Clock::now();
+        REQUIRE_FALSE(llmcpp::sleepFor(source.get_token(), 10s));
+        REQUIRE(Clock::now() - start < 5s);
+        canceller.join();
+    }
+
+    SECTION("Already cancelled tokens do not sleep") {
+        source.request_stop();
+        auto start = Clock::now();
+        REQUIRE_FALSE(llmcpp::sleepFor(source.get_token(), 10s));
+        REQUIRE(Clock::now() - start < 1s);
+    }
+}
@@ -1,6 +1,11 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
 #include <set>
+#include <thread>
 #include <vector>
 
 #include "anthropic/AnthropicClient.h"
@@ -9,6 +14,7 @@
 #include "core/LLMTypes.h"
 #include "openai/OpenAIClient.h"
 #include "openai/OpenAISchemaBuilder.h"
+#include "providers/ClientFactory.h"
 
 TEST_CASE("ClientFactory provider registration", "[client][factory]") {
     // Test that we can create a client factory
@@ -71,6 +77,50 @@ TEST_CASE("ClientFactory unsupported providers", "[client][factory][errors]") {
     }
 }
 
+TEST_CASE("ClientFactory provider registry", "[client][factory]") {
+    struct ConfiguredClient : LLMClient {
+        explicit ConfiguredClient(json c) : config(std::move(c)) {}
+        void sendRequest(const LLMRequest&, LLMResponseCallback) override {}
+        std::string getClientName() const override { return "configured"; }
+        json config;
+    };
+
+    REQUIRE_FALSE(llmcpp::ClientFactory::isProviderSupported("test-local"));
+    llmcpp::ProviderRegistrar registrar("test-local", [](const json& config) {
+        return std::make_unique<ConfiguredClient>(config);
+    });
+
+    SECTION("Registered providers receive the full config") {
+        json config = {{"base_url", "http://127.0.0.1:8080/v1"}, {"timeout_seconds", 120}};
+        auto client = llmcpp::ClientFactory::createClient("test-local", config);
+        REQUIRE(client != nullptr);
+        REQUIRE(static_cast<ConfiguredClient&>(*client).config == config);
+
+        // The instance-style factory shares the registry
+        ClientFactory factory;
+        REQUIRE(factory.isProviderSupported("test-local"));
+        auto providers = factory.getSupportedProviders();
+        REQUIRE(std::is_sorted(providers.begin(), providers.end()));
+        REQUIRE(std::find(providers.begin(), providers.end(), "openai") != providers.end());
+        REQUIRE(std::find(providers.begin(), providers.end(), "anthropic") != providers.end());
+    }
+
+    SECTION("API key shorthand") {
+        auto client = llmcpp::ClientFactory::createClient("test-local", "key");
+        REQUIRE(static_cast<ConfiguredClient&>(*client).config == json{{"api_key", "key"}});
+    }
+
+    SECTION("Built-in providers read their config") {
+        auto client = llmcpp::ClientFactory::createClient(
+            "anthropic", json{{"api_key", "test-key"}, {"timeout_seconds", 5}});
+        REQUIRE(client != nullptr);
+        REQUIRE(client->getClientName() == "AnthropicClient");
+    }
+
+    REQUIRE(llmcpp::ClientFactory::unregisterProvider("test-local"));
+    REQUIRE(llmcpp::ClientFactory::createClient("test-local", json::object()) == nullptr);
+}
+
 TEST_CASE("ClientManager lifecycle", "[client][manager]") {
     ClientManager manager;
 
@@ -189,8 +239,88 @@ TEST_CASE("ClientManager concurrency", "[client][manager][concurrency]") {
     }
 
     SECTION("Concurrent client access") {
-        // Test concurrent access to clients
-        REQUIRE(true);
+        // Lookups run against published snapshots while another thread adds and removes
+        struct NullClient : LLMClient {
+            void sendRequest(const LLMRequest&, LLMResponseCallback) override {}
+            std::string getClientName() const override { return "null"; }
+        };
+        auto stable = std::make_shared<NullClient>();
+        REQUIRE(manager.addClient("stable", stable));
+
+        std::atomic<bool> done{false};
+        std::atomic<int> misses{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < 4; ++t) {
+            readers.emplace_back([&] {
+                while (!done.load()) {
+                    if (manager.getClient("stable") != stable) {
+                        ++misses;
+                    }
+                    auto churn = manager.getClient("churn");
+                    if (churn && churn->getClientName() != "null") {
+                        ++misses;
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < 500; ++i) {
+            manager.addClient("churn", std::make_shared<NullClient>());
+            manager.removeClient("churn");
+        }
+        done = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        REQUIRE(misses == 0);
+        REQUIRE(manager.getClientCount() == 1);
+        REQUIRE_FALSE(manager.addClient("stable", stable));
+        REQUIRE(manager.removeClient("stable"));
+        REQUIRE(manager.getClient("stable") == nullptr);
+        REQUIRE(stable.use_count() == 1);
+    }
+}
+
+TEST_CASE("ClientManager snapshots release clients", "[client][manager][concurrency]") {
+    struct NullClient : LLMClient {
+        void sendRequest(const LLMRequest&, LLMResponseCallback) override {}
+        std::string getClientName() const override { return "null"; }
+    };
+    auto first = std::make_unique<ClientManager>();
+    ClientManager second;
+    auto client = std::make_shared<NullClient>();
+    REQUIRE(first->addClient("a", client));
+    REQUIRE(second.addClient("b", std::make_shared<NullClient>()));
+
+    // Alternating managers keeps a snapshot of each on this thread
+    REQUIRE(first->getClient("a") == client);
+    REQUIRE(second.hasClient("b"));
+    REQUIRE(first->hasClient("a"));
+
+    SECTION("Removal on the calling thread") {
+        REQUIRE(first->removeClient("a"));
+        REQUIRE(client.use_count() == 1);
+    }
+
+    SECTION("Another thread lets go of a destroyed manager on its next lookup") {
+        std::promise<void> looked;
+        std::promise<void> destroyed;
+        std::atomic<bool> sawClient{false};
+        std::atomic<long> usesAfterLookup{0};
+        std::thread reader([&, destroyedFuture = destroyed.get_future()] {
+            sawClient = first->hasClient("a") && second.hasClient("b");
+            looked.set_value();
+            destroyedFuture.wait();
+            second.hasClient("b");
+            usesAfterLookup = client.use_count();  // Before thread exit drops the cache
+        });
+        looked.get_future().wait();
+        first.reset();
+        REQUIRE(client.use_count() == 2);  // Still in the reader's snapshot of `first`
+        destroyed.set_value();
+        reader.join();
+        REQUIRE(sawClient);
+        REQUIRE(usesAfterLookup == 1);
     }
 }
 
@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+#include "core/CompiledSchema.h"
+#include "core/JsonSchemaBuilder.h"
+
+using json = nlohmann::json;
+using llmcpp::CompiledSchema;
+
+namespace {
+
+json personSchema() {
+    return JsonSchemaBuilder::object()
+        .property("name", JsonSchemaBuilder::string().minLength(1))
+        .property("age", JsonSchemaBuilder::integer().minimum(0))
+        .property("role", JsonSchemaBuilder::stringEnum({"admin", "user"}))
+        .property("tags", JsonSchemaBuilder::array().items(JsonSchemaBuilder::string()))
+        .required({"name", "age"})
+        .additionalProperties(false)
+        .build();
+}
+
+}  // namespace
+
+TEST_CASE("CompiledSchema validates basic keywords", "[schema][unit]") {
+    auto schema = CompiledSchema::compile(personSchema());
+
+    SECTION("Valid instance") {
+        json person = {{"name", "Ada"}, {"age", 36}, {"role", "admin"}, {"tags", {"x", "y"}}};
+        REQUIRE(schema->validate(person).valid());
+        REQUIRE(schema->isValid(person));
+    }
+
+    SECTION("Type mismatch reports a JSON Pointer path") {
+        auto result = schema->validate({{"name", "Ada"}, {"age", 36}, {"tags", {"x", 3}}});
+        REQUIRE(result.errors.size() == 1);
+        REQUIRE(result.errors[0].path == "/tags/1");
+        REQUIRE(result.errors[0].keyword == "type");
+    }
+
+    SECTION("Missing required and unexpected properties") {
+        auto result = schema->validate({{"name", "Ada"}, {"extra", true}});
+        REQUIRE_FALSE(result);
+        bool sawRequired = false;
+        bool sawAdditional = false;
+        for (const auto& error : result.errors) {
+            sawRequired |= error.keyword == "required";
+            sawAdditional |= error.keyword == "additionalProperties";
+        }
+        REQUIRE(sawRequired);
+        REQUIRE(sawAdditional);
+    }
+
+    SECTION("Enum, minimum and minLength") {
+        REQUIRE_FALSE(schema->isValid({{"name", "Ada"}, {"age", 1}, {"role", "root"}}));
+        REQUIRE_FALSE(schema->isValid({{"name", "Ada"}, {"age", -1}}));
+        REQUIRE_FALSE(schema->isValid({{"name", ""}, {"age", 1}}));
+    }
+
+    SECTION("Integer accepts integral floats only") {
+        REQUIRE(schema->isValid({{"name", "Ada"}, {"age", 3.0}}));
+        REQUIRE_FALSE(schema->isValid({{"name", "Ada"}, {"age", 3.5}}));
+    }
+
+    SECTION("maxErrors caps the error list") {
+        json bad = {{"tags", json::array({1, 2, 3, 4, 5})}};
+        REQUIRE(schema->validate(bad, 2).errors.size() == 2);
+    }
+}
+
+TEST_CASE("CompiledSchema combinators and references", "[schema][unit]") {
+    SECTION("anyOf and oneOf") {
+        auto schema = CompiledSchema::compile(
+            {{"oneOf", {{{"type", "integer"}}, {{"type", "number"}, {"minimum", 10}}}}});
+        REQUIRE(schema->isValid(3));
+        REQUIRE(schema->isValid(10.5));
+        REQUIRE_FALSE(schema->isValid(12));  // Matches both branches
+        REQUIRE_FALSE(schema->isValid("x"));
+
+        auto anyOf = CompiledSchema::compile({{"anyOf", {{{"type", "string"}}, {{"type", "null"}}}}});
+        REQUIRE(anyOf->isValid(nullptr));
+        REQUIRE(anyOf->validate(1).errors.at(0).keyword == "anyOf");
+    }
+
+    SECTION("Recursive local $ref") {
+        json tree = {{"type", "object"},
+                     {"properties",
+                      {{"value", {{"type", "integer"}}},
+                       {"children", {{"type", "array"}, {"items", {{"$ref", "#"}}}}}}},
+                     {"required", {"value"}}};
+        auto schema = CompiledSchema::compile(tree);
+        json ok = {{"value", 1}, {"children", {{{"value", 2}, {"children", json::array()}}}}};
+        json bad = {{"value", 1}, {"children", {{{"value", "two"}}}}};
+        REQUIRE(schema->isValid(ok));
+        auto result = schema->validate(bad);
+        REQUIRE(result.errors.size() == 1);
+        REQUIRE(result.errors[0].path == "/children/0/value");
+    }
+
+    SECTION("$defs references") {
+        json schema = {{"$defs", {{"id", {{"type", "string"}, {"pattern", "^[a-z]+-[0-9]+$"}}}}},
+                       {"type", "array"},
+                       {"items", {{"$ref", "#/$defs/id"}}},
+                       {"uniqueItems", true}};
+        auto compiled = CompiledSchema::compile(schema);
+        REQUIRE(compiled->isValid({"ab-1", "cd-2"}));
+        REQUIRE_FALSE(compiled->isValid({"ab-1", "ab-1"}));
+        REQUIRE_FALSE(compiled->isValid({"AB-1"}));
+    }
+
+    SECTION("Malformed schemas are rejected at compile time") {
+        REQUIRE_THROWS_AS(CompiledSchema::compile({{"type", "strnig"}}), std::invalid_argument);
+        REQUIRE_THROWS_AS(CompiledSchema::compile({{"$ref", "#/missing"}}), std::invalid_argument);
+        REQUIRE_THROWS_AS(CompiledSchema::compile({{"pattern", "("}}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("CompiledSchema cache reuses compiled validators", "[schema][unit]") {
+    CompiledSchema::clearCache();
+    auto first = CompiledSchema::cached(personSchema());
+    auto second = CompiledSchema::cached(personSchema());
+    REQUIRE(first.get() == second.get());
+    REQUIRE(CompiledSchema::cacheSize() == 1);
+
+    auto fromText = CompiledSchema::cached(std::string(R"({"type":"string"})"));
+    REQUIRE(fromText->isValid("hello"));
+    REQUIRE(CompiledSchema::cacheSize() == 2);
+
+    CompiledSchema::clearCache();
+    REQUIRE(CompiledSchema::cacheSize() == 0);
+}
+
+TEST_CASE("validateStructuredOutput gates responses on the request schema", "[schema][unit]") {
+    LLMRequestConfig config;
+    config.schemaObject = personSchema();
+
+    LLMResponse response;
+    response.success = true;
+    response.result = {{"name", "Ada"}};
+
+    SECTION("Disabled by default") {
+        llmcpp::validateStructuredOutput(config, response);
+        REQUIRE(response.success);
+    }
+
+    SECTION("Invalid output becomes an error") {
+        config.validateOutput = true;
+        llmcpp::validateStructuredOutput(config, response);
+        REQUIRE_FALSE(response.success);
+        REQUIRE(response.errorMessage.find("age") != std::string::npos);
+        REQUIRE(response.result == json{{"name", "Ada"}});
+    }
+
+    SECTION("Valid output passes through") {
+        config.validateOutput = true;
+        response.result["age"] = 36;
+        llmcpp::validateStructuredOutput(config, response);
+        REQUIRE(response.success);
+    }
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <string>
+
+#include "core/ContextWindowManager.h"
+
+using llmcpp::ContextWindowManager;
+
+namespace {
+
+// One token per byte keeps the expected counts readable
+size_t countBytes(std::string_view text) { return text.size(); }
+
+json message(const std::string& role, const std::string& content) {
+    return json{{"role", role}, {"content", content}};
+}
+
+LLMRequest makeRequest(LLMContext context, const std::string& model = "custom-model") {
+    LLMRequestConfig config;
+    config.model = model;
+    return LLMRequest(config, "sys", std::move(context));
+}
+
+}  // namespace
+
+TEST_CASE("Model limits", "[context][unit]") {
+    auto gpt4o = ContextWindowManager::modelLimits("gpt-4o-2024-08-06");
+    REQUIRE(gpt4o);
+    REQUIRE(gpt4o->contextWindow == 128000);
+    REQUIRE(ContextWindowManager::modelLimits("gpt-4")->contextWindow == 8192);
+    REQUIRE(ContextWindowManager::modelLimits("gpt-4.1-mini")->contextWindow == 1047576);
+    REQUIRE(ContextWindowManager::modelLimits("claude-sonnet-4-20250514")->contextWindow ==
+            200000);
+    REQUIRE_FALSE(ContextWindowManager::modelLimits("my-local-model"));
+}
+
+TEST_CASE("Context budget", "[context][unit]") {
+    ContextWindowManager manager(countBytes);
+    auto request = makeRequest({}, "gpt-4");
+    REQUIRE(manager.budgetFor(request) == 8192 - 4096);
+
+    request.config.maxTokens = 1000;
+    REQUIRE(manager.budgetFor(request) == 8192 - 1000);
+
+    // The reservation is capped at the model's max output
+    request.config.maxTokens = 50000;
+    REQUIRE(manager.budgetFor(request, "gpt-4o") == 128000 - 16384);
+
+    REQUIRE_FALSE(manager.budgetFor(makeRequest({})));
+    manager.setContextWindow(500);
+    manager.setReservedOutputTokens(100);
+    REQUIRE(manager.budgetFor(makeRequest({})) == 400);
+}
+
+TEST_CASE("Unknown models are not fitted", "[context][unit]") {
+    ContextWindowManager manager(countBytes);
+    auto request = makeRequest({message("user", std::string(100000, 'x'))});
+    auto result = manager.fit(request);
+    REQUIRE_FALSE(result.budget);
+    REQUIRE(result.fits);
+    REQUIRE_FALSE(result.changed());
+    REQUIRE(request.context.size() == 1);
+    REQUIRE_FALSE(manager.fitted(request));
+}
+
+TEST_CASE("Oldest messages are evicted first", "[context][unit]") {
+    ContextWindowManager manager(countBytes);
+    manager.setReservedOutputTokens(0);
+
+    // Each message costs 3 framing + 4 role/4 user + 10 content = 17 or 18 tokens
+    auto request = makeRequest({message("user", "aaaaaaaaaa"), message("assistant", "bbbbbbbbbb"),
+                                message("user", "cccccccccc"), message("user", "dddddddddd")});
+    const size_t full = manager.countTokens(request);
+    manager.setContextWindow(full - 1);
+
+    auto result = manager.fit(request);
+    REQUIRE(result.fits);
+    REQUIRE(result.evictedMessages == 1);
+    REQUIRE_FALSE(result.truncated);
+    REQUIRE(result.tokensBefore == full);
+    REQUIRE(result.tokensAfter == manager.countTokens(request));
+    REQUIRE(request.context.size() == 3);
+    REQUIRE(request.context.front()["content"] == "bbbbbbbbbb");
+    REQUIRE(request.context.back()["content"] == "dddddddddd");
+}
+
+TEST_CASE("The newest message is truncated to its tail", "[context][unit]") {
+    ContextWindowManager manager(countBytes);
+    manager.setReservedOutputTokens(0);
+    manager.setContextWindow(200);
+
+    std::string content(1000, 'a');
+    content += "the end";
+    auto request = makeRequest({message("user", "old"), message("user", content)});
+
+    auto result = manager.fit(request);
+    REQUIRE(result.fits);
+    REQUIRE(result.truncated);
+    REQUIRE(result.evictedMessages == 1);
+    REQUIRE(request.context.size() == 1);
+    const auto kept = request.context.back()["content"].get<std::string>();
+    REQUIRE(kept.size() < content.size());
+    REQUIRE(kept.size() > 100);
+    REQUIRE(content.ends_with(kept));
+    REQUIRE(result.tokensAfter <= 200);
+
+    SECTION("Truncation never splits a UTF-8 sequence") {
+        std::string wide;
+        for (int i = 0; i < 400; ++i) {
+            wide += "\xc3\xa9";  // é
+        }
+        auto utf8 = makeRequest({message("user", wide)});
+        REQUIRE(manager.fit(utf8).truncated);
+        const auto tail = utf8.context.back()["content"].get<std::string>();
+        REQUIRE(tail.size() % 2 == 0);
+        REQUIRE(static_cast<unsigned char>(tail.front()) == 0xC3);
+    }
+}
+
+TEST_CASE("Evicted messages are summarized", "[context][unit]") {
+    ContextWindowManager manager(countBytes);
+    manager.setReservedOutputTokens(0);
+
+    size_t summarizedCount = 0;
+    manager.setSummarizer(
+        [&](const LLMContext& evicted, size_t maxTokens) {
+            summarizedCount = evicted.size();
+            REQUIRE(maxTokens > 0);
+            return LLMContext{message("user", "summary")};
+        },
+        20);
+
+    LLMContext context;
+    for (int i = 0; i < 10; ++i) {
+        context.push_back(message("user", "message number " + std::to_string(i)));
+    }
+    auto request = makeRequest(context);
+    manager.setContextWindow(manager.countTokens(request) / 2);
+
+    auto result = manager.fit(request);
+    REQUIRE(result.fits);
+    REQUIRE(result.summarized);
+    REQUIRE(summarizedCount == result.evictedMessages);
+    REQUIRE(request.context.front()["content"] == "summary");
+    REQUIRE(request.context.back()["content"] == "message number 9");
+    REQUIRE(result.tokensAfter == manager.countTokens(request));
+    REQUIRE(result.tokensAfter <= *result.budget);
+}
+
+TEST_CASE("Requests that cannot fit are rejected", "[context][unit]") {
+    ContextWindowManager manager(countBytes);
+    manager.setReservedOutputTokens(0);
+    manager.setContextWindow(10);
+
+    // The prompt alone is over budget and is never trimmed
+    LLMRequestConfig config;
+    auto request = LLMRequest(config, std::string(100, 'p'), LLMContext{message("user", "hi")});
+    ContextWindowManager::FitResult result;
+    REQUIRE_THROWS_AS(manager.fitted(request, {}, &result), std::length_error);
+    REQUIRE_FALSE(result.fits);
+    REQUIRE(result.evictedMessages == 1);
+    REQUIRE(request.context.size() == 1);  // The caller's request is untouched
+
+    manager.setContextWindow(1000);
+    REQUIRE_FALSE(manager.fitted(request, {}, &result));
+    REQUIRE(result.tokensAfter == manager.countTokens(request));
+}
@@ -0,0 +1,250 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/CostMeter.h"
+
+using llmcpp::CostMeter;
+using llmcpp::ModelPricing;
+
+namespace {
+
+LLMUsage makeUsage(int input, int output, int cached = 0, int cacheWrite = 0, int reasoning = 0) {
+    LLMUsage usage;
+    usage.inputTokens = input;
+    usage.outputTokens = output;
+    usage.cachedInputTokens = cached;
+    usage.cacheCreationInputTokens = cacheWrite;
+    usage.reasoningTokens = reasoning;
+    return usage;
+}
+
+// One token per byte keeps estimates readable
+size_t countBytes(std::string_view text) { return text.size(); }
+
+LLMRequest makeRequest(const std::string& tenant, const std::string& model, int maxTokens) {
+    LLMRequestConfig config;
+    config.model = model;
+    config.tenant = tenant;
+    config.maxTokens = maxTokens;
+    return LLMRequest(config, "hello");
+}
+
+}  // namespace
+
+TEST_CASE("Usage is priced per token class", "[cost][unit]") {
+    const ModelPricing pricing{2.00, 0.50, 0.0, 8.00};
+
+    // 1M uncached input, 1M cached input, 1M output (of which reasoning is a part)
+    auto usage = makeUsage(2000000, 1000000, 1000000, 0, 400000);
+    REQUIRE(CostMeter::cost(usage, pricing) == Catch::Approx(2.00 + 0.50 + 8.00));
+
+    // No cached price: cached tokens cost full input
+    REQUIRE(CostMeter::cost(usage, ModelPricing{2.00, 0.0, 0.0, 8.00}) ==
+            Catch::Approx(2.00 + 2.00 + 8.00));
+
+    // Anthropic cache writes are billed at their own rate
+    auto anthropic = makeUsage(1000000, 0, 0, 1000000);
+    REQUIRE(CostMeter::cost(anthropic, ModelPricing{3.00, 0.30, 3.75, 15.00}) ==
+            Catch::Approx(3.75));
+
+    CostMeter meter;
+    REQUIRE(meter.cost(makeUsage(1000000, 0), "gpt-4o-2024-08-06") == Catch::Approx(2.50));
+    REQUIRE_FALSE(meter.cost(makeUsage(10, 10), "my-finetune"));
+    meter.setPrice("my-finetune", ModelPricing{1.00, 0.0, 0.0, 1.00});
+    REQUIRE(meter.cost(makeUsage(500000, 500000), "my-finetune") == Catch::Approx(1.00));
+}
+
+TEST_CASE("Spend is aggregated per tenant, tag and model", "[cost][unit]") {
+    CostMeter meter;
+    const auto usage = makeUsage(1000, 500, 200, 0, 100);
+    const double each = *meter.cost(usage, "gpt-4.1");
+
+    REQUIRE(meter.record(usage, "gpt-4.1", "acme", "search") == Catch::Approx(each));
+    meter.record(usage, "gpt-4.1", "acme", "search");
+    meter.record(usage, "gpt-4.1", "acme", "chat");
+    meter.record(usage, "gpt-4.1", "globex");
+    meter.record(usage, "my-finetune", "globex");  // Unpriced: tokens counted, no cost
+
+    auto acme = meter.tenantTotals("acme");
+    REQUIRE(acme.requests == 3);
+    REQUIRE(acme.inputTokens == 3000);
+    REQUIRE(acme.cachedInputTokens == 600);
+    REQUIRE(acme.reasoningTokens == 300);
+    REQUIRE(acme.costUsd == Catch::Approx(3 * each));
+    REQUIRE(meter.tenantTotals("globex").requests == 2);
+    REQUIRE(meter.tenantTotals("globex").costUsd == Catch::Approx(each));
+    REQUIRE(meter.tenantTotals("initech").requests == 0);
+    REQUIRE(meter.totals().requests == 5);
+
+    auto series = meter.snapshot();
+    REQUIRE(series.size() == 4);
+    bool found = false;
+    for (const auto& entry : series) {
+        if (entry.tenant == "acme" && entry.tag == "search") {
+            REQUIRE(entry.model == "gpt-4.1");
+            REQUIRE(entry.totals.requests == 2);
+            found = true;
+        }
+    }
+    REQUIRE(found);
+
+    meter.reset();
+    REQUIRE(meter.totals().requests == 0);
+    REQUIRE(meter.snapshot().empty());
+}
+
+TEST_CASE("Series beyond the limit go to the overflow series", "[cost][unit]") {
+    CostMeter meter({}, 2);
+    for (int i = 0; i < 5; ++i) {
+        meter.record(makeUsage(10, 10), "gpt-4o", "tenant" + std::to_string(i));
+    }
+    REQUIRE(meter.totals().requests == 5);
+    auto series = meter.snapshot();
+    REQUIRE(series.size() == 3);
+    REQUIRE(series.back().tenant == "*");
+    REQUIRE(series.back().totals.requests == 3);
+}
+
+TEST_CASE("Budgeted tenants are tracked beyond the series limit", "[cost][unit]") {
+    CostMeter meter(countBytes, 2);
+    meter.record(makeUsage(10, 10), "gpt-4o", "tenant0");
+    meter.record(makeUsage(10, 10), "gpt-4o", "tenant1");
+    meter.setBudget("late", {1.0, CostMeter::BudgetMode::Hard, ""});
+
+    meter.record(makeUsage(400000, 0), "gpt-4o", "late");  // $1.00
+    meter.record(makeUsage(10, 10), "gpt-4o", "unbudgeted");
+    REQUIRE(meter.tenantTotals("late").costUsd == Catch::Approx(1.0));
+    REQUIRE(meter.tenantTotals("unbudgeted").requests == 0);  // Only in the overflow series
+    REQUIRE(meter.totals().requests == 4);
+    REQUIRE(meter.admit(makeRequest("late", "gpt-4o", 1000)).decision ==
+            CostMeter::Decision::Reject);
+
+    meter.reset();
+    REQUIRE(meter.tenantTotals("late").requests == 0);
+    REQUIRE(meter.admit(makeRequest("late", "gpt-4o", 1000)).decision ==
+            CostMeter::Decision::Allow);
+}
+
+TEST_CASE("Concurrent recording loses no updates", "[cost][unit]") {
+    CostMeter meter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&meter, t] {
+            for (int i = 0; i < 1000; ++i) {
+                meter.record(makeUsage(100, 10), "gpt-4o-mini", "tenant" + std::to_string(i % 4),
+                             "tag" + std::to_string(t % 2));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto totals = meter.totals();
+    REQUIRE(totals.requests == 8000);
+    REQUIRE(totals.inputTokens == 800000);
+    REQUIRE(meter.tenantTotals("tenant0").requests == 2000);
+    REQUIRE(meter.snapshot().size() == 8);
+    const double each = *meter.cost(makeUsage(100, 10), "gpt-4o-mini");
+    REQUIRE(totals.costUsd == Catch::Approx(8000 * each));
+}
+
+TEST_CASE("Budgets are enforced before sending", "[cost][unit]") {
+    CostMeter meter(countBytes);
+    auto request = makeRequest("acme", "gpt-4o", 1000);
+    const double estimate = meter.estimate(request, "gpt-4o");
+    REQUIRE(estimate > 0.0);
+
+    SECTION("Tenants without a budget are always admitted") {
+        auto admission = meter.admit(request);
+        REQUIRE(admission.decision == CostMeter::Decision::Allow);
+        REQUIRE_FALSE(admission.limitUsd);
+    }
+
+    SECTION("Hard budgets reject") {
+        meter.setBudget("acme", {1.0, CostMeter::BudgetMode::Hard, ""});
+        REQUIRE(meter.admit(request).decision == CostMeter::Decision::Allow);
+
+        meter.record(makeUsage(400000, 0), "gpt-4o", "acme");  // $1.00
+        auto admission = meter.admit(request);
+        REQUIRE(admission.decision == CostMeter::Decision::Reject);
+        REQUIRE(admission.spentUsd == Catch::Approx(1.0));
+        REQUIRE(admission.estimatedCostUsd == Catch::Approx(estimate));
+    }
+
+    SECTION("Soft budgets downgrade") {
+        meter.setBudget("acme", {1.0, CostMeter::BudgetMode::Soft, "gpt-4o-mini"});
+        meter.record(makeUsage(400000, 0), "gpt-4o", "acme");
+        auto admission = meter.admit(request);
+        REQUIRE(admission.decision == CostMeter::Decision::Downgrade);
+        REQUIRE(admission.model == "gpt-4o-mini");
+        REQUIRE(admission.estimatedCostUsd < estimate);
+
+        // Already on the cheaper model: let it through
+        REQUIRE(meter.admit(request, "gpt-4o-mini").decision == CostMeter::Decision::Allow);
+    }
+
+    REQUIRE_THROWS_AS(meter.setBudget("acme", {-1.0, CostMeter::BudgetMode::Hard, ""}),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Admitted estimates are reserved until the request settles", "[cost][unit]") {
+    CostMeter meter(countBytes);
+    auto request = makeRequest("acme", "gpt-4o", 1000);
+    const double estimate = meter.estimate(request, "gpt-4o");
+    meter.setBudget("acme", {estimate * 2.5, CostMeter::BudgetMode::Hard, ""});
+
+    SECTION("Requests in flight count against the budget") {
+        auto first = meter.admit(request);
+        auto second = meter.admit(request);
+        REQUIRE(first.decision == CostMeter::Decision::Allow);
+        REQUIRE(second.decision == CostMeter::Decision::Allow);
+        REQUIRE(second.pendingUsd == Catch::Approx(estimate));
+
+        auto third = meter.admit(request);
+        REQUIRE(third.decision == CostMeter::Decision::Reject);
+        REQUIRE(third.pendingUsd == Catch::Approx(2 * estimate));
+        REQUIRE(third.reservation.usd() == 0.0);
+
+        // A failed or cancelled request gives its estimate back
+        first.reservation.release();
+        REQUIRE(meter.admit(request).decision == CostMeter::Decision::Allow);
+    }
+
+    SECTION("Settling replaces the estimate with the recorded cost") {
+        auto admission = meter.admit(request);
+        REQUIRE(admission.reservation.usd() == Catch::Approx(estimate));
+        meter.record(makeUsage(10, 10), "gpt-4o", "acme");
+        admission.reservation.release();
+
+        auto next = meter.admit(request);
+        REQUIRE(next.pendingUsd == 0.0);
+        REQUIRE(next.spentUsd == Catch::Approx(*meter.cost(makeUsage(10, 10), "gpt-4o")));
+    }
+
+    SECTION("Concurrent admissions cannot overrun a hard budget") {
+        std::atomic<int> admitted{0};
+        std::vector<std::vector<CostMeter::Admission>> held(8);
+        std::vector<std::thread> threads;
+        for (auto& admissions : held) {
+            threads.emplace_back([&meter, &request, &admitted, &admissions] {
+                for (int i = 0; i < 50; ++i) {
+                    auto admission = meter.admit(request);
+                    if (admission.decision == CostMeter::Decision::Allow) {
+                        ++admitted;
+                        admissions.push_back(std::move(admission));  // Still in flight
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE(admitted == 2);
+    }
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/JsonStructuralScanner.h"
+
+using llmcpp::JsonStructuralScanner;
+using Isa = JsonStructuralScanner::Isa;
+using Range = JsonStructuralScanner::Range;
+
+namespace {
+
+const std::vector<Isa> kIsas = {Isa::Scalar, Isa::SSE2, Isa::AVX2};
+
+// Character-at-a-time reference for matchingBracketEnd
+size_t referenceBracketEnd(const std::string& text, size_t start) {
+    const char open = text[start];
+    const char close = open == '[' ? ']' : '}';
+    int depth = 0;
+    bool inString = false;
+    bool escape = false;
+    for (size_t i = start; i < text.size(); ++i) {
+        char c = text[i];
+        if (inString) {
+            if (escape) {
+                escape = false;
+            } else if (c == '\\') {
+                escape = true;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = true;
+        } else if (c == open) {
+            ++depth;
+        } else if (c == close && --depth == 0) {
+            return i + 1;
+        }
+    }
+    return std::string::npos;
+}
+
+// Character-at-a-time reference for balancedObjects
+std::vector<Range> referenceObjects(const std::string& text) {
+    std::vector<size_t> open;
+    std::vector<Range> ranges;
+    bool inString = false;
+    bool escape = false;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (inString) {
+            if (escape) {
+                escape = false;
+            } else if (c == '\\') {
+                escape = true;
+            } else if (c == '"') {
+                inString = false;
+            }
+        } else if (c == '"') {
+            inString = !open.empty();
+        } else if (c == '{') {
+            open.push_back(i);
+        } else if (c == '}' && !open.empty()) {
+            size_t begin = open.back();
+            open.pop_back();
+            while (!ranges.empty() && ranges.back().begin > begin) {
+                ranges.pop_back();
+            }
+            ranges.push_back({begin, i + 1});
+        }
+    }
+    return ranges;
+}
+
+// Backslash-heavy text mostly takes the per-character fallback; sparse text stays in bulk
+std::string randomText(std::mt19937& rng, size_t length, bool sparseEscapes) {
+    const std::string alphabet =
+        sparseEscapes ? "{}[]\"abcdefghijklmnop :,\n" : "{}[]\"\\\\\"ab :,\n";
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::string text(length, ' ');
+    for (auto& c : text) {
+        c = alphabet[pick(rng)];
+    }
+    return text;
+}
+
+}  // namespace
+
+TEST_CASE("JsonStructuralScanner finds matching brackets", "[scanner][unit]") {
+    for (Isa isa : kIsas) {
+        REQUIRE(JsonStructuralScanner::matchingBracketEnd("[1, [2], \"]\"] tail", 0, isa) == 13);
+        REQUIRE(JsonStructuralScanner::matchingBracketEnd(R"({"a": "\"}", "b": {}})", 0, isa) ==
+                21);
+        REQUIRE(JsonStructuralScanner::matchingBracketEnd("[[[", 0, isa) == std::string::npos);
+        REQUIRE(JsonStructuralScanner::matchingBracketEnd("x[]", 0, isa) == std::string::npos);
+    }
+
+    SECTION("Strings and escape runs spanning block boundaries") {
+        for (size_t pad = 0; pad < 70; ++pad) {
+            std::string text = "[\"" + std::string(pad, 'x') + "\\\\\\\"]\\\\\", 1]";
+            for (Isa isa : kIsas) {
+                REQUIRE(JsonStructuralScanner::matchingBracketEnd(text, 0, isa) ==
+                        referenceBracketEnd(text, 0));
+            }
+        }
+    }
+}
+
+TEST_CASE("JsonStructuralScanner salvages balanced objects", "[scanner][unit]") {
+    std::string text = R"(Note "quoted" [{"a": "}"}, {"b": {"c": 1}}, {"d": )";
+    for (Isa isa : kIsas) {
+        auto ranges = JsonStructuralScanner::balancedObjects(text, isa);
+        REQUIRE(ranges == referenceObjects(text));
+        REQUIRE(ranges.size() == 2);
+        REQUIRE(text.substr(ranges[1].begin, ranges[1].end - ranges[1].begin) ==
+                R"({"b": {"c": 1}})");
+    }
+}
+
+TEST_CASE("JsonStructuralScanner agrees with a character scan", "[scanner][unit]") {
+    std::mt19937 rng(1234);
+    for (int round = 0; round < 2000; ++round) {
+        std::string text = randomText(rng, rng() % 300, round % 2 == 0);
+        if (round % 4 == 0 && !text.empty()) {
+            text[rng() % text.size()] = '\\';
+        }
+        auto expected = referenceObjects(text);
+        for (Isa isa : kIsas) {
+            REQUIRE(JsonStructuralScanner::balancedObjects(text, isa) == expected);
+        }
+        size_t start = text.find_first_of("[{");
+        if (start != std::string::npos) {
+            size_t expectedEnd = referenceBracketEnd(text, start);
+            for (Isa isa : kIsas) {
+                REQUIRE(JsonStructuralScanner::matchingBracketEnd(text, start, isa) == expectedEnd);
+            }
+        }
+    }
+}
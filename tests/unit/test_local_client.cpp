@@ -0,0 +1,229 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+#include "core/CostMeter.h"
+#include "local/LocalClient.h"
+#include "providers/ClientFactory.h"
+
+using namespace Local;
+
+namespace {
+
+LLMRequestConfig modelConfig(const std::string& model = "qwen2.5-7b-instruct") {
+    LLMRequestConfig config;
+    config.client = "local";
+    config.model = model;
+    return config;
+}
+
+}  // namespace
+
+TEST_CASE("Local config JSON round trip", "[local][unit]") {
+    LocalConfig config("http://127.0.0.1:8080/v1");
+    config.defaultModel = "llama-3.1-8b";
+    config.endpoint = Endpoint::Completions;
+    config.headers = {{"X-Tenant", "blue"}};
+    config.timeoutSeconds = 300;
+
+    auto restored = LocalConfig::fromJson(config.toJson());
+    REQUIRE(restored.baseUrl == config.baseUrl);
+    REQUIRE(restored.apiKey.empty());
+    REQUIRE(restored.defaultModel == "llama-3.1-8b");
+    REQUIRE(restored.endpoint == Endpoint::Completions);
+    REQUIRE(restored.headers.at("X-Tenant") == "blue");
+    REQUIRE(restored.timeoutSeconds == 300);
+    REQUIRE(restored.maxRetries == 0);
+
+    REQUIRE(endpointFromString("chat") == Endpoint::ChatCompletions);
+    REQUIRE_THROWS_AS(endpointFromString("embeddings"), std::invalid_argument);
+}
+
+TEST_CASE("Local request bodies", "[local][unit]") {
+    LocalConfig config;
+
+    SECTION("Prompt alone is the user message") {
+        auto body = buildRequestBody(LLMRequest(modelConfig(), "Say hi"), config, false);
+        REQUIRE(body["model"] == "qwen2.5-7b-instruct");
+        REQUIRE(body["messages"].size() == 1);
+        REQUIRE(body["messages"][0]["role"] == "user");
+        REQUIRE(body["messages"][0]["content"] == "Say hi");
+        REQUIRE_FALSE(body.contains("stream"));
+    }
+
+    SECTION("With context the prompt becomes the system message") {
+        LLMContext context = {json{{"role", "user"}, {"content", "What is 2+2?"}},
+                              json{{"notes", "plain values are sent as user text"}}};
+        auto body =
+            buildRequestBody(LLMRequest(modelConfig(), "Answer briefly", context), config, false);
+        const auto& messages = body["messages"];
+        REQUIRE(messages.size() == 3);
+        REQUIRE(messages[0]["role"] == "system");
+        REQUIRE(messages[1]["content"] == "What is 2+2?");
+        REQUIRE(messages[2]["role"] == "user");
+        REQUIRE(messages[2]["content"].get<std::string>().find("notes") != std::string::npos);
+    }
+
+    SECTION("Sampling options, schema and streaming") {
+        auto requestConfig = modelConfig("");
+        requestConfig.maxTokens = 64;
+        requestConfig.temperature = 0.2f;
+        requestConfig.topK = 40;
+        requestConfig.stopSequences = std::vector<std::string>{"\n\n"};
+        requestConfig.functionName = "answer";
+        requestConfig.schemaObject =
+            json{{"type", "object"}, {"properties", {{"value", {{"type", "integer"}}}}}};
+
+        auto body = buildRequestBody(LLMRequest(requestConfig, "2+2"), config, true);
+        REQUIRE_FALSE(body.contains("model"));
+        REQUIRE(body["max_tokens"] == 64);
+        REQUIRE(body["top_k"] == 40);
+        REQUIRE(body["stop"][0] == "\n\n");
+        REQUIRE(body["response_format"]["type"] == "json_schema");
+        REQUIRE(body["response_format"]["json_schema"]["name"] == "answer");
+        REQUIRE(body["response_format"]["json_schema"]["schema"]["type"] == "object");
+        REQUIRE(body["stream"] == true);
+        REQUIRE(body["stream_options"]["include_usage"] == true);
+    }
+
+    SECTION("Default model fills in") {
+        config.defaultModel = "llama-3.1-8b";
+        auto body = buildRequestBody(LLMRequest(modelConfig(""), "hi"), config, false);
+        REQUIRE(body["model"] == "llama-3.1-8b");
+    }
+
+    SECTION("Completions join context and prompt") {
+        config.endpoint = Endpoint::Completions;
+        LLMContext context = {json{{"role", "user"}, {"content", "Once upon a time"}}};
+        auto body = buildRequestBody(LLMRequest(modelConfig(), "Continue:", context), config, false);
+        REQUIRE_FALSE(body.contains("messages"));
+        REQUIRE(body["prompt"] == "Once upon a time\n\nContinue:");
+    }
+
+    SECTION("Invalid schema string") {
+        auto requestConfig = modelConfig();
+        requestConfig.jsonSchema = "{not json";
+        REQUIRE_THROWS_AS(buildRequestBody(LLMRequest(requestConfig, "hi"), config, false),
+                          std::runtime_error);
+    }
+}
+
+TEST_CASE("Local response parsing", "[local][unit]") {
+    SECTION("Chat completion") {
+        json body = {{"id", "chatcmpl-1"},
+                     {"choices", {{{"index", 0}, {"message", {{"content", "Hello"}}}}}},
+                     {"usage", {{"prompt_tokens", 7}, {"completion_tokens", 2}}}};
+        auto response = parseResponse(body, false);
+        REQUIRE(response.success);
+        REQUIRE(response.responseId == "chatcmpl-1");
+        REQUIRE(response.result["text"] == "Hello");
+        REQUIRE(response.usage.inputTokens == 7);
+        REQUIRE(response.usage.outputTokens == 2);
+        REQUIRE_FALSE(response.result.contains("choices"));
+
+        body["usage"]["prompt_tokens_details"] = {{"cached_tokens", 4}};
+        REQUIRE(parseResponse(body, false).usage.cachedInputTokens == 4);
+    }
+
+    SECTION("Completions with several choices") {
+        json body = {{"choices", {{{"index", 1}, {"text", "b"}}, {{"index", 0}, {"text", "a"}}}}};
+        auto response = parseResponse(body, false);
+        REQUIRE(response.success);
+        REQUIRE(response.result["text"] == "a");
+        REQUIRE(response.result["choices"] == json::array({"a", "b"}));
+    }
+
+    SECTION("Structured output") {
+        json body = {{"choices", {{{"message", {{"content", R"({"value":4})"}}}}}}};
+        auto response = parseResponse(body, true);
+        REQUIRE(response.success);
+        REQUIRE(response.result["value"] == 4);
+
+        body["choices"][0]["message"]["content"] = "four";
+        REQUIRE_FALSE(parseResponse(body, true).success);
+    }
+
+    SECTION("Errors") {
+        auto response = parseResponse(json{{"error", {{"message", "model not loaded"}}}}, false);
+        REQUIRE_FALSE(response.success);
+        REQUIRE(response.errorMessage == "model not loaded");
+        REQUIRE_FALSE(parseResponse(json{{"choices", json::array()}}, false).success);
+    }
+}
+
+TEST_CASE("Local stream accumulation", "[local][unit]") {
+    std::string stream =
+        "data: {\"id\":\"chatcmpl-9\",\"choices\":[{\"index\":0,\"delta\":{\"role\":\"assistant\"}}]}"
+        "\n\n"
+        "data: {\"id\":\"chatcmpl-9\",\"choices\":[{\"index\":0,\"delta\":{\"content\":\"Hel\"}},"
+        "{\"index\":1,\"delta\":{\"content\":\"Hi\"}}]}\n\n"
+        ": keep-alive\n\n"
+        "data: {\"id\":\"chatcmpl-9\",\"choices\":[{\"index\":0,\"delta\":{\"content\":\"lo\"}}]}"
+        "\n\n"
+        "data: {\"id\":\"chatcmpl-9\",\"choices\":[],\"usage\":{\"prompt_tokens\":5,"
+        "\"completion_tokens\":3}}\n\n"
+        "data: [DONE]\n\n";
+
+    SECTION("Deltas arrive in order across arbitrary chunk boundaries") {
+        for (size_t step : {size_t{1}, size_t{7}, stream.size()}) {
+            std::vector<std::string> deltas;
+            StreamAccumulator accumulator([&deltas](const std::string& d) { deltas.push_back(d); });
+            for (size_t pos = 0; pos < stream.size(); pos += step) {
+                accumulator.feed(std::string_view(stream).substr(pos, step));
+            }
+            REQUIRE(accumulator.done());
+
+            auto response = accumulator.finish(false);
+            REQUIRE(response.success);
+            REQUIRE(deltas == std::vector<std::string>{"Hel", "lo"});
+            REQUIRE(response.responseId == "chatcmpl-9");
+            REQUIRE(response.result["text"] == "Hello");
+            REQUIRE(response.result["choices"] == json::array({"Hello", "Hi"}));
+            REQUIRE(response.usage.inputTokens == 5);
+            REQUIRE(response.usage.outputTokens == 3);
+        }
+    }
+
+    SECTION("Legacy completions chunks") {
+        StreamAccumulator accumulator;
+        accumulator.feed("data: {\"choices\":[{\"index\":0,\"text\":\"4\"}]}\n\ndata: [DONE]\n\n");
+        auto response = accumulator.finish(true);
+        REQUIRE(response.success);
+        REQUIRE(response.result == 4);
+    }
+
+    SECTION("Error event") {
+        StreamAccumulator accumulator;
+        accumulator.feed("data: {\"error\":{\"message\":\"context length exceeded\"}}\n\n");
+        auto response = accumulator.finish(false);
+        REQUIRE_FALSE(response.success);
+        REQUIRE(response.errorMessage == "context length exceeded");
+    }
+}
+
+TEST_CASE("Local client construction", "[local][unit]") {
+    LocalClient client("http://127.0.0.1:1/v1");
+    REQUIRE(client.getClientName() == "LocalClient");
+    REQUIRE(client.supportsStreaming());
+    REQUIRE(client.getConfig().apiKey.empty());
+
+    auto fromFactory = llmcpp::ClientFactory::createClient(
+        "local", json{{"base_url", "http://127.0.0.1:1/v1"}, {"endpoint", "completions"}});
+    REQUIRE(fromFactory != nullptr);
+    REQUIRE(fromFactory->getClientName() == "LocalClient");
+}
+
+TEST_CASE("Local client applies request hooks", "[local][unit]") {
+    // Nothing listens on port 1, so only a rejection before sending can name the budget
+    LocalClient client("http://127.0.0.1:1/v1");
+    auto meter = std::make_shared<llmcpp::CostMeter>();
+    meter->setBudget("acme", {0.0, llmcpp::CostMeter::BudgetMode::Hard, ""});
+    client.setCostMeter(meter);
+
+    auto config = modelConfig("gpt-4o");
+    config.tenant = "acme";
+    auto response = client.sendRequest(LLMRequest(config, "hello"));
+    REQUIRE_FALSE(response.success);
+    REQUIRE(response.errorMessage.find("Budget exceeded") != std::string::npos);
+    REQUIRE(meter->totals().requests == 0);
+}
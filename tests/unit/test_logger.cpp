@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/Logger.h"
+
+using json = nlohmann::json;
+using namespace llmcpp;
+
+namespace {
+
+class CaptureSink : public LogSink {
+   public:
+    void write(const LogRecord& record) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records_.push_back(record);
+    }
+
+    std::vector<LogRecord> records() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::vector<LogRecord> records_;
+};
+
+// Routes the global logger into a capture sink for the duration of a test
+struct ScopedCapture {
+    std::shared_ptr<CaptureSink> sink = std::make_shared<CaptureSink>();
+    LogLevel previousLevel = Logger::instance().getLevel();
+
+    explicit ScopedCapture(LogLevel level) {
+        Logger::instance().flush();
+        Logger::instance().setSink(sink);
+        Logger::instance().setLevel(level);
+    }
+
+    ~ScopedCapture() {
+        Logger::instance().flush();
+        Logger::instance().setLevel(previousLevel);
+        Logger::instance().setSink(std::make_shared<StderrLogSink>());
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Logger filters by runtime level", "[logger][unit]") {
+    ScopedCapture capture(LogLevel::Warn);
+
+    LLMCPP_LOG_DEBUG("test", "debug message");
+    LLMCPP_LOG_INFO("test", "info message");
+    LLMCPP_LOG_WARN("test", "warn message");
+    LLMCPP_LOG_ERROR("test", "error message", {{"code", 42}});
+    Logger::instance().flush();
+
+    auto records = capture.sink->records();
+    REQUIRE(records.size() == 2);
+    REQUIRE(records[0].level == LogLevel::Warn);
+    REQUIRE(records[0].message == "warn message");
+    REQUIRE(records[1].level == LogLevel::Error);
+    REQUIRE(records[1].component == "test");
+    REQUIRE(records[1].fields["code"] == 42);
+}
+
+TEST_CASE("Disabled log statements don't evaluate their arguments", "[logger][unit]") {
+    ScopedCapture capture(LogLevel::Error);
+
+    int evaluations = 0;
+    auto expensive = [&]() {
+        ++evaluations;
+        return std::string("payload");
+    };
+    LLMCPP_LOG_DEBUG("test", expensive());
+    Logger::instance().flush();
+
+    REQUIRE(evaluations == 0);
+    REQUIRE(capture.sink->records().empty());
+}
+
+TEST_CASE("Logger records are structured", "[logger][unit]") {
+    ScopedCapture capture(LogLevel::Trace);
+
+    LLMCPP_LOG_INFO("openai", "request sent", {{"model", "gpt-4o"}, {"attempt", 1}});
+    Logger::instance().flush();
+
+    auto records = capture.sink->records();
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].timestampUnixNano > 0);
+
+    auto j = records[0].toJson();
+    REQUIRE(j["level"] == "INFO");
+    REQUIRE(j["component"] == "openai");
+    REQUIRE(j["message"] == "request sent");
+    REQUIRE(j["model"] == "gpt-4o");
+    REQUIRE(j["attempt"] == 1);
+    REQUIRE(j["timestamp"].get<std::string>().back() == 'Z');
+}
+
+TEST_CASE("Logger accepts concurrent producers", "[logger][unit]") {
+    ScopedCapture capture(LogLevel::Info);
+
+    const int threads = 4;
+    const int perThread = 500;
+    auto droppedBefore = Logger::instance().droppedCount();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t]() {
+            for (int i = 0; i < perThread; ++i) {
+                LLMCPP_LOG_INFO("worker", "tick", {{"thread", t}, {"i", i}});
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    Logger::instance().flush();
+
+    auto dropped = Logger::instance().droppedCount() - droppedBefore;
+    auto records = capture.sink->records();
+    REQUIRE(records.size() + dropped == static_cast<size_t>(threads * perThread));
+
+    // Per-producer ordering is preserved
+    std::vector<int> lastSeen(threads, -1);
+    for (const auto& record : records) {
+        int t = record.fields["thread"];
+        int i = record.fields["i"];
+        REQUIRE(i > lastSeen[t]);
+        lastSeen[t] = i;
+    }
+}
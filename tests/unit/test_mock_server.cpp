@@ -0,0 +1,339 @@
+#include <httplib.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "anthropic/AnthropicClient.h"
+#include "local/LocalClient.h"
+#include "mock/MockLlmServer.h"
+#include "openai/OpenAIClient.h"
+#include "providers/ClientFactory.h"
+
+using json = nlohmann::json;
+using namespace llmcpp::mock;
+
+TEST_CASE("Mock server latency distributions", "[mock][unit]") {
+    SECTION("Parse specs") {
+        auto fixed = LatencyDistribution::parse("fixed:50");
+        REQUIRE(fixed.has_value());
+        REQUIRE(fixed->kind == LatencyDistribution::Kind::Fixed);
+        REQUIRE(fixed->a == 50.0);
+
+        auto uniform = LatencyDistribution::parse("uniform:10,100");
+        REQUIRE(uniform.has_value());
+        REQUIRE(uniform->b == 100.0);
+
+        REQUIRE(LatencyDistribution::parse("lognormal:80,0.5").has_value());
+        REQUIRE(LatencyDistribution::parse("exp:20").has_value());
+    }
+
+    SECTION("Reject malformed specs") {
+        REQUIRE_FALSE(LatencyDistribution::parse("uniform:10").has_value());
+        REQUIRE_FALSE(LatencyDistribution::parse("gamma:1,2").has_value());
+        REQUIRE_FALSE(LatencyDistribution::parse("fixed:abc").has_value());
+    }
+
+    SECTION("Samples are deterministic for a seed and never negative") {
+        auto dist = LatencyDistribution::normal(1.0, 50.0);
+        std::mt19937_64 a(7), b(7);
+        for (int i = 0; i < 100; ++i) {
+            double sample = dist.sampleMs(a);
+            REQUIRE(sample == dist.sampleMs(b));
+            REQUIRE(sample >= 0.0);
+        }
+    }
+}
+
+TEST_CASE("Mock server canned payloads", "[mock][unit]") {
+    SECTION("Payload size is honoured") {
+        REQUIRE(MockLlmServer::makeText(8, 1000).size() == 1000);
+        REQUIRE(MockLlmServer::makeText(3, 0) == "lorem ipsum dolor");
+    }
+
+    SECTION("Token split reassembles the text") {
+        auto text = MockLlmServer::makeText(10, 0);
+        auto chunks = MockLlmServer::splitTokens(text, 10);
+        REQUIRE(chunks.size() == 10);
+        std::string joined;
+        for (const auto& chunk : chunks) {
+            joined += chunk;
+        }
+        REQUIRE(joined == text);
+    }
+
+    SECTION("Responses body parses as a ResponsesResponse") {
+        json request = {{"model", "gpt-4o-mini"}};
+        auto body = MockLlmServer::makeResponsesBody(request, "1", "hello", 3, 1);
+        auto response = OpenAI::ResponsesResponse::fromJson(body);
+        REQUIRE(response.getOutputText() == "hello");
+        REQUIRE(body["usage"]["total_tokens"] == 4);
+    }
+
+    SECTION("Structured output follows the requested schema") {
+        json request = {
+            {"model", "gpt-4o-mini"},
+            {"text",
+             {{"format",
+               {{"type", "json_schema"},
+                {"schema",
+                 {{"type", "object"},
+                  {"properties", {{"n", {{"type", "integer"}}}, {"s", {{"type", "string"}}}}}}}}}}}};
+        REQUIRE(MockLlmServer::wantsStructuredOutput(request));
+        auto body = MockLlmServer::makeResponsesBody(request, "1", "x", 1, 1);
+        auto output = json::parse(body["output"][0]["content"][0]["text"].get<std::string>());
+        REQUIRE(output["n"] == 1);
+        REQUIRE(output["s"] == "x");
+    }
+
+    SECTION("Messages SSE stream ends with message_stop") {
+        json request = {{"model", "claude-3-5-haiku-20241022"}, {"stream", true}};
+        auto events = MockLlmServer::makeMessagesEvents(request, "1", "a b c", 2, 3);
+        REQUIRE(events.front().rfind("event: message_start\n", 0) == 0);
+        REQUIRE(events.back().rfind("event: message_stop\n", 0) == 0);
+        REQUIRE(events.size() == 3 + 3 + 2);  // start, block start, 3 deltas, stop, delta, stop
+    }
+
+    SECTION("Chat completions honour n and end the stream with [DONE]") {
+        json request = {{"messages", json::array()},
+                        {"n", 2},
+                        {"stream", true},
+                        {"stream_options", {{"include_usage", true}}}};
+        auto body = MockLlmServer::makeChatCompletionsBody(request, "1", "a b", 2, 2);
+        REQUIRE(body["choices"].size() == 2);
+        REQUIRE(body["choices"][1]["message"]["content"] == "a b");
+
+        auto events = MockLlmServer::makeChatCompletionsEvents(request, "1", "a b", 2, 2);
+        REQUIRE(events.size() == 2 + 1 + 1);  // 2 deltas, usage chunk, [DONE]
+        REQUIRE(events.back() == "data: [DONE]\n\n");
+
+        Local::StreamAccumulator accumulator;
+        for (const auto& event : events) {
+            accumulator.feed(event);
+        }
+        auto response = accumulator.finish(false);
+        REQUIRE(response.success);
+        REQUIRE(response.result["choices"] == json::array({"a b", "a b"}));
+        REQUIRE(response.usage.outputTokens == 4);
+    }
+}
+
+TEST_CASE("Mock server round trip with real clients", "[mock][unit]") {
+    MockServerConfig config;
+    config.outputTokens = 4;
+    MockLlmServer server(config);
+    server.start();
+
+    LLMRequestConfig requestConfig;
+    requestConfig.maxTokens = 16;
+
+    SECTION("OpenAI Responses API") {
+        OpenAI::OpenAIConfig openaiConfig;
+        openaiConfig.apiKey = "mock";
+        openaiConfig.baseUrl = server.baseUrl() + "/v1";
+        OpenAIClient client(openaiConfig);
+
+        requestConfig.client = "openai";
+        requestConfig.model = "gpt-4o-mini";
+        auto response = client.sendRequest(LLMRequest(requestConfig, "Say hi"));
+        REQUIRE(response.success);
+        REQUIRE(response.usage.outputTokens == 4);
+    }
+
+    SECTION("OpenAI Chat Completions API") {
+        OpenAI::OpenAIConfig openaiConfig;
+        openaiConfig.apiKey = "mock";
+        openaiConfig.baseUrl = server.baseUrl() + "/v1";
+        OpenAIClient client(openaiConfig);
+
+        requestConfig.client = "openai";
+        requestConfig.model = "gpt-4";  // Not a Responses model: routed to Chat Completions
+        requestConfig.extensions["n"] = 2;
+        auto response = client.sendRequest(LLMRequest(requestConfig, "Say hi"));
+        REQUIRE(response.success);
+        REQUIRE(response.result["choices"].size() == 2);
+        REQUIRE(response.usage.outputTokens == 8);
+
+        std::string streamed;
+        auto streamedResponse =
+            client
+                .sendStreamingRequestAsync(
+                    LLMRequest(requestConfig, "Say hi"),
+                    [&streamed](const std::string& delta) { streamed += delta; })
+                .get();
+        REQUIRE(streamedResponse.success);
+        REQUIRE(streamed == streamedResponse.result["text"].get<std::string>());
+        REQUIRE(streamedResponse.result["choices"].size() == 2);
+        REQUIRE(server.stats().streamed == 1);
+    }
+
+    SECTION("Anthropic Messages API") {
+        Anthropic::AnthropicConfig anthropicConfig("mock");
+        anthropicConfig.baseUrl = server.baseUrl();
+        Anthropic::AnthropicClient client(anthropicConfig);
+
+        requestConfig.client = "anthropic";
+        requestConfig.model = "claude-3-5-haiku-20241022";
+        auto response = client.sendRequest(LLMRequest(requestConfig, "Say hi"));
+        REQUIRE(response.success);
+        REQUIRE(response.usage.outputTokens == 4);
+    }
+
+    SECTION("Clients built from JSON config through the factory") {
+        auto send = [](LLMClient& client, const LLMRequest& request) {
+            std::promise<LLMResponse> done;
+            auto response = done.get_future();
+            client.sendRequest(request, [&done](LLMResponse r) { done.set_value(std::move(r)); });
+            return response.get();
+        };
+
+        requestConfig.model = "gpt-4o-mini";
+        auto openai = llmcpp::ClientFactory::createClient(
+            "openai", json{{"api_key", "mock"},
+                           {"base_url", server.baseUrl() + "/v1"},
+                           {"headers", {{"X-Tenant", "blue"}}}});
+        REQUIRE(openai != nullptr);
+        REQUIRE(send(*openai, LLMRequest(requestConfig, "Say hi")).success);
+
+        requestConfig.model = "claude-3-5-haiku-20241022";
+        auto anthropic = llmcpp::ClientFactory::createClient(
+            "anthropic", json{{"api_key", "mock"}, {"base_url", server.baseUrl()}});
+        REQUIRE(anthropic != nullptr);
+        REQUIRE(send(*anthropic, LLMRequest(requestConfig, "Say hi")).success);
+    }
+
+    SECTION("SSE streaming") {
+        httplib::Client http(server.baseUrl());
+        json body = {{"model", "gpt-4o-mini"}, {"stream", true}};
+        auto result = http.Post("/v1/responses", body.dump(), "application/json");
+        REQUIRE(result);
+        REQUIRE(result->get_header_value("Content-Type") == "text/event-stream");
+        REQUIRE(result->body.find("event: response.output_text.delta") != std::string::npos);
+        REQUIRE(result->body.find("event: response.completed") != std::string::npos);
+        REQUIRE(server.stats().streamed == 1);
+    }
+
+    SECTION("OpenAI-compatible local server") {
+        Local::LocalConfig localConfig(server.baseUrl() + "/v1");
+        localConfig.defaultModel = "llama-3.1-8b";
+        Local::LocalClient client(localConfig);
+        REQUIRE(client.getConfig().apiKey.empty());
+
+        requestConfig.model.clear();
+        auto response = client.sendRequest(LLMRequest(requestConfig, "Say hi"));
+        REQUIRE(response.success);
+        REQUIRE(response.result["text"] == MockLlmServer::makeText(4, 0));
+        REQUIRE(response.usage.outputTokens == 4);
+
+        std::string streamed;
+        response = client.sendStreamingRequest(
+            LLMRequest(requestConfig, "Say hi"),
+            [&streamed](const std::string& delta) { streamed += delta; });
+        REQUIRE(response.success);
+        REQUIRE(streamed == response.result["text"].get<std::string>());
+        REQUIRE(response.usage.outputTokens == 4);
+        REQUIRE(server.stats().streamed == 1);
+
+        localConfig.endpoint = Local::Endpoint::Completions;
+        Local::LocalClient completions(localConfig);
+        response = completions.sendRequest(LLMRequest(requestConfig, "Once upon a time"));
+        REQUIRE(response.success);
+        REQUIRE(response.responseId.rfind("cmpl-", 0) == 0);
+    }
+}
+
+TEST_CASE("Mock server error injection", "[mock][unit]") {
+    MockServerConfig config;
+    config.rate429 = 1.0;
+    MockLlmServer server(config);
+    server.start();
+
+    httplib::Client http(server.baseUrl());
+    auto result = http.Post("/v1/messages", "{}", "application/json");
+    REQUIRE(result);
+    REQUIRE(result->status == 429);
+    REQUIRE(json::parse(result->body)["error"]["type"] == "rate_limit_error");
+    REQUIRE(server.stats().injected429 == 1);
+}
+
+TEST_CASE("Mock server requests are cancellable", "[mock][unit]") {
+    using namespace std::chrono_literals;
+    using Clock = std::chrono::steady_clock;
+
+    MockServerConfig config;
+    config.timeToFirstToken = LatencyDistribution::fixed(2000);
+    config.outputTokens = 40;
+    config.tokensPerSecond = 20;
+    MockLlmServer server(config);
+    server.start();
+
+    LLMRequestConfig requestConfig;
+    requestConfig.maxTokens = 64;
+    llmcpp::CancellationSource source;
+
+    OpenAI::OpenAIConfig openaiConfig;
+    openaiConfig.apiKey = "mock";
+    openaiConfig.baseUrl = server.baseUrl() + "/v1";
+
+    SECTION("Cancelling aborts the wait for the response") {
+        OpenAIClient client(openaiConfig);
+        requestConfig.model = "gpt-4o-mini";
+        LLMRequest request(requestConfig, "Say hi");
+        request.cancellation = source.get_token();
+
+        auto start = Clock::now();
+        auto future = client.sendRequestAsync(request);
+        std::this_thread::sleep_for(100ms);
+        source.request_stop();
+        auto response = future.get();
+        REQUIRE_FALSE(response.success);
+        REQUIRE(response.errorMessage == "Operation cancelled");
+        REQUIRE(Clock::now() - start < 1000ms);
+    }
+
+    SECTION("Cancelling ends a stream at the next chunk") {
+        OpenAIClient client(openaiConfig);
+        requestConfig.model = "gpt-4";  // Chat Completions: streamed delta by delta
+        LLMRequest request(requestConfig, "Say hi");
+        request.cancellation = source.get_token();
+
+        std::string streamed;
+        Clock::time_point cancelledAt;
+        auto response = client
+                            .sendStreamingRequestAsync(request,
+                                                       [&](const std::string& delta) {
+                                                           if (streamed.empty()) {
+                                                               cancelledAt = Clock::now();
+                                                               source.request_stop();
+                                                           }
+                                                           streamed += delta;
+                                                       })
+                            .get();
+        REQUIRE_FALSE(response.success);
+        REQUIRE(response.errorMessage == "Operation cancelled");
+        REQUIRE_FALSE(streamed.empty());
+        REQUIRE(streamed.size() < MockLlmServer::makeText(40, 0).size());
+        REQUIRE(Clock::now() - cancelledAt < 1000ms);
+    }
+
+    SECTION("Anthropic requests honour the token too") {
+        Anthropic::AnthropicConfig anthropicConfig("mock");
+        anthropicConfig.baseUrl = server.baseUrl();
+        Anthropic::AnthropicClient client(anthropicConfig);
+        requestConfig.model = "claude-3-5-haiku-20241022";
+        LLMRequest request(requestConfig, "Say hi");
+        request.cancellation = source.get_token();
+
+        std::thread canceller([&source]() {
+            std::this_thread::sleep_for(100ms);
+            source.request_stop();
+        });
+        auto start = Clock::now();
+        auto response = client.sendRequest(request);
+        canceller.join();
+        REQUIRE_FALSE(response.success);
+        REQUIRE(response.errorMessage == "Operation cancelled");
+        REQUIRE(Clock::now() - start < 1000ms);
+    }
+}
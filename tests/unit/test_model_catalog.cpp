@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <set>
+#include <string>
+
+#include "core/ModelCatalog.h"
+#include "openai/OpenAITypes.h"
+
+using llmcpp::ModelFeature;
+using llmcpp::ModelProvider;
+
+// Lookups are usable in constant expressions
+static_assert(llmcpp::findModel("gpt-4o") != nullptr);
+static_assert(llmcpp::findModel("gpt-4o")->contextWindow == 128000);
+static_assert(llmcpp::resolveModel("claude-sonnet-4-20250514") ==
+              llmcpp::findModel("claude-sonnet-4"));
+static_assert(!llmcpp::modelSupports("o3", ModelFeature::Sampling));
+
+TEST_CASE("Every catalog entry is found by its name", "[models][unit]") {
+    std::set<std::string_view> names;
+    for (const auto& info : llmcpp::modelCatalog()) {
+        REQUIRE(names.insert(info.name).second);
+        REQUIRE(llmcpp::findModel(info.name) == &info);
+        REQUIRE(info.pricing.input > 0.0);
+        REQUIRE(info.pricing.output > 0.0);
+    }
+    REQUIRE_FALSE(llmcpp::findModel(""));
+    REQUIRE_FALSE(llmcpp::findModel("gpt-4o-"));
+    REQUIRE_FALSE(llmcpp::findModel("custom"));
+    REQUIRE_FALSE(llmcpp::findModel("GPT-4O"));
+}
+
+TEST_CASE("Snapshots and aliases resolve to their base model", "[models][unit]") {
+    REQUIRE(llmcpp::resolveModel("gpt-4o-mini-2024-07-18") == llmcpp::findModel("gpt-4o-mini"));
+    REQUIRE(llmcpp::resolveModel("gpt-4.1-2025-04-14") == llmcpp::findModel("gpt-4.1"));
+    REQUIRE(llmcpp::resolveModel("claude-opus-4-1-20250805") ==
+            llmcpp::findModel("claude-opus-4-1"));
+    REQUIRE(llmcpp::resolveModel("claude-3-5-haiku-latest") ==
+            llmcpp::findModel("claude-3-5-haiku"));
+    REQUIRE(llmcpp::resolveModel("o3") == llmcpp::findModel("o3"));
+
+    REQUIRE_FALSE(llmcpp::resolveModel("gpt-4o-2024-8-06"));
+    REQUIRE_FALSE(llmcpp::resolveModel("my-model-20250101"));
+    REQUIRE_FALSE(llmcpp::resolveModel("-latest"));
+}
+
+TEST_CASE("Model capabilities", "[models][unit]") {
+    const auto* gpt5 = llmcpp::findModel("gpt-5");
+    REQUIRE(gpt5->provider == ModelProvider::OpenAI);
+    REQUIRE(gpt5->supports(ModelFeature::Reasoning));
+    REQUIRE_FALSE(gpt5->supports(ModelFeature::Sampling));
+    REQUIRE(gpt5->supports(ModelFeature::ResponsesApi | ModelFeature::Tools));
+
+    REQUIRE(llmcpp::modelSupports("gpt-4o", ModelFeature::Sampling));
+    REQUIRE_FALSE(llmcpp::modelSupports("gpt-3.5-turbo", ModelFeature::ResponsesApi));
+    REQUIRE(llmcpp::modelSupports("claude-3-7-sonnet-20250219", ModelFeature::Reasoning));
+    REQUIRE_FALSE(llmcpp::modelSupports("unknown-model", ModelFeature::None));
+
+    auto anthropic = llmcpp::modelNames(ModelProvider::Anthropic);
+    REQUIRE(anthropic.size() == 8);
+    for (const auto& name : anthropic) {
+        REQUIRE(llmcpp::findModel(name)->supports(ModelFeature::MessagesApi));
+    }
+}
+
+TEST_CASE("OpenAI routing reads the catalog", "[models][unit]") {
+    REQUIRE(supportsResponses("gpt-4.1-mini"));
+    REQUIRE(supportsResponses("gpt-4o-2024-08-06"));
+    REQUIRE_FALSE(supportsResponses("gpt-3.5-turbo"));
+    REQUIRE(supportsChatCompletions("gpt-3.5-turbo"));
+    REQUIRE(OpenAI::supportsStructuredOutputs(OpenAI::Model::GPT_4o));
+    REQUIRE_FALSE(OpenAI::supportsStructuredOutputs(OpenAI::Model::GPT_3_5_Turbo));
+
+    LLMRequestConfig config;
+    config.model = "o4-mini";
+    REQUIRE(OpenAI::detectApiType(LLMRequest(config, "hi")) == OpenAI::ApiType::RESPONSES);
+    config.model = "gpt-4";
+    REQUIRE(OpenAI::detectApiType(LLMRequest(config, "hi")) ==
+            OpenAI::ApiType::CHAT_COMPLETIONS);
+
+    // Sampling parameters are dropped for every reasoning model, not only o3
+    OpenAI::ResponsesRequest request;
+    request.model = "gpt-5-mini";
+    request.temperature = 0.5;
+    request.topP = 0.9;
+    auto body = request.toJson();
+    REQUIRE_FALSE(body.contains("temperature"));
+    REQUIRE_FALSE(body.contains("top_p"));
+
+    request.model = "my-finetune";
+    body = request.toJson();
+    REQUIRE(body.contains("temperature"));
+    REQUIRE(body.contains("top_p"));
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/JsonSchemaBuilder.h"
+#include "core/SchemaInterner.h"
+#include "openai/OpenAIStrictSchema.h"
+#include "openai/OpenAITypes.h"
+
+using json = nlohmann::json;
+using OpenAI::normalizeStrictSchema;
+using OpenAI::StrictSchemaIssue;
+
+namespace {
+
+bool hasIssue(const OpenAI::StrictSchemaResult& result, StrictSchemaIssue::Severity severity,
+              const std::string& keyword) {
+    for (const auto& issue : result.issues) {
+        if (issue.severity == severity && issue.keyword == keyword) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST_CASE("Strict normalizer completes objects", "[openai][strict][unit]") {
+    auto tag = JsonSchemaBuilder::object().property("label", JsonSchemaBuilder::string());
+    auto schema = JsonSchemaBuilder::object()
+                      .property("name", JsonSchemaBuilder::string())
+                      .property("nickname", JsonSchemaBuilder::string())
+                      .property("tags", JsonSchemaBuilder::arrayOf(tag))
+                      .required({"name", "tags"})
+                      .build();
+
+    auto result = normalizeStrictSchema(schema);
+    REQUIRE(result.ok());
+
+    const auto& out = result.schema;
+    REQUIRE(out["additionalProperties"] == false);
+    REQUIRE(out["required"] == json::array({"name", "nickname", "tags"}));
+    REQUIRE(out["properties"]["name"]["type"] == "string");
+    REQUIRE(out["properties"]["nickname"]["type"] == json::array({"string", "null"}));
+
+    const auto& item = out["properties"]["tags"]["items"];
+    REQUIRE(item["additionalProperties"] == false);
+    REQUIRE(item["required"] == json::array({"label"}));
+    REQUIRE(item["properties"]["label"]["type"] == json::array({"string", "null"}));
+
+    REQUIRE(hasIssue(result, StrictSchemaIssue::Severity::Warning, "required"));
+}
+
+TEST_CASE("Strict normalizer makes every optional shape nullable", "[openai][strict][unit]") {
+    json schema = {
+        {"type", "object"},
+        {"properties",
+         {{"ref", {{"$ref", "#/$defs/Point"}}},
+          {"choice", {{"anyOf", json::array({{{"type", "string"}}, {{"type", "integer"}}})}}},
+          {"color", {{"type", "string"}, {"enum", json::array({"red", "blue"})}}},
+          {"either", {{"type", json::array({"string", "integer"})}}}}},
+        {"$defs",
+         {{"Point",
+           {{"type", "object"}, {"properties", {{"x", {{"type", "number"}}}}}, {"required", {"x"}}}}}}};
+
+    auto result = normalizeStrictSchema(schema);
+    REQUIRE(result.ok());
+    const auto& props = result.schema["properties"];
+
+    REQUIRE(props["ref"]["anyOf"] == json::array({{{"$ref", "#/$defs/Point"}}, {{"type", "null"}}}));
+    REQUIRE(props["choice"]["anyOf"].size() == 3);
+    REQUIRE(props["choice"]["anyOf"][2] == json{{"type", "null"}});
+    REQUIRE(props["color"]["type"] == json::array({"string", "null"}));
+    REQUIRE(props["color"]["enum"] == json::array({"red", "blue", nullptr}));
+    REQUIRE(props["either"]["type"] == json::array({"string", "integer", "null"}));
+
+    // Definitions are normalized too
+    REQUIRE(result.schema["$defs"]["Point"]["additionalProperties"] == false);
+}
+
+TEST_CASE("Strict normalizer reports unsupported constructs", "[openai][strict][unit]") {
+    SECTION("Rejected keywords are errors") {
+        json schema = {{"type", "object"},
+                       {"properties", {{"a", {{"not", {{"type", "string"}}}}}}},
+                       {"required", {"a"}}};
+        auto result = normalizeStrictSchema(schema);
+        REQUIRE_FALSE(result.ok());
+        REQUIRE(hasIssue(result, StrictSchemaIssue::Severity::Error, "not"));
+        REQUIRE(result.errorSummary().find("/properties/a") != std::string::npos);
+    }
+
+    SECTION("Unsupported constraints are dropped with a warning") {
+        json schema = {{"type", "object"},
+                       {"properties", {{"a", {{"type", "string"}, {"minLength", 3}}}}},
+                       {"required", {"a"}}};
+        auto result = normalizeStrictSchema(schema);
+        REQUIRE(result.ok());
+        REQUIRE_FALSE(result.schema["properties"]["a"].contains("minLength"));
+        REQUIRE(hasIssue(result, StrictSchemaIssue::Severity::Warning, "minLength"));
+
+        OpenAI::StrictSchemaOptions options;
+        options.dropUnsupportedKeywords = false;
+        REQUIRE_FALSE(normalizeStrictSchema(schema, options).ok());
+    }
+
+    SECTION("Root must be an object") {
+        REQUIRE_FALSE(normalizeStrictSchema(json{{"type", "string"}}).ok());
+        REQUIRE_FALSE(normalizeStrictSchema(
+                          json{{"anyOf", json::array({{{"type", "object"}}, {{"type", "null"}}})}})
+                          .ok());
+    }
+
+    SECTION("Schema-valued additionalProperties is an error") {
+        json schema = {{"type", "object"}, {"additionalProperties", {{"type", "string"}}}};
+        auto result = normalizeStrictSchema(schema);
+        REQUIRE(hasIssue(result, StrictSchemaIssue::Severity::Error, "additionalProperties"));
+    }
+
+    SECTION("Nesting and size limits") {
+        json schema = {{"type", "object"}, {"properties", json::object()}};
+        json* cursor = &schema;
+        for (int i = 0; i < 4; ++i) {
+            (*cursor)["properties"]["child"] = {{"type", "object"}, {"properties", json::object()}};
+            cursor = &(*cursor)["properties"]["child"];
+        }
+        OpenAI::StrictSchemaOptions options;
+        options.maxDepth = 3;
+        REQUIRE_FALSE(normalizeStrictSchema(schema, options).ok());
+        options.maxDepth = 5;
+        REQUIRE(normalizeStrictSchema(schema, options).ok());
+        options.maxProperties = 2;
+        REQUIRE_FALSE(normalizeStrictSchema(schema, options).ok());
+    }
+}
+
+TEST_CASE("Strict schemas are cached per interned schema", "[openai][strict][unit]") {
+    auto schema = JsonSchemaBuilder::object()
+                      .property("answer", JsonSchemaBuilder::string())
+                      .property("note", JsonSchemaBuilder::string())
+                      .required({"answer"})
+                      .intern();
+
+    auto strict = OpenAI::strictSchemaFor(schema);
+    REQUIRE(strict);
+    REQUIRE(strict.get() != schema.get());
+    REQUIRE(strict->value()["required"] == json::array({"answer", "note"}));
+    REQUIRE(OpenAI::strictSchemaFor(schema).get() == strict.get());
+
+    SECTION("Already-strict schemas normalize to themselves") {
+        REQUIRE(OpenAI::strictSchemaFor(strict).get() == strict.get());
+    }
+
+    SECTION("Incompatible schemas throw every time") {
+        auto bad = llmcpp::SchemaInterner::intern(
+            json{{"type", "object"}, {"properties", {{"a", {{"allOf", json::array()}}}}}});
+        REQUIRE_THROWS_AS(OpenAI::strictSchemaFor(bad), std::invalid_argument);
+        REQUIRE_THROWS_AS(OpenAI::strictSchemaFor(bad), std::invalid_argument);
+    }
+
+    SECTION("Splicing uses the normalized bytes") {
+        LLMRequestConfig config;
+        config.model = "gpt-4o";
+        config.internedSchema = schema;
+        auto request = OpenAI::ResponsesRequest::fromLLMRequest(LLMRequest(config, "Q"));
+        REQUIRE(request.text->strict());
+
+        std::string body =
+            request.spliceSchema(request.toJson(/*schemaPlaceholder=*/true).dump(), strict);
+        REQUIRE(json::parse(body)["text"]["format"]["schema"] == strict->value());
+    }
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include "openai/OpenAIMcpUtils.h"
 #include "openai/OpenAITypes.h"
 
 using namespace OpenAI;
@@ -317,6 +318,130 @@ TEST_CASE("OpenAI::ChatCompletionChoice deserialization", "[openai][types]") {
     REQUIRE(choice.finishReason == "stop");
 }
 
+TEST_CASE("OpenAI::ChatCompletionRequest from LLMRequest", "[openai][types]") {
+    LLMRequestConfig config;
+    config.model = "gpt-4";
+    config.topP = 0.9f;
+    config.stopSequences = std::vector<std::string>{"END"};
+    config.extensions["n"] = 2;
+    config.functionName = "answer";
+    config.schemaObject =
+        json{{"type", "object"}, {"properties", {{"value", {{"type", "integer"}}}}}};
+    FunctionTool lookup;
+    lookup.name = "lookup";
+    lookup.parameters = {{"type", "object"}, {"properties", json::object()}};
+    setTools(config, {lookup});
+
+    LLMContext context = {json{{"role", "user"}, {"content", "What is 2+2?"}}};
+    auto request = ChatCompletionRequest::fromLLMRequest(LLMRequest(config, "Be brief", context));
+    REQUIRE(request.messages.size() == 2);
+    REQUIRE(request.messages[0].role == "system");
+    REQUIRE(request.messages[1].content == "What is 2+2?");
+
+    request.stream = true;
+    json j = request.toJson();
+    REQUIRE(j["top_p"] == Catch::Approx(0.9));
+    REQUIRE(j["n"] == 2);
+    REQUIRE(j["stop"][0] == "END");
+    REQUIRE(j["stream_options"]["include_usage"] == true);
+    REQUIRE(j["tools"][0]["type"] == "function");
+    REQUIRE(j["tools"][0]["function"]["name"] == "lookup");
+    REQUIRE_FALSE(j["tools"][0]["function"].contains("type"));
+    REQUIRE(j["response_format"]["type"] == "json_schema");
+    REQUIRE(j["response_format"]["json_schema"]["name"] == "answer");
+    REQUIRE(j["response_format"]["json_schema"]["schema"]["type"] == "object");
+
+    auto prompt = ChatCompletionRequest::fromLLMRequest(LLMRequest(LLMRequestConfig{}, "Hi"));
+    REQUIRE(prompt.messages.size() == 1);
+    REQUIRE(prompt.messages[0].role == "user");
+
+    request.tools = std::vector<ToolVariant>{WebSearchTool{}};
+    REQUIRE_THROWS_AS(request.toJson(), std::invalid_argument);
+}
+
+TEST_CASE("OpenAI::ChatCompletionResponse conversion", "[openai][types]") {
+    json j = json::parse(R"({
+        "id": "chatcmpl-1",
+        "object": "chat.completion",
+        "created": 1700000000,
+        "model": "gpt-4",
+        "choices": [
+            {"index": 1, "message": {"role": "assistant", "content": "Hi"}, "finish_reason": "stop"},
+            {"index": 0, "message": {"role": "assistant", "content": "Hello"}, "finish_reason": "stop"}
+        ],
+        "usage": {"prompt_tokens": 9, "completion_tokens": 3, "total_tokens": 12}
+    })");
+
+    auto response = ChatCompletionResponse::fromJson(j);
+    REQUIRE(response.choices.size() == 2);
+    REQUIRE(response.choices[0].message.content == "Hello");  // Ordered by index
+    REQUIRE(response.usage.inputTokens == 9);
+
+    auto llm = response.toLLMResponse();
+    REQUIRE(llm.success);
+    REQUIRE(llm.responseId == "chatcmpl-1");
+    REQUIRE(llm.result["text"] == "Hello");
+    REQUIRE(llm.result["choices"] == json::array({"Hello", "Hi"}));
+
+    SECTION("Tool calls with null content") {
+        json call = json::parse(R"({
+            "index": 0,
+            "message": {"role": "assistant", "content": null, "tool_calls": [
+                {"id": "call_1", "type": "function",
+                 "function": {"name": "lookup", "arguments": "{\"q\":\"x\"}"}}
+            ]},
+            "finish_reason": "tool_calls"
+        })");
+        ChatCompletionResponse toolResponse;
+        toolResponse.choices.push_back(ChatCompletionChoice::fromJson(call));
+        auto toolLlm = toolResponse.toLLMResponse();
+        REQUIRE(toolLlm.success);
+        REQUIRE(toolLlm.result["function_calls"][0]["name"] == "lookup");
+        REQUIRE(toolLlm.result["function_calls"][0]["arguments"]["q"] == "x");
+    }
+
+    SECTION("No choices") {
+        REQUIRE_FALSE(ChatCompletionResponse{}.toLLMResponse().success);
+    }
+}
+
+TEST_CASE("OpenAI::applyChatCompletionChunk", "[openai][types]") {
+    ChatCompletionResponse response;
+    auto chunk = [](const char* text) { return json::parse(text); };
+
+    REQUIRE(applyChatCompletionChunk(
+                response, chunk(R"({"id":"c1","model":"gpt-4","choices":[
+                    {"index":0,"delta":{"role":"assistant","content":""}},
+                    {"index":1,"delta":{"content":"B"}}]})")) == "");
+    REQUIRE(applyChatCompletionChunk(
+                response, chunk(R"({"id":"c1","choices":[{"index":0,"delta":{"content":"A"}}]})")) ==
+            "A");
+    applyChatCompletionChunk(response, chunk(R"({"id":"c1","choices":[{"index":0,"delta":{
+        "tool_calls":[{"index":0,"id":"call_1","function":{"name":"lookup","arguments":"{\"q\""}}]}}]})"));
+    applyChatCompletionChunk(response, chunk(R"({"id":"c1","choices":[{"index":0,"delta":{
+        "tool_calls":[{"index":0,"function":{"arguments":":1}"}}]},"finish_reason":"tool_calls"}]})"));
+    applyChatCompletionChunk(
+        response, chunk(R"({"id":"c1","choices":[],"usage":{"prompt_tokens":4,"completion_tokens":6}})"));
+
+    REQUIRE(response.id == "c1");
+    REQUIRE(response.choices.size() == 2);
+    REQUIRE(response.choices[0].message.content == "A");
+    REQUIRE(response.choices[1].message.content == "B");
+    REQUIRE(response.choices[0].finishReason == "tool_calls");
+    REQUIRE(response.usage.outputTokens == 6);
+
+    auto llm = response.toLLMResponse();
+    REQUIRE(llm.result["function_calls"][0]["id"] == "call_1");
+    REQUIRE(llm.result["function_calls"][0]["arguments"]["q"] == 1);
+    REQUIRE(llm.result["choices"] == json::array({"A", "B"}));
+
+    // A call index past the next new call is rejected instead of allocating up to it
+    REQUIRE_THROWS_AS(applyChatCompletionChunk(response, chunk(R"({"choices":[{"index":0,"delta":{
+        "tool_calls":[{"index":1000000,"function":{"arguments":"{}"}}]}}]})")),
+                      std::runtime_error);
+    REQUIRE(response.choices[0].toolCalls->size() == 1);
+}
+
 TEST_CASE("OpenAI::OpenAIConfig serialization", "[openai][types]") {
     OpenAIConfig config;
     config.apiKey = "sk-test123";
@@ -355,6 +480,22 @@ TEST_CASE("OpenAI::OpenAIConfig deserialization", "[openai][types]") {
     REQUIRE(config.maxRetries == 3);  // Default value
 }
 
+TEST_CASE("OpenAI::OpenAIConfig transport options", "[openai][types]") {
+    auto config = OpenAIConfig::fromJson(json{{"apiKey", "sk-camel"},
+                                              {"max_retries", 0},
+                                              {"verify_ssl", false},
+                                              {"headers", {{"X-Tenant", "blue"}}}});
+
+    REQUIRE(config.apiKey == "sk-camel");
+    REQUIRE(config.maxRetries == 0);
+    REQUIRE_FALSE(config.verifySSL);
+    REQUIRE(config.headers.at("X-Tenant") == "blue");
+
+    auto roundTrip = OpenAIConfig::fromJson(config.toJson());
+    REQUIRE_FALSE(roundTrip.verifySSL);
+    REQUIRE(roundTrip.headers == config.headers);
+}
+
 TEST_CASE("OpenAI::OpenAIConfig default values", "[openai][types]") {
     OpenAIConfig config;
 
@@ -558,3 +699,165 @@ TEST_CASE("ResponsesRequest parameter filtering for reasoning models",
 
     // Parameter support checking section removed - not part of ResponsesRequest interface
 }
+
+TEST_CASE("OpenAI::ResponsesResponse output index", "[openai][types]") {
+    ResponsesResponse response;
+    response.output = {
+        {{"type", "mcp_list_tools"}, {"tools", {{{"name", "search"}}, "fetch"}}},
+        {{"type", "message"},
+         {"content", {{{"type", "output_text"}, {"text", "first"}}}}},
+        {{"type", "mcp_call"}, {"name", "search"}, {"output", "a"}},
+        {{"type", "function_call"}, {"name", "lookup"}, {"arguments", "{}"}},
+        {{"type", "mcp_call"}, {"name", "fetch"}, {"error", "timeout"}},
+        {{"type", "text"}, {"text", "second"}},
+        {{"type", 42}},
+        "not an object",
+        {{"type", "mcp_call"}, {"name", "search"}, {"output", "b"}},
+    };
+
+    using ItemType = ResponseOutputIndex::ItemType;
+    auto index = response.outputIndex();
+    REQUIRE(index.items(ItemType::McpCall).size() == 3);
+    REQUIRE(index.items(ItemType::Other).size() == 2);
+    REQUIRE(index.mcpCalls("search").size() == 2);
+    REQUIRE(index.mcpCalls("missing").empty());
+    REQUIRE(index.mcpToolsUsed() == std::vector<std::string>{"search", "fetch"});
+
+    SECTION("Scanning and indexed extractors agree") {
+        REQUIRE(response.getOutputText() == "first\nsecond");
+        REQUIRE(response.getOutputText(index) == "first\nsecond");
+        REQUIRE(response.getFunctionCalls().size() == 1);
+        REQUIRE(response.getFunctionCalls(index).size() == 1);
+        REQUIRE(McpUtils::extractMcpCalls(response).size() == 3);
+        REQUIRE(McpUtils::extractMcpCalls(response, index).size() == 3);
+        REQUIRE(McpUtils::wasToolCalled(response, "fetch"));
+        REQUIRE(McpUtils::wasToolCalled(response, index, "fetch"));
+        REQUIRE_FALSE(McpUtils::wasToolCalled(response, "missing"));
+        REQUIRE(McpUtils::getToolOutput(response, "search") == json("a"));
+        REQUIRE(McpUtils::getToolOutput(response, index, "search") == json("a"));
+        REQUIRE_FALSE(McpUtils::getToolOutput(response, "fetch").has_value());
+        REQUIRE(McpUtils::getAllToolOutputs(response, "search") == std::vector<json>{"a", "b"});
+        REQUIRE(McpUtils::getAllToolOutputs(response, index, "search") ==
+                std::vector<json>{"a", "b"});
+        REQUIRE(McpUtils::wereMcpToolsListed(response));
+        REQUIRE(McpUtils::wereMcpToolsListed(response, index));
+        REQUIRE(McpUtils::getAvailableMcpTools(response) ==
+                std::vector<std::string>{"search", "fetch"});
+        REQUIRE(McpUtils::getAvailableMcpTools(response, index) ==
+                std::vector<std::string>{"search", "fetch"});
+        REQUIRE(McpUtils::wereAllToolsCalled(response, {"search", "fetch"}));
+        REQUIRE(McpUtils::wereAllToolsCalled(response, index, {"search", "fetch"}));
+
+        json stats = McpUtils::getMcpUsageStats(response);
+        REQUIRE(stats == McpUtils::getMcpUsageStats(response, index));
+        REQUIRE(stats["total_calls"] == 3);
+        REQUIRE(stats["successful_calls"] == 2);
+        REQUIRE(stats["failed_calls"] == 1);
+        REQUIRE(stats["tools_used"] == json{"search", "fetch"});
+    }
+
+    SECTION("Indexed queries share one index instead of rebuilding it") {
+        response.output.push_back({{"type", "mcp_call"}, {"name", "summarize"}, {"output", "c"}});
+        // The prebuilt index predates the new item, so only the scanning forms see it
+        REQUIRE(McpUtils::wasToolCalled(response, "summarize"));
+        REQUIRE_FALSE(McpUtils::wasToolCalled(response, index, "summarize"));
+        REQUIRE_FALSE(McpUtils::getToolOutput(response, index, "summarize").has_value());
+        REQUIRE(McpUtils::extractMcpCalls(response).size() == 4);
+        REQUIRE(McpUtils::extractMcpCalls(response, index).size() == 3);
+        REQUIRE(McpUtils::getMcpUsageStats(response, index)["total_calls"] == 3);
+        REQUIRE(McpUtils::getMcpUsageStats(response)["total_calls"] == 4);
+    }
+
+    SECTION("Extractors see in-place edits") {
+        response.output[3]["type"] = "image";
+        REQUIRE(response.getFunctionCalls().empty());
+        REQUIRE(response.getImageGenerations().size() == 1);
+    }
+
+    SECTION("Copies index their own output") {
+        ResponsesResponse copy = response;
+        copy.output.erase(copy.output.begin() + 2);
+        REQUIRE(copy.outputIndex().mcpCalls("search").size() == 1);
+        REQUIRE(response.outputIndex().mcpCalls("search").size() == 2);
+    }
+
+    SECTION("Extractors see a same-size reassignment") {
+        response.output = {{{"type", "function_call"}, {"name", "lookup"}}};
+        REQUIRE(response.getFunctionCalls().size() == 1);
+        response.output = {{{"type", "message"},
+                            {"content", {{{"type", "output_text"}, {"text", "replaced"}}}}}};
+        REQUIRE(response.getFunctionCalls().empty());
+        REQUIRE(response.getOutputText() == "replaced");
+    }
+}
+
+TEST_CASE("OpenAI::usageFromJson cached tokens", "[openai][types]") {
+    SECTION("Responses usage") {
+        auto usage = usageFromJson({{"input_tokens", 2400},
+                                    {"output_tokens", 50},
+                                    {"input_tokens_details", {{"cached_tokens", 1920}}},
+                                    {"output_tokens_details", {{"reasoning_tokens", 32}}}});
+        REQUIRE(usage.inputTokens == 2400);
+        REQUIRE(usage.outputTokens == 50);
+        REQUIRE(usage.cachedInputTokens == 1920);
+        REQUIRE(usage.reasoningTokens == 32);
+        REQUIRE(usage.cacheHitRate() == Catch::Approx(0.8));
+    }
+
+    SECTION("Chat Completions usage, full response and final stream chunk") {
+        json usageJson = {{"prompt_tokens", 1100},
+                          {"completion_tokens", 9},
+                          {"prompt_tokens_details", {{"cached_tokens", 1024}}}};
+        auto response = ChatCompletionResponse::fromJson(
+            {{"choices", json::array({{{"index", 0}, {"message", {{"content", "hi"}}}}})},
+             {"usage", usageJson}});
+        REQUIRE(response.usage.cachedInputTokens == 1024);
+        REQUIRE(response.toLLMResponse(false).usage.cachedInputTokens == 1024);
+
+        ChatCompletionResponse streamed;
+        applyChatCompletionChunk(streamed, {{"choices", json::array()}, {"usage", usageJson}});
+        REQUIRE(streamed.usage.inputTokens == 1100);
+        REQUIRE(streamed.usage.cachedInputTokens == 1024);
+    }
+
+    SECTION("Missing details") {
+        auto usage = usageFromJson({{"prompt_tokens", 10}, {"prompt_tokens_details", nullptr}});
+        REQUIRE(usage.inputTokens == 10);
+        REQUIRE(usage.cachedInputTokens == 0);
+        REQUIRE(usageFromJson(json::object()).cacheHitRate() == 0.0);
+    }
+}
+
+TEST_CASE("OpenAI::ResponsesRequest static prefix", "[openai][types]") {
+    LLMRequestConfig config;
+    config.model = "gpt-4o";
+    config.temperature = 0.7f;
+    config.topP = 0.9f;
+    config.schemaObject =
+        json{{"type", "object"}, {"properties", {{"label", {{"type", "string"}}}}}};
+
+    auto request = ResponsesRequest::fromLLMRequest(LLMRequest(config, "Classify", json("a")));
+    auto body = request.toJson();
+    REQUIRE(body["temperature"].dump() == "0.7");
+    REQUIRE(body["top_p"].dump() == "0.9");
+
+    SECTION("Context is not part of the prefix") {
+        auto other = ResponsesRequest::fromLLMRequest(LLMRequest(config, "Classify", json("b")));
+        REQUIRE(other.staticPrefix() == request.staticPrefix());
+        REQUIRE(request.staticPrefix().bytes.find("Classify") != std::string::npos);
+    }
+
+    SECTION("Instructions and schema are") {
+        auto reworded = ResponsesRequest::fromLLMRequest(LLMRequest(config, "Label", json("a")));
+        REQUIRE(reworded.staticPrefix() != request.staticPrefix());
+
+        config.schemaObject = json{{"type", "object"}};
+        auto reshaped = ResponsesRequest::fromLLMRequest(LLMRequest(config, "Classify", json("a")));
+        REQUIRE(reshaped.staticPrefix() != request.staticPrefix());
+    }
+
+    SECTION("Chat Completions bodies use the same canonical floats") {
+        auto chat = ChatCompletionRequest::fromLLMRequest(LLMRequest(config, "Classify"));
+        REQUIRE(chat.toJson()["temperature"].dump() == "0.7");
+    }
+}
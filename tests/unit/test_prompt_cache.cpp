@@ -0,0 +1,36 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/PromptCache.h"
+
+using namespace llmcpp;
+using json = nlohmann::json;
+
+TEST_CASE("Canonical floats", "[prompt_cache][unit]") {
+    REQUIRE(canonicalFloat(0.7f) == 0.7);
+    REQUIRE(canonicalFloat(0.1f) == 0.1);
+    REQUIRE(canonicalFloat(1.0f) == 1.0);
+    REQUIRE(canonicalFloat(0.0f) == 0.0);
+    REQUIRE(json(canonicalFloat(0.7f)).dump() == "0.7");
+    REQUIRE(json(static_cast<double>(0.7f)).dump() != "0.7");
+}
+
+TEST_CASE("Prompt prefix hashing", "[prompt_cache][unit]") {
+    json tools = json::array({{{"name", "lookup"}, {"parameters", {{"type", "object"}}}}});
+
+    SECTION("Equal content gives equal bytes regardless of construction order") {
+        json reordered = json::array({{{"parameters", {{"type", "object"}}}, {"name", "lookup"}}});
+        auto a = PromptPrefix::of(json::array({tools, "You are terse."}));
+        auto b = PromptPrefix::of(json::array({reordered, "You are terse."}));
+        REQUIRE(a.bytes == b.bytes);
+        REQUIRE(a == b);
+        REQUIRE(a.bytes ==
+                R"([[{"name":"lookup","parameters":{"type":"object"}}],"You are terse."])");
+    }
+
+    SECTION("Any change to a part changes the hash") {
+        auto a = PromptPrefix::of(json::array({tools, "You are terse."}));
+        auto b = PromptPrefix::of(json::array({tools, "You are verbose."}));
+        REQUIRE(a != b);
+        REQUIRE(a.hash.toHex() != b.hash.toHex());
+    }
+}
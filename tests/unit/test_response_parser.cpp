@@ -77,3 +77,71 @@ TEST_CASE("ResponseParser returns raw responses", "[responseparser]") {
         }
     }
 }
+
+TEST_CASE("ResponseParser scans fenced JSON", "[responseparser]") {
+    SECTION("Multiple blocks with and without a language tag") {
+        std::string text = "Intro\n```json\n{\"a\": 1}\n```\nmiddle ```[1, 2]``` and ```not json```";
+        auto results = ResponseParser::parseMarkdownFencedJson(text);
+        REQUIRE(results.size() == 2);
+        REQUIRE(results[0].data == json{{"a", 1}});
+        REQUIRE(results[1].data == json::array({1, 2}));
+        REQUIRE(results[0].source == "markdown_fenced");
+    }
+
+    SECTION("Unterminated fence yields nothing") {
+        REQUIRE(ResponseParser::parseMarkdownFencedJson("```json\n{\"a\": 1}").empty());
+    }
+
+    SECTION("Large blocks are handled without recursion") {
+        json big = json::array();
+        for (int i = 0; i < 20000; ++i) {
+            big.push_back({{"id", i}, {"text", "item " + std::to_string(i)}});
+        }
+        auto results = ResponseParser::parseMarkdownFencedJson("```json\n" + big.dump() + "\n```");
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].data == big);
+    }
+}
+
+TEST_CASE("ResponseParser scans XML function calls", "[responseparser]") {
+    std::string text =
+        "Let me do that.\n"
+        "<function_calls>\n"
+        "<invoke name=\"create_item\">\n"
+        "<parameter name=\"description\"> A new item </parameter>\n"
+        "<parameter name='payload'>{\"id\": 7}</parameter>\n"
+        "</invoke>\n"
+        "<invoke  name = 'noop' ></invoke>\n"
+        "</function_calls>\n"
+        "<function_calls><invoke name=\"second\"><parameter name=\"n\">3</parameter></invoke>"
+        "</function_calls>";
+
+    auto results = ResponseParser::parseXmlFunctionCalls(text);
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].description == "A new item");
+    REQUIRE(results[0].data["description"] == "A new item");
+    REQUIRE(results[0].data["payload"] == json{{"id", 7}});
+    REQUIRE(results[0].source == "xml_function_call");
+    REQUIRE(results[1].data == json{{"n", 3}});
+
+    SECTION("Unclosed blocks are ignored") {
+        REQUIRE(ResponseParser::parseXmlFunctionCalls(
+                    "<function_calls><invoke name=\"x\"><parameter name=\"a\">1</parameter>")
+                    .empty());
+    }
+}
+
+TEST_CASE("ResponseParser salvages JSON arrays from text", "[responseparser]") {
+    SECTION("Balanced array after prose") {
+        auto results = ResponseParser::parseJsonArrayFromText("Result: [1, \"]\", [2]] done");
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].data == json::array({1, "]", json::array({2})}));
+    }
+
+    SECTION("Truncated array keeps the complete objects") {
+        auto results = ResponseParser::parseJsonArrayFromText(
+            "He said \"ok\": [{\"a\": \"{\"}, {\"b\": {\"c\": 2}}, {\"d\": ");
+        REQUIRE(results.size() == 1);
+        REQUIRE(results[0].data == json::parse(R"([{"a": "{"}, {"b": {"c": 2}}])"));
+    }
+}
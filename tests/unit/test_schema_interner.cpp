@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/JsonSchemaBuilder.h"
+#include "core/SchemaInterner.h"
+#include "openai/OpenAITypes.h"
+
+using json = nlohmann::json;
+using llmcpp::SchemaHash128;
+using llmcpp::SchemaInterner;
+
+namespace {
+
+JsonSchemaBuilder answerSchema() {
+    return JsonSchemaBuilder::object()
+        .property("answer", JsonSchemaBuilder::string())
+        .property("confidence", JsonSchemaBuilder::number().minimum(0).maximum(1))
+        .required({"answer", "confidence"})
+        .additionalProperties(false);
+}
+
+}  // namespace
+
+TEST_CASE("SchemaHash128 is stable and sensitive to content", "[interner][unit]") {
+    REQUIRE(SchemaHash128::of("") == SchemaHash128::of(""));
+    REQUIRE(SchemaHash128::of("{}") == SchemaHash128::of("{}"));
+    REQUIRE(SchemaHash128::of("{\"a\":1}") != SchemaHash128::of("{\"a\":2}"));
+    // Known MurmurHash3 x64_128 value of the empty input
+    REQUIRE(SchemaHash128::of("").toHex() == "00000000000000000000000000000000");
+    REQUIRE(SchemaHash128::of("hello").toHex().size() == 32);
+}
+
+TEST_CASE("SchemaInterner shares identical schemas", "[interner][unit]") {
+    auto first = answerSchema().intern();
+    auto second = SchemaInterner::intern(answerSchema().build());
+    REQUIRE(first.get() == second.get());
+
+    SECTION("Key order does not matter") {
+        auto text = SchemaInterner::internText(
+            R"({"type":"object","additionalProperties":false,
+                "required":["answer","confidence"],
+                "properties":{"confidence":{"maximum":1.0,"minimum":0.0,"type":"number"},
+                              "answer":{"type":"string"}}})");
+        REQUIRE(text.get() == first.get());
+    }
+
+    SECTION("Canonical form is compact with sorted keys") {
+        auto schema = SchemaInterner::intern(json{{"type", "string"}, {"description", "x"}});
+        REQUIRE(schema->canonical() == R"({"description":"x","type":"string"})");
+        REQUIRE(schema->hash() == SchemaHash128::of(schema->canonical()));
+    }
+
+    SECTION("Different schemas stay distinct") {
+        auto other = SchemaInterner::intern(json{{"type", "integer"}});
+        REQUIRE(other.get() != first.get());
+    }
+}
+
+TEST_CASE("Released schemas leave the interning table", "[interner][unit]") {
+    size_t before = SchemaInterner::size();
+    {
+        auto schema = SchemaInterner::intern(json{{"title", "temporary-schema"}});
+        REQUIRE(SchemaInterner::size() == before + 1);
+    }
+    REQUIRE(SchemaInterner::size() == before);
+}
+
+TEST_CASE("Responses requests splice interned schema bytes", "[interner][unit]") {
+    auto schema = answerSchema().intern();
+
+    LLMRequestConfig config;
+    config.model = "gpt-4o";
+    config.functionName = "answer";
+    config.internedSchema = schema;
+    REQUIRE(config.hasSchema());
+
+    auto request = OpenAI::ResponsesRequest::fromLLMRequest(LLMRequest(config, "Question?"));
+    REQUIRE(request.text.has_value());
+    REQUIRE(request.text->schema().get() == schema.get());
+
+    json withPlaceholder = request.toJson(/*schemaPlaceholder=*/true);
+    REQUIRE(withPlaceholder["text"]["format"]["schema"].is_string());
+
+    std::string body = request.spliceSchema(withPlaceholder.dump());
+    REQUIRE(json::parse(body) == request.toJson());
+    REQUIRE(body.find(schema->canonical()) != std::string::npos);
+
+    SECTION("schemaObject requests are interned too") {
+        LLMRequestConfig plain;
+        plain.model = "gpt-4o";
+        plain.schemaObject = answerSchema().build();
+        auto plainRequest = OpenAI::ResponsesRequest::fromLLMRequest(LLMRequest(plain, "Q"));
+        REQUIRE(plainRequest.text->schema().get() == schema.get());
+    }
+}
+
+TEST_CASE("Schema splicing ignores input that equals the placeholder", "[interner][unit]") {
+    auto schema = answerSchema().intern();
+    const std::string token = "@llmcpp-interned-schema:" + schema->hash().toHex();
+
+    LLMRequestConfig config;
+    config.model = "gpt-4o";
+    config.functionName = "answer";
+    config.internedSchema = schema;
+    auto request = OpenAI::ResponsesRequest::fromLLMRequest(LLMRequest(config, token));
+    request.instructions = token;
+    REQUIRE(request.text->schemaPlaceholderToken() == token);
+
+    json parsed = json::parse(request.spliceSchema(request.toJson(true).dump()));
+    REQUIRE(parsed == request.toJson());
+    REQUIRE(parsed["instructions"] == token);
+    REQUIRE(parsed["text"]["format"]["schema"].is_object());
+}
+
+TEST_CASE("JsonSchemaBuilder moves temporary child builders", "[interner][unit]") {
+    JsonSchemaBuilder child = JsonSchemaBuilder::string().description("kept");
+    auto parent = JsonSchemaBuilder::object()
+                      .property("copied", child)
+                      .property("moved", JsonSchemaBuilder::string().description("moved"))
+                      .build();
+    REQUIRE(parent["properties"]["copied"]["description"] == "kept");
+    REQUIRE(parent["properties"]["moved"]["description"] == "moved");
+    REQUIRE(child.build()["description"] == "kept");
+}
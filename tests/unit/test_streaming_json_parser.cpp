@@ -0,0 +1,115 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "core/StreamingJsonParser.h"
+
+using json = nlohmann::json;
+using llmcpp::StreamedValue;
+using llmcpp::StreamingJsonParser;
+
+namespace {
+
+// Feed `text` in chunks of `chunkSize` bytes and collect what the parser emits
+std::vector<StreamedValue> feedInChunks(const std::string& path, const std::string& text,
+                                        size_t chunkSize) {
+    std::vector<StreamedValue> values;
+    StreamingJsonParser parser(path, [&](StreamedValue value) { values.push_back(std::move(value)); });
+    for (size_t pos = 0; pos < text.size(); pos += chunkSize) {
+        parser.feed(std::string_view(text).substr(pos, chunkSize));
+    }
+    REQUIRE_FALSE(parser.failed());
+    return values;
+}
+
+}  // namespace
+
+TEST_CASE("StreamingJsonParser emits root array elements", "[streaming][unit]") {
+    const std::string text =
+        R"([1, -2.5e3, "a \"]\" b", true, null, {"k": [1, {"x": "}"}]}, [], "\\"])";
+    const json expected = json::parse(text);
+
+    for (size_t chunkSize : {1, 2, 3, 7, 1000}) {
+        auto values = feedInChunks("", text, chunkSize);
+        REQUIRE(values.size() == expected.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            REQUIRE(values[i].index == i);
+            REQUIRE(values[i].value == expected[i]);
+        }
+    }
+}
+
+TEST_CASE("StreamingJsonParser emits elements before the stream ends", "[streaming][unit]") {
+    std::vector<json> seen;
+    StreamingJsonParser parser([&](StreamedValue value) { seen.push_back(value.value); });
+
+    parser.feed(R"([{"id": 1}, {"id")");
+    REQUIRE(seen.size() == 1);
+    REQUIRE(seen[0] == json{{"id", 1}});
+
+    parser.feed(R"(: 2}, 3)");
+    REQUIRE(seen.size() == 2);  // 3 may still grow into 30
+
+    parser.feed("0]");
+    REQUIRE(seen.size() == 3);
+    REQUIRE(seen[2] == 30);
+    REQUIRE(parser.complete());
+
+    parser.feed(", 99]");  // Trailing text is ignored
+    REQUIRE(parser.emitted() == 3);
+}
+
+TEST_CASE("StreamingJsonParser follows a container path", "[streaming][unit]") {
+    const std::string text = "Here you go:\n```json\n" +
+                             json{{"summary", "x"},
+                                  {"items", {{{"name", "a"}}, {{"name", "b"}}}},
+                                  {"meta", {{"items", {1, 2}}}}}
+                                 .dump(2) +
+                             "\n```";
+
+    SECTION("Array elements at a nested path") {
+        auto values = feedInChunks("/items", text, 5);
+        REQUIRE(values.size() == 2);
+        REQUIRE(values[1].index == 1);
+        REQUIRE(values[1].value == json{{"name", "b"}});
+    }
+
+    SECTION("Object fields at the root") {
+        auto values = feedInChunks("", text, 5);
+        REQUIRE(values.size() == 3);
+        REQUIRE(values[0].key == "items");  // nlohmann::json dumps keys sorted
+        REQUIRE(values[1].key == "meta");
+        REQUIRE(values[2].key == "summary");
+        REQUIRE(values[2].value == "x");
+    }
+
+    SECTION("Array index in the path") {
+        auto values = feedInChunks("/items/0", text, 3);
+        REQUIRE(values.size() == 1);
+        REQUIRE(values[0].key == "name");
+        REQUIRE(values[0].value == "a");
+    }
+
+    SECTION("Escaped member names") {
+        auto values = feedInChunks("/a~1b", R"({"a\/b": [true]})", 1);
+        REQUIRE(values.size() == 1);
+        REQUIRE(values[0].value == true);
+    }
+}
+
+TEST_CASE("StreamingJsonParser reports invalid elements", "[streaming][unit]") {
+    size_t calls = 0;
+    StreamingJsonParser parser([&](StreamedValue) { ++calls; });
+    parser.feed("[1, tru, 3]");
+    REQUIRE(parser.failed());
+    REQUIRE(calls == 1);
+
+    parser.reset();
+    parser.feed("[4]");
+    REQUIRE_FALSE(parser.failed());
+    REQUIRE(parser.complete());
+    REQUIRE(calls == 2);
+
+    REQUIRE_THROWS_AS(StreamingJsonParser("items", [](StreamedValue) {}), std::invalid_argument);
+}
@@ -0,0 +1,227 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/Tokenizer.h"
+
+using llmcpp::BpeRanks;
+using llmcpp::BpeTokenizer;
+using Encoding = BpeTokenizer::Encoding;
+using Pieces = std::vector<std::string_view>;
+
+namespace {
+
+// Every single byte is a token (rank = byte value), followed by `merges` in rank order
+BpeTokenizer makeTokenizer(Encoding encoding, const std::vector<std::string>& merges = {}) {
+    BpeRanks ranks;
+    for (int b = 0; b < 256; ++b) {
+        ranks.insert(std::string(1, static_cast<char>(b)), static_cast<BpeRanks::Rank>(b));
+    }
+    for (size_t i = 0; i < merges.size(); ++i) {
+        ranks.insert(merges[i], static_cast<BpeRanks::Rank>(256 + i));
+    }
+    return BpeTokenizer(encoding, std::move(ranks));
+}
+
+// Quadratic reference merge: repeatedly join the leftmost lowest-ranked adjacent pair
+std::vector<BpeRanks::Rank> referenceMerge(const BpeRanks& ranks, const std::string& piece) {
+    std::vector<std::string> parts;
+    for (char c : piece) {
+        parts.emplace_back(1, c);
+    }
+    while (parts.size() > 1) {
+        size_t best = parts.size();
+        BpeRanks::Rank bestRank = BpeRanks::npos;
+        for (size_t i = 0; i + 1 < parts.size(); ++i) {
+            auto rank = ranks.find(parts[i] + parts[i + 1]);
+            if (rank < bestRank) {
+                bestRank = rank;
+                best = i;
+            }
+        }
+        if (best == parts.size()) {
+            break;
+        }
+        parts[best] += parts[best + 1];
+        parts.erase(parts.begin() + static_cast<long>(best) + 1);
+    }
+    std::vector<BpeRanks::Rank> result;
+    for (const auto& part : parts) {
+        result.push_back(ranks.find(part));
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("BpeRanks lookup", "[tokenizer][unit]") {
+    BpeRanks ranks;
+    for (int i = 0; i < 1000; ++i) {
+        ranks.insert("token" + std::to_string(i), static_cast<BpeRanks::Rank>(i));
+    }
+    REQUIRE(ranks.size() == 1000);
+    REQUIRE(ranks.find("token0") == 0);
+    REQUIRE(ranks.find("token999") == 999);
+    REQUIRE(ranks.find("token1000") == BpeRanks::npos);
+    REQUIRE(ranks.find("") == BpeRanks::npos);
+
+    ranks.insert("token5", 42);
+    REQUIRE(ranks.size() == 1000);
+    REQUIRE(ranks.find("token5") == 42);
+}
+
+TEST_CASE("cl100k_base pretokenizer", "[tokenizer][unit]") {
+    auto tokenizer = makeTokenizer(Encoding::Cl100kBase);
+    auto split = [&](std::string_view text) { return tokenizer.pretokenize(text); };
+
+    REQUIRE(split("Hello world") == Pieces{"Hello", " world"});
+    REQUIRE(split("I'm  here") == Pieces{"I", "'m", " ", " here"});
+    REQUIRE(split("don't") == Pieces{"don", "'t"});
+    REQUIRE(split("We'LL") == Pieces{"We", "'LL"});
+    REQUIRE(split("1234567") == Pieces{"123", "456", "7"});
+    REQUIRE(split("foo!!! bar\n\n") == Pieces{"foo", "!!!", " bar", "\n\n"});
+    REQUIRE(split("x  \n  y") == Pieces{"x", "  \n", " ", " y"});
+    REQUIRE(split("trailing   ") == Pieces{"trailing", "   "});
+    REQUIRE(split(" 42") == Pieces{" ", "42"});
+    REQUIRE(split("\tindent") == Pieces{"\tindent"});
+    REQUIRE(split("a.b();\n") == Pieces{"a", ".b", "();\n"});
+    REQUIRE(split("héllo wörld") == Pieces{"héllo", " wörld"});
+    REQUIRE(split("") == Pieces{});
+}
+
+TEST_CASE("o200k_base pretokenizer", "[tokenizer][unit]") {
+    auto tokenizer = makeTokenizer(Encoding::O200kBase);
+    auto split = [&](std::string_view text) { return tokenizer.pretokenize(text); };
+
+    REQUIRE(split("don't") == Pieces{"don't"});
+    REQUIRE(split("CamelCase HTTPServer") == Pieces{"Camel", "Case", " HTTPServer"});
+    REQUIRE(split("ABC") == Pieces{"ABC"});
+    REQUIRE(split("path/to/file\n") == Pieces{"path", "/to", "/file", "\n"});
+    REQUIRE(split("x ?!/\n") == Pieces{"x", " ?!/\n"});
+    REQUIRE(split("12345") == Pieces{"123", "45"});
+    REQUIRE(split("Ünïcode ΑΒΓ") == Pieces{"Ünïcode", " ΑΒΓ"});
+}
+
+TEST_CASE("Pretokenizer pieces cover the input", "[tokenizer][unit]") {
+    std::mt19937 rng(7);
+    const std::string alphabet = "aZ9 \n\t'!/\xc3\xa9\xe4\xb8\xad\xff";
+    for (auto encoding : {Encoding::Cl100kBase, Encoding::O200kBase}) {
+        auto tokenizer = makeTokenizer(encoding);
+        for (int round = 0; round < 200; ++round) {
+            std::string text;
+            for (int i = 0; i < 64; ++i) {
+                text += alphabet[rng() % alphabet.size()];
+            }
+            std::string joined;
+            for (auto piece : tokenizer.pretokenize(text)) {
+                REQUIRE_FALSE(piece.empty());
+                joined += piece;
+            }
+            REQUIRE(joined == text);
+        }
+    }
+}
+
+TEST_CASE("Byte-pair merge", "[tokenizer][unit]") {
+    SECTION("Lowest rank merges first") {
+        auto abFirst = makeTokenizer(Encoding::Cl100kBase, {"ab", "bc"});
+        REQUIRE(abFirst.encode("abc") == std::vector<BpeRanks::Rank>{256, 'c'});
+        auto bcFirst = makeTokenizer(Encoding::Cl100kBase, {"bc", "ab"});
+        REQUIRE(bcFirst.encode("abc") == std::vector<BpeRanks::Rank>{'a', 256});
+    }
+
+    SECTION("Equal ranks merge leftmost first") {
+        auto tokenizer = makeTokenizer(Encoding::Cl100kBase, {"aa"});
+        REQUIRE(tokenizer.encode("aaa") == std::vector<BpeRanks::Rank>{256, 'a'});
+        REQUIRE(tokenizer.countTokens("aaaa") == 2);
+    }
+
+    SECTION("Whole pieces in the vocabulary are one token") {
+        auto tokenizer = makeTokenizer(Encoding::Cl100kBase, {" w", "wo", "or", " world"});
+        REQUIRE(tokenizer.encode("hi world") == std::vector<BpeRanks::Rank>{'h', 'i', 259});
+    }
+
+    SECTION("Heap merge matches the quadratic reference") {
+        std::mt19937 rng(11);
+        std::vector<std::string> merges;
+        for (int i = 0; i < 300; ++i) {
+            std::string token;
+            int length = 2 + static_cast<int>(rng() % 4);
+            for (int j = 0; j < length; ++j) {
+                token += static_cast<char>('a' + rng() % 4);
+            }
+            merges.push_back(token);
+        }
+        auto tokenizer = makeTokenizer(Encoding::Cl100kBase, merges);
+        BpeRanks ranks;
+        for (int b = 0; b < 256; ++b) {
+            ranks.insert(std::string(1, static_cast<char>(b)), static_cast<BpeRanks::Rank>(b));
+        }
+        for (size_t i = 0; i < merges.size(); ++i) {
+            ranks.insert(merges[i], static_cast<BpeRanks::Rank>(256 + i));
+        }
+        for (int round = 0; round < 200; ++round) {
+            std::string word;
+            int length = 1 + static_cast<int>(rng() % 40);
+            for (int j = 0; j < length; ++j) {
+                word += static_cast<char>('a' + rng() % 4);
+            }
+            REQUIRE(tokenizer.encode(word) == referenceMerge(ranks, word));
+        }
+    }
+}
+
+TEST_CASE("Tiktoken vocabulary loading", "[tokenizer][unit]") {
+    std::istringstream vocab("YQ== 0\nYg== 1\r\nYWI= 2\n\n");
+    auto tokenizer = BpeTokenizer::fromTiktoken(vocab, Encoding::O200kBase);
+    REQUIRE(tokenizer.vocabularySize() == 3);
+    REQUIRE(tokenizer.encoding() == Encoding::O200kBase);
+    REQUIRE(tokenizer.encode("ab") == std::vector<BpeRanks::Rank>{2});
+    REQUIRE(tokenizer.encode("ba") == std::vector<BpeRanks::Rank>{1, 0});
+
+    std::istringstream malformed("YQ== 0\nnot base64!\n");
+    REQUIRE_THROWS_AS(BpeTokenizer::fromTiktoken(malformed, Encoding::Cl100kBase),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(BpeTokenizer::fromTiktokenFile("/nonexistent/vocab.tiktoken",
+                                                     Encoding::Cl100kBase),
+                      std::runtime_error);
+}
+
+TEST_CASE("Encoding for model", "[tokenizer][unit]") {
+    REQUIRE(BpeTokenizer::encodingForModel("gpt-4o-mini") == Encoding::O200kBase);
+    REQUIRE(BpeTokenizer::encodingForModel("gpt-4.1") == Encoding::O200kBase);
+    REQUIRE(BpeTokenizer::encodingForModel("o3-mini") == Encoding::O200kBase);
+    REQUIRE(BpeTokenizer::encodingForModel("gpt-4") == Encoding::Cl100kBase);
+    REQUIRE(BpeTokenizer::encodingForModel("gpt-3.5-turbo") == Encoding::Cl100kBase);
+    REQUIRE(std::string(BpeTokenizer::encodingName(Encoding::O200kBase)) == "o200k_base");
+}
+
+TEST_CASE("Request token counting", "[tokenizer][unit]") {
+    // Without merges every byte is one token, so counts are byte counts plus framing
+    auto tokenizer = makeTokenizer(Encoding::Cl100kBase);
+    const size_t framing = BpeTokenizer::kTokensPerMessage;
+    const size_t priming = BpeTokenizer::kReplyPrimingTokens;
+
+    LLMRequestConfig config;
+    config.model = "gpt-4";
+    REQUIRE(tokenizer.countTokens(LLMRequest(config, "")) == priming);
+    REQUIRE(tokenizer.countTokens(LLMRequest(config, "hi")) ==
+            priming + framing + std::string("system").size() + 2);
+
+    LLMContext context = {
+        json{{"role", "assistant"}, {"content", "yo"}},
+        json{{"role", "user"},
+             {"content", json::array({{{"type", "input_text"}, {"text", "abc"}}})}},
+        json("plain")};
+    size_t expected = priming + (framing + 6 + 2) + (framing + 9 + 2) + (framing + 4 + 3) +
+                      (framing + 4 + 5);
+    REQUIRE(tokenizer.countTokens(LLMRequest(config, "hi", context)) == expected);
+
+    config.schemaObject = json{{"type", "object"}};
+    REQUIRE(tokenizer.countTokens(LLMRequest(config, "hi", context)) ==
+            expected + std::string(R"({"type":"object"})").size());
+}
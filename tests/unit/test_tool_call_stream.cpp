@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "anthropic/AnthropicToolSession.h"
+#include "core/SseParser.h"
+#include "core/ToolCallStream.h"
+#include "openai/OpenAIToolSession.h"
+
+using json = nlohmann::json;
+using namespace std::chrono_literals;
+
+namespace {
+
+std::string frame(const std::string& event, const json& data) {
+    return "event: " + event + "\ndata: " + data.dump() + "\n\n";
+}
+
+// Two interleaved function calls followed by text, as the Responses API streams them
+std::vector<json> responsesEvents() {
+    return {
+        {{"type", "response.created"}},
+        {{"type", "response.output_item.added"},
+         {"output_index", 0},
+         {"item", {{"type", "function_call"}, {"id", "fc_a"}, {"call_id", "call_a"},
+                   {"name", "echo"}, {"arguments", ""}}}},
+        {{"type", "response.output_item.added"},
+         {"output_index", 1},
+         {"item", {{"type", "function_call"}, {"id", "fc_b"}, {"call_id", "call_b"},
+                   {"name", "echo"}, {"arguments", ""}}}},
+        {{"type", "response.function_call_arguments.delta"}, {"output_index", 0},
+         {"delta", R"({"v":)"}},
+        {{"type", "response.function_call_arguments.delta"}, {"output_index", 1},
+         {"delta", R"({"v":)"}},
+        {{"type", "response.function_call_arguments.delta"}, {"output_index", 0},
+         {"delta", R"("a"})"}},
+        {{"type", "response.function_call_arguments.done"}, {"output_index", 0},
+         {"arguments", R"({"v":"a"})"}},
+        {{"type", "response.output_item.done"},
+         {"output_index", 0},
+         {"item", {{"type", "function_call"}, {"call_id", "call_a"}, {"name", "echo"},
+                   {"arguments", R"({"v":"a"})"}}}},
+        {{"type", "response.function_call_arguments.delta"}, {"output_index", 1},
+         {"delta", R"("b"})"}},
+        {{"type", "response.function_call_arguments.done"}, {"output_index", 1},
+         {"arguments", R"({"v":"b"})"}},
+        {{"type", "response.output_text.delta"}, {"output_index", 2}, {"delta", "done"}},
+        {{"type", "response.completed"}},
+    };
+}
+
+llmcpp::ToolRunner echoRunner(std::atomic<int>& calls) {
+    llmcpp::ToolRunner runner;
+    runner.addTool({"echo", "Echo v", json{{"type", "object"}}}, [&calls](const json& args) {
+        ++calls;
+        return args.at("v");
+    });
+    return runner;
+}
+
+}  // namespace
+
+TEST_CASE("SseParser frames events across arbitrary chunks", "[streaming][unit]") {
+    const std::string body = ": keep-alive\r\nevent: first\r\ndata: {\"a\":1}\r\n\r\n"
+                             "data: line1\ndata: line2\n\n"
+                             "event: empty\n\n"
+                             "data:no-space\n";
+
+    for (size_t chunkSize : {1, 2, 5, 1000}) {
+        std::vector<llmcpp::SseParser::Event> events;
+        llmcpp::SseParser parser([&](const auto& event) { events.push_back(event); });
+        for (size_t pos = 0; pos < body.size(); pos += chunkSize) {
+            parser.feed(std::string_view(body).substr(pos, chunkSize));
+        }
+        REQUIRE(events.size() == 2);
+        parser.finish();
+
+        REQUIRE(events.size() == 3);
+        REQUIRE(events[0].event == "first");
+        REQUIRE(events[0].data == R"({"a":1})");
+        REQUIRE(events[1].event.empty());
+        REQUIRE(events[1].data == "line1\nline2");
+        REQUIRE(events[2].data == "no-space");
+    }
+}
+
+TEST_CASE("ToolCallAssembler assembles interleaved calls", "[streaming][unit]") {
+    std::vector<llmcpp::ToolCall> calls;
+    llmcpp::ToolCallAssembler assembler([&](llmcpp::ToolCall call) { calls.push_back(call); });
+
+    size_t emittedBeforeSecondCloses = 0;
+    for (const auto& event : responsesEvents()) {
+        OpenAI::applyResponsesStreamEvent(assembler, event);
+        if (event["type"] == "response.function_call_arguments.delta" &&
+            event["output_index"] == 1 && calls.size() == 1) {
+            emittedBeforeSecondCloses = calls.size();
+        }
+    }
+
+    REQUIRE(emittedBeforeSecondCloses == 1);  // First call left before the second finished
+    REQUIRE(calls.size() == 2);
+    REQUIRE(calls[0].id == "call_a");
+    REQUIRE(calls[0].arguments == json{{"v", "a"}});
+    REQUIRE(calls[1].id == "call_b");
+    REQUIRE(calls[1].arguments == json{{"v", "b"}});
+    REQUIRE(assembler.open() == 0);
+
+    SECTION("Empty and malformed arguments") {
+        assembler.begin(7, "x", "noargs");
+        REQUIRE(assembler.finish(7));
+        REQUIRE(calls.back().arguments == json::object());
+
+        assembler.begin(8, "y", "broken");
+        assembler.append(8, R"({"v":)");
+        REQUIRE(assembler.finish(8));
+        REQUIRE(calls.back().arguments == R"({"v":)");
+
+        REQUIRE_FALSE(assembler.finish(9));
+    }
+}
+
+TEST_CASE("Closing events without arguments keep the streamed deltas", "[streaming][unit]") {
+    std::vector<llmcpp::ToolCall> calls;
+    llmcpp::ToolCallAssembler assembler([&](llmcpp::ToolCall call) { calls.push_back(call); });
+
+    for (const char* closing :
+         {"response.function_call_arguments.done", "response.output_item.done"}) {
+        calls.clear();
+        const json item = {{"type", "function_call"}, {"call_id", "call_c"}, {"name", "echo"}};
+        OpenAI::applyResponsesStreamEvent(
+            assembler,
+            {{"type", "response.output_item.added"}, {"output_index", 0}, {"item", item}});
+        OpenAI::applyResponsesStreamEvent(assembler,
+                                          {{"type", "response.function_call_arguments.delta"},
+                                           {"output_index", 0},
+                                           {"delta", R"({"v":"c"})"}});
+        json done = {{"type", closing}, {"output_index", 0}};
+        if (std::string(closing) == "response.output_item.done") {
+            done["item"] = item;
+        }
+        REQUIRE(OpenAI::applyResponsesStreamEvent(assembler, done));
+
+        REQUIRE(calls.size() == 1);
+        REQUIRE(calls[0].arguments == json{{"v", "c"}});
+    }
+}
+
+TEST_CASE("Anthropic stream events map onto the assembler", "[streaming][unit]") {
+    std::vector<llmcpp::ToolCall> calls;
+    llmcpp::ToolCallAssembler assembler([&](llmcpp::ToolCall call) { calls.push_back(call); });
+
+    const std::vector<json> events = {
+        {{"type", "message_start"}},
+        {{"type", "content_block_start"}, {"index", 0},
+         {"content_block", {{"type", "text"}, {"text", ""}}}},
+        {{"type", "content_block_delta"}, {"index", 0},
+         {"delta", {{"type", "text_delta"}, {"text", "Checking"}}}},
+        {{"type", "content_block_stop"}, {"index", 0}},
+        {{"type", "content_block_start"}, {"index", 1},
+         {"content_block", {{"type", "tool_use"}, {"id", "toolu_1"}, {"name", "echo"},
+                            {"input", json::object()}}}},
+        {{"type", "content_block_delta"}, {"index", 1},
+         {"delta", {{"type", "input_json_delta"}, {"partial_json", R"({"v": )"}}}},
+        {{"type", "content_block_delta"}, {"index", 1},
+         {"delta", {{"type", "input_json_delta"}, {"partial_json", R"("x"})"}}}},
+        {{"type", "content_block_stop"}, {"index", 1}},
+        {{"type", "message_stop"}},
+    };
+
+    std::vector<bool> handled;
+    for (const auto& event : events) {
+        handled.push_back(Anthropic::applyMessagesStreamEvent(assembler, event));
+    }
+    REQUIRE(handled == std::vector<bool>{false, false, false, false, true, true, true, true,
+                                         false});
+    REQUIRE(calls.size() == 1);
+    REQUIRE(calls[0].id == "toolu_1");
+    REQUIRE(calls[0].arguments == json{{"v", "x"}});
+}
+
+TEST_CASE("StreamingToolDispatcher runs calls while the stream continues", "[streaming][unit]") {
+    std::atomic<int> calls{0};
+    auto runner = echoRunner(calls);
+    llmcpp::StreamingToolDispatcher dispatcher(runner, OpenAI::applyResponsesStreamEvent);
+    auto feed = dispatcher.streamCallback();
+
+    auto events = responsesEvents();
+    size_t i = 0;
+    for (; i < events.size(); ++i) {
+        feed(frame(events[i]["type"], events[i]));
+        if (events[i]["type"] == "response.output_item.done") {
+            break;  // First call closed; the second is still streaming
+        }
+    }
+    REQUIRE(dispatcher.dispatched() == 1);
+    for (int waited = 0; calls == 0 && waited < 200; ++waited) {
+        std::this_thread::sleep_for(5ms);
+    }
+    REQUIRE(calls == 1);
+
+    for (++i; i < events.size(); ++i) {
+        feed(frame(events[i]["type"], events[i]));
+    }
+    feed("data: [DONE]\n\n");
+
+    auto results = dispatcher.results();
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0].id == "call_a");
+    REQUIRE(results[0].output == "a");
+    REQUIRE(results[1].output == "b");
+    REQUIRE(calls == 2);
+}
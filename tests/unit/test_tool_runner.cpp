@@ -0,0 +1,266 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include "anthropic/AnthropicToolSession.h"
+#include "core/ToolRunner.h"
+#include "openai/OpenAIToolSession.h"
+
+using json = nlohmann::json;
+using namespace std::chrono_literals;
+
+namespace tool_runner_test {
+
+struct AddArgs {
+    int a = 0;
+    int b = 0;
+};
+LLMCPP_SCHEMA(AddArgs, a, b)
+
+}  // namespace tool_runner_test
+
+namespace {
+
+// Replays scripted turns and records what the runner submitted
+class ScriptedSession : public llmcpp::ToolSession {
+   public:
+    explicit ScriptedSession(std::vector<llmcpp::ToolTurn> turns) : turns_(std::move(turns)) {}
+
+    llmcpp::ToolTurn start(const std::vector<llmcpp::ToolDefinition>& tools) override {
+        advertised = tools;
+        return next();
+    }
+
+    llmcpp::ToolTurn submit(const std::vector<llmcpp::ToolCallResult>& results) override {
+        submitted.push_back(results);
+        return next();
+    }
+
+    std::vector<llmcpp::ToolDefinition> advertised;
+    std::vector<std::vector<llmcpp::ToolCallResult>> submitted;
+
+   private:
+    llmcpp::ToolTurn next() {
+        if (turn_ >= turns_.size()) {
+            throw std::runtime_error("script exhausted");
+        }
+        return turns_[turn_++];
+    }
+
+    std::vector<llmcpp::ToolTurn> turns_;
+    size_t turn_ = 0;
+};
+
+llmcpp::ToolTurn callTurn(std::vector<llmcpp::ToolCall> calls) {
+    llmcpp::ToolTurn turn;
+    turn.calls = std::move(calls);
+    turn.usage.inputTokens = 10;
+    return turn;
+}
+
+llmcpp::ToolTurn answerTurn(std::string text) {
+    llmcpp::ToolTurn turn;
+    turn.text = std::move(text);
+    turn.usage.inputTokens = 10;
+    return turn;
+}
+
+llmcpp::ToolRunner makeRunner() {
+    llmcpp::ToolRunner runner;
+    runner.addTool<tool_runner_test::AddArgs>(
+        "add", "Add two integers",
+        [](const tool_runner_test::AddArgs& args) { return args.a + args.b; });
+    runner.addTool({"sleep", "Sleep for ms milliseconds", json{{"type", "object"}}},
+                   [](const json& args) {
+                       std::this_thread::sleep_for(std::chrono::milliseconds(args.value("ms", 0)));
+                       return json("slept");
+                   });
+    runner.addTool({"fail", "Always throws", json{{"type", "object"}}},
+                   [](const json&) -> json { throw std::runtime_error("boom"); });
+    return runner;
+}
+
+}  // namespace
+
+TEST_CASE("ToolRunner loops until the final answer", "[tools][unit]") {
+    auto runner = makeRunner();
+    ScriptedSession session({callTurn({{"c1", "add", {{"a", 2}, {"b", 3}}}}),
+                             callTurn({{"c2", "add", {{"a", 5}, {"b", 5}}},
+                                       {"c3", "fail", json::object()},
+                                       {"c4", "missing", json::object()},
+                                       {"c5", "add", "not an object"}}),
+                             answerTurn("10")});
+
+    auto result = runner.run(session);
+    REQUIRE(result.success);
+    REQUIRE(result.text == "10");
+    REQUIRE(result.steps == 3);
+    REQUIRE(result.usage.inputTokens == 30);
+    REQUIRE(result.toolResults.size() == 5);
+
+    REQUIRE(session.advertised.size() == 3);
+    REQUIRE(session.advertised[0].parameters["required"] == json{"a", "b"});
+
+    REQUIRE(session.submitted.size() == 2);
+    REQUIRE(session.submitted[0][0].output == 5);
+    const auto& second = session.submitted[1];
+    REQUIRE(second[0].id == "c2");
+    REQUIRE(second[0].output == 10);
+    REQUIRE(second[1].isError);
+    REQUIRE(second[1].output == "boom");
+    REQUIRE(second[2].isError);
+    REQUIRE(second[2].output == "Unknown tool: missing");
+    REQUIRE(second[3].isError);
+}
+
+TEST_CASE("ToolRunner runs a turn's calls in parallel", "[tools][unit]") {
+    auto runner = makeRunner();
+    std::vector<llmcpp::ToolCall> calls;
+    for (int i = 0; i < 4; ++i) {
+        calls.push_back({"c" + std::to_string(i), "sleep", {{"ms", 200}}});
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    auto results = runner.execute(calls);
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    REQUIRE(results.size() == 4);
+    for (size_t i = 0; i < results.size(); ++i) {
+        REQUIRE(results[i].id == "c" + std::to_string(i));
+        REQUIRE(results[i].output == "slept");
+        REQUIRE(results[i].durationMs >= 150.0);
+    }
+    REQUIRE(elapsed < 600ms);  // Serial execution would take 800 ms
+}
+
+TEST_CASE("ToolRunner enforces step and time limits", "[tools][unit]") {
+    SECTION("Step limit") {
+        llmcpp::ToolRunner runner(llmcpp::ToolRunner::Options{2, 0ms, 8});
+        runner.addTool({"noop", "", json{{"type", "object"}}}, [](const json&) { return 1; });
+        ScriptedSession session({callTurn({{"c1", "noop", json::object()}}),
+                                 callTurn({{"c2", "noop", json::object()}}),
+                                 answerTurn("unreachable")});
+        auto result = runner.run(session);
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.steps == 2);
+        REQUIRE(result.errorMessage.find("2 steps") != std::string::npos);
+    }
+
+    SECTION("Deadline") {
+        auto runner = makeRunner();
+        runner.options().timeout = 100ms;
+        ScriptedSession session({callTurn({{"c1", "sleep", {{"ms", 1000}}}}), answerTurn("late")});
+
+        auto started = std::chrono::steady_clock::now();
+        auto result = runner.run(session);
+        REQUIRE(std::chrono::steady_clock::now() - started < 800ms);
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "Tool loop deadline exceeded");
+        REQUIRE(result.toolResults.size() == 1);
+        REQUIRE(result.toolResults[0].isError);
+        REQUIRE(result.toolResults[0].output == "Tool call timed out");
+    }
+
+    SECTION("Session errors end the loop") {
+        auto runner = makeRunner();
+        ScriptedSession session({callTurn({{"c1", "add", {{"a", 1}, {"b", 1}}}})});
+        auto result = runner.run(session);
+        REQUIRE_FALSE(result.success);
+        REQUIRE(result.errorMessage == "script exhausted");
+    }
+
+    SECTION("Duplicate registration") {
+        auto runner = makeRunner();
+        REQUIRE_THROWS_AS(runner.addTool({"add", "", json::object()}, [](const json&) { return 0; }),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("OpenAI ResponsesToolSession wire format", "[tools][unit]") {
+    std::vector<json> sent;
+    int turn = 0;
+    auto sender = [&](const OpenAI::ResponsesRequest& request) {
+        sent.push_back(request.toJson());
+        OpenAI::ResponsesResponse response;
+        response.id = "resp_" + std::to_string(++turn);
+        if (turn == 1) {
+            response.output = {{{"type", "function_call"},
+                                {"id", "fc_1"},
+                                {"call_id", "call_1"},
+                                {"name", "add"},
+                                {"arguments", R"({"a":1,"b":2})"}}};
+        } else {
+            response.output = {{{"type", "message"},
+                                {"content", {{{"type", "output_text"}, {"text", "3"}}}}}};
+        }
+        return response;
+    };
+
+    OpenAI::ResponsesRequest request;
+    request.model = "gpt-4o";
+    request.instructions = "Use the tools";
+    request.input = OpenAI::ResponsesInput::fromText("What is 1 + 2?");
+    OpenAI::ResponsesToolSession session(sender, request);
+
+    auto result = makeRunner().run(session);
+    REQUIRE(result.success);
+    REQUIRE(result.text == "3");
+    REQUIRE(result.responseId == "resp_2");
+
+    REQUIRE(sent.size() == 2);
+    REQUIRE(sent[0]["tools"].size() == 3);
+    REQUIRE(sent[0]["tools"][0]["strict"] == true);  // Typed schemas are already strict
+    REQUIRE(sent[0]["tools"][1]["strict"] == false);
+    REQUIRE(sent[1]["previous_response_id"] == "resp_1");
+    REQUIRE(sent[1]["instructions"] == "Use the tools");
+    REQUIRE(sent[1]["input"] == json::array({{{"type", "function_call_output"},
+                                              {"call_id", "call_1"},
+                                              {"output", "3"}}}));
+
+    request.store = false;
+    REQUIRE_THROWS_AS(OpenAI::ResponsesToolSession(sender, request), std::invalid_argument);
+}
+
+TEST_CASE("Anthropic MessagesToolSession wire format", "[tools][unit]") {
+    std::vector<json> sent;
+    auto sender = [&](const Anthropic::MessagesRequest& request) {
+        sent.push_back(request.toJson());
+        Anthropic::MessagesResponse response;
+        if (sent.size() == 1) {
+            response.content = {Anthropic::MessageContent::createText("Let me check."),
+                                Anthropic::MessageContent::createToolUse(
+                                    "toolu_1", "add", {{"a", 4}, {"b", 4}}),
+                                Anthropic::MessageContent::createToolUse("toolu_2", "fail",
+                                                                         json::object())};
+        } else {
+            response.content = {Anthropic::MessageContent::createText("8")};
+        }
+        return response;
+    };
+
+    Anthropic::MessagesRequest request;
+    request.model = "claude-sonnet-4-20250514";
+    request.maxTokens = 256;
+    request.messages.push_back(
+        {Anthropic::MessageRole::USER, {Anthropic::MessageContent::createText("4 + 4?")}});
+    Anthropic::MessagesToolSession session(sender, request);
+
+    auto result = makeRunner().run(session);
+    REQUIRE(result.success);
+    REQUIRE(result.text == "8");
+
+    REQUIRE(sent.size() == 2);
+    REQUIRE(sent[0]["tools"][0]["input_schema"]["type"] == "object");
+    const auto& messages = sent[1]["messages"];
+    REQUIRE(messages.size() == 3);
+    REQUIRE(messages[1]["role"] == "assistant");
+    REQUIRE(messages[1]["content"][1]["type"] == "tool_use");
+    REQUIRE(messages[2]["role"] == "user");
+    REQUIRE(messages[2]["content"][0] ==
+            json{{"type", "tool_result"}, {"tool_use_id", "toolu_1"}, {"content", "8"}});
+    REQUIRE(messages[2]["content"][1]["is_error"] == true);
+    REQUIRE(session.request().messages.size() == 4);
+}
@@ -0,0 +1,263 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+
+#include "core/Tracing.h"
+#include "llmcpp.h"
+
+using json = nlohmann::json;
+using namespace llmcpp;
+
+namespace {
+
+// Installs an in-memory exporter for the duration of a test
+struct ScopedExporter {
+    std::shared_ptr<InMemorySpanExporter> exporter = std::make_shared<InMemorySpanExporter>();
+    ScopedExporter() { Tracer::setExporter(exporter); }
+    ~ScopedExporter() { Tracer::setExporter(nullptr); }
+};
+
+const SpanData* findSpan(const std::vector<SpanData>& spans, const std::string& name) {
+    for (const auto& span : spans) {
+        if (span.name == name) {
+            return &span;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+TEST_CASE("TraceContext traceparent round trip", "[tracing][unit]") {
+    SECTION("Valid header") {
+        auto ctx =
+            TraceContext::fromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01");
+        REQUIRE(ctx.has_value());
+        REQUIRE(ctx->traceId == "4bf92f3577b34da6a3ce929d0e0e4736");
+        REQUIRE(ctx->spanId == "00f067aa0ba902b7");
+        REQUIRE(ctx->sampled);
+        REQUIRE(ctx->toTraceparent() ==
+                "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01");
+    }
+
+    SECTION("Unsampled flag") {
+        auto ctx =
+            TraceContext::fromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00");
+        REQUIRE(ctx.has_value());
+        REQUIRE_FALSE(ctx->sampled);
+    }
+
+    SECTION("Malformed headers are rejected") {
+        REQUIRE_FALSE(TraceContext::fromTraceparent("").has_value());
+        REQUIRE_FALSE(TraceContext::fromTraceparent("garbage").has_value());
+        REQUIRE_FALSE(
+            TraceContext::fromTraceparent("00-00000000000000000000000000000000-00f067aa0ba902b7-01")
+                .has_value());
+        REQUIRE_FALSE(
+            TraceContext::fromTraceparent("00-4BF92F3577B34DA6A3CE929D0E0E4736-00f067aa0ba902b7-01")
+                .has_value());
+        REQUIRE_FALSE(
+            TraceContext::fromTraceparent("ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01")
+                .has_value());
+    }
+}
+
+TEST_CASE("Spans are no-ops without an exporter", "[tracing][unit]") {
+    Tracer::setExporter(nullptr);
+    REQUIRE_FALSE(Tracer::isEnabled());
+
+    Span span("noop");
+    span.setAttribute("key", "value");
+    REQUIRE_FALSE(span.isRecording());
+    REQUIRE(Span::current() == nullptr);
+}
+
+TEST_CASE("Spans nest through the thread's current span", "[tracing][unit]") {
+    ScopedExporter scoped;
+
+    {
+        Span parent("parent", SpanData::Kind::Client);
+        REQUIRE(Span::current() == &parent);
+        {
+            Span child("child");
+            child.setAttribute("llm.retry.attempt", 1);
+            REQUIRE(Span::current() == &child);
+        }
+        REQUIRE(Span::current() == &parent);
+        parent.setStatus(SpanData::StatusCode::Ok);
+    }
+    REQUIRE(Span::current() == nullptr);
+
+    auto spans = scoped.exporter->getSpans();
+    REQUIRE(spans.size() == 2);
+
+    // Children finish first
+    REQUIRE(spans[0].name == "child");
+    REQUIRE(spans[1].name == "parent");
+    REQUIRE(spans[0].traceId == spans[1].traceId);
+    REQUIRE(spans[0].parentSpanId == spans[1].spanId);
+    REQUIRE(spans[1].parentSpanId.empty());
+    REQUIRE(spans[0].attributes["llm.retry.attempt"] == 1);
+    REQUIRE(spans[1].status == SpanData::StatusCode::Ok);
+    REQUIRE(spans[1].kind == SpanData::Kind::Client);
+    REQUIRE(spans[1].endTimeUnixNano >= spans[0].endTimeUnixNano);
+}
+
+TEST_CASE("Spans join an inbound trace context", "[tracing][unit]") {
+    ScopedExporter scoped;
+
+    auto inbound =
+        TraceContext::fromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01");
+    {
+        Span span("llm.client.request", inbound, SpanData::Kind::Client);
+        REQUIRE(span.context().traceId == inbound->traceId);
+        REQUIRE(span.context().spanId != inbound->spanId);
+    }
+
+    auto spans = scoped.exporter->getSpans();
+    REQUIRE(spans.size() == 1);
+    REQUIRE(spans[0].traceId == "4bf92f3577b34da6a3ce929d0e0e4736");
+    REQUIRE(spans[0].parentSpanId == "00f067aa0ba902b7");
+}
+
+TEST_CASE("Unsampled trace contexts propagate but are not exported", "[tracing][unit]") {
+    ScopedExporter scoped;
+
+    auto inbound =
+        TraceContext::fromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00");
+    {
+        Span span("llm.client.request", inbound, SpanData::Kind::Client);
+        Span child("llm.http");
+        REQUIRE(span.isRecording());
+        REQUIRE_FALSE(child.context().sampled);
+        REQUIRE(child.context().traceId == inbound->traceId);
+        REQUIRE(child.context().toTraceparent().ends_with("-00"));
+    }
+    REQUIRE(scoped.exporter->getSpans().empty());
+}
+
+TEST_CASE("Spans ended out of order leave a valid current span", "[tracing][unit]") {
+    ScopedExporter scoped;
+
+    auto outer = std::make_unique<Span>("outer");
+    auto middle = std::make_unique<Span>("middle");
+    Span inner("inner");
+    REQUIRE(Span::current() == &inner);
+
+    middle.reset();
+    REQUIRE(Span::current() == &inner);
+    outer.reset();
+    REQUIRE(Span::current() == &inner);
+
+    inner.end();
+    REQUIRE(Span::current() == nullptr);
+    REQUIRE(scoped.exporter->getSpans().size() == 3);
+}
+
+TEST_CASE("OTLP/JSON export format", "[tracing][unit]") {
+    SpanData span;
+    span.name = "HTTP POST";
+    span.traceId = "4bf92f3577b34da6a3ce929d0e0e4736";
+    span.spanId = "00f067aa0ba902b7";
+    span.parentSpanId = "1111111111111111";
+    span.kind = SpanData::Kind::Client;
+    span.startTimeUnixNano = 1000;
+    span.endTimeUnixNano = 2000;
+    span.status = SpanData::StatusCode::Error;
+    span.statusMessage = "HTTP 429 error";
+    span.attributes = {{"http.status_code", 429}, {"llm.model", "gpt-4o"}};
+
+    SECTION("Span encoding") {
+        auto otlp = OtlpJsonFileExporter::toOtlpJson(span, "test-service");
+        auto& resourceSpan = otlp["resourceSpans"][0];
+        REQUIRE(resourceSpan["resource"]["attributes"][0]["key"] == "service.name");
+        REQUIRE(resourceSpan["resource"]["attributes"][0]["value"]["stringValue"] ==
+                "test-service");
+
+        auto& scopeSpan = resourceSpan["scopeSpans"][0];
+        REQUIRE(scopeSpan["scope"]["name"] == "llmcpp");
+        REQUIRE(scopeSpan["scope"]["version"] == LLMCPP_VERSION);
+
+        auto& encoded = scopeSpan["spans"][0];
+        REQUIRE(encoded["name"] == "HTTP POST");
+        REQUIRE(encoded["kind"] == 3);
+        REQUIRE(encoded["parentSpanId"] == "1111111111111111");
+        REQUIRE(encoded["startTimeUnixNano"] == "1000");
+        REQUIRE(encoded["endTimeUnixNano"] == "2000");
+        REQUIRE(encoded["status"]["code"] == 2);
+        REQUIRE(encoded["status"]["message"] == "HTTP 429 error");
+
+        bool foundStatusCode = false;
+        for (const auto& attr : encoded["attributes"]) {
+            if (attr["key"] == "http.status_code") {
+                foundStatusCode = true;
+                REQUIRE(attr["value"]["intValue"] == "429");
+            }
+        }
+        REQUIRE(foundStatusCode);
+    }
+
+    SECTION("File exporter writes one request per line") {
+        std::string path = "llmcpp_test_traces.jsonl";
+        std::remove(path.c_str());
+        {
+            OtlpJsonFileExporter exporter(path);
+            exporter.exportSpan(span);
+            exporter.exportSpan(span);
+            exporter.flush();
+        }
+
+        std::ifstream in(path);
+        std::string line;
+        int lines = 0;
+        while (std::getline(in, line)) {
+            auto parsed = json::parse(line);
+            REQUIRE(parsed["resourceSpans"][0]["scopeSpans"][0]["spans"][0]["spanId"] ==
+                    "00f067aa0ba902b7");
+            ++lines;
+        }
+        in.close();
+        std::remove(path.c_str());
+        REQUIRE(lines == 2);
+    }
+}
+
+TEST_CASE("OpenAI client produces a client/attempt/HTTP span tree", "[tracing][unit]") {
+    ScopedExporter scoped;
+
+    // Unresolvable host: the request fails fast without touching the network
+    OpenAI::OpenAIConfig config;
+    config.apiKey = "test-key";
+    config.baseUrl = "https://invalid.localdomain.test/v1";
+    config.maxRetries = 0;
+    config.timeoutSeconds = 1;
+    OpenAIClient client(config);
+
+    LLMRequestConfig requestConfig;
+    requestConfig.client = "openai";
+    requestConfig.model = "gpt-4o-mini";
+    LLMRequest request(requestConfig, "Hello");
+    request.traceContext =
+        TraceContext::fromTraceparent("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01");
+
+    auto response = client.sendRequest(request);
+    REQUIRE_FALSE(response.success);
+
+    auto spans = scoped.exporter->getSpans();
+    auto* clientSpan = findSpan(spans, "llm.client.request");
+    auto* attemptSpan = findSpan(spans, "llm.retry.attempt");
+    auto* httpSpan = findSpan(spans, "HTTP POST");
+    REQUIRE(clientSpan != nullptr);
+    REQUIRE(attemptSpan != nullptr);
+    REQUIRE(httpSpan != nullptr);
+
+    REQUIRE(clientSpan->traceId == "4bf92f3577b34da6a3ce929d0e0e4736");
+    REQUIRE(clientSpan->parentSpanId == "00f067aa0ba902b7");
+    REQUIRE(attemptSpan->parentSpanId == clientSpan->spanId);
+    REQUIRE(httpSpan->parentSpanId == attemptSpan->spanId);
+
+    REQUIRE(clientSpan->status == SpanData::StatusCode::Error);
+    REQUIRE(clientSpan->attributes["llm.model"] == "gpt-4o-mini");
+    REQUIRE(clientSpan->attributes["llm.retry.count"] == 0);
+    REQUIRE(httpSpan->attributes["http.status_code"] == 0);
+}
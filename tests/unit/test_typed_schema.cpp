@@ -0,0 +1,143 @@
+#include <catch2/catch_test_macros.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/CompiledSchema.h"
+#include "core/TypedSchema.h"
+
+using json = nlohmann::json;
+
+namespace typed_test {
+
+struct Address {
+    std::string city;
+    std::optional<std::string> postcode;
+};
+LLMCPP_SCHEMA(Address, city, postcode)
+
+struct Person {
+    std::string name;
+    int age = 0;
+    double score = 0.0;
+    bool active = false;
+    std::vector<std::string> tags;
+    std::optional<Address> address;
+    std::vector<Address> previous;
+};
+LLMCPP_SCHEMA(Person, name, age, score, active, tags, address, previous)
+
+}  // namespace typed_test
+
+using typed_test::Address;
+using typed_test::Person;
+
+TEST_CASE("Typed schemas derive strict JSON Schema", "[typed][unit]") {
+    const json& schema = llmcpp::schemaFor<Person>();
+
+    REQUIRE(schema["type"] == "object");
+    REQUIRE(schema["additionalProperties"] == false);
+    REQUIRE(schema["required"] == json::array({"name", "age", "score", "active", "tags",
+                                                "address", "previous"}));
+    REQUIRE(schema["properties"]["age"]["type"] == "integer");
+    REQUIRE(schema["properties"]["score"]["type"] == "number");
+    REQUIRE(schema["properties"]["tags"]["items"]["type"] == "string");
+    REQUIRE(schema["properties"]["address"]["type"] == json::array({"object", "null"}));
+    REQUIRE(schema["properties"]["previous"]["items"]["properties"]["postcode"]["type"] ==
+            json::array({"string", "null"}));
+
+    // Built once per type
+    REQUIRE(&llmcpp::schemaFor<Person>() == &schema);
+
+    LLMRequestConfig config;
+    llmcpp::applySchema<Person>(config);
+    REQUIRE(config.functionName == "Person");
+    REQUIRE(config.internedSchema == llmcpp::internedSchemaFor<Person>());
+    REQUIRE(config.internedSchema->value() == schema);
+}
+
+TEST_CASE("Typed parser reads output text without a DOM", "[typed][unit]") {
+    const std::string text = R"({
+        "name": "Ada \"Countess\" Lovelace é",
+        "age": 36,
+        "score": 9.5,
+        "active": true,
+        "tags": ["math", "poetry"],
+        "address": {"city": "London", "postcode": null},
+        "previous": [{"city": "Marylebone"}],
+        "unknown": {"nested": [1, 2, {"x": "y"}]}
+    })";
+
+    Person p = llmcpp::parseStructured<Person>(std::string_view(text));
+    REQUIRE(p.name == "Ada \"Countess\" Lovelace \xC3\xA9");
+    REQUIRE(p.age == 36);
+    REQUIRE(p.score == 9.5);
+    REQUIRE(p.active);
+    REQUIRE(p.tags == std::vector<std::string>{"math", "poetry"});
+    REQUIRE(p.address.has_value());
+    REQUIRE(p.address->city == "London");
+    REQUIRE_FALSE(p.address->postcode.has_value());
+    REQUIRE(p.previous.size() == 1);
+    REQUIRE(p.previous[0].city == "Marylebone");
+
+    SECTION("Output generated from the schema validates against it") {
+        auto compiled = llmcpp::CompiledSchema::compile(llmcpp::schemaFor<Person>());
+        json dom = json::parse(text);
+        dom.erase("unknown");
+        dom["previous"][0]["postcode"] = nullptr;
+        REQUIRE(compiled->isValid(dom));
+    }
+
+    SECTION("DOM and text parsers agree") {
+        Person fromJson = llmcpp::parseStructured<Person>(json::parse(text));
+        REQUIRE(fromJson.name == p.name);
+        REQUIRE(fromJson.tags == p.tags);
+        REQUIRE(fromJson.address->city == "London");
+    }
+}
+
+TEST_CASE("Typed parser reports errors", "[typed][unit]") {
+    SECTION("Missing required field") {
+        std::string error;
+        auto result = llmcpp::tryParseStructured<Address>(R"({"postcode": "N1"})", &error);
+        REQUIRE_FALSE(result.has_value());
+        REQUIRE(error.find("city") != std::string::npos);
+    }
+
+    SECTION("Type mismatch includes the offset") {
+        try {
+            llmcpp::parseStructured<Person>(std::string_view(R"({"name": 42})"));
+            FAIL("expected TypedParseError");
+        } catch (const llmcpp::TypedParseError& e) {
+            REQUIRE(e.offset() == 9);
+        }
+    }
+
+    SECTION("Integers out of range") {
+        auto withAge = [](const std::string& age) {
+            return R"({"name": "a", "age": )" + age +
+                   R"(, "score": 1, "active": true, "tags": [], "previous": []})";
+        };
+        REQUIRE(llmcpp::tryParseStructured<Person>(withAge("3.0e1")));
+        REQUIRE_FALSE(llmcpp::tryParseStructured<Person>(withAge("1e300")));
+        REQUIRE_FALSE(llmcpp::tryParseStructured<Person>(withAge("9.3e18")));
+        REQUIRE_FALSE(llmcpp::tryParseStructured<Person>(withAge("4294967296")));
+
+        json tooLarge = json::parse(withAge("4294967296"));
+        REQUIRE_THROWS_AS(llmcpp::parseStructured<Person>(tooLarge), llmcpp::TypedParseError);
+        tooLarge["age"] = int64_t{-4294967296};
+        REQUIRE_THROWS_AS(llmcpp::parseStructured<Person>(tooLarge), llmcpp::TypedParseError);
+    }
+
+    SECTION("Trailing garbage and truncation") {
+        REQUIRE_FALSE(llmcpp::tryParseStructured<Address>(R"({"city": "Paris"} x)"));
+        REQUIRE_FALSE(llmcpp::tryParseStructured<Address>(R"({"city": "Par)"));
+    }
+
+    SECTION("Failed responses are not parsed") {
+        LLMResponse response;
+        response.success = false;
+        response.errorMessage = "rate limited";
+        REQUIRE_THROWS_AS(llmcpp::parseStructured<Address>(response), std::runtime_error);
+    }
+}